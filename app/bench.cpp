@@ -0,0 +1,423 @@
+/******************************************************************************
+ * bench.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "algorithms/push_relabel.h"
+#include "balance_configuration.h"
+#include "configuration.h"
+#include "data_structure/flow_graph.h"
+#include "data_structure/graph_access.h"
+#include "data_structure/priority_queues/bucket_pq.h"
+#include "graph_generator.h"
+#include "graph_io.h"
+#include "mmap_graph_io.h"
+#include "parse_bench_parameters.h"
+#include "partition/coarsening/clustering/size_constraint_label_propagation.h"
+#include "partition/coarsening/contraction.h"
+#include "partition/coarsening/matching/random_matching.h"
+#include "partition/graph_partitioner.h"
+#include "partition/partition_config.h"
+#include "partition/uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement_commons.h"
+#include "quality_metrics.h"
+#include "random_functions.h"
+#include "timer.h"
+
+// Every benchmark prints one JSON object per line. Times are in seconds, the
+// peak resident set size is the high water mark of the process during the
+// timed runs in KB (it cannot drop below the memory that was in use before).
+
+struct bench_stats {
+        std::vector< double > times;
+        long peak_rss;
+};
+
+static void reset_peak_rss() {
+        std::ofstream clear_refs("/proc/self/clear_refs");
+        if(clear_refs) clear_refs << "5";
+}
+
+static long peak_rss() {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while( std::getline(status, line) ) {
+                if( line.compare(0, 6, "VmHWM:") == 0 ) return atol(line.c_str() + 6);
+        }
+
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+}
+
+static double median(std::vector< double > values) {
+        std::sort(values.begin(), values.end());
+        unsigned mid = values.size() / 2;
+        return values.size() % 2 == 1 ? values[mid] : (values[mid-1] + values[mid]) / 2;
+}
+
+// runs setup (untimed) and kernel (timed) the given number of times
+template< typename Setup, typename Kernel >
+static bench_stats run_benchmark(int repetitions, Setup setup, Kernel kernel) {
+        bench_stats stats;
+        reset_peak_rss();
+        for( int i = 0; i < repetitions; i++) {
+                setup();
+                timer t;
+                kernel();
+                stats.times.push_back(t.elapsed());
+        }
+        stats.peak_rss = peak_rss();
+        return stats;
+}
+
+static void print_result(std::ostream & out, const std::string & fields, const bench_stats & stats) {
+        out << "{" << fields
+            << ",\"repetitions\":" << stats.times.size()
+            << ",\"time_min\":"    << *std::min_element(stats.times.begin(), stats.times.end())
+            << ",\"time_median\":" << median(stats.times)
+            << ",\"peak_rss_kb\":" << stats.peak_rss << "}" << std::endl;
+}
+
+/******************************************************************************
+ * generated graphs
+ *****************************************************************************/
+
+// rgg, grid and rmat keep the parameters of the original benchmark set, every other
+// name is passed to graph_generator::generate with an average degree of 8
+static bool generate_graph(const std::string & name, const BenchConfig & bench_config, graph_access & G) {
+        NodeID n = 1 << bench_config.scale;
+        if( name == "rgg" ) {
+                graph_generator::random_geometric(G, n, 0.55 * sqrt(log(n) / n), 2, bench_config.seed);
+        } else if( name == "grid" ) {
+                NodeID side = std::max(2, (int)sqrt(n));
+                graph_generator::triangulated_grid(G, side, side);
+        } else if( name == "rmat" ) {
+                graph_generator::rmat(G, bench_config.scale, 8, 0.57, 0.19, 0.19, bench_config.seed);
+        } else {
+                return graph_generator::generate(G, name, n, 8, bench_config.seed);
+        }
+        return true;
+}
+
+static bool apply_preset(const std::string & preset, PartitionConfig & partition_config) {
+        configuration cfg;
+        cfg.standard(partition_config);
+        if( preset == "strong" ) {
+                cfg.strong(partition_config);
+        } else if( preset == "eco" ) {
+                cfg.eco(partition_config);
+        } else if( preset == "fast" ) {
+                cfg.fast(partition_config);
+        } else if( preset == "fsocial" ) {
+                cfg.fastsocial(partition_config);
+        } else if( preset == "esocial" ) {
+                cfg.ecosocial(partition_config);
+        } else if( preset == "ssocial" ) {
+                cfg.strongsocial(partition_config);
+        } else {
+                return false;
+        }
+        return true;
+}
+
+// blocks of consecutive nodes in BFS order, a cheap partition with a small cut
+static void bfs_partition(graph_access & G, PartitionID k) {
+        std::vector< NodeID > order;
+        std::vector< bool > touched(G.number_of_nodes(), false);
+        order.reserve(G.number_of_nodes());
+        forall_nodes(G, start) {
+                if( touched[start] ) continue;
+                touched[start] = true;
+                order.push_back(start);
+                for( NodeID head = order.size() - 1; head < order.size(); head++) {
+                        NodeID node = order[head];
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if( !touched[target] ) {
+                                        touched[target] = true;
+                                        order.push_back(target);
+                                }
+                        } endfor
+                }
+        } endfor
+
+        G.set_partition_count(k);
+        for( NodeID i = 0; i < order.size(); i++) {
+                G.setPartitionIndex(order[i], (PartitionID)((unsigned long long)i * k / order.size()));
+        }
+}
+
+/******************************************************************************
+ * micro benchmarks
+ *****************************************************************************/
+
+static void run_micro_benchmarks(const BenchConfig & bench_config, const std::string & graph_name,
+                                 graph_access & G, std::ostream & out) {
+        std::stringstream graph_fields;
+        graph_fields << "\"benchmark\":\"micro\",\"graph\":\"" << graph_name << "\""
+                     << ",\"n\":" << G.number_of_nodes() << ",\"m\":" << G.number_of_edges() / 2;
+
+        PartitionConfig partition_config;
+        apply_preset("eco", partition_config);
+        partition_config.k = bench_config.k;
+        G.set_partition_count(bench_config.k);
+        balance_configuration bc;
+        bc.configurate_balance(partition_config, G);
+        random_functions::setSeed(bench_config.seed);
+
+        int repetitions = bench_config.repetitions;
+        NodeID n        = G.number_of_nodes();
+        std::mt19937 rng(bench_config.seed);
+
+        // bucket_pq: insert every node, change every key once, delete all
+        {
+                EdgeWeight span = std::max(1, (int)G.getMaxDegree());
+                std::uniform_int_distribution< Gain > gain(-span, span);
+                std::vector< Gain > gains(2 * n);
+                for( Gain & g : gains ) g = gain(rng);
+
+                long checksum = 0;
+                bucket_pq* queue = NULL;
+                bench_stats stats = run_benchmark(repetitions, [&]() {
+                        delete queue;
+                        queue = new bucket_pq(span);
+                }, [&]() {
+                        checksum = 0;
+                        for( NodeID node = 0; node < n; node++) queue->insert(node, gains[node]);
+                        for( NodeID node = 0; node < n; node++) queue->changeKey(node, gains[n + node]);
+                        while( !queue->empty() ) checksum += queue->deleteMax();
+                });
+                delete queue;
+
+                std::stringstream fields;
+                fields << graph_fields.str() << ",\"kernel\":\"bucket_pq\",\"operations\":" << 3 * (long)n
+                       << ",\"checksum\":" << checksum;
+                print_result(out, fields.str(), stats);
+        }
+
+        // compute_gain of every node for a BFS partition
+        {
+                bfs_partition(G, bench_config.k);
+                kway_graph_refinement_commons commons(partition_config);
+
+                long checksum = 0;
+                bench_stats stats = run_benchmark(repetitions, [](){}, [&]() {
+                        checksum = 0;
+                        forall_nodes(G, node) {
+                                PartitionID max_gainer;
+                                EdgeWeight ext_degree;
+                                checksum += commons.compute_gain(G, node, max_gainer, ext_degree);
+                        } endfor
+                });
+
+                std::stringstream fields;
+                fields << graph_fields.str() << ",\"kernel\":\"compute_gain\",\"operations\":" << (long)n
+                       << ",\"checksum\":" << checksum;
+                print_result(out, fields.str(), stats);
+        }
+
+        // push_relabel between the first two blocks of the BFS partition
+        {
+                NodeID source = n, sink = n + 1;
+                flow_graph fG;
+                FlowType flow = 0;
+                bench_stats stats = run_benchmark(repetitions, [&]() {
+                        fG.start_construction(n + 2, 2 * G.number_of_edges() + 2 * n);
+                        forall_nodes(G, node) {
+                                forall_out_edges(G, e, node) {
+                                        fG.new_edge(node, G.getEdgeTarget(e), G.getEdgeWeight(e));
+                                } endfor
+                                if( G.getPartitionIndex(node) == 0 ) {
+                                        fG.new_edge(source, node, std::numeric_limits< int >::max());
+                                } else if( G.getPartitionIndex(node) == 1 ) {
+                                        fG.new_edge(node, sink, std::numeric_limits< int >::max());
+                                }
+                        } endfor
+                        fG.finish_construction();
+                }, [&]() {
+                        push_relabel solver;
+                        std::vector< NodeID > source_set;
+                        flow = solver.solve_max_flow_min_cut(fG, source, sink, true, source_set);
+                });
+
+                std::stringstream fields;
+                fields << graph_fields.str() << ",\"kernel\":\"push_relabel\",\"flow\":" << flow;
+                print_result(out, fields.str(), stats);
+        }
+
+        // contraction of a random matching
+        {
+                Matching edge_matching;
+                CoarseMapping coarse_mapping;
+                NodePermutationMap permutation;
+                NodeID no_of_coarse_vertices = 0;
+                random_matching matcher;
+                partition_config.max_vertex_weight = partition_config.upper_bound_partition;
+                matcher.match(partition_config, G, edge_matching, coarse_mapping, no_of_coarse_vertices, permutation);
+
+                contraction contracter;
+                graph_access* coarser = NULL;
+                bench_stats stats = run_benchmark(repetitions, [&]() {
+                        delete coarser;
+                        coarser = new graph_access();
+                }, [&]() {
+                        contracter.contract(partition_config, G, *coarser, edge_matching,
+                                            coarse_mapping, no_of_coarse_vertices, permutation);
+                });
+
+                std::stringstream fields;
+                fields << graph_fields.str() << ",\"kernel\":\"contract\",\"coarse_n\":" << coarser->number_of_nodes();
+                print_result(out, fields.str(), stats);
+                delete coarser;
+        }
+
+        // size-constrained label propagation as used for cluster coarsening
+        {
+                size_constraint_label_propagation sclp;
+                NodeWeight block_upperbound = ceil(partition_config.upper_bound_partition /
+                                                   (double)partition_config.cluster_coarsening_factor);
+                std::vector< NodeID > cluster_id;
+                NodeID number_of_blocks = 0;
+                bench_stats stats = run_benchmark(repetitions, [](){}, [&]() {
+                        sclp.label_propagation(partition_config, G, block_upperbound, cluster_id, number_of_blocks);
+                });
+
+                std::stringstream fields;
+                fields << graph_fields.str() << ",\"kernel\":\"label_propagation\",\"clusters\":" << number_of_blocks;
+                print_result(out, fields.str(), stats);
+        }
+
+        // parsing the graph from a METIS file with mmap io and the stream based reader
+        {
+                char filename[] = "/tmp/kahip_bench_XXXXXX";
+                int fd = mkstemp(filename);
+                if( fd >= 0 ) {
+                        close(fd);
+                        graph_io::writeGraph(G, filename);
+
+                        bench_stats stats = run_benchmark(repetitions, [](){}, [&]() {
+                                graph_access H;
+                                kahip::mmap_io::graph_from_metis_file(H, filename);
+                        });
+                        std::stringstream fields;
+                        fields << graph_fields.str() << ",\"kernel\":\"mmap_io\"";
+                        print_result(out, fields.str(), stats);
+
+                        stats = run_benchmark(repetitions, [](){}, [&]() {
+                                graph_access H;
+                                graph_io::readGraphWeighted(H, filename);
+                        });
+                        std::stringstream stream_fields;
+                        stream_fields << graph_fields.str() << ",\"kernel\":\"graph_io\"";
+                        print_result(out, stream_fields.str(), stats);
+
+                        unlink(filename);
+                }
+        }
+
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, 0);
+        } endfor
+}
+
+/******************************************************************************
+ * macro benchmarks
+ *****************************************************************************/
+
+static void run_macro_benchmarks(const BenchConfig & bench_config, const std::string & graph_name,
+                                 graph_access & G, std::ostream & out) {
+        for( const std::string & preset : bench_config.presets ) {
+                PartitionConfig partition_config;
+                if( !apply_preset(preset, partition_config) ) {
+                        std::cerr << "unknown preset " << preset << std::endl;
+                        continue;
+                }
+                partition_config.k = bench_config.k;
+
+                std::vector< EdgeWeight > cuts;
+                double max_balance = 0;
+                int repetition = 0;
+                bench_stats stats = run_benchmark(bench_config.repetitions, [&]() {
+                        forall_nodes(G, node) {
+                                G.setPartitionIndex(node, 0);
+                        } endfor
+                        G.set_partition_count(partition_config.k);
+                        partition_config.seed = bench_config.seed + repetition++;
+                        srand(partition_config.seed);
+                        random_functions::setSeed(partition_config.seed);
+
+                        balance_configuration bc;
+                        bc.configurate_balance(partition_config, G);
+                }, [&]() {
+                        PartitionConfig working_config = partition_config;
+                        graph_partitioner partitioner;
+                        partitioner.perform_partitioning(working_config, G);
+
+                        quality_metrics qm;
+                        cuts.push_back(qm.edge_cut(G));
+                        max_balance = std::max(max_balance, qm.balance(G));
+                });
+
+                double avg_cut = 0;
+                for( EdgeWeight cut : cuts ) avg_cut += cut;
+                avg_cut /= cuts.size();
+
+                std::stringstream fields;
+                fields << "\"benchmark\":\"macro\",\"graph\":\"" << graph_name << "\""
+                       << ",\"n\":" << G.number_of_nodes() << ",\"m\":" << G.number_of_edges() / 2
+                       << ",\"preset\":\"" << preset << "\",\"k\":" << bench_config.k
+                       << ",\"cut_min\":" << *std::min_element(cuts.begin(), cuts.end())
+                       << ",\"cut_avg\":" << avg_cut
+                       << ",\"balance_max\":" << max_balance;
+                print_result(out, fields.str(), stats);
+        }
+}
+
+int main(int argn, char **argv) {
+        BenchConfig bench_config;
+        if( parse_bench_parameters(argn, argv, bench_config) ) {
+                return 0;
+        }
+
+        std::ofstream output_file;
+        if( bench_config.filename_output != "" ) {
+                output_file.open(bench_config.filename_output.c_str(), std::ios::app);
+                if( !output_file ) {
+                        std::cerr << "could not open " << bench_config.filename_output << std::endl;
+                        return 1;
+                }
+        }
+
+        // the partitioner writes to std::cout, the results go to the original stream
+        std::ostream out(bench_config.filename_output != "" ? output_file.rdbuf() : std::cout.rdbuf());
+        std::streambuf* backup = std::cout.rdbuf();
+        std::ofstream null_stream("/dev/null");
+        std::cout.rdbuf(null_stream.rdbuf());
+
+        for( const std::string & graph_name : bench_config.graphs ) {
+                graph_access G;
+                if( !generate_graph(graph_name, bench_config, G) ) {
+                        std::cerr << "unknown graph " << graph_name << std::endl;
+                        continue;
+                }
+
+                if( bench_config.run_micro ) run_micro_benchmarks(bench_config, graph_name, G, out);
+                if( bench_config.run_macro ) run_macro_benchmarks(bench_config, graph_name, G, out);
+        }
+
+        std::cout.rdbuf(backup);
+        return 0;
+}
@@ -264,6 +264,10 @@ inline void configuration::fast_separator( PartitionConfig & partition_config )
 
 inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.filename_output                        = "";
+        partition_config.trace_filename                         = "";
+        partition_config.generator                              = "";
+        partition_config.generator_nodes                        = 1 << 16;
+        partition_config.generator_avg_degree                   = 8;
         partition_config.use_mmap_io = false;
         partition_config.seed                                   = 0;
         partition_config.fast                                   = false;
@@ -343,6 +347,7 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.refinement_type                        = REFINEMENT_TYPE_FM;
         partition_config.flow_region_factor                     = 4.0;
         partition_config.aggressive_random_levels               = 3;
+        partition_config.gpa_local_max_rounds                   = 0;
         partition_config.refined_bubbling                       = true;
         partition_config.corner_refinement_enabled              = false;
         partition_config.bubbling_iterations                    = 1;
@@ -362,6 +367,7 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.kway_stop_rule                         = KWAY_SIMPLE_STOP_RULE;
         partition_config.kway_adaptive_limits_alpha             = 1.0;
         partition_config.max_flow_iterations                    = 10;
+        partition_config.flow_piercing_steps                    = 0;
         partition_config.no_change_convergence                  = false;
         partition_config.compute_vertex_separator               = false;
         partition_config.toposort_iterations                    = 4;
@@ -379,6 +385,8 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
 
         partition_config.disable_hard_rebalance                 = false;
         partition_config.amg_iterations                         = 5;
+        partition_config.algdist_test_vectors                   = 3;
+        partition_config.algdist_iterations                     = 7;
         partition_config.kaffpa_perfectly_balance               = false;
         partition_config.kaffpaE                                = false;
 
@@ -425,6 +433,8 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.label_iterations_refinement  = 25;
         partition_config.number_of_clusterings        = 1;
         partition_config.label_propagation_refinement = false;
+        partition_config.parallel_label_propagation_refinement = false;
+        partition_config.label_propagation_refinement_balance  = LP_BALANCE_STRICT;
         partition_config.balance_factor               = 0;
         partition_config.cluster_coarsening_during_ip = false;
         partition_config.set_upperbound               = true;
@@ -12,6 +12,7 @@
 #include "data_structure/graph_access.h"
 #include "graph_io.h"
 #include "macros_assertions.h"
+#include "mmap_graph_io.h"
 #include "parse_parameters.h"
 #include "partition/partition_config.h"
 #include "quality_metrics.h"
@@ -36,14 +37,18 @@ int main(int argn, char **argv) {
         }
 
         graph_access G;     
-        graph_io::readGraphWeighted(G, graph_filename);
+        if (partition_config.use_mmap_io) {
+                kahip::mmap_io::graph_from_metis_file(G, graph_filename);
+        } else {
+                graph_io::readGraphWeighted(G, graph_filename);
+        }
 
         G.set_partition_count(partition_config.k); 
  
         std::vector<PartitionID> input_partition;
         if(partition_config.input_partition != "") {
                 std::cout <<  "reading input partition" << std::endl;
-                graph_io::readPartition(G, partition_config.input_partition);
+                kahip::mmap_io::partition_from_file(G, partition_config.input_partition);
         } else {
                 std::cout <<  "Please specify an input partition using the --input_partition flag."  << std::endl;
                 exit(0);
@@ -51,12 +56,13 @@ int main(int argn, char **argv) {
 
         std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
         quality_metrics qm;
+        partition_metrics metrics = qm.evaluate(G);
 
-        std::cout << "cut \t\t"         << qm.edge_cut(G)                 << std::endl;
-        std::cout << "no boundary vertices \t\t" << qm.boundary_nodes(G)           << std::endl;
-        std::cout << "balance \t"       << qm.balance(G)                  << std::endl;
-        std::cout << "balance based on edges \t"       << qm.balance_edges(G)                  << std::endl;
-        std::cout << "max comm vol \t"  << qm.max_communication_volume(G) << std::endl;
-        std::cout << "min comm vol \t"  << qm.min_communication_volume(G) << std::endl;
-        std::cout << "total comm vol \t"  << qm.total_communication_volume(G) << std::endl;
+        std::cout << "cut \t\t"         << metrics.edge_cut                   << std::endl;
+        std::cout << "no boundary vertices \t\t" << metrics.boundary_nodes    << std::endl;
+        std::cout << "balance \t"       << metrics.balance                    << std::endl;
+        std::cout << "balance based on edges \t"       << metrics.balance_edges << std::endl;
+        std::cout << "max comm vol \t"  << metrics.max_communication_volume   << std::endl;
+        std::cout << "min comm vol \t"  << metrics.min_communication_volume   << std::endl;
+        std::cout << "total comm vol \t"  << metrics.total_communication_volume << std::endl;
 }
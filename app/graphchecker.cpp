@@ -1,5 +1,5 @@
 /******************************************************************************
- * graphchecker.cpp 
+ * graphchecker.cpp
  * *
  * Source of KaHIP -- Karlsruhe High Quality Partitioning.
  * Christian Schulz <christian.schulz.phone@gmail.com>
@@ -7,16 +7,249 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <limits>
+#include <string>
 #include <vector>
-#include <unordered_set>
+#include <omp.h>
+
+#include "data_structure/graph_access.h"
+#include "mmap_graph_io.h"
 
 using namespace std;
 
-// this program implements the functions to check the metis graph 
+const std::string separator_line = "*******************************************************************************";
+
+// a part of the file that starts and ends at a line boundary,
+// every chunk is parsed by one thread
+struct file_chunk {
+        std::size_t begin;
+        std::size_t end;
+        long lines;      // all lines including comments
+        long node_lines; // lines that describe a node
+
+        // set by the parsing pass
+        long first_line;
+        long first_node;
+        long edges;        // (directed) edges described in the chunk
+        long node_weight_sum;
+        long edge_weight_sum;
+        long invalid_node; // first node with a parallel edge or a self-loop
+        std::string error;
+        std::string invalid_node_error;
+};
+
+static void fail(const std::string & message) {
+        std::cout << message;
+        std::cout << separator_line << std::endl;
+        exit(1);
+}
+
+static inline bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+}
+
+static inline std::size_t end_of_line(const char * contents, std::size_t position, std::size_t end) {
+        const char * newline = (const char *) memchr(contents + position, '\n', end - position);
+        return newline == NULL ? end : newline - contents;
+}
+
+// parses the numbers of one line, returns false if the line contains anything else
+static bool parse_line(const char * p, const char * end, std::vector< long > & numbers) {
+        numbers.clear();
+        while( p < end ) {
+                while( p < end && is_space(*p) ) p++;
+                if( p == end ) break;
+
+                bool negative = *p == '-';
+                if( negative ) p++;
+                if( p == end || !isdigit(*p) ) return false;
+
+                long number = 0;
+                while( p < end && isdigit(*p) ) {
+                        if( number < std::numeric_limits<long>::max() / 10 - 10 ) {
+                                number = number * 10 + (*p - '0');
+                        }
+                        p++;
+                }
+                if( p < end && !is_space(*p) ) return false;
+
+                numbers.push_back(negative ? -number : number);
+        }
+        return true;
+}
+
+// counts lines and node lines of a chunk, the lines are not parsed
+static void count_chunk(const char * contents, file_chunk & chunk) {
+        chunk.lines = chunk.node_lines = 0;
+        for( std::size_t position = chunk.begin; position < chunk.end; position = end_of_line(contents, position, chunk.end) + 1) {
+                chunk.lines++;
+                if( contents[position] != '%' ) chunk.node_lines++;
+        }
+}
+
+static inline long target_of(uint64_t adjacent) {
+        return (long)(adjacent >> 32);
+}
+
+static inline long weight_of(uint64_t adjacent) {
+        return (long)(adjacent & 0xFFFFFFFF);
+}
+
+// random looking key of the arc (source,target) with the given weight
+static inline uint64_t arc_key(long source, long target, long weight) {
+        uint64_t x = ((uint64_t)source << 32 | (uint64_t)target) + 0x9e3779b97f4a7c15ULL * ((uint64_t)weight + 1);
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+}
+
+// the arcs of a node line that has been validated by parse_chunk, target and weight
+// are packed such that sorting orders by target
+static void arcs_of_line(const char * contents, std::size_t position, std::size_t length, bool node_weights, bool edge_weights,
+                         std::vector< long > & numbers, std::vector< uint64_t > & arcs) {
+        parse_line(contents + position, contents + end_of_line(contents, position, length), numbers);
+        arcs.clear();
+        for( std::size_t i = node_weights ? 1 : 0; i < numbers.size(); ) {
+                long target      = numbers[i++] - 1;
+                long edge_weight = edge_weights ? numbers[i++] : 1;
+                arcs.push_back(((uint64_t)target << 32) | (uint64_t)edge_weight);
+        }
+        std::sort(arcs.begin(), arcs.end());
+}
+
+// parses and validates the node lines of a chunk, stops at the first error of the chunk.
+// The graph is not stored, every arc (u,v,w) adds its key to balance[u] and removes the
+// key of (v,u,w) from balance[v]. If the file contains all backward edges with the same
+// weights, all balances are zero afterwards.
+static void parse_chunk(const char * contents, file_chunk & chunk, long nmbNodes, long ew, bool node_weights, bool edge_weights,
+                        std::vector< std::atomic< uint64_t > > & balance) {
+        std::vector< long > numbers;
+        std::vector< uint64_t > arcs;
+        long line = chunk.first_line;
+        long node = chunk.first_node;
+        chunk.edges = chunk.node_weight_sum = chunk.edge_weight_sum = 0;
+        chunk.invalid_node = nmbNodes;
+
+        std::size_t position = chunk.begin;
+        for( ; position < chunk.end; position = end_of_line(contents, position, chunk.end) + 1, line++) {
+                if( contents[position] == '%' ) continue; // a comment in the file
+
+                std::stringstream error;
+                std::size_t line_end = end_of_line(contents, position, chunk.end);
+                if( node >= nmbNodes ) break; // reported when the node counts are compared
+
+                if( !parse_line(contents + position, contents + line_end, numbers) ) {
+                        error <<  "Line " << line << " of your file contains something that is not a number."  << std::endl;
+                        chunk.error = error.str();
+                        return;
+                }
+
+                std::size_t i = 0;
+                if( node_weights ) {
+                        if( numbers.empty() ) {
+                                error <<  "The node " <<  node+1 << " has no node weight."  << std::endl;
+                                error <<  "See line " << line << " of your file."  << std::endl;
+                                chunk.error = error.str();
+                                return;
+                        }
+                        long node_weight = numbers[i++];
+                        if( node_weight < 0 ) {
+                                error <<  "The node " <<  node+1 << " has weight < 0."  << std::endl;
+                                error <<  "See line " << line << " of your file."  << std::endl;
+                                chunk.error = error.str();
+                                return;
+                        }
+                        chunk.node_weight_sum += node_weight;
+                }
+
+                if( edge_weights && (numbers.size() - i) % 2 != 0 ) {
+                        error <<  "Something is wrong."  << std::endl;
+                        error <<  "See line " << line << " of your file."  << std::endl;
+                        error <<  "There is not the right amount of numbers in line " << line << " of the file. " << std::endl;
+                        if( node_weights ) {
+                                error <<  "That means either the node weight is missing, "
+                                      <<  "or there is an edge without a weight specified, "
+                                      <<  "or there are no edge weights at all despite the specification "
+                                      <<  ew  << " in the first line of the file."<< std::endl;
+                        } else {
+                                error <<  "That there is may be an edge without an edge weight specified "
+                                      <<  "or there are no edge weights at all despite the specification "
+                                      <<  ew  << " in the first line of the file."<< std::endl;
+                        }
+                        chunk.error = error.str();
+                        return;
+                }
+
+                arcs.clear();
+                while( i < numbers.size() ) {
+                        long target = numbers[i++];
+                        if( target > nmbNodes || target <= 0 ) {
+                                error <<  "Node " << node+1 << " has an edge to a node greater than the number of nodes specified in the file or smaller or equal to zero, i.e. it has target " <<  target << " and the number of nodes specified was " <<  nmbNodes << std::endl;
+                                error <<  "See line " << line << " of your file."  << std::endl;
+                                chunk.error = error.str();
+                                return;
+                        }
+
+                        long edge_weight = 1;
+                        if( edge_weights ) {
+                                edge_weight = numbers[i++];
+                                if( edge_weight > (long)std::numeric_limits<unsigned int>::max() ) {
+                                        error <<  "The sum of the edge weights exeeds 32 bits. Currently not supported."  << std::endl;
+                                        error <<  "Please scale weights of the graph."  << std::endl;
+                                        chunk.error = error.str();
+                                        return;
+                                }
+                                if( edge_weight <= 0 ) {
+                                        error <<  "The edge starting from node " <<  (node+1) << " and ending in node " << target
+                                              <<  " has weight <= 0. " << std::endl;
+                                        error <<  "See line " << line << " of your file."  << std::endl;
+                                        chunk.error = error.str();
+                                        return;
+                                }
+                                chunk.edge_weight_sum += edge_weight;
+                        }
+
+                        arcs.push_back(((uint64_t)(target - 1) << 32) | (uint64_t)edge_weight);
+                }
+                chunk.edges += arcs.size();
+
+                // sort the arcs of the line, then parallel edges are neighbours
+                std::sort(arcs.begin(), arcs.end());
+                for( std::size_t a = 0; a < arcs.size() && chunk.invalid_node == nmbNodes; a++) {
+                        long target = target_of(arcs[a]);
+                        if( a > 0 && target_of(arcs[a-1]) == target ) {
+                                error <<  "The file contains parallel edges."  << std::endl;
+                                error <<  "In line " <<  line << " of the file " <<  (target+1) << " is listed twice."   << std::endl;
+                        } else if( target == node ) {
+                                error <<  "The file contains a graph with self-loops."  << std::endl;
+                                error <<  "In line " <<  line << " of the file (node="
+                                      << node+1 << ") the target " <<  (target+1) << " is listed."   << std::endl;
+                        } else {
+                                continue;
+                        }
+                        chunk.invalid_node       = node;
+                        chunk.invalid_node_error = error.str();
+                }
+
+                for( uint64_t arc : arcs ) {
+                        long target = target_of(arc);
+                        balance[node].fetch_add(arc_key(node, target, weight_of(arc)), std::memory_order_relaxed);
+                        balance[target].fetch_sub(arc_key(target, node, weight_of(arc)), std::memory_order_relaxed);
+                }
+                node++;
+        }
+}
+
+// this program implements the functions to check the metis graph
 // format
 int main(int argn, char **argv)
 {
@@ -26,7 +259,6 @@ int main(int argn, char **argv)
                 exit(0);
         }
 
-        std::string line;
         std::string filename(argv[1]);
 
         // open file for reading
@@ -35,44 +267,37 @@ int main(int argn, char **argv)
                 std::cerr << "Error opening " << filename << std::endl;
                 return 1;
         }
+        in.close();
 
-        std::cout <<  "*******************************************************************************"  << std::endl;
+        std::cout <<  separator_line  << std::endl;
         std::cout <<  "KaHIP -- graph format checker."  << std::endl;
         std::cout <<  "Output will be given using the IDs from file, i.e. the IDs are starting from 1."  << std::endl;
-        std::cout <<  "*******************************************************************************"  << std::endl;
+        std::cout <<  separator_line  << std::endl;
+
+        kahip::mmap_io::MappedFile mapped_file = kahip::mmap_io::mmap_file_from_disk(filename);
+        const char * contents = mapped_file.contents;
+        const std::size_t length = mapped_file.length;
 
-        std::getline(in,line);
         //skip comments
-        while( line[0] == '%' ) {
-                std::getline(in, line);
+        std::size_t position = 0;
+        long line = 1;
+        while( position < length && contents[position] == '%' ) {
+                position = end_of_line(contents, position, length) + 1;
+                line++;
         }
 
-        long nmbNodes;
-        long nmbEdges;
-        long ew = 0;
-
-        std::stringstream ss(line);
-        ss >> nmbNodes;
-        ss >> nmbEdges;
-        ss >> ew;
-
-
-        std::vector< long > node_starts;
-        node_starts.reserve(nmbNodes + 1);
-        node_starts.push_back(0);
-
-        std::vector< long > adjacent_nodes;
-        adjacent_nodes.reserve(nmbEdges * 2);
-
-        std::vector< long > graph_edgeweights;
-        graph_edgeweights.reserve(nmbEdges * 2);
-        long node_weight;
-        long total_nodeweight = 0;
-        long total_edgeweight = 0;
+        std::vector< long > header;
+        std::size_t header_end = end_of_line(contents, std::min(position, length), length);
+        if( position >= length || !parse_line(contents + position, contents + header_end, header) || header.size() < 2 ) {
+                fail("The first line of the file has to contain the number of nodes and the number of edges.\n");
+        }
 
-        long node_degree = 0;
-        long node_counter = 0;
-        long edge_counter = 0;
+        long nmbNodes = header[0];
+        long nmbEdges = header[1];
+        long ew       = header.size() > 2 ? header[2] : 0;
+        if( nmbNodes < 0 || nmbEdges < 0 || nmbNodes >= (long)std::numeric_limits<unsigned int>::max() ) {
+                fail("The number of nodes or edges in the first line of the file is invalid or exceeds 32 bits.\n");
+        }
 
         bool node_weights = false;
         bool edge_weights = false;
@@ -85,185 +310,160 @@ int main(int argn, char **argv)
                 edge_weights = true;
         }
 
-        while( std::getline(in, line) ) {
-                
-                if( node_counter > nmbNodes ) {
-                        std::cout <<  "There are more nodes in the file than specified in the first line of the file."  << std::endl;
-                        std::cout <<  "You specified " <<  nmbNodes << " nodes." << std::endl;
-                        std::cout <<  node_counter  << std::endl;
-                        std::cout <<  "*******************************************************************************"  << std::endl;
-                        exit(0);
-                }
+        // cut the rest of the file into chunks at line boundaries
+        const std::size_t body_begin = std::min(header_end + 1, length);
+        const int num_chunks = 4 * omp_get_max_threads();
+        std::vector< file_chunk > chunks(num_chunks);
+        for( int c = 0; c < num_chunks; c++) {
+                std::size_t begin = body_begin + (length - body_begin) / num_chunks * c;
+                if( c > 0 ) begin = std::max(begin, chunks[c-1].begin);
+                while( begin < length && begin > body_begin && contents[begin-1] != '\n' ) begin++;
+                chunks[c].begin = begin;
+                if( c > 0 ) chunks[c-1].end = begin;
+        }
+        chunks[num_chunks-1].end = length;
 
-                if (line[0] == '%') { // a comment in the file
-                        continue;
-                }
-                node_degree = 0;
+        #pragma omp parallel for schedule(dynamic, 1)
+        for( int c = 0; c < num_chunks; c++) {
+                count_chunk(contents, chunks[c]);
+        }
 
-                std::stringstream ss(line);
-                if( node_weights ) {
-                        ss >> node_weight;
-                        if( node_weight < 0 ) {
-                            std::cout <<  "The node " <<  node_counter+1 << " has weight < 0."  << std::endl;
-                            std::cout <<  "See line " << node_counter+2 << " of your file."  << std::endl;
-                            std::cout <<  "*******************************************************************************"  << std::endl;
-                            exit(0);
-                        }
-                        total_nodeweight += node_weight;
-                        if(total_nodeweight > (long)std::numeric_limits<unsigned int>::max()) {
-                                std::cout <<  "The sum of the node weights exeeds 32 bits. Currently not supported."  << std::endl;
-                                std::cout <<  "Please scale weights of the graph."  << std::endl;
-                                std::cout <<  "*******************************************************************************"  << std::endl;
-                                exit(0);
-                        }
+        long node_counter = 0;
+        for( int c = 0; c < num_chunks; c++) {
+                chunks[c].first_line = line + 1;
+                chunks[c].first_node = node_counter;
+                line         += chunks[c].lines;
+                node_counter += chunks[c].node_lines;
+        }
+
+        std::vector< std::atomic< uint64_t > > balance(nmbNodes);
+        #pragma omp parallel for schedule(dynamic, 1)
+        for( int c = 0; c < num_chunks; c++) {
+                parse_chunk(contents, chunks[c], nmbNodes, ew, node_weights, edge_weights, balance);
+        }
+
+        // report the first error in the file
+        long edge_counter     = 0;
+        long total_nodeweight = 0;
+        long total_edgeweight = 0;
+        for( int c = 0; c < num_chunks; c++) {
+                if( !chunks[c].error.empty() ) {
+                        fail(chunks[c].error);
                 }
+                edge_counter     += chunks[c].edges;
+                total_nodeweight += chunks[c].node_weight_sum;
+                total_edgeweight += chunks[c].edge_weight_sum;
+        }
 
-                long target;
-                while( ss >> target ) {
-                        node_degree++;
-                        if( target > nmbNodes || target <= 0 ) {
-                                 std::cout <<  "Node " << node_counter+1 << " has an edge to a node greater than the number of nodes specified in the file or smaller or equal to zero, i.e. it has target " <<  target << " and the number of nodes specified was " <<  nmbNodes << std::endl;
-                                 std::cout <<  "See line " << node_counter+2 << " of your file."  << std::endl;
-                                 std::cout <<  "*******************************************************************************"  << std::endl;
-                                 exit(0);
-                        }
-                        adjacent_nodes.push_back(target - 1);
-                        long edge_weight = 1;
-                        if( edge_weights ) {
-                                if( ss.eof() ) {
-                                        std::cout <<  "Something is wrong."  << std::endl;
-                                        std::cout <<  "See line " << node_counter+2 << " of your file."  << std::endl;
-                                        std::cout <<  "There is not the right amount of numbers in line " << node_counter+2 << " of the file. " << std::endl;
-                                        if( node_weights ) {
-                                                std::cout <<  "That means either the node weight is missing, "
-                                                          <<  "or there is an edge without a weight specified, " 
-                                                          <<  "or there are no edge weights at all despite the specification " 
-                                                          <<  ew  << " in the first line of the file."<< std::endl;
-                                                std::cout <<  "*******************************************************************************"  << std::endl;
-                                        } else {
-                                                std::cout <<  "That there is may be an edge without an edge weight specified "
-                                                          <<  "or there are no edge weights at all despite the specification " 
-                                                          <<  ew  << " in the first line of the file."<< std::endl;
-                                                std::cout <<  "*******************************************************************************"  << std::endl;
-
-                                        }
-                                        exit(0);
+        if( node_counter > nmbNodes ) {
+                std::stringstream error;
+                error <<  "There are more nodes in the file than specified in the first line of the file."  << std::endl;
+                error <<  "You specified " <<  nmbNodes << " nodes." << std::endl;
+                error <<  node_counter  << std::endl;
+                fail(error.str());
+        }
 
-                                }
-                                ss >> edge_weight;
-                                total_edgeweight += edge_weight;
-
-                                if(total_edgeweight > (long)std::numeric_limits<unsigned int>::max()) {
-                                        std::cout <<  "The sum of the edge weights exeeds 32 bits. Currently not supported."  << std::endl;
-                                        std::cout <<  "Please scale weights of the graph."  << std::endl;
-                                        std::cout <<  "*******************************************************************************"  << std::endl;
-                                        exit(0);
-                                }
+        if(total_nodeweight > (long)std::numeric_limits<unsigned int>::max()) {
+                fail("The sum of the node weights exeeds 32 bits. Currently not supported.\nPlease scale weights of the graph.\n");
+        }
 
-                                if( edge_weight <= 0 ) {
-                                        std::cout <<  "The edge starting from node " <<  (node_counter+1) << " and ending in node " << target  
-                                                  <<  " has weight <= 0. " << std::endl;
-                                        std::cout <<  "See line " << node_counter+2 << " of your file."  << std::endl;
-                                        std::cout <<  "*******************************************************************************"  << std::endl;
-                                        exit(0);
-                                }
-                        }
-                        graph_edgeweights.push_back(edge_weight);
-                        edge_counter++;
-                }
-                node_counter++;
-                node_starts.push_back(node_starts.back() + node_degree);
-                if(in.eof()) {
-                        break;
-                }
+        if(total_edgeweight > (long)std::numeric_limits<unsigned int>::max()) {
+                fail("The sum of the edge weights exeeds 32 bits. Currently not supported.\nPlease scale weights of the graph.\n");
         }
-        std::cout <<  "IO done. Now checking the graph .... "  << std::endl;
 
+        std::cout <<  "IO done. Now checking the graph .... "  << std::endl;
 
         // check node counter
         if( node_counter != nmbNodes ) {
-                std::cout <<  "The number of nodes specified in the beginning of the file "
-                          <<  "does not match the number of nodes that are in the file."  << std::endl;
-                std::cout <<  "You specified " <<  nmbNodes <<  " but there are " <<  node_counter  << std::endl;
-                std::cout <<  "*******************************************************************************"  << std::endl;
-                exit(0);
+                std::stringstream error;
+                error <<  "The number of nodes specified in the beginning of the file "
+                      <<  "does not match the number of nodes that are in the file."  << std::endl;
+                error <<  "You specified " <<  nmbNodes <<  " but there are " <<  node_counter  << std::endl;
+                fail(error.str());
         }
 
         // check edge counter
-        if( edge_counter != 2*nmbEdges || node_starts.back() != 2*nmbEdges) {
-                std::cout <<  "The number of edges specified in the beginning of the file " 
-                          <<  "does not match the number of edges that are in the file."  << std::endl;
-                std::cout <<  "You specified " <<  2*nmbEdges <<  " but there are " <<  edge_counter << std::endl;
-                std::cout <<  "*******************************************************************************"  << std::endl;
-                exit(0);
+        if( edge_counter != 2*nmbEdges ) {
+                std::stringstream error;
+                error <<  "The number of edges specified in the beginning of the file "
+                      <<  "does not match the number of edges that are in the file."  << std::endl;
+                error <<  "You specified " <<  2*nmbEdges <<  " but there are " <<  edge_counter << std::endl;
+                fail(error.str());
         }
 
+        // parallel edges and self-loops, the chunks are in file order
+        for( int c = 0; c < num_chunks; c++) {
+                if( chunks[c].invalid_node < nmbNodes ) {
+                        fail(chunks[c].invalid_node_error);
+                }
+        }
 
-        // check if there are parallel edges
+        long first_unbalanced_node = nmbNodes;
+        #pragma omp parallel for schedule(static) reduction(min:first_unbalanced_node)
         for( long node = 0; node < nmbNodes; node++) {
-                std::unordered_set< long > seen_adjacent_nodes;
-                for( long e = node_starts[node]; e < node_starts[node + 1]; e++) {
-                        long target = adjacent_nodes[e];
-                        if( !seen_adjacent_nodes.insert(target).second ) {
-                                std::cout <<  "The file contains parallel edges."  << std::endl;
-                                std::cout <<  "In line " <<  node+2 << " of the file " <<  (target+1) << " is listed twice."   << std::endl;
-                                std::cout <<  "*******************************************************************************"  << std::endl;
-                                exit(0);
-                        }
+                if( balance[node].load(std::memory_order_relaxed) != 0 ) {
+                        first_unbalanced_node = std::min(first_unbalanced_node, node);
+                }
+        }
 
-                        // check for self loops
-                        if( target == node ) {
-                                std::cout <<  "The file contains a graph with self-loops."  << std::endl;
-                                std::cout <<  "In line " <<  node+2 << " of the file (node=" 
-                                          << node+1 << ") the target " <<  (target+1) << " is listed."   << std::endl;
-                                std::cout <<  "*******************************************************************************"  << std::endl;
-                                exit(0);
+        if( first_unbalanced_node < nmbNodes ) {
+                // only needed to report the error, position and line of every node in the file
+                std::vector< std::size_t > node_position(nmbNodes);
+                std::vector< long > node_line(nmbNodes);
+                #pragma omp parallel for schedule(dynamic, 1)
+                for( int c = 0; c < num_chunks; c++) {
+                        long cur_line = chunks[c].first_line;
+                        long cur_node = chunks[c].first_node;
+                        for( std::size_t pos = chunks[c].begin; pos < chunks[c].end; pos = end_of_line(contents, pos, chunks[c].end) + 1, cur_line++) {
+                                if( contents[pos] == '%' ) continue;
+                                node_position[cur_node] = pos;
+                                node_line[cur_node++]   = cur_line;
                         }
                 }
-        }
 
-        // if for backward edges and also check if the weights match
-        for( long node = 0; node < nmbNodes; node++) {
-                for( long e = node_starts[node]; e < node_starts[node + 1]; e++) {
-                        long target = adjacent_nodes[e];
-                        long forward_weight = graph_edgeweights[e];
-
-                        bool found = false;
-                        for( long e_bar = node_starts[target]; e_bar < node_starts[target + 1]; e_bar++) {
-                                if( adjacent_nodes[e_bar] == node) {
-                                        found = true;
-                                        if( graph_edgeweights[e_bar] != forward_weight) {
-                                                std::cout <<  "The file does not contain valid edge weights. " 
-                                                          <<  "The weights of the forward edges must be equal " 
-                                                          <<  "to the weight of the backward edges. "<< std::endl;
-                                                std::cout <<  "Node " <<  node+1 << " does contain an arc to node " 
-                                                          << target+1 << " with weight " << forward_weight 
-                                                          <<  " but the weight of the backward edge (" <<  target+1 << "," << node+1 << ") " 
-                                                          <<  " is  " << graph_edgeweights[e_bar] << std::endl;
-                                                std::cout <<  "You can find the backward edge in line " << target+2 << " of the file."  << std::endl;
-                                                std::cout <<  "You can find the forward edge in line " << node+2 << " of the file."  << std::endl;
-                                                std::cout <<  "*******************************************************************************"  << std::endl;
-                                                exit(0);
-                                        } 
-                                        break;
+                // an unbalanced node has a forward edge without backward edge or an
+                // incoming edge without outgoing edge, look for the first node of the first kind
+                std::vector< long > numbers;
+                std::vector< uint64_t > arcs;
+                std::vector< uint64_t > target_arcs;
+                for( long node = first_unbalanced_node; node < nmbNodes; node++) {
+                        if( balance[node].load(std::memory_order_relaxed) == 0 ) continue;
+
+                        arcs_of_line(contents, node_position[node], length, node_weights, edge_weights, numbers, arcs);
+                        for( uint64_t arc : arcs ) {
+                                long target         = target_of(arc);
+                                long forward_weight = weight_of(arc);
+                                arcs_of_line(contents, node_position[target], length, node_weights, edge_weights, numbers, target_arcs);
+                                auto backward_edge = std::lower_bound(target_arcs.begin(), target_arcs.end(), (uint64_t)node << 32);
+
+                                std::stringstream error;
+                                if( backward_edge == target_arcs.end() || target_of(*backward_edge) != node ) {
+                                        error <<  "The file does not contain all forward and backward edges. "  << std::endl;
+                                        error <<  "Node " <<  node+1 << " (line " << node_line[node]
+                                              << ") does contain an arc to node " << target+1 << " but there is no edge ("
+                                              <<  target+1 << "," << node+1 << ") in the file. "<<  std::endl;
+                                        error <<  "Please insert this edge in line " << node_line[target] << " of the file." << std::endl;
+                                        fail(error.str());
+                                } else if( weight_of(*backward_edge) != forward_weight) {
+                                        error <<  "The file does not contain valid edge weights. "
+                                              <<  "The weights of the forward edges must be equal "
+                                              <<  "to the weight of the backward edges. "<< std::endl;
+                                        error <<  "Node " <<  node+1 << " does contain an arc to node "
+                                              << target+1 << " with weight " << forward_weight
+                                              <<  " but the weight of the backward edge (" <<  target+1 << "," << node+1 << ") "
+                                              <<  " is  " << weight_of(*backward_edge) << std::endl;
+                                        error <<  "You can find the backward edge in line " << node_line[target] << " of the file."  << std::endl;
+                                        error <<  "You can find the forward edge in line " << node_line[node] << " of the file."  << std::endl;
+                                        fail(error.str());
                                 }
                         }
-                        if(!found) {
-                                std::cout <<  "The file does not contain all forward and backward edges. "  << std::endl;
-                                std::cout <<  "Node " <<  node+1 << " (line " << node+2 
-                                          << ") does contain an arc to node " << target+1 << " but there is no edge ("
-                                          <<  target+1 << "," << node+1 << ") in the file. "<<  std::endl;
-                                std::cout <<  "Please insert this edge in line " << target+2 << " of the file." << std::endl;
-                                std::cout <<  "*******************************************************************************"  << std::endl;
-                                exit(0);
-                        }
                 }
         }
+        kahip::mmap_io::munmap_file_from_disk(mapped_file);
 
         std::cout <<  "The graph format seems correct."  << std::endl;
-        std::cout <<  "*******************************************************************************"  << std::endl;
+        std::cout <<  separator_line  << std::endl;
 
 
         return 0;
 }
-
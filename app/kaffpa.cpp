@@ -17,6 +17,7 @@
 #include "data_structure/graph_access.h"
 #include "data_structure/matrix/normal_matrix.h"
 #include "data_structure/matrix/online_distance_matrix.h"
+#include "graph_generator.h"
 #include "graph_io.h"
 #include "macros_assertions.h"
 #include "mapping/mapping_algorithms.h"
@@ -28,6 +29,7 @@
 #include "quality_metrics.h"
 #include "random_functions.h"
 #include "timer.h"
+#include "trace.h"
 
 int main(int argn, char **argv) {
 
@@ -59,7 +61,13 @@ int main(int argn, char **argv) {
         graph_access G;     
 
         timer t;
-        if (partition_config.use_mmap_io) {
+        if (!partition_config.generator.empty()) {
+                if(!graph_generator::generate(G, partition_config.generator, partition_config.generator_nodes,
+                                              partition_config.generator_avg_degree, partition_config.seed)) {
+                        std::cerr <<  "unknown generator " << partition_config.generator  << std::endl;
+                        return 1;
+                }
+        } else if (partition_config.use_mmap_io) {
                 kahip::mmap_io::graph_from_metis_file(G, graph_filename);
         } else {
                 graph_io::readGraphWeighted(G, graph_filename);
@@ -76,6 +84,10 @@ int main(int argn, char **argv) {
 
         std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
         // ***************************** perform partitioning ***************************************       
+        if(partition_config.trace_filename != "") {
+                trace::enable();
+        }
+
         t.restart();
         graph_partitioner partitioner;
         quality_metrics qm;
@@ -117,6 +129,10 @@ int main(int argn, char **argv) {
         std::cout.rdbuf(backup);
         std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
 
+        if(trace::enabled() && !trace::write(partition_config.trace_filename)) {
+                std::cerr <<  "could not write trace to " << partition_config.trace_filename  << std::endl;
+        }
+
         int qap = 0;
         if(partition_config.enable_mapping) {
                 std::cout <<  "performing mapping!"  << std::endl;
@@ -26,6 +26,7 @@
 #include "quality_metrics.h"
 #include "random_functions.h"
 #include "timer.h"
+#include "trace.h"
 
 int main(int argn, char **argv) {
 
@@ -79,16 +80,30 @@ int main(int argn, char **argv) {
                 } endfor
         }
 
+        int rank, size;
+        MPI_Comm communicator = MPI_COMM_WORLD; 
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
+
+        if(partition_config.trace_filename != "") {
+                trace::enable(rank);
+        }
+
         t.restart();
 
         parallel_mh_async mh;
         mh.perform_partitioning(partition_config, G);
 
-        
-        int rank, size;
-        MPI_Comm communicator = MPI_COMM_WORLD; 
-        MPI_Comm_rank( communicator, &rank);
-        MPI_Comm_size( communicator, &size);
+        if(trace::enabled()) {
+                // every process writes its own trace, they can be loaded together
+                std::stringstream trace_filename;
+                trace_filename << partition_config.trace_filename;
+                if( size > 1 ) trace_filename << "." << rank;
+
+                if(!trace::write(trace_filename.str())) {
+                        std::cerr <<  "could not write trace to " << trace_filename.str()  << std::endl;
+                }
+        }
 
         if( rank == ROOT ) {
                 std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
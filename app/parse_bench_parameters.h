@@ -0,0 +1,126 @@
+/******************************************************************************
+ * parse_bench_parameters.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PARSE_BENCH_PARAMETERS_4XK8ZQ1M
+#define PARSE_BENCH_PARAMETERS_4XK8ZQ1M
+
+#include <algorithm>
+#include <argtable3.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct BenchConfig {
+        // generated graphs have about 2^scale nodes
+        int scale;
+        PartitionID k;
+        int repetitions;
+        int seed;
+        bool run_micro;
+        bool run_macro;
+        std::vector< std::string > graphs;
+        std::vector< std::string > presets;
+        std::string filename_output;
+};
+
+static std::vector< std::string > split_comma_list(const std::string & list) {
+        std::vector< std::string > items;
+        std::stringstream ss(list);
+        std::string item;
+        while( std::getline(ss, item, ',') ) {
+                if( !item.empty() ) items.push_back(item);
+        }
+        return items;
+}
+
+int parse_bench_parameters(int argn, char **argv, BenchConfig & bench_config) {
+        const char *progname = argv[0];
+
+        struct arg_lit *help            = arg_lit0(NULL, "help","Print help.");
+        struct arg_int *scale           = arg_int0(NULL, "scale", NULL, "Generated graphs have about 2^scale nodes. Default: 14.");
+        struct arg_int *k               = arg_int0(NULL, "k", NULL, "Number of blocks for the kernels and presets (at least 2). Default: 16.");
+        struct arg_int *repetitions     = arg_int0(NULL, "repetitions", NULL, "Number of timed runs of every benchmark. Default: 3.");
+        struct arg_int *user_seed       = arg_int0(NULL, "seed", NULL, "Seed for the generators and the partitioner. Default: 0.");
+        struct arg_str *graphs          = arg_str0(NULL, "graphs", NULL, "Comma separated list of generated graphs out of rgg, grid, rmat (or grid3d, rgg3d, ba, rhg). Default: rgg,grid,rmat.");
+        struct arg_str *presets         = arg_str0(NULL, "presets", NULL, "Comma separated list of presets for the macro benchmarks. Default: fast,eco,strong,fsocial,esocial,ssocial.");
+        struct arg_lit *micro_only      = arg_lit0(NULL, "micro_only", "Only run the kernel benchmarks.");
+        struct arg_lit *macro_only      = arg_lit0(NULL, "macro_only", "Only run the preset benchmarks.");
+        struct arg_str *filename_output = arg_str0(NULL, "output_filename", NULL, "Append the results (one JSON object per line) to this file instead of printing them.");
+        struct arg_end *end             = arg_end(100);
+
+        void* argtable[] = {
+                help, scale, k, repetitions, user_seed, graphs, presets, micro_only, macro_only, filename_output, end
+        };
+
+        int nerrors = arg_parse(argn, argv, argtable);
+
+        if(help->count > 0) {
+                printf("Usage: %s", progname);
+                arg_print_syntax(stdout, argtable, "\n");
+                arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        if(nerrors > 0) {
+                arg_print_errors(stderr, end, progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        bench_config.scale           = 14;
+        bench_config.k               = 16;
+        bench_config.repetitions     = 3;
+        bench_config.seed            = 0;
+        bench_config.run_micro       = true;
+        bench_config.run_macro       = true;
+        bench_config.graphs          = split_comma_list("rgg,grid,rmat");
+        bench_config.presets         = split_comma_list("fast,eco,strong,fsocial,esocial,ssocial");
+        bench_config.filename_output = "";
+
+        if(scale->count > 0) {
+                bench_config.scale = scale->ival[0];
+        }
+
+        if(k->count > 0) {
+                bench_config.k = std::max(2, k->ival[0]);
+        }
+
+        if(repetitions->count > 0) {
+                bench_config.repetitions = std::max(1, repetitions->ival[0]);
+        }
+
+        if(user_seed->count > 0) {
+                bench_config.seed = user_seed->ival[0];
+        }
+
+        if(graphs->count > 0) {
+                bench_config.graphs = split_comma_list(graphs->sval[0]);
+        }
+
+        if(presets->count > 0) {
+                bench_config.presets = split_comma_list(presets->sval[0]);
+        }
+
+        if(micro_only->count > 0) {
+                bench_config.run_macro = false;
+        }
+
+        if(macro_only->count > 0) {
+                bench_config.run_micro = false;
+        }
+
+        if(filename_output->count > 0) {
+                bench_config.filename_output = filename_output->sval[0];
+        }
+
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return 0;
+}
+
+#endif /* end of include guard: PARSE_BENCH_PARAMETERS_4XK8ZQ1M */
@@ -41,10 +41,19 @@ int parse_parameters(int argn, char **argv,
         struct arg_lit *use_wcycles                          = arg_lit0(NULL, "use_wcycle", "Enables wcycles.");
         struct arg_lit *disable_refined_bubbling             = arg_lit0(NULL, "disable_refined_bubbling", "Disables refinement during initial partitioning using bubbling (Default: enabled).");
         struct arg_lit *enable_convergence                   = arg_lit0(NULL, "enable_convergence", "Enables convergence mode, i.e. every step is running until no change.(Default: disabled).");
-        struct arg_lit *enable_omp                           = arg_lit0(NULL, "enable_omp", "Enable parallel omp.");
+        struct arg_lit *enable_omp                           = arg_lit0(NULL, "enable_omp", "Use all OpenMP threads in the parallel parts, e.g. initial partitioning, algebraic distances and node ordering reductions. (Default: disabled)");
         struct arg_lit *wcycle_no_new_initial_partitioning   = arg_lit0(NULL, "wcycle_no_new_initial_partitioning", "Using this option, the graph is initially partitioned only the first time we are at the deepest level.");
+#if defined MODE_KAFFPA && !defined MODE_GLOBALMS
+        // kaffpa can generate the graph instead (see --generator)
+        struct arg_str *filename                             = arg_strn(NULL, NULL, "FILE", 0, 1, "Path to graph file to partition.");
+        struct arg_str *generator                            = arg_str0(NULL, "generator", NULL, "Generate the graph instead of reading FILE. One of grid2d, grid3d, rgg2d, rgg3d, rmat, ba, rhg.");
+        struct arg_int *generator_nodes                      = arg_int0(NULL, "generator_nodes", NULL, "Number of nodes of the generated graph (rounded for grids and rmat). Default: 2^16.");
+        struct arg_dbl *generator_avg_degree                 = arg_dbl0(NULL, "generator_avg_degree", NULL, "Average degree of the generated graph. Default: 8.");
+#else
         struct arg_str *filename                             = arg_strn(NULL, NULL, "FILE", 1, 1, "Path to graph file to partition.");
+#endif
         struct arg_str *filename_output                      = arg_str0(NULL, "output_filename", NULL, "Specify the name of the output file (that contains the partition).");
+        struct arg_str *trace_filename                       = arg_str0(NULL, "trace_file", NULL, "Write a trace of the multilevel phases (Chrome trace JSON) to this file.");
         struct arg_int *user_seed                            = arg_int0(NULL, "seed", NULL, "Seed to use for the PRNG.");
 #ifndef MODE_GLOBALMS
         struct arg_int *k                                    = arg_int1(NULL, "k", NULL, "Number of blocks to partition the graph.");
@@ -72,6 +81,7 @@ int parse_parameters(int argn, char **argv,
         struct arg_int *initial_partitioning_repetitions     = arg_int0(NULL, "initial_partitioning_repetitions", NULL, "Number of initial partitioning repetitons. Default: 5.");
         struct arg_int *minipreps                            = arg_int0(NULL, "minipreps", NULL, "Default: 10.");
         struct arg_int *aggressive_random_levels             = arg_int0(NULL, "aggressive_random_levels", NULL, "In case matching is randomgpa, this is the number of levels that should be matched using random matching. Default: 3.");
+        struct arg_int *gpa_local_max_rounds                 = arg_int0(NULL, "gpa_local_max_rounds", NULL, "Grow the gpa paths from locally heaviest edges in parallel rounds instead of sorting all edges. 0 disables. Default: 0.");
 
 
 #ifdef MODE_NODEORDERING
@@ -94,9 +104,12 @@ int parse_parameters(int argn, char **argv,
         struct arg_rex *refinement_scheduling_algorithm      = arg_rex0(NULL, "refinement_scheduling_algorithm", "^(fast|active_blocks|active_blocks_kway)$", "QUALITY", REG_EXTENDED, " One of {fast, active_blocks, active_blocks_kway}.");
         struct arg_dbl *bank_account_factor                  = arg_dbl0(NULL, "bank_account_factor", NULL, "The bank account factor for the scheduler. Default 1.5 (%).");
         struct arg_dbl *flow_region_factor                   = arg_dbl0(NULL, "flow_region_factor", NULL, "If using flow, then the regions found are sized flow_region_factor * imbalance. Default: 4 (%).");
+        struct arg_int *flow_piercing_steps                  = arg_int0(NULL, "flow_piercing_steps", NULL, "If the minimum cut of a flow region is not balanced, pierce up to this many nodes and augment the existing flow. Default: 0.");
         struct arg_dbl *kway_adaptive_limits_alpha           = arg_dbl0(NULL, "kway_adaptive_limits_alpha", NULL, "This is the factor alpha used for the adaptive stopping criteria. Default: 1.0");
         struct arg_rex *stop_rule                            = arg_rex0(NULL, "stop_rule", "^(simple|multiplek|strong)$", "VARIANT", REG_EXTENDED, "Stop rule to use. One of {simple, multiplek, strong}. Default: simple" );
         struct arg_int *num_vert_stop_factor                 = arg_int0(NULL, "num_vert_stop_factor", NULL, "x*k (for multiple_k stop rule). Default 20.");
+        struct arg_lit *parallel_lp_refinement               = arg_lit0(NULL, "parallel_lp_refinement", "Run the label propagation refinement (e.g. of fsocial) with all OpenMP threads.");
+        struct arg_rex *lp_refinement_balance                = arg_rex0(NULL, "lp_refinement_balance", "^(strict|relaxed)$", "VARIANT", REG_EXTENDED, "Balance of the parallel label propagation refinement. One of {strict, relaxed}. Default: strict" );
         struct arg_rex *kway_search_stop_rule                = arg_rex0(NULL, "kway_stop_rule", "^(simple|adaptive)$", "VARIANT", REG_EXTENDED, "Stop rule to use during kway_refinement. One of {simple, adaptive}. Default: simple" );
         struct arg_int *bubbling_iterations                  = arg_int0(NULL, "bubbling_iterations", NULL, "Number of bubbling iterations to perform: Default 1 .");
         struct arg_int *kway_rounds                          = arg_int0(NULL, "kway_rounds", NULL, "Number of kway refinement rounds to perform: Default 1 .");
@@ -131,6 +144,8 @@ int parse_parameters(int argn, char **argv,
         struct arg_int *unsuccessful_reps                    = arg_int0(NULL, "unsuccessful_reps", NULL, "Unsuccessful reps to fresh start.");
         struct arg_int *local_partitioning_repetitions       = arg_int0(NULL, "local_partitioning_repetitions", NULL, "Number of local repetitions.");
         struct arg_int *amg_iterations                       = arg_int0(NULL, "amg_iterations", NULL, "Number of amg iterations.");
+        struct arg_int *algdist_test_vectors                 = arg_int0(NULL, "algdist_test_vectors", NULL, "Number of test vectors of the algebraic distance edge rating. Default: 3.");
+        struct arg_int *algdist_iterations                   = arg_int0(NULL, "algdist_iterations", NULL, "Number of smoothing iterations of the algebraic distance edge rating. Default: 7.");
         struct arg_int *mh_flip_coin                         = arg_int0(NULL, "mh_flip_coin", NULL, "Control the ratio of mutation and crossovers. c/10 Mutation and (10-c)/10 crossovers.");
         struct arg_int *mh_initial_population_fraction       = arg_int0(NULL, "mh_initial_population_fraction", NULL, "Control the initial population fraction parameter (Default: 1000).");
         struct arg_lit *mh_print_log                         = arg_lit0(NULL, "mh_print_log", "Each PE prints a logfile (timestamp, edgecut).");
@@ -212,26 +227,28 @@ int parse_parameters(int argn, char **argv,
 #ifdef MODE_DEVEL
                 k, graph_weighted, imbalance, edge_rating_tiebreaking, 
                 matching_type, edge_rating, rate_first_level_inner_outer, first_level_random_matching, 
-                aggressive_random_levels, gpa_grow_internal, match_islands, stop_rule, num_vert_stop_factor,
+                aggressive_random_levels, gpa_local_max_rounds, gpa_grow_internal, match_islands, stop_rule, num_vert_stop_factor,
                 initial_partition, initial_partitioning_repetitions, disable_refined_bubbling, 
                 bubbling_iterations, initial_partition_optimize, bipartition_post_fm_limit, bipartition_post_ml_limit, bipartition_tries,
                 bipartition_algorithm,
                 permutation_quality, permutation_during_refinement, enforce_balance,
                 refinement_scheduling_algorithm, bank_account_factor, refinement_type, 
-                fm_search_limit, flow_region_factor, most_balanced_flows,toposort_iterations, 
+                fm_search_limit, flow_region_factor, flow_piercing_steps, most_balanced_flows,toposort_iterations, 
                 kway_rounds, kway_search_stop_rule, kway_fm_limits, kway_adaptive_limits_alpha, 
+                parallel_lp_refinement, lp_refinement_balance,
                 enable_corner_refinement, disable_qgraph_refinement,local_multitry_fm_alpha, local_multitry_rounds,
                 global_cycle_iterations, use_wcycles, wcycle_no_new_initial_partitioning, use_fullmultigrid, use_vcycle,level_split, 
                 enable_convergence, compute_vertex_separator, 
                 input_partition, preconfiguration, only_first_level, disable_max_vertex_weight_constraint, 
                 recursive_bipartitioning, use_bucket_queues, time_limit, unsuccessful_reps, local_partitioning_repetitions, 
+                trace_filename,
                 mh_pool_size, mh_plain_repetitions, mh_disable_nc_combine, mh_disable_cross_combine, mh_enable_tournament_selection,       
                 mh_disable_combine, mh_enable_quickstart, mh_disable_diversify_islands, mh_flip_coin, mh_initial_population_fraction, 
 		mh_print_log,mh_sequential_mode, mh_optimize_communication_volume, mh_enable_tabu_search,
                 mh_disable_diversify, mh_diversify_best, mh_cross_combine_original_k, disable_balance_singletons, initial_partition_optimize_fm_limits,
                 initial_partition_optimize_multitry_fm_alpha, initial_partition_optimize_multitry_rounds,
                 enable_omp, 
-                amg_iterations,
+                amg_iterations, algdist_test_vectors, algdist_iterations,
                 kaba_neg_cycle_algorithm, kabaE_internal_bal, kaba_internal_no_aug_steps_aug, 
                 kaba_packing_iterations, kaba_flip_packings, kaba_lsearch_p, kaffpa_perfectly_balanced_refinement, 
                 kaba_unsucc_iterations, kaba_disable_zero_weight_cycles,
@@ -253,7 +270,15 @@ int parse_parameters(int argn, char **argv,
                 distance_parameter_string,
                 online_distances,
                 filename_output, 
+                trace_filename,
+                gpa_local_max_rounds,
+                parallel_lp_refinement, lp_refinement_balance,
+                enable_omp,
+                #ifndef MODE_GLOBALMS
+                generator, generator_nodes, generator_avg_degree,
+                #endif
 #elif defined MODE_EVALUATOR
+                use_mmap_io,
                 k,   
                 preconfiguration, 
                 input_partition,
@@ -300,6 +325,7 @@ int parse_parameters(int argn, char **argv,
                 #endif
                 //filename_output, 
                 reduction_order,
+                enable_omp,
         #endif
                 //convergence_factor,
                 //max_simplicial_degree,
@@ -322,6 +348,7 @@ int parse_parameters(int argn, char **argv,
 		balance_edges,
                 input_partition,
                 filename_output, 
+                trace_filename,
 #elif defined MODE_LABELPROPAGATION
                 cluster_upperbound,
                 label_propagation_iterations,
@@ -481,6 +508,33 @@ int parse_parameters(int argn, char **argv,
                 partition_config.filename_output = filename_output->sval[0];
         }
 
+        if(trace_filename->count > 0) {
+                partition_config.trace_filename = trace_filename->sval[0];
+        }
+
+#if defined MODE_KAFFPA && !defined MODE_GLOBALMS
+        // only kaffpa builds the graph with graph_generator, the other programs do not
+        // list the generator options and reject them as invalid options
+        if(generator->count > 0) {
+                partition_config.generator = generator->sval[0];
+        }
+
+        if(generator_nodes->count > 0) {
+                partition_config.generator_nodes = std::max(1, generator_nodes->ival[0]);
+        }
+
+        if(generator_avg_degree->count > 0) {
+                partition_config.generator_avg_degree = generator_avg_degree->dval[0];
+        }
+
+        if(graph_filename.empty() && partition_config.generator.empty()) {
+                fprintf(stderr, "%s: missing FILE (or --generator)\n", progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+#endif
+
         if(initial_partition_optimize->count > 0) {
                 partition_config.initial_partition_optimize = true;
         }
@@ -521,6 +575,14 @@ int parse_parameters(int argn, char **argv,
                 partition_config.amg_iterations = amg_iterations->ival[0];
         }
 
+        if(algdist_test_vectors->count > 0) {
+                partition_config.algdist_test_vectors = std::max(1, algdist_test_vectors->ival[0]);
+        }
+
+        if(algdist_iterations->count > 0) {
+                partition_config.algdist_iterations = std::max(1, algdist_iterations->ival[0]);
+        }
+
         if(max_initial_ns_tries->count > 0) {
                 partition_config.max_initial_ns_tries = max_initial_ns_tries->ival[0];
         }
@@ -863,6 +925,10 @@ int parse_parameters(int argn, char **argv,
                 partition_config.aggressive_random_levels = aggressive_random_levels->ival[0];
         }
 
+        if(gpa_local_max_rounds->count > 0) {
+                partition_config.gpa_local_max_rounds = std::max(0, gpa_local_max_rounds->ival[0]);
+        }
+
         if(rate_first_level_inner_outer->count > 0) {
                 partition_config.rate_first_level_inner_outer = true;
         }
@@ -883,6 +949,10 @@ int parse_parameters(int argn, char **argv,
                 partition_config.flow_region_factor = flow_region_factor->dval[0];
         }
 
+        if (flow_piercing_steps->count > 0) {
+                partition_config.flow_piercing_steps = flow_piercing_steps->ival[0];
+        }
+
         if (kway_adaptive_limits_alpha->count > 0) {
                 partition_config.kway_adaptive_limits_alpha = kway_adaptive_limits_alpha->dval[0];
         }
@@ -1048,6 +1118,21 @@ int parse_parameters(int argn, char **argv,
                 }
         }
 
+        if(parallel_lp_refinement->count > 0) {
+                partition_config.parallel_label_propagation_refinement = true;
+        }
+
+        if (lp_refinement_balance->count > 0) {
+                if(strcmp("strict", lp_refinement_balance->sval[0]) == 0) {
+                        partition_config.label_propagation_refinement_balance = LP_BALANCE_STRICT;
+                } else if (strcmp("relaxed", lp_refinement_balance->sval[0]) == 0) {
+                        partition_config.label_propagation_refinement_balance = LP_BALANCE_RELAXED;
+                } else {
+                        fprintf(stderr, "Invalid label propagation balance: \"%s\"\n", lp_refinement_balance->sval[0]);
+                        exit(0);
+                }
+        }
+
         if (permutation_quality->count > 0) {
                 if(strcmp("none", permutation_quality->sval[0]) == 0) {
                         partition_config.permutation_quality = PERMUTATION_QUALITY_NONE;
@@ -15,6 +15,9 @@
 
 struct SpacConfig {
     EdgeWeight infinity;
+    bool streaming;
+    double hdrf_lambda;
+    unsigned streaming_local_search_rounds;
 };
 
 int parse_spac_parameters(int argn, char **argv, PartitionConfig &partition_config, SpacConfig &spac_config,
@@ -30,10 +33,14 @@ int parse_spac_parameters(int argn, char **argv, PartitionConfig &partition_conf
     struct arg_rex *preconfiguration = arg_rex1(NULL, "preconfiguration", "^(strong$|eco$|fast$|fastsocial|ecosocial|strongsocial)$", "VARIANT", REG_EXTENDED, "Use a preconfiguration. (Default: eco) [strong|eco|fast|fastsocial|ecosocial|strongsocial]." );
     struct arg_int *infinity = arg_int0(NULL, "infinity", NULL, "Infinity edge weight. Default: 1000");
     struct arg_int *imbalance = arg_int0(NULL, "imbalance", NULL, "Desired imbalance. Default: 3%");
+    struct arg_lit *streaming = arg_lit0(NULL, "streaming", "Assign the edges in a single HDRF pass followed by a greedy local search on the vertex cut instead of partitioning the split graph. Needs much less memory, but the result is not refined with the SPAC model. Default: disabled");
+    struct arg_dbl *hdrf_lambda = arg_dbl0(NULL, "hdrf_lambda", NULL, "Weight of the balance term in the HDRF score (only with --streaming). Default: 1.0");
+    struct arg_int *streaming_local_search_rounds = arg_int0(NULL, "streaming_local_search_rounds", NULL, "Number of local search passes over the edges (only with --streaming). Default: 5");
     struct arg_end *end = arg_end(100);
 
     void *argtable[] = {
-            help, filename, k, seed, preconfiguration, infinity, filename_output, imbalance, end
+            help, filename, k, seed, preconfiguration, infinity, filename_output, imbalance,
+            streaming, hdrf_lambda, streaming_local_search_rounds, end
     };
 
     // Parse arguments.
@@ -95,6 +102,20 @@ int parse_spac_parameters(int argn, char **argv, PartitionConfig &partition_conf
         spac_config.infinity = 1000;
     }
 
+    spac_config.streaming = streaming->count > 0;
+
+    if (hdrf_lambda->count > 0) {
+        spac_config.hdrf_lambda = hdrf_lambda->dval[0];
+    } else {
+        spac_config.hdrf_lambda = 1.0;
+    }
+
+    if (streaming_local_search_rounds->count > 0) {
+        spac_config.streaming_local_search_rounds = streaming_local_search_rounds->ival[0];
+    } else {
+        spac_config.streaming_local_search_rounds = 5;
+    }
+
     if(filename_output->count > 0) {
             partition_config.filename_output = filename_output->sval[0];
     }
@@ -22,6 +22,7 @@
 #include "tools/timer.h"
 #include "io/graph_io.h"
 #include "spac/spac.h"
+#include "spac/streaming_edge_partitioner.h"
 #include "tools/quality_metrics.h"
 
 static void execute_kahip(graph_access &G, PartitionConfig &config);
@@ -52,25 +53,45 @@ int main(int argn, char **argv) {
               << "n(input): " << input_graph.number_of_nodes() << "\n"
               << "m(input): " << input_graph.number_of_edges() << std::endl;
 
-    // construct split graph
-    t.restart();
-    spac splitter(input_graph, spac_config.infinity);
-    graph_access &split_graph = splitter.construct_split_graph();
-    std::cout << "split graph construction took " << t.elapsed() << "\n"
-              << "n(split): " << split_graph.number_of_nodes() << "\n"
-              << "m(split): " << split_graph.number_of_edges() << std::endl;
-
-    // partition split graph
-    t.restart();
-    execute_kahip(split_graph, partition_config);
-    std::cout << "kahip took " << t.elapsed() << "\n"
-              << "edge cut: " << quality_metrics().edge_cut(split_graph) << std::endl;
-
-    // evaluate edge partition
-    t.restart();
-    splitter.fix_cut_dominant_edges();
-    std::vector<PartitionID> edge_partition = splitter.project_partition();
-    unsigned vertex_cut = splitter.calculate_vertex_cut(edge_partition);
+    std::vector<PartitionID> edge_partition;
+    unsigned vertex_cut = 0;
+    if (spac_config.streaming) {
+        // assign the edges directly, the split graph is never built
+        t.restart();
+        std::vector<EdgeID> reverse_edge;
+        spac::compute_reverse_edges(input_graph, reverse_edge);
+        streaming_edge_partitioner partitioner(input_graph, partition_config.k, partition_config.imbalance / 100.0,
+                                               spac_config.hdrf_lambda);
+        edge_partition = partitioner.perform_partitioning(reverse_edge);
+        std::cout << "streaming took " << t.elapsed() << "\n"
+                  << "vertex cut (streaming): " << partitioner.calculate_vertex_cut() << std::endl;
+
+        t.restart();
+        partitioner.perform_local_search(edge_partition, reverse_edge, spac_config.streaming_local_search_rounds);
+        std::cout << "local search took " << t.elapsed() << std::endl;
+
+        vertex_cut = partitioner.calculate_vertex_cut();
+    } else {
+        // construct split graph
+        t.restart();
+        spac splitter(input_graph, spac_config.infinity);
+        graph_access &split_graph = splitter.construct_split_graph();
+        std::cout << "split graph construction took " << t.elapsed() << "\n"
+                  << "n(split): " << split_graph.number_of_nodes() << "\n"
+                  << "m(split): " << split_graph.number_of_edges() << std::endl;
+
+        // partition split graph
+        t.restart();
+        execute_kahip(split_graph, partition_config);
+        std::cout << "kahip took " << t.elapsed() << "\n"
+                  << "edge cut: " << quality_metrics().edge_cut(split_graph) << std::endl;
+
+        // evaluate edge partition
+        t.restart();
+        splitter.fix_cut_dominant_edges();
+        edge_partition = splitter.project_partition();
+        vertex_cut = splitter.calculate_vertex_cut(edge_partition);
+    }
     std::cout << "vertex cut: " << vertex_cut << std::endl;
 
     quality_metrics qm;
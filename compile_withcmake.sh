@@ -49,6 +49,10 @@ fi
 
 cp ./build/libinterface_static.a deploy/libkahip.a
 cp ./build/libinterface.so deploy/libkahip.so
+if [[ -f "./build/libinterface64.so" ]]; then 
+        cp ./build/libinterface64.so deploy/libkahip64.so
+        cp ./interface/kaHIP_interface_64.h deploy/
+fi
 cp ./build/parallel/parallel_src/dsp* ./deploy/distributed_edge_partitioning
 cp ./build/parallel/parallel_src/g* ./deploy
 cp ./build/parallel/parallel_src/parhip* ./deploy/parhip
@@ -63,7 +67,7 @@ cp ./build/parallel/modified_kahip/lib*.a deploy/parallel/libkahip.a
 # maybe adapt paths here and python version here
 if [ "$1" == "BUILDPYTHONMODULE" ]; then
 cd misc/pymodule/
-g++ -O3 -Wall -shared -std=c++11 -fPIC `python3.5 -m pybind11 --includes` kahip.cpp -L../../deploy/ -lkahip -o kahip`python3.5-config --extension-suffix` -Ipybind11/include -I/usr/include/python3.5m/
+g++ -O3 -Wall -shared -std=c++11 -fPIC `python3.5 -m pybind11 --includes` kahip.cpp -L../../deploy/ -lkahip -lkahip64 -o kahip`python3.5-config --extension-suffix` -Ipybind11/include -I/usr/include/python3.5m/
 cd ..; cd ..;
 cp misc/pymodule/call* deploy/
 cp misc/pymodule/kahip.cp* deploy/
@@ -5,7 +5,11 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <omp.h>
 #include <sstream>
 
 #ifdef USEMETIS
@@ -34,6 +38,42 @@
 
 using namespace std;
 
+// std::cout is shared by all threads, so concurrent calls must not swap its buffer
+// on their own (a call would restore the buffer that another call just replaced).
+// The first suppressing call detaches the buffer and the last one puts it back,
+// while any call suppresses its output the output of all calls is suppressed.
+class output_suppression {
+        public:
+                output_suppression(bool suppress) : m_suppress(suppress) {
+                        if(!m_suppress) return;
+
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if( m_suppressing_calls++ == 0 ) {
+                                m_backup = std::cout.rdbuf(nullptr);
+                        }
+                }
+
+                ~output_suppression() {
+                        if(!m_suppress) return;
+
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        if( --m_suppressing_calls == 0 ) {
+                                std::cout.rdbuf(m_backup);
+                        }
+                }
+
+        private:
+                bool m_suppress;
+
+                static std::mutex m_mutex;
+                static int m_suppressing_calls;
+                static std::streambuf* m_backup;
+};
+
+std::mutex output_suppression::m_mutex;
+int output_suppression::m_suppressing_calls = 0;
+std::streambuf* output_suppression::m_backup = nullptr;
+
 void internal_build_graph( PartitionConfig & partition_config, 
                            int* n, 
                            int* vwgt, 
@@ -73,7 +113,8 @@ void internal_kaffpa_call(PartitionConfig & partition_config,
                           int* nparts, 
                           double* imbalance, 
                           int* edgecut, 
-                          int* part) {
+                          int* part,
+                          refinement_workspace * workspace = NULL) {
 
         //streambuf* backup = cout.rdbuf();
         //ofstream ofs;
@@ -86,7 +127,7 @@ void internal_kaffpa_call(PartitionConfig & partition_config,
         graph_access G;     
         internal_build_graph( partition_config, n, vwgt, xadj, adjcwgt, adjncy, G);
 
-        graph_partitioner partitioner;
+        graph_partitioner partitioner(workspace);
         partitioner.perform_partitioning(partition_config, G);
 
         forall_nodes(G, node) {
@@ -100,22 +141,8 @@ void internal_kaffpa_call(PartitionConfig & partition_config,
         //cout.rdbuf(backup);
 }
 
-void kaffpa(int* n, 
-                   int* vwgt, 
-                   int* xadj, 
-                   int* adjcwgt, 
-                   int* adjncy, 
-                   int* nparts, 
-                   double* imbalance, 
-                   bool suppress_output, 
-                   int seed,
-                   int mode,
-                   int* edgecut, 
-                   int* part) {
+void internal_kaffpa_configuration(int mode, PartitionConfig & partition_config) {
         configuration cfg;
-        PartitionConfig partition_config;
-        partition_config.k = *nparts;
-
         switch( mode ) {
                 case FAST: 
                         cfg.fast(partition_config);
@@ -139,11 +166,75 @@ void kaffpa(int* n,
                         cfg.eco(partition_config);
                         break;
         }
+}
+
+void kaffpa(int* n, 
+                   int* vwgt, 
+                   int* xadj, 
+                   int* adjcwgt, 
+                   int* adjncy, 
+                   int* nparts, 
+                   double* imbalance, 
+                   bool suppress_output, 
+                   int seed,
+                   int mode,
+                   int* edgecut, 
+                   int* part) {
+        PartitionConfig partition_config;
+        partition_config.k = *nparts;
+        internal_kaffpa_configuration(mode, partition_config);
 
         partition_config.seed = seed;
         internal_kaffpa_call(partition_config, suppress_output, n, vwgt, xadj, adjcwgt, adjncy, nparts, imbalance, edgecut, part);
 }
 
+void kaffpa_batch(int num_graphs, 
+                  int* n, 
+                  int** vwgt, 
+                  int** xadj, 
+                  int** adjcwgt, 
+                  int** adjncy, 
+                  int* nparts, 
+                  double* imbalance, 
+                  bool suppress_output, 
+                  int seed,
+                  int mode,
+                  int num_threads,
+                  int* edgecut, 
+                  int** part) {
+        if( num_graphs <= 0 ) return;
+        output_suppression suppression(suppress_output);
+
+        // the configuration only depends on the number of blocks, it is set up once per k
+        std::map< int, PartitionConfig > configurations;
+        for( int i = 0; i < num_graphs; i++) {
+                if( configurations.find(nparts[i]) != configurations.end() ) continue;
+
+                PartitionConfig & partition_config = configurations[nparts[i]];
+                partition_config.k = nparts[i];
+                internal_kaffpa_configuration(mode, partition_config);
+                partition_config.seed = seed;
+        }
+
+        if( num_threads <= 0 ) num_threads = omp_get_max_threads();
+        num_threads = std::max(1, std::min(num_threads, num_graphs));
+
+        #pragma omp parallel num_threads(num_threads)
+        {
+                // scratch memory of the local searches, grows to the largest graph of the thread
+                refinement_workspace workspace;
+
+                #pragma omp for schedule(dynamic, 1)
+                for( int i = 0; i < num_graphs; i++) {
+                        PartitionConfig partition_config = configurations.find(nparts[i])->second;
+                        internal_kaffpa_call(partition_config, suppress_output, &n[i], 
+                                             vwgt == NULL ? NULL : vwgt[i], xadj[i], 
+                                             adjcwgt == NULL ? NULL : adjcwgt[i], adjncy[i], 
+                                             &nparts[i], &imbalance[i], &edgecut[i], part[i], &workspace);
+                }
+        }
+}
+
 void kaffpa_balance_NE(int* n, 
                    int* vwgt, 
                    int* xadj, 
@@ -203,12 +294,7 @@ void internal_nodeseparator_call(PartitionConfig & partition_config,
                           int** separator) {
 
         //first perform std partitioning using KaFFPa
-        streambuf* backup = cout.rdbuf();
-        ofstream ofs;
-        ofs.open("/dev/null");
-        if(suppress_output) {
-               cout.rdbuf(ofs.rdbuf()); 
-        }
+        output_suppression suppression(suppress_output);
 
         partition_config.k         = *nparts;
         partition_config.imbalance = 100*(*imbalance);
@@ -285,9 +371,6 @@ void internal_nodeseparator_call(PartitionConfig & partition_config,
                         }
                 } endfor
         }
-
-        ofs.close();
-        cout.rdbuf(backup);
 }
 
 
@@ -342,10 +425,7 @@ void reduced_nd(int* n,
                 int seed,
                 int mode,
                 int* ordering) {
-        std::streambuf* backup = std::cout.rdbuf();
-        if(suppress_output) {
-                std::cout.rdbuf(nullptr);
-        }
+        output_suppression suppression(suppress_output);
 
         configuration cfg;
         PartitionConfig partition_config;
@@ -400,9 +480,6 @@ void reduced_nd(int* n,
         for (int i = 0; i < *n; ++i) {
                 ordering[i] = dissection.ordering()[i];
         }
-
-        // Restore cout output stream
-        std::cout.rdbuf(backup);
 }
 
 #ifdef USEMETIS
@@ -412,10 +489,7 @@ void reduced_nd_fast(int* n,
                       bool suppress_output,
                       int seed,
                       int* ordering) {
-        std::streambuf* backup = std::cout.rdbuf();
-        if(suppress_output) {
-                std::cout.rdbuf(nullptr);
-        }
+        output_suppression suppression(suppress_output);
 
         configuration cfg;
         PartitionConfig partition_config;
@@ -486,9 +560,6 @@ void reduced_nd_fast(int* n,
                 ordering[i] = final_labels[i];
         }
 
-        // Restore cout output stream
-        std::cout.rdbuf(backup);
-
         // Delete temporary graph
         delete[] m_xadj;
         delete[] m_adjncy;
@@ -27,11 +27,24 @@ const int MAPMODE_BISECTION = 1;
 // same data structures as in metis 
 // edgecut and part are output parameters
 // part has to be an array of n ints
+// the calls can be made concurrently from different threads, the result of a call
+// only depends on its input and seed
 void kaffpa(int* n, int* vwgt, int* xadj, 
                    int* adjcwgt, int* adjncy, int* nparts, 
                    double* imbalance,  bool suppress_output, int seed, int mode, 
                    int* edgecut, int* part);
 
+// partitions num_graphs graphs, graph i is given by n[i], vwgt[i], xadj[i], adjcwgt[i] 
+// and adjncy[i] (vwgt and adjcwgt or their entries can be NULL) and is partitioned into
+// nparts[i] blocks with imbalance imbalance[i]. edgecut[i] and part[i] are the outputs,
+// part[i] has to be an array of n[i] ints. the graphs are distributed over num_threads
+// threads (0 uses the OpenMP default) that keep their scratch memory from graph to graph.
+// graph i is partitioned as by a kaffpa call with the same arguments
+void kaffpa_batch(int num_graphs, int* n, int** vwgt, int** xadj, 
+                  int** adjcwgt, int** adjncy, int* nparts, 
+                  double* imbalance, bool suppress_output, int seed, int mode,
+                  int num_threads, int* edgecut, int** part);
+
 // balance constraint on nodes and edges
 void kaffpa_balance_NE(int* n, int* vwgt, int* xadj, 
                 int* adjcwgt, int* adjncy, int* nparts, 
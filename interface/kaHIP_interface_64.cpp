@@ -0,0 +1,159 @@
+/******************************************************************************
+ * kaHIP_interface_64.cpp
+ *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ *
+ * Compiled together with a copy of the library built with MODE64BITEDGES
+ * and MODE64BITWEIGHTS, see libinterface64 in CMakeLists.txt.
+ *****************************************************************************/
+
+#include <iostream>
+#include <limits>
+
+#include "kaHIP_interface_64.h"
+#include "../lib/data_structure/graph_access.h"
+#include "../lib/tools/quality_metrics.h"
+#include "../lib/tools/random_functions.h"
+#include "../lib/partition/partition_config.h"
+#include "../lib/partition/graph_partitioner.h"
+#include "../app/configuration.h"
+#include "../app/balance_configuration.h"
+
+#if !defined(MODE64BITEDGES) || !defined(MODE64BITWEIGHTS)
+#error "the 64 bit interface has to be compiled with MODE64BITEDGES and MODE64BITWEIGHTS"
+#endif
+
+using namespace std;
+
+bool internal_build_graph_64( PartitionConfig & partition_config,
+                              int64_t* n,
+                              int64_t* vwgt,
+                              int64_t* xadj,
+                              int64_t* adjcwgt,
+                              int64_t* adjncy,
+                              graph_access & G) {
+        // node ids stay 32 bit, the largest value is reserved
+        if( *n < 0 || *n >= (int64_t)std::numeric_limits<NodeID>::max() ) {
+                std::cerr <<  "kaffpa_64: the number of nodes has to be in [0, 2^32-1)"  << std::endl;
+                return false;
+        }
+
+        NodeID nodes = *n;
+        G.start_construction(nodes, xadj[nodes]);
+
+        for( NodeID i = 0; i < nodes; i++) {
+                NodeID node = G.new_node();
+                G.setNodeWeight(node, vwgt == NULL ? 1 : vwgt[i]);
+                G.setPartitionIndex(node, 0);
+
+                for( int64_t e = xadj[i]; e < xadj[i+1]; e++) {
+                        EdgeID e_bar = G.new_edge(node, adjncy[e]);
+                        G.setEdgeWeight(e_bar, adjcwgt == NULL ? 1 : adjcwgt[e]);
+                }
+        }
+
+        G.finish_construction();
+        G.set_partition_count(partition_config.k);
+
+        random_functions::setSeed(partition_config.seed);
+
+        balance_configuration bc;
+        bc.configurate_balance( partition_config, G);
+        return true;
+}
+
+void internal_kaffpa_call_64(PartitionConfig & partition_config,
+                             int64_t* n,
+                             int64_t* vwgt,
+                             int64_t* xadj,
+                             int64_t* adjcwgt,
+                             int64_t* adjncy,
+                             double* imbalance,
+                             int64_t* edgecut,
+                             int* part) {
+
+        partition_config.imbalance = 100*(*imbalance);
+        graph_access G;
+        if( !internal_build_graph_64( partition_config, n, vwgt, xadj, adjcwgt, adjncy, G) ) {
+                *edgecut = -1;
+                return;
+        }
+
+        graph_partitioner partitioner;
+        partitioner.perform_partitioning(partition_config, G);
+
+        forall_nodes(G, node) {
+                part[node] = G.getPartitionIndex(node);
+        } endfor
+
+        quality_metrics qm;
+        *edgecut = qm.edge_cut(G);
+}
+
+void internal_kaffpa_configuration_64(int mode, PartitionConfig & partition_config) {
+        configuration cfg;
+        switch( mode ) {
+                case FAST:
+                        cfg.fast(partition_config);
+                        break;
+                case ECO:
+                        cfg.eco(partition_config);
+                        break;
+                case STRONG:
+                        cfg.strong(partition_config);
+                        break;
+                case FASTSOCIAL:
+                        cfg.fastsocial(partition_config);
+                        break;
+                case ECOSOCIAL:
+                        cfg.ecosocial(partition_config);
+                        break;
+                case STRONGSOCIAL:
+                        cfg.strongsocial(partition_config);
+                        break;
+                default:
+                        cfg.eco(partition_config);
+                        break;
+        }
+}
+
+void kaffpa_64(int64_t* n,
+               int64_t* vwgt,
+               int64_t* xadj,
+               int64_t* adjcwgt,
+               int64_t* adjncy,
+               int* nparts,
+               double* imbalance,
+               bool suppress_output,
+               int seed,
+               int mode,
+               int64_t* edgecut,
+               int* part) {
+        PartitionConfig partition_config;
+        partition_config.k = *nparts;
+        internal_kaffpa_configuration_64(mode, partition_config);
+
+        partition_config.seed = seed;
+        internal_kaffpa_call_64(partition_config, n, vwgt, xadj, adjcwgt, adjncy, imbalance, edgecut, part);
+}
+
+void kaffpa_balance_NE_64(int64_t* n,
+                          int64_t* vwgt,
+                          int64_t* xadj,
+                          int64_t* adjcwgt,
+                          int64_t* adjncy,
+                          int* nparts,
+                          double* imbalance,
+                          bool suppress_output,
+                          int seed,
+                          int mode,
+                          int64_t* edgecut,
+                          int* part) {
+        PartitionConfig partition_config;
+        partition_config.k = *nparts;
+        internal_kaffpa_configuration_64(mode, partition_config);
+
+        partition_config.seed = seed;
+        partition_config.balance_edges = true;
+        internal_kaffpa_call_64(partition_config, n, vwgt, xadj, adjcwgt, adjncy, imbalance, edgecut, part);
+}
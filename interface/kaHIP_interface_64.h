@@ -0,0 +1,49 @@
+/******************************************************************************
+ * kaHIP_interface_64.h
+ *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ *****************************************************************************/
+
+
+#ifndef KAFFPA_INTERFACE_64_T4NQ8XWB
+#define KAFFPA_INTERFACE_64_T4NQ8XWB
+
+#include <stdint.h>
+
+#include "kaHIP_interface.h"
+
+#ifdef __cplusplus
+
+extern "C"
+{
+#endif
+
+#if defined(_WIN32)
+        #define KAHIP_EXPORT_64
+#else
+        #define KAHIP_EXPORT_64 __attribute__((visibility("default")))
+#endif
+
+// 64 bit variant of the interface provided by libinterface64 (libkahip64).
+// same data structures as in metis with 64 bit idx_t, the library uses 64 bit
+// edge ids and weights internally. the number of nodes has to be smaller than 2^32-1.
+// only the functions below are exported, so the library can be linked together
+// with the 32 bit library and the fast 32 bit path stays available for small graphs.
+// edgecut and part are output parameters, part has to be an array of n ints.
+// edgecut is -1 if the graph could not be handled
+KAHIP_EXPORT_64 void kaffpa_64(int64_t* n, int64_t* vwgt, int64_t* xadj,
+                               int64_t* adjcwgt, int64_t* adjncy, int* nparts,
+                               double* imbalance,  bool suppress_output, int seed, int mode,
+                               int64_t* edgecut, int* part);
+
+// balance constraint on nodes and edges
+KAHIP_EXPORT_64 void kaffpa_balance_NE_64(int64_t* n, int64_t* vwgt, int64_t* xadj,
+                                          int64_t* adjcwgt, int64_t* adjncy, int* nparts,
+                                          double* imbalance,  bool suppress_output, int seed, int mode,
+                                          int64_t* edgecut, int* part);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of include guard: KAFFPA_INTERFACE_64_T4NQ8XWB */
@@ -6,13 +6,14 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <deque>
 
 #include "algorithms/strongly_connected_components.h"
 #include "cycle_search.h"
 #include "random_functions.h"
 #include "timer.h"
 
-double cycle_search::total_time = 0;
+thread_local double cycle_search::total_time = 0;
 
 cycle_search::cycle_search() {
 
@@ -24,9 +25,9 @@ cycle_search::~cycle_search() {
 
 void cycle_search::find_random_cycle(graph_access & G, std::vector<NodeID> & cycle) {
 	//first perform a bfs starting from a random node and build the parent array
-        std::deque<NodeID>* bfsqueue = new std::deque<NodeID>;
+        std::deque<NodeID> bfsqueue;
 	NodeID v = random_functions::nextInt(0, G.number_of_nodes()-1);
-	bfsqueue->push_back(v); 
+	bfsqueue.push_back(v); 
 
 	std::vector<bool>   touched(G.number_of_nodes(),false);
 	std::vector<bool>   is_leaf(G.number_of_nodes(),false);
@@ -35,9 +36,9 @@ void cycle_search::find_random_cycle(graph_access & G, std::vector<NodeID> & cyc
 	touched[v] = true;
 	parent[v]  = v;
 
-	while(!bfsqueue->empty()) {
-		NodeID source = bfsqueue->front();
-		bfsqueue->pop_front();
+	while(!bfsqueue.empty()) {
+		NodeID source = bfsqueue.front();
+		bfsqueue.pop_front();
 
 		bool is_leaf = true;
 		forall_out_edges(G, e, source) {
@@ -46,7 +47,7 @@ void cycle_search::find_random_cycle(graph_access & G, std::vector<NodeID> & cyc
 				is_leaf         = false;
 				touched[target] = true; 
 				parent[target]  = source;
-				bfsqueue->push_back(target);
+				bfsqueue.push_back(target);
 			}
 		} endfor
 
@@ -24,7 +24,7 @@ public:
 
         bool find_shortest_path(graph_access & G, NodeID & start, NodeID & dest, std::vector<NodeID> & cycle); 
 
-        static double total_time;
+        static thread_local double total_time;
 private:
 
         bool negative_cycle_detection(graph_access & G, 
@@ -7,7 +7,7 @@
 
 #include "push_relabel.h"
 
-push_relabel::push_relabel( ) {
+push_relabel::push_relabel( bool highest_label ) : m_highest_label(highest_label) {
                 
 }
 
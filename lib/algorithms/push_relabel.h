@@ -9,6 +9,8 @@
 #define MAX_FLOW_MIN_CUT_Q5EJKHNS
 
 #include <iostream>
+#include <queue>
+#include <vector>
 #include "definitions.h"
 #include "data_structure/graph_access.h"
 #include "data_structure/flow_graph.h"
@@ -18,17 +20,53 @@ const int    WORK_OP_RELABEL    = 9;
 const double GLOBAL_UPDATE_FRQ  = 0.51;
 const int    WORK_NODE_TO_EDGES = 4;
 
+// push relabel algorithm with highest label or FIFO selection of active nodes
+// highest label: active nodes are kept in buckets indexed by their distance label. nodes with a label 
+// smaller than n are discharged first, afterwards the remaining excess is returned to the source.
+// FIFO selection performs better on the split node networks used to compute vertex separators.
+// all nodes with a label smaller than n are also kept in doubly linked lists per label so that the 
+// gap heuristic only touches the nodes that are actually lifted.
+// the internal arrays are reused if the same object solves several flow problems.
 class push_relabel {
 public:
-        push_relabel( );
+        push_relabel( bool highest_label = true );
         virtual ~push_relabel();
 
         void init( flow_graph & G, NodeID source, NodeID sink ) {
-                m_excess.resize(G.number_of_nodes(),0);
-                m_distance.resize(G.number_of_nodes(),0);
-                m_active.resize(G.number_of_nodes(), false);
-                m_count.resize(2*G.number_of_nodes(),0);
-                m_bfstouched.resize(G.number_of_nodes());
+                m_excess.assign(G.number_of_nodes(),0);
+                init_labels(G, source, sink);
+
+                forall_out_edges(G, e, source) {
+                        m_excess[source] += G.getEdgeCapacity(source, e);
+                        push(source, e);
+                } endfor
+        
+        }
+
+        // resets labels, buckets and level lists, the excess values are not touched
+        void init_labels( flow_graph & G, NodeID source, NodeID sink ) {
+                NodeID n          = G.number_of_nodes();
+                NodeID max_labels = 2*n+2;
+
+                m_distance.assign(n,0);
+                m_active.assign(n, false);
+                m_count.assign(max_labels,0);
+                m_bfstouched.assign(n, false);
+                m_current_edge.resize(n);
+                m_bucket_head.assign(max_labels, UNDEFINED_NODE);
+                m_bucket_next.assign(n, UNDEFINED_NODE);
+                while( !m_Q.empty() ) m_Q.pop();
+                m_level_head.assign(n, UNDEFINED_NODE);
+                m_level_next.assign(n, UNDEFINED_NODE);
+                m_level_prev.assign(n, UNDEFINED_NODE);
+
+                forall_nodes(G, node) {
+                        m_current_edge[node] = G.get_first_edge(node);
+                } endfor
+
+                m_max_active_low  = 0;
+                m_max_active_high = n;
+                m_max_level       = 0;
 
                 m_count[0] = G.number_of_nodes()-1;
                 m_count[G.number_of_nodes()] = 1;
@@ -36,32 +74,46 @@ public:
                 m_distance[source] = G.number_of_nodes();
                 m_active[source]   = true;
                 m_active[sink]     = true;
-
-                forall_out_edges(G, e, source) {
-                        m_excess[source] += G.getEdgeCapacity(source, e);
-                        push(source, e);
-                } endfor
-        
         }
 
         // perform a backward bfs in the residual starting at the sink
-        // to update distance labels
+        // to update distance labels, afterwards the buckets and level lists are rebuilt
         void global_relabeling( NodeID source, NodeID sink ) {
-                std::queue< NodeID > Q; 
+                NodeID n = m_G->number_of_nodes();
                 forall_nodes((*m_G), node) {
-                        m_distance[node]   = std::max(m_distance[node], m_G->number_of_nodes());
+                        m_distance[node]   = std::max(m_distance[node], n);
                         m_bfstouched[node] = false;
                 } endfor
                 
-                Q.push(sink);
+                m_bfsqueue.clear();
+                m_bfsqueue.push_back(sink);
                 m_bfstouched[sink]   = true;
                 m_bfstouched[source] = true;
                 m_distance[sink]     = 0;
 
-                NodeID node = 0;
-                while( !Q.empty() ) {
-                       node = Q.front();
-                       Q.pop();  
+                for( unsigned int head = 0; head < m_bfsqueue.size(); head++) {
+                       NodeID node = m_bfsqueue[head];
+
+                       forall_out_edges((*m_G), e, node) {
+                               NodeID target = m_G->getEdgeTarget(node, e);
+                               if(m_bfstouched[target]) continue;
+
+                               EdgeID rev_e = m_G->getReverseEdge(node, e);
+                               if( m_G->getEdgeCapacity( target, rev_e) - m_G->getEdgeFlow( target, rev_e) > 0 ) {
+                                        m_distance[target] = m_distance[node]+1;
+                                        m_bfsqueue.push_back(target);
+                                        m_bfstouched[target] = true;
+                               }
+                       } endfor
+                }
+
+                // nodes that can not reach the sink anymore have to return their excess to the source,
+                // hence their label is n plus the distance to the source in the residual graph
+                m_distance[source] = n;
+                unsigned int sink_reached = m_bfsqueue.size();
+                m_bfsqueue.push_back(source);
+                for( unsigned int head = sink_reached; head < m_bfsqueue.size(); head++) {
+                       NodeID node = m_bfsqueue[head];
 
                        forall_out_edges((*m_G), e, node) {
                                NodeID target = m_G->getEdgeTarget(node, e);
@@ -69,14 +121,30 @@ public:
 
                                EdgeID rev_e = m_G->getReverseEdge(node, e);
                                if( m_G->getEdgeCapacity( target, rev_e) - m_G->getEdgeFlow( target, rev_e) > 0 ) {
-                                        m_count[ m_distance[target] ] --;
                                         m_distance[target] = m_distance[node]+1;
-                                        m_count[ m_distance[target] ] ++;
-                                        Q.push(target);
+                                        m_bfsqueue.push_back(target);
                                         m_bfstouched[target] = true;
                                }
                        } endfor
                 }
+
+                std::fill(m_count.begin(), m_count.end(), 0);
+                std::fill(m_bucket_head.begin(), m_bucket_head.end(), UNDEFINED_NODE);
+                while( !m_Q.empty() ) m_Q.pop();
+                std::fill(m_level_head.begin(), m_level_head.end(), UNDEFINED_NODE);
+                m_max_active_low  = 0;
+                m_max_active_high = n;
+                m_max_level       = 0;
+
+                forall_nodes((*m_G), node) {
+                        m_count[m_distance[node]]++;
+                        m_current_edge[node] = m_G->get_first_edge(node);
+                        if( node == source || node == sink ) continue;
+
+                        if( m_distance[node] < n ) level_insert(node);
+                        m_active[node] = false;
+                        enqueue(node);
+                } endfor
         }
 
         // push flow from source to target if possible
@@ -101,22 +169,71 @@ public:
                 enqueue(target);
         }
 
-        // put a vertex in the FIFO queue of the algorithm 
+        // put a vertex into the bucket of its distance label or into the FIFO queue
         void enqueue( NodeID target ) {
                 if( m_active[target] ) return;
                 if( m_excess[target] > 0) {
                         m_active[target] = true;
-                        //m_Q.push(target, m_distance[target]);
-                        m_Q.push(target);
+                        if( !m_highest_label ) {
+                                m_Q.push(target);
+                                return;
+                        }
+
+                        NodeID level = m_distance[target];
+                        m_bucket_next[target] = m_bucket_head[level];
+                        m_bucket_head[level]  = target;
+                        if( level < m_G->number_of_nodes() ) {
+                                m_max_active_low  = std::max(m_max_active_low, level);
+                        } else {
+                                m_max_active_high = std::max(m_max_active_high, level);
+                        }
+                }
+        }
+
+        // returns the active node with the highest label, labels below n are preferred (or the next node in FIFO order)
+        // returns UNDEFINED_NODE if there is no active node left
+        NodeID dequeue() {
+                if( !m_highest_label ) {
+                        if( m_Q.empty() ) return UNDEFINED_NODE;
+                        NodeID node    = m_Q.front(); m_Q.pop();
+                        m_active[node] = false;
+                        return node;
+                }
+
+                NodeID n = m_G->number_of_nodes();
+                while( true ) {
+                        while( m_max_active_low > 0 && m_bucket_head[m_max_active_low] == UNDEFINED_NODE ) {
+                                m_max_active_low--;
+                        }
+
+                        NodeID level = m_max_active_low;
+                        if( m_bucket_head[level] == UNDEFINED_NODE ) {
+                                while( m_max_active_high > n && m_bucket_head[m_max_active_high] == UNDEFINED_NODE ) {
+                                        m_max_active_high--;
+                                }
+                                level = m_max_active_high;
+                                if( m_bucket_head[level] == UNDEFINED_NODE ) return UNDEFINED_NODE;
+                        }
+
+                        NodeID node          = m_bucket_head[level];
+                        m_bucket_head[level] = m_bucket_next[node];
+                        m_active[node]       = false;
+
+                        if( m_distance[node] == level ) return node;
+                        // the node has been lifted by the gap heuristic while it was waiting in the bucket
+                        enqueue(node);
                 }
         }
 
         // try to push as much excess as possible out of the node node
         void discharge( NodeID node ) {
                 EdgeID end = m_G->get_first_invalid_edge(node);
-                for(EdgeID e = m_G->get_first_edge(node); e < end && m_excess[node] > 0; ++e) {
+                EdgeID e   = m_current_edge[node];
+                for( ; e < end; ++e) {
                         push( node, e );
+                        if( m_excess[node] == 0 ) break;
                 }
+                m_current_edge[node] = e;
 
                 if( m_excess[node] > 0 ) {
                         if( m_count[ m_distance[node] ] == 1 && m_distance[node] < m_G->number_of_nodes()) {
@@ -129,16 +246,24 @@ public:
         }
 
 
-        // gap heuristic
+        // gap heuristic, lifts all nodes with label at least level to n
         void gap_heuristic( NodeID level ) {
                 m_gaps++;
-                forall_nodes((*m_G), node) {
-                        if(m_distance[node] < level ) continue;
-                        m_count[m_distance[node]]--;
-                        m_distance[node] = std::max(m_distance[node], m_G->number_of_nodes());
-                        m_count[m_distance[node]]++;
-                        enqueue(node);
-                } endfor
+                NodeID n = m_G->number_of_nodes();
+                for( NodeID cur_level = level; cur_level <= m_max_level; cur_level++) {
+                        NodeID node = m_level_head[cur_level];
+                        while( node != UNDEFINED_NODE ) {
+                                NodeID next = m_level_next[node];
+                                m_count[cur_level]--;
+                                m_distance[node] = n;
+                                m_count[n]++;
+                                m_current_edge[node] = m_G->get_first_edge(node);
+                                enqueue(node);
+                                node = next;
+                        } 
+                        m_level_head[cur_level] = UNDEFINED_NODE;
+                } 
+                m_max_level = level > 0 ? level - 1 : 0;
         }
 
         // relabel a node with respect to its 
@@ -147,8 +272,11 @@ public:
                 m_work += WORK_OP_RELABEL;
                 m_num_relabels++;
 
+                NodeID n = m_G->number_of_nodes();
+                if( m_distance[node] < n ) level_remove(node);
+
                 m_count[m_distance[node]]--;
-                m_distance[node] = 2*m_G->number_of_nodes();
+                m_distance[node] = 2*n;
 
                 forall_out_edges((*m_G), e, node) {
                         if( m_G->getEdgeCapacity( node, e) - m_G->getEdgeFlow( node, e) > 0) {
@@ -159,6 +287,8 @@ public:
                 } endfor
 
                 m_count[m_distance[node]]++;
+                m_current_edge[node] = m_G->get_first_edge(node);
+                if( m_distance[node] < n ) level_insert(node);
                 enqueue(node);
         }
 
@@ -176,12 +306,47 @@ public:
 
                 init(G, source, sink);
                 global_relabeling( source, sink );
-         
+
+                return run(source, sink, compute_source_set, source_set);
+        }
+
+        // continues from the flow that is currently stored in G, e.g. after capacities 
+        // have been increased or edges have been added (piercing). the number of nodes of G must 
+        // not have changed since the last call of solve_max_flow_min_cut on this object.
+        // returns the value of the new maximum flow
+        FlowType resume_max_flow_min_cut( flow_graph & G, 
+                                          NodeID source, 
+                                          NodeID sink, 
+                                          bool compute_source_set, 
+                                          std::vector< NodeID > & source_set) {
+                m_G                  = & G;
+                m_work               = 0;
+                m_num_relabels       = 0;
+                m_gaps               = 0;
+                m_pushes             = 0;
+                m_global_updates     = 1;
+
+                // the old labels may be invalid for the new capacities, hence exact labels are computed first
+                init_labels(G, source, sink);
+                global_relabeling( source, sink );
+
+                forall_out_edges(G, e, source) {
+                        m_excess[source] += G.getEdgeCapacity(source, e) - G.getEdgeFlow(source, e);
+                        push(source, e);
+                } endfor
+
+                return run(source, sink, compute_source_set, source_set);
+        }
+
+        FlowType run( NodeID source, 
+                      NodeID sink, 
+                      bool compute_source_set, 
+                      std::vector< NodeID > & source_set) {
+                flow_graph & G = *m_G;
                 int work_todo = WORK_NODE_TO_EDGES*G.number_of_nodes() + G.number_of_edges();
                 // main loop
-                while(!m_Q.empty()) {
-                        NodeID v    = m_Q.front(); m_Q.pop();
-                        m_active[v] = false;
+                NodeID v = dequeue();
+                while( v != UNDEFINED_NODE ) {
                         discharge(v);
 
                         if( m_work > GLOBAL_UPDATE_FRQ*work_todo) {
@@ -189,6 +354,7 @@ public:
                                 m_work = 0;
                                 m_global_updates++;
                         }
+                        v = dequeue();
                 }
 
                 if(compute_source_set) {
@@ -199,20 +365,19 @@ public:
                                 m_bfstouched[node] = false;
                         } endfor
 
-                        std::queue< NodeID > Q;
-                        Q.push(source);
+                        m_bfsqueue.clear();
+                        m_bfsqueue.push_back(source);
                         m_bfstouched[source] = true;
 
-                        while( !Q.empty() ) {
-                                NodeID node = Q.front();
-                                Q.pop();
+                        for( unsigned int head = 0; head < m_bfsqueue.size(); head++) {
+                                NodeID node = m_bfsqueue[head];
                                 source_set.push_back(node);
 
                                 forall_out_edges(G, e, node) {
                                         NodeID target = G.getEdgeTarget(node, e);
                                         FlowType resCap = G.getEdgeCapacity(node, e) - G.getEdgeFlow(node, e);
                                         if(resCap > 0 && !m_bfstouched[target]) {
-                                                Q.push(target);
+                                                m_bfsqueue.push_back(target);
                                                 m_bfstouched[target] = true;
                                         }
                                 } endfor
@@ -223,13 +388,49 @@ public:
                 return m_excess[sink];
         }
 private:
+        void level_insert( NodeID node ) {
+                NodeID level       = m_distance[node];
+                NodeID next        = m_level_head[level];
+                m_level_next[node] = next;
+                m_level_prev[node] = UNDEFINED_NODE;
+                if( next != UNDEFINED_NODE ) m_level_prev[next] = node;
+                m_level_head[level] = node;
+                m_max_level = std::max(m_max_level, level);
+        }
+
+        void level_remove( NodeID node ) {
+                NodeID next = m_level_next[node];
+                NodeID prev = m_level_prev[node];
+                if( next != UNDEFINED_NODE ) m_level_prev[next] = prev;
+                if( prev != UNDEFINED_NODE ) {
+                        m_level_next[prev] = next;
+                } else {
+                        m_level_head[m_distance[node]] = next;
+                }
+        }
+
         std::vector<long long> m_excess;
         std::vector<NodeID>    m_distance;
-	std::vector<bool>      m_active; // store which nodes are in the queue already
+	std::vector<bool>      m_active; // store which nodes are in a bucket already
 	std::vector<int>       m_count;
-        std::queue<NodeID>     m_Q;
 	std::vector<bool>      m_bfstouched; 
-        //highest_label_queue    m_Q;
+        std::vector<EdgeID>    m_current_edge;
+        std::vector<NodeID>    m_bfsqueue;
+
+        // buckets of active nodes, singly linked lists indexed by distance label 
+        bool                   m_highest_label;
+        std::queue<NodeID>     m_Q;
+        std::vector<NodeID>    m_bucket_head;
+        std::vector<NodeID>    m_bucket_next;
+        NodeID m_max_active_low;
+        NodeID m_max_active_high;
+
+        // all nodes with distance label smaller than n, doubly linked lists indexed by distance label
+        std::vector<NodeID>    m_level_head;
+        std::vector<NodeID>    m_level_next;
+        std::vector<NodeID>    m_level_prev;
+        NodeID m_max_level;
+
         int m_num_relabels;
         int m_gaps;
         int m_global_updates;
@@ -8,28 +8,27 @@
 #ifndef FLOW_GRAPH_636S5L2S
 #define FLOW_GRAPH_636S5L2S
 
+#include <vector>
+
 #include "definitions.h"
 
 struct rEdge {
-    NodeID     source;
     NodeID     target;
     FlowType   capacity;
     FlowType   flow;
     EdgeID     reverse_edge_index;
-
-    rEdge( NodeID source, NodeID target, FlowType capacity, FlowType flow, EdgeID reverse_edge_index) {
-        this->source             = source;
-        this->target             = target;
-        this->capacity           = capacity;
-        this->flow               = flow;
-        this->reverse_edge_index = reverse_edge_index;
-    }
-
 };
 
-// this is a adjacency list implementation of the residual graph
+// this is a flat (CSR) implementation of the residual graph
 // for each edge we create, we create a rev edge with cap 0
 // zero capacity edges are residual edges
+//
+// new_edge only buffers the edge, the CSR arrays are built in finish_construction.
+// edge ids are global, i.e. forall_out_edges(G, e, node) yields e in [m_first_edge[node], m_first_edge[node+1])
+// the source argument of the accessors is kept for compatibility and is not needed to locate an edge.
+// all buffers keep their capacity, so a flow_graph object can be reused for several flow problems.
+// new_edge can also be called after finish_construction, the next finish_construction then appends the 
+// new edges to the adjacency lists. existing edges keep their flow and their position within the list of a node.
 class flow_graph {
 public:
         flow_graph() {
@@ -40,18 +39,23 @@ public:
         virtual ~flow_graph() {};
 
         void start_construction(NodeID nodes, EdgeID edges = 0) {
-                m_adjacency_lists.resize(nodes);
                 m_num_nodes = nodes;
-                m_num_edges = edges;
+                m_num_edges = 0;
+                m_edges.clear();
+                m_edge_buffer.clear();
+                m_edge_buffer.reserve(edges);
+                m_first_edge.assign(nodes+1, 0);
+                m_degree.assign(nodes, 0);
         }
  
-        void finish_construction() {};
+        void finish_construction(); 
 
         NodeID number_of_nodes() {return m_num_nodes;};
         EdgeID number_of_edges() {return m_num_edges;};
 
         NodeID getEdgeTarget(NodeID source, EdgeID e);
-        NodeID getEdgeCapacity(NodeID source, EdgeID e);
+        FlowType getEdgeCapacity(NodeID source, EdgeID e);
+        void setEdgeCapacity(NodeID source, EdgeID e, FlowType capacity);
 
         FlowType getEdgeFlow(NodeID source, EdgeID e);
         void setEdgeFlow(NodeID source, EdgeID e, FlowType flow);
@@ -59,64 +63,138 @@ public:
         EdgeID getReverseEdge(NodeID source, EdgeID e);
         
         void new_edge(NodeID source, NodeID target, FlowType capacity) {
-               m_adjacency_lists[source].push_back(rEdge(source, target, capacity, 0, m_adjacency_lists[target].size()));
+               m_edge_buffer.push_back(buffered_edge(source, target, capacity));
                // for each edge we add a reverse edge
-               m_adjacency_lists[target].push_back(rEdge(target, source, 0, 0, m_adjacency_lists[source].size() - 1));
+               m_degree[source]++;
+               m_degree[target]++;
                m_num_edges += 2;
         };
 
-        EdgeID get_first_edge(NodeID node) {return 0;};
-        EdgeID get_first_invalid_edge(NodeID node) {return m_adjacency_lists[node].size();};
+        EdgeID get_first_edge(NodeID node) {return m_first_edge[node];};
+        EdgeID get_first_invalid_edge(NodeID node) {return m_first_edge[node+1];};
 
 
 private:
-        std::vector< std::vector<rEdge> > m_adjacency_lists;
+        struct buffered_edge {
+                NodeID   source;
+                NodeID   target;
+                FlowType capacity;
+
+                buffered_edge( NodeID source, NodeID target, FlowType capacity) {
+                        this->source   = source;
+                        this->target   = target;
+                        this->capacity = capacity;
+                }
+        };
+
+        std::vector< rEdge >         m_edges;
+        std::vector< EdgeID >        m_first_edge;
+        std::vector< buffered_edge > m_edge_buffer;
+        std::vector< EdgeID >        m_degree; // number of buffered edges per node
+        std::vector< EdgeID >        m_insert_pos;
+        std::vector< rEdge >         m_old_edges;
+        std::vector< EdgeID >        m_old_first_edge;
         NodeID m_num_nodes;
-        NodeID m_num_edges;
+        EdgeID m_num_edges;
+};
+
+inline
+void flow_graph::finish_construction() {
+        m_old_edges.swap(m_edges);
+        m_old_first_edge.swap(m_first_edge);
+
+        m_first_edge.resize(m_num_nodes+1);
+        m_first_edge[0] = 0;
+        for( NodeID node = 0; node < m_num_nodes; node++) {
+                EdgeID old_degree    = m_old_first_edge[node+1] - m_old_first_edge[node];
+                m_first_edge[node+1] = m_first_edge[node] + old_degree + m_degree[node];
+        }
+        m_edges.resize(m_num_edges);
+
+        // edges that already have been constructed keep their offset within the adjacency list 
+        m_insert_pos.resize(m_num_nodes);
+        for( NodeID node = 0; node < m_num_nodes; node++) {
+                EdgeID shift = m_first_edge[node];
+                for( EdgeID e = m_old_first_edge[node]; e < m_old_first_edge[node+1]; e++) {
+                        rEdge & edge = m_edges[shift + e - m_old_first_edge[node]];
+                        edge = m_old_edges[e];
+                        edge.reverse_edge_index = m_first_edge[edge.target] + edge.reverse_edge_index - m_old_first_edge[edge.target];
+                }
+                m_insert_pos[node] = shift + m_old_first_edge[node+1] - m_old_first_edge[node];
+                m_degree[node]     = 0;
+        }
+
+        // buffered edges are placed in insertion order, hence the order of the out edges of a node
+        // is the same as in the previous adjacency list implementation
+        for( const buffered_edge & edge : m_edge_buffer ) {
+                EdgeID forward = m_insert_pos[edge.source]++;
+                EdgeID reverse = m_insert_pos[edge.target]++;
+
+                m_edges[forward].target             = edge.target;
+                m_edges[forward].capacity           = edge.capacity;
+                m_edges[forward].flow               = 0;
+                m_edges[forward].reverse_edge_index = reverse;
+
+                m_edges[reverse].target             = edge.source;
+                m_edges[reverse].capacity           = 0;
+                m_edges[reverse].flow               = 0;
+                m_edges[reverse].reverse_edge_index = forward;
+        }
+        m_edge_buffer.clear();
+        m_old_edges.clear();
+}
+
+inline
+FlowType flow_graph::getEdgeCapacity(NodeID source, EdgeID e) {
+#ifdef NDEBUG
+        return m_edges[e].capacity;        
+#else
+        return m_edges.at(e).capacity;        
+#endif
 };
 
 inline
-NodeID flow_graph::getEdgeCapacity(NodeID source, EdgeID e) {
+void flow_graph::setEdgeCapacity(NodeID source, EdgeID e, FlowType capacity) {
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].capacity;        
+        m_edges[e].capacity = capacity;        
 #else
-        return m_adjacency_lists.at(source).at(e).capacity;        
+        m_edges.at(e).capacity = capacity;        
 #endif
 };
 
 inline
 void flow_graph::setEdgeFlow(NodeID source, EdgeID e, FlowType flow) {
 #ifdef NDEBUG
-        m_adjacency_lists[source][e].flow = flow;        
+        m_edges[e].flow = flow;        
 #else
-        m_adjacency_lists.at(source).at(e).flow = flow;        
+        m_edges.at(e).flow = flow;        
 #endif
 };
 
 inline
 FlowType flow_graph::getEdgeFlow(NodeID source, EdgeID e) {
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].flow;        
+        return m_edges[e].flow;        
 #else
-        return m_adjacency_lists.at(source).at(e).flow;        
+        return m_edges.at(e).flow;        
 #endif
 };
 
 inline
 NodeID flow_graph::getEdgeTarget(NodeID source, EdgeID e) {
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].target;        
+        return m_edges[e].target;        
 #else
-        return m_adjacency_lists.at(source).at(e).target;        
+        return m_edges.at(e).target;        
 #endif
 };
 
 inline
 EdgeID flow_graph::getReverseEdge(NodeID source, EdgeID e) {
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].reverse_edge_index;
+        return m_edges[e].reverse_edge_index;
 #else
-        return m_adjacency_lists.at(source).at(e).reverse_edge_index;        
+        return m_edges.at(e).reverse_edge_index;        
 #endif
 
 }
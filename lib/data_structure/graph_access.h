@@ -109,6 +109,16 @@ private:
         return node++;
     }
 
+    // bulk construction: offsets and targets are written directly (e.g. by several threads)
+    // instead of being appended in order, finish_construction completes the graph
+    void start_bulk_construction(NodeID n, EdgeID m) {
+        start_construction(n, m);
+        node          = n;
+        e             = m;
+        m_last_source = (int)n - 1;
+        m_nodes[n].firstEdge = m;
+    }
+
     void finish_construction() {
         // inert dummy node
         m_nodes.resize(node+1);
@@ -172,6 +182,9 @@ class graph_access {
                 /* ============================================================= */
                 void start_construction(NodeID nodes, EdgeID edges);
                 NodeID new_node();
+                void start_bulk_construction(NodeID nodes, EdgeID edges);
+                void setFirstEdge(NodeID node, EdgeID first_edge);
+                void setEdgeTarget(EdgeID edge, NodeID target);
                 EdgeID new_edge(NodeID source, NodeID target);
                 void finish_construction();
 
@@ -264,6 +277,18 @@ inline EdgeID graph_access::new_edge(NodeID source, NodeID target) {
         return graphref->new_edge(source, target);
 }
 
+inline void graph_access::start_bulk_construction(NodeID nodes, EdgeID edges) {
+        graphref->start_bulk_construction(nodes, edges);
+}
+
+inline void graph_access::setFirstEdge(NodeID node, EdgeID first_edge) {
+        graphref->m_nodes[node].firstEdge = first_edge;
+}
+
+inline void graph_access::setEdgeTarget(EdgeID edge, NodeID target) {
+        graphref->m_edges[edge].target = target;
+}
+
 inline void graph_access::finish_construction() {
         graphref->finish_construction();
 }
@@ -474,6 +499,7 @@ inline void graph_access::set_partition_count(PartitionID count) {
 }
 
 inline int graph_access::build_from_metis(int n, int* xadj, int* adjncy) {
+        delete graphref;
         graphref = new basicGraph();
         start_construction(n, xadj[n]);
 
@@ -494,6 +520,7 @@ inline int graph_access::build_from_metis(int n, int* xadj, int* adjncy) {
 }
 
 inline int graph_access::build_from_metis_weighted(int n, int* xadj, int* adjncy, int * vwgt, int* adjwgt) {
+        delete graphref;
         graphref = new basicGraph();
         start_construction(n, xadj[n]);
 
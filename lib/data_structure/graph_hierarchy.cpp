@@ -8,6 +8,7 @@
 #include "graph_hierarchy.h"
 
 graph_hierarchy::graph_hierarchy() : m_current_coarser_graph(NULL), 
+                                     m_finest_graph(NULL),
                                      m_current_coarse_mapping(NULL){
 
 }
@@ -25,6 +26,7 @@ graph_hierarchy::~graph_hierarchy() {
 }
 
 void graph_hierarchy::push_back(graph_access * G, CoarseMapping * coarse_mapping) {
+        if(m_the_graph_hierarchy.empty()) m_finest_graph = G;
         m_the_graph_hierarchy.push(G);
         m_the_mappings.push(coarse_mapping);
 	m_to_delete_mappings.push_back(coarse_mapping);
@@ -107,6 +109,10 @@ graph_access* graph_hierarchy::get_coarsest( ) {
         return m_coarsest_graph;                
 }
 
+graph_access* graph_hierarchy::get_finest( ) {
+        return m_finest_graph;
+}
+
 graph_access* graph_hierarchy::pop_coarsest( ) {
         graph_access* current_coarsest = m_the_graph_hierarchy.top(); 
         m_the_graph_hierarchy.pop();
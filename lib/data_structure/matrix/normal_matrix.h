@@ -21,6 +21,16 @@ public:
         };
         virtual ~normal_matrix() {};
 
+        // reinitializes the matrix lazily to dim_x times dim_y entries, the rows keep their memory
+        void reset(unsigned int dim_x, unsigned int dim_y) {
+                m_dim_x = dim_x;
+                m_dim_y = dim_y;
+                for( unsigned int x = 0; x < m_internal_matrix.size(); x++) {
+                        m_internal_matrix[x].clear();
+                }
+                m_internal_matrix.resize(m_dim_x);
+        };
+
         inline int get_xy(unsigned int x, unsigned int y) {
                 if( m_internal_matrix[x].size() == 0 ) { 
                         return m_lazy_init_val;
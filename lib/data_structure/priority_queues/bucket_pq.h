@@ -36,13 +36,25 @@ class bucket_pq : public priority_queue_interface {
                 void deleteNode(NodeID node) override;
 
                 bool contains(NodeID node) override;
+                void clear() override;
+
+                // empties the queue and prepares it for gains in [-gain_span, gain_span]
+                void reset(const EdgeWeight & gain_span);
+
+                // switches to an array indexed by node ids below n instead of the hash map,
+                // used by queues that are kept alive over many searches on the same graph
+                void reserve_index(NodeID n);
 
               private:
+                std::pair<Count, Gain> & queue_index(NodeID node);
+                void erase_queue_index(NodeID node);
+
                 NodeID     m_elements;
                 EdgeWeight m_gain_span;
                 unsigned   m_max_idx; //points to the non-empty bucket with the largest gain
 
                 std::unordered_map<NodeID, std::pair<Count, Gain> > m_queue_index;
+                std::vector< std::pair<Count, Gain> >          m_dense_queue_index;
                 std::vector< std::vector<NodeID> >             m_buckets;
 };
 
@@ -54,6 +66,46 @@ inline bucket_pq::bucket_pq( const EdgeWeight & gain_span_input ) {
         m_buckets.resize(2*m_gain_span+1);
 }
 
+inline std::pair<Count, Gain> & bucket_pq::queue_index(NodeID node) {
+        if( m_dense_queue_index.empty() ) {
+                return m_queue_index[node];
+        }
+        return m_dense_queue_index[node];
+}
+
+inline void bucket_pq::erase_queue_index(NodeID node) {
+        if( m_dense_queue_index.empty() ) {
+                m_queue_index.erase(node);
+        } else {
+                m_dense_queue_index[node].first = std::numeric_limits<Count>::max();
+        }
+}
+
+inline void bucket_pq::reserve_index(NodeID n) {
+        if( m_dense_queue_index.size() < n ) {
+                m_dense_queue_index.resize(n, std::make_pair(std::numeric_limits<Count>::max(), 0));
+        }
+}
+
+inline void bucket_pq::clear() {
+        for( unsigned address = 0; address <= m_max_idx && address < m_buckets.size(); address++) {
+                for( unsigned i = 0; i < m_buckets[address].size(); i++) {
+                        erase_queue_index(m_buckets[address][i]);
+                }
+                m_buckets[address].clear();
+        }
+        m_elements = 0;
+        m_max_idx  = 0;
+}
+
+inline void bucket_pq::reset(const EdgeWeight & gain_span_input) {
+        clear();
+        m_gain_span = gain_span_input;
+        if( m_buckets.size() < 2*m_gain_span+1 ) {
+                m_buckets.resize(2*m_gain_span+1);
+        }
+}
+
 inline NodeID bucket_pq::size() {
         return m_elements;
 }
@@ -65,8 +117,9 @@ inline void bucket_pq::insert(NodeID node, Gain gain) {
         }
 
         m_buckets[address].push_back( node );
-        m_queue_index[node].first  = m_buckets[address].size() - 1; //store position
-        m_queue_index[node].second = gain;
+        std::pair<Count, Gain> & index = queue_index(node);
+        index.first  = m_buckets[address].size() - 1; //store position
+        index.second = gain;
 
         m_elements++;
 }
@@ -86,7 +139,7 @@ inline NodeID bucket_pq::maxElement( ) {
 inline NodeID bucket_pq::deleteMax() {
        NodeID node = m_buckets[m_max_idx].back();
        m_buckets[m_max_idx].pop_back();
-       m_queue_index.erase(node);
+       erase_queue_index(node);
 
        if( m_buckets[m_max_idx].size() == 0 ) {
              //update max_idx
@@ -111,7 +164,7 @@ inline void bucket_pq::increaseKey(NodeID node, Gain new_gain) {
 }
 
 inline Gain bucket_pq::getKey(NodeID node) {
-        return m_queue_index[node].second;
+        return queue_index(node).second;
 }
 
 inline void bucket_pq::changeKey(NodeID node, Gain new_gain) {
@@ -120,14 +173,14 @@ inline void bucket_pq::changeKey(NodeID node, Gain new_gain) {
 }
 
 inline void bucket_pq::deleteNode(NodeID node) {
-        ASSERT_TRUE(m_queue_index.find(node) != m_queue_index.end());
-        Count in_bucket_idx = m_queue_index[node].first;
-        Gain  old_gain      = m_queue_index[node].second;
+        ASSERT_TRUE(contains(node));
+        Count in_bucket_idx = queue_index(node).first;
+        Gain  old_gain      = queue_index(node).second;
         unsigned address    = old_gain + m_gain_span;
 
         if( m_buckets[address].size() > 1 ) {
                 //swap current element with last element and pop_back
-                m_queue_index[m_buckets[address].back()].first = in_bucket_idx; // update helper structure
+                queue_index(m_buckets[address].back()).first = in_bucket_idx; // update helper structure
                 std::swap(m_buckets[address][in_bucket_idx], m_buckets[address].back());
                 m_buckets[address].pop_back();
         } else {
@@ -146,11 +199,15 @@ inline void bucket_pq::deleteNode(NodeID node) {
         }
 
         m_elements--;
-        m_queue_index.erase(node);
+        erase_queue_index(node);
 }
 
 inline bool bucket_pq::contains(NodeID node) {
-        return m_queue_index.find(node) != m_queue_index.end();
+        if( m_dense_queue_index.empty() ) {
+                return m_queue_index.find(node) != m_queue_index.end();
+        }
+        return node < m_dense_queue_index.size()
+               && m_dense_queue_index[node].first != std::numeric_limits<Count>::max();
 }
 
 
@@ -15,7 +15,7 @@
 
 #include "data_structure/priority_queues/priority_queue_interface.h"
 
-typedef int Key;
+typedef Gain Key;
 
 template < typename Data >
 class QElement {
@@ -82,12 +82,21 @@ class maxNodeHeap : public priority_queue_interface {
                 void increaseKey(NodeID node, Gain gain) override;
                 void changeKey(NodeID node, Gain gain) override;
                 Gain getKey(NodeID node) override;
+                void clear() override;
+
+                // switches to an array indexed by node ids below n instead of the hash map,
+                // used by queues that are kept alive over many searches on the same graph
+                void reserve_index(NodeID n);
 
         private:
                 std::vector< PQElement >               m_elements;      // elements that contain the data
                 std::unordered_map<NodeID, int>   m_element_index; // stores index of the node in the m_elements array
+                std::vector< int >                     m_dense_element_index; // same as m_element_index, -1 if not contained
                 std::vector< std::pair<Key, int> >     m_heap;          // key and index in elements (pointer)
 
+                int & element_index(NodeID node);
+                void erase_element_index(NodeID node);
+
                 void siftUp( int pos );
                 void siftDown( int pos );
 
@@ -95,6 +104,35 @@ class maxNodeHeap : public priority_queue_interface {
 
 
 
+inline int & maxNodeHeap::element_index(NodeID node) {
+        if( m_dense_element_index.empty() ) {
+                return m_element_index[node];
+        }
+        return m_dense_element_index[node];
+}
+
+inline void maxNodeHeap::erase_element_index(NodeID node) {
+        if( m_dense_element_index.empty() ) {
+                m_element_index.erase(node);
+        } else {
+                m_dense_element_index[node] = -1;
+        }
+}
+
+inline void maxNodeHeap::reserve_index(NodeID n) {
+        if( m_dense_element_index.size() < n ) {
+                m_dense_element_index.resize(n, -1);
+        }
+}
+
+inline void maxNodeHeap::clear() {
+        for( unsigned i = 0; i < m_elements.size(); i++) {
+                erase_element_index(m_elements[i].get_data().node);
+        }
+        m_elements.clear();
+        m_heap.clear();
+}
+
 inline Gain maxNodeHeap::maxValue() {
         return m_heap[0].first;
 };
@@ -105,13 +143,13 @@ inline NodeID maxNodeHeap::maxElement() {
 
 inline void maxNodeHeap::siftDown( int pos ) {
 
-        int curKey   = m_heap[pos].first;
+        Key curKey   = m_heap[pos].first;
         int lhsChild = 2*pos+1;
         int rhsChild = 2*pos+2;
         if( rhsChild < (int) m_heap.size() ) {
 
-                int lhsKey = m_heap[lhsChild].first;
-                int rhsKey = m_heap[rhsChild].first;
+                Key lhsKey = m_heap[lhsChild].first;
+                Key rhsKey = m_heap[rhsChild].first;
 
                 if( lhsKey < curKey && rhsKey < curKey) {
                         return; // we are done
@@ -177,33 +215,33 @@ inline bool maxNodeHeap::empty( ) {
 }
 
 inline void maxNodeHeap::insert(NodeID node, Gain gain) {
-        if( m_element_index.find(node) == m_element_index.end() ) {
-                int element_index =  m_elements.size();
-                int heap_size     =  m_heap.size();
+        if( !contains(node) ) {
+                int new_index =  m_elements.size();
+                int heap_size =  m_heap.size();
 
                 m_elements.push_back( PQElement( Data(node), gain, heap_size) );
-                m_heap.push_back( std::pair< Key, int>(gain, element_index) );
-                m_element_index[node] = element_index;
+                m_heap.push_back( std::pair< Key, int>(gain, new_index) );
+                element_index(node) = new_index;
                 siftUp( heap_size );
         }
 }
 
 inline void maxNodeHeap::deleteNode(NodeID node) {
-        int element_index = m_element_index[node];
-        int heap_index    = m_elements[element_index].get_index();
+        int node_index = element_index(node);
+        int heap_index = m_elements[node_index].get_index();
 
-        m_element_index.erase(node);
+        erase_element_index(node);
 
         std::swap( m_heap[heap_index], m_heap[m_heap.size() - 1]);
         //update the position of its element in the element array
         m_elements[m_heap[heap_index].second].set_index(heap_index);
 
         // we dont want holes in the elements array -- delete the deleted element from the array
-        if(element_index != (int)(m_elements.size() - 1)) {
-                std::swap( m_elements[element_index], m_elements[m_elements.size() - 1]);
-                m_heap[ m_elements[element_index].get_index() ].second = element_index;
-                int cnode              = m_elements[element_index].get_data().node;
-                m_element_index[cnode] = element_index;
+        if(node_index != (int)(m_elements.size() - 1)) {
+                std::swap( m_elements[node_index], m_elements[m_elements.size() - 1]);
+                m_heap[ m_elements[node_index].get_index() ].second = node_index;
+                int cnode            = m_elements[node_index].get_data().node;
+                element_index(cnode) = node_index;
         }
 
         m_elements.pop_back();
@@ -218,20 +256,20 @@ inline void maxNodeHeap::deleteNode(NodeID node) {
 
 inline NodeID maxNodeHeap::deleteMax() {
         if( m_heap.size() > 0) {
-                int element_index = m_heap[0].second;
-                int node = m_elements[element_index].get_data().node;
-                m_element_index.erase(node);
+                int node_index = m_heap[0].second;
+                int node = m_elements[node_index].get_data().node;
+                erase_element_index(node);
 
                 m_heap[0] = m_heap[m_heap.size() - 1];
                 //update the position of its element in the element array
                 m_elements[m_heap[0].second].set_index(0);
 
                 // we dont want holes in the elements array -- delete the deleted element from the array
-                if(element_index != (int)(m_elements.size() - 1)) {
-                        m_elements[element_index] = m_elements[m_elements.size() - 1];
-                        m_heap[ m_elements[element_index].get_index() ].second = element_index;
-                        int cnode              = m_elements[element_index].get_data().node;
-                        m_element_index[cnode] = element_index;
+                if(node_index != (int)(m_elements.size() - 1)) {
+                        m_elements[node_index] = m_elements[m_elements.size() - 1];
+                        m_heap[ m_elements[node_index].get_index() ].second = node_index;
+                        int cnode            = m_elements[node_index].get_data().node;
+                        element_index(cnode) = node_index;
                 }
 
                 m_elements.pop_back();
@@ -249,7 +287,7 @@ inline NodeID maxNodeHeap::deleteMax() {
 }
 
 inline void maxNodeHeap::changeKey(NodeID node, Gain gain) {
-        Gain old_gain = m_heap[m_elements[m_element_index[node]].get_index()].first;
+        Gain old_gain = m_heap[m_elements[element_index(node)].get_index()].first;
         if( old_gain > gain ) {
                 decreaseKey(node, gain);
         } else if ( old_gain < gain ) {
@@ -258,8 +296,8 @@ inline void maxNodeHeap::changeKey(NodeID node, Gain gain) {
 };
 
 inline void maxNodeHeap::decreaseKey(NodeID node, Gain gain) {
-        ASSERT_TRUE(m_element_index.find(node) != m_element_index.end());
-        int queue_idx = m_element_index[node];
+        ASSERT_TRUE(contains(node));
+        int queue_idx = element_index(node);
         int heap_idx  = m_elements[queue_idx].get_index();
         m_elements[queue_idx].set_key(gain);
         m_heap[heap_idx].first = gain;
@@ -267,8 +305,8 @@ inline void maxNodeHeap::decreaseKey(NodeID node, Gain gain) {
 }
 
 inline void maxNodeHeap::increaseKey(NodeID node, Gain gain) {
-        ASSERT_TRUE(m_element_index.find(node) != m_element_index.end());
-        int queue_idx = m_element_index[node];
+        ASSERT_TRUE(contains(node));
+        int queue_idx = element_index(node);
         int heap_idx  = m_elements[queue_idx].get_index();
         m_elements[queue_idx].set_key(gain);
         m_heap[heap_idx].first = gain;
@@ -276,12 +314,15 @@ inline void maxNodeHeap::increaseKey(NodeID node, Gain gain) {
 }
 
 inline Gain maxNodeHeap::getKey(NodeID node) {
-        return m_heap[m_elements[m_element_index[node]].get_index()].first;
+        return m_heap[m_elements[element_index(node)].get_index()].first;
 };
 
 
 inline bool maxNodeHeap::contains(NodeID node) {
-       return m_element_index.find(node) != m_element_index.end();
+       if( m_dense_element_index.empty() ) {
+               return m_element_index.find(node) != m_element_index.end();
+       }
+       return node < m_dense_element_index.size() && m_dense_element_index[node] != -1;
 }
 
 #endif
@@ -32,6 +32,9 @@ class priority_queue_interface {
                 virtual Gain getKey(NodeID element)  = 0;
                 virtual void deleteNode(NodeID node) = 0;
                 virtual bool contains(NodeID node)   = 0;
+
+                /* removes all elements, the allocated memory is kept for reuse */
+                virtual void clear() = 0;
 };
 
 typedef priority_queue_interface refinement_pq;
@@ -32,8 +32,15 @@ typedef unsigned int 	NodeID;
 typedef double 		EdgeRatingType;
 typedef unsigned int 	PathID;
 typedef unsigned int 	PartitionID;
+#ifdef MODE64BITWEIGHTS
+typedef uint64_t 	NodeWeight;
+typedef int64_t 	SignedNodeWeight; // differences of node weights
+typedef int64_t 	EdgeWeight;
+#else
 typedef unsigned int 	NodeWeight;
+typedef int 		SignedNodeWeight; // differences of node weights
 typedef int 		EdgeWeight;
+#endif
 typedef EdgeWeight 	Gain;
 #ifdef MODE64BITEDGES
 typedef uint64_t 	EdgeID;
@@ -139,6 +146,11 @@ typedef enum {
 	KWAY_ADAPTIVE_STOP_RULE
 } KWayStopRule;
 
+typedef enum {
+        LP_BALANCE_STRICT,
+        LP_BALANCE_RELAXED
+} LabelPropagationBalance;
+
 typedef enum {
         COIN_RNDTIE, 
 	COIN_DIFFTIE, 
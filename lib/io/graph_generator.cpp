@@ -0,0 +1,462 @@
+/******************************************************************************
+ * graph_generator.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "graph_generator.h"
+#include "graph_generator_random.h"
+#include "tools/parallel_tools.h"
+
+graph_generator::graph_generator() {
+
+}
+
+graph_generator::~graph_generator() {
+
+}
+
+namespace {
+
+using namespace graph_generator_random;
+
+// distributes count points uniformly over the cells [lo, hi) by recursive binomial splits,
+// the number of points in a cell thus does not depend on which other cells are computed
+void split_counts(uint64_t key, uint64_t lo, uint64_t hi, uint64_t count, std::vector< NodeID > & counts) {
+        if( hi - lo == 1 ) {
+                counts[lo] = count;
+                return;
+        }
+
+        uint64_t mid = lo + (hi - lo) / 2;
+        counter_rng rng(mix(key ^ mix(lo)) + hi);
+        uint64_t left = binomial(rng, count, (mid - lo) / (double)(hi - lo));
+
+        #pragma omp task if(hi - lo > 4096) shared(counts)
+        split_counts(key, lo, mid, left, counts);
+        split_counts(key, mid, hi, count - left, counts);
+        #pragma omp taskwait
+}
+
+// returns the first node of every cell, the last entry is the number of points
+std::vector< NodeID > cell_starts(uint64_t key, uint64_t cells, NodeID points) {
+        std::vector< NodeID > start(cells + 1, 0);
+        #pragma omp parallel
+        {
+                #pragma omp single
+                split_counts(key, 0, cells, points, start);
+        }
+
+        NodeID sum = 0;
+        for( uint64_t cell = 0; cell <= cells; cell++) {
+                NodeID count = start[cell];
+                start[cell]  = sum;
+                sum         += count;
+        }
+        return start;
+}
+
+// neighbors(node, adjacent) appends the neighbors of node to adjacent, it has to be
+// symmetric and is called twice per node (once to count, once to write the edges)
+template< typename Neighbors >
+void build_graph(graph_access & G, NodeID n, Neighbors neighbors) {
+        std::vector< EdgeID > first_edge(n + 1, 0);
+
+        #pragma omp parallel
+        {
+                std::vector< NodeID > adjacent;
+                #pragma omp for schedule(dynamic, 256)
+                for( NodeID node = 0; node < n; node++) {
+                        adjacent.clear();
+                        neighbors(node, adjacent);
+                        first_edge[node] = adjacent.size();
+                }
+        }
+        parallel_tools::prefix_sum(first_edge);
+
+        G.start_bulk_construction(n, first_edge[n]);
+        #pragma omp parallel
+        {
+                std::vector< NodeID > adjacent;
+                #pragma omp for schedule(dynamic, 256)
+                for( NodeID node = 0; node < n; node++) {
+                        adjacent.clear();
+                        neighbors(node, adjacent);
+                        std::sort(adjacent.begin(), adjacent.end());
+
+                        G.setFirstEdge(node, first_edge[node]);
+                        G.setNodeWeight(node, 1);
+                        G.setPartitionIndex(node, 0);
+
+                        EdgeID e = first_edge[node];
+                        for( NodeID target : adjacent ) {
+                                G.setEdgeTarget(e, target);
+                                G.setEdgeWeight(e, 1);
+                                e++;
+                        }
+                }
+        }
+        G.finish_construction();
+}
+
+// builds the graph from undirected edges that may contain self loops and duplicates
+void build_graph(graph_access & G, NodeID n, std::vector< std::pair< NodeID, NodeID > > & edges) {
+        std::vector< EdgeID > bucket(n + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for( std::size_t i = 0; i < edges.size(); i++) {
+                if( edges[i].first == edges[i].second ) continue;
+                #pragma omp atomic
+                bucket[edges[i].first]++;
+                #pragma omp atomic
+                bucket[edges[i].second]++;
+        }
+        parallel_tools::prefix_sum(bucket);
+
+        std::vector< NodeID > targets(bucket[n]);
+        std::vector< EdgeID > insert_position(bucket);
+        #pragma omp parallel for schedule(static)
+        for( std::size_t i = 0; i < edges.size(); i++) {
+                NodeID source = edges[i].first;
+                NodeID target = edges[i].second;
+                if( source == target ) continue;
+
+                EdgeID position;
+                #pragma omp atomic capture
+                position = insert_position[source]++;
+                targets[position] = target;
+
+                #pragma omp atomic capture
+                position = insert_position[target]++;
+                targets[position] = source;
+        }
+        std::vector< std::pair< NodeID, NodeID > >().swap(edges);
+        std::vector< EdgeID >().swap(insert_position);
+
+        // the order within a bucket depends on the threads, sorting makes the graph deterministic
+        std::vector< EdgeID > first_edge(n + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for( NodeID node = 0; node < n; node++) {
+                std::vector< NodeID >::iterator begin = targets.begin() + bucket[node];
+                std::vector< NodeID >::iterator end   = targets.begin() + bucket[node + 1];
+                std::sort(begin, end);
+                first_edge[node] = std::unique(begin, end) - begin;
+        }
+        parallel_tools::prefix_sum(first_edge);
+
+        G.start_bulk_construction(n, first_edge[n]);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for( NodeID node = 0; node < n; node++) {
+                G.setFirstEdge(node, first_edge[node]);
+                G.setNodeWeight(node, 1);
+                G.setPartitionIndex(node, 0);
+
+                EdgeID e = first_edge[node];
+                for( EdgeID i = bucket[node]; e < first_edge[node + 1]; i++, e++) {
+                        G.setEdgeTarget(e, targets[i]);
+                        G.setEdgeWeight(e, 1);
+                }
+        }
+        G.finish_construction();
+}
+
+}
+
+void graph_generator::grid(graph_access & G, NodeID x, NodeID y, NodeID z) {
+        x = std::max< NodeID >(x, 1);
+        y = std::max< NodeID >(y, 1);
+        z = std::max< NodeID >(z, 1);
+
+        build_graph(G, x * y * z, [&](NodeID node, std::vector< NodeID > & adjacent) {
+                NodeID i = node % x;
+                NodeID j = (node / x) % y;
+                NodeID k = node / (x * y);
+                if( k > 0 )     adjacent.push_back(node - x * y);
+                if( j > 0 )     adjacent.push_back(node - x);
+                if( i > 0 )     adjacent.push_back(node - 1);
+                if( i + 1 < x ) adjacent.push_back(node + 1);
+                if( j + 1 < y ) adjacent.push_back(node + x);
+                if( k + 1 < z ) adjacent.push_back(node + x * y);
+        });
+}
+
+void graph_generator::triangulated_grid(graph_access & G, NodeID x, NodeID y) {
+        x = std::max< NodeID >(x, 1);
+        y = std::max< NodeID >(y, 1);
+
+        build_graph(G, x * y, [&](NodeID node, std::vector< NodeID > & adjacent) {
+                NodeID i = node % x;
+                NodeID j = node / x;
+                if( i > 0 && j > 0 )         adjacent.push_back(node - x - 1);
+                if( j > 0 )                  adjacent.push_back(node - x);
+                if( i > 0 )                  adjacent.push_back(node - 1);
+                if( i + 1 < x )              adjacent.push_back(node + 1);
+                if( j + 1 < y )              adjacent.push_back(node + x);
+                if( i + 1 < x && j + 1 < y ) adjacent.push_back(node + x + 1);
+        });
+}
+
+void graph_generator::random_geometric(graph_access & G, NodeID n, double radius, int dimension, int seed) {
+        dimension = dimension == 3 ? 3 : 2;
+
+        // cells have a side length of at least radius, thus only adjacent cells have to
+        // be searched. there are at most n cells.
+        double max_cells_per_dim = floor(pow(std::max< NodeID >(n, 1), 1.0 / dimension) + 1e-9);
+        NodeID cells_per_dim     = std::max(1.0, std::min(floor(1 / radius), max_cells_per_dim));
+        uint64_t cells           = dimension == 3 ? (uint64_t)cells_per_dim * cells_per_dim * cells_per_dim
+                                                  : (uint64_t)cells_per_dim * cells_per_dim;
+
+        std::vector< NodeID > cell_start = cell_starts(random_key(seed, 1, dimension), cells, n);
+        std::vector< double > coordinate(dimension * (std::size_t)n);
+        std::vector< NodeID > node_cell(n);
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for( uint64_t cell = 0; cell < cells; cell++) {
+                counter_rng rng(random_key(seed, 2, cell));
+                uint64_t cell_coordinate[3] = {cell % cells_per_dim,
+                                               (cell / cells_per_dim) % cells_per_dim,
+                                               cell / ((uint64_t)cells_per_dim * cells_per_dim)};
+                for( NodeID node = cell_start[cell]; node < cell_start[cell + 1]; node++) {
+                        for( int d = 0; d < dimension; d++) {
+                                coordinate[dimension * (std::size_t)node + d] = (cell_coordinate[d] + rng.uniform()) / cells_per_dim;
+                        }
+                        node_cell[node] = cell;
+                }
+        }
+
+        double squared_radius = radius * radius;
+        int z_range = dimension == 3 ? 1 : 0;
+        build_graph(G, n, [&](NodeID node, std::vector< NodeID > & adjacent) {
+                uint64_t cell = node_cell[node];
+                long cx = cell % cells_per_dim;
+                long cy = (cell / cells_per_dim) % cells_per_dim;
+                long cz = cell / ((uint64_t)cells_per_dim * cells_per_dim);
+                const double * p = &coordinate[dimension * (std::size_t)node];
+
+                for( long dz = -z_range; dz <= z_range; dz++) {
+                        for( long dy = -1; dy <= 1; dy++) {
+                                for( long dx = -1; dx <= 1; dx++) {
+                                        long x = cx + dx, y = cy + dy, z = cz + dz;
+                                        if( x < 0 || y < 0 || z < 0 || x >= (long)cells_per_dim
+                                         || y >= (long)cells_per_dim || z >= (long)cells_per_dim ) continue;
+
+                                        uint64_t neighbor_cell = ((uint64_t)z * cells_per_dim + y) * cells_per_dim + x;
+                                        for( NodeID target = cell_start[neighbor_cell]; target < cell_start[neighbor_cell + 1]; target++) {
+                                                if( target == node ) continue;
+                                                const double * q = &coordinate[dimension * (std::size_t)target];
+                                                double distance = 0;
+                                                for( int d = 0; d < dimension; d++) {
+                                                        distance += (p[d] - q[d]) * (p[d] - q[d]);
+                                                }
+                                                if( distance <= squared_radius ) adjacent.push_back(target);
+                                        }
+                                }
+                        }
+                }
+        });
+}
+
+void graph_generator::rmat(graph_access & G, int log_n, double edge_factor,
+                           double a, double b, double c, int seed) {
+        log_n = std::max(1, std::min(31, log_n));
+        NodeID n         = (NodeID)1 << log_n;
+        uint64_t samples = std::max(0.0, edge_factor) * n;
+
+        // every chunk of samples has its own random numbers
+        const uint64_t chunk_size = 1 << 16;
+        uint64_t chunks = (samples + chunk_size - 1) / chunk_size;
+        std::vector< std::pair< NodeID, NodeID > > edges(samples);
+
+        #pragma omp parallel for schedule(dynamic)
+        for( uint64_t chunk = 0; chunk < chunks; chunk++) {
+                counter_rng rng(random_key(seed, 3, chunk));
+                for( uint64_t i = chunk * chunk_size; i < std::min(samples, (chunk + 1) * chunk_size); i++) {
+                        NodeID source = 0, target = 0;
+                        for( int bit = 0; bit < log_n; bit++) {
+                                double r = rng.uniform();
+                                if( r < a ) continue;
+                                if( r < a + b ) {
+                                        target |= (NodeID)1 << bit;
+                                } else if( r < a + b + c ) {
+                                        source |= (NodeID)1 << bit;
+                                } else {
+                                        source |= (NodeID)1 << bit;
+                                        target |= (NodeID)1 << bit;
+                                }
+                        }
+                        edges[i] = std::make_pair(source, target);
+                }
+        }
+
+        build_graph(G, n, edges);
+}
+
+void graph_generator::barabasi_albert(graph_access & G, NodeID n, NodeID min_degree, int seed) {
+        min_degree = std::max< NodeID >(min_degree, 1);
+
+        // Batagelj and Brandes: the edge list M has the entries M[2i] = i / min_degree and
+        // M[2i+1] = M[r] for a random r <= 2i. following r until it is even resolves an
+        // entry without the preceding ones, so all edges can be generated independently.
+        std::vector< std::pair< NodeID, NodeID > > edges((std::size_t)n * min_degree);
+        #pragma omp parallel for schedule(static)
+        for( NodeID node = 0; node < n; node++) {
+                for( NodeID i = 0; i < min_degree; i++) {
+                        uint64_t position = 2 * ((uint64_t)node * min_degree + i) + 1;
+                        do {
+                                position = random_key(seed, 4, position) % position;
+                        } while( position % 2 == 1 );
+
+                        edges[(std::size_t)node * min_degree + i] = std::make_pair(node, (NodeID)(position / 2 / min_degree));
+                }
+        }
+
+        build_graph(G, n, edges);
+}
+
+void graph_generator::random_hyperbolic(graph_access & G, NodeID n, double avg_degree, double gamma, int seed) {
+        // points in a disk of radius R, the radial density alpha sinh(alpha r) / (cosh(alpha R) - 1)
+        // gives the power law exponent gamma = 2 alpha + 1 and R the expected average degree
+        const double alpha  = std::max(0.51, (gamma - 1) / 2);
+        const double xi     = alpha / (alpha - 0.5);
+        const double R      = std::max(1e-3, 2 * log(2 * xi * xi * n / (M_PI * std::max(avg_degree, 1e-3))));
+        const double cosh_R = cosh(R);
+        const double norm   = cosh(alpha * R) - 1;
+        auto cdf = [&](double r) { return (cosh(alpha * r) - 1) / norm; };
+
+        // radial bands of width ln(2) / alpha, each band is cut into angular sectors
+        // with about eight points, nodes are numbered by band, sector and angle
+        const unsigned bands = std::max(1, (int)ceil(alpha * R / log(2)));
+        std::vector< double > band_radius(bands + 1), band_cosh(bands + 1), band_sinh(bands + 1);
+        for( unsigned b = 0; b <= bands; b++) {
+                band_radius[b] = R * b / bands;
+                band_cosh[b]   = cosh(band_radius[b]);
+                band_sinh[b]   = sinh(band_radius[b]);
+        }
+
+        std::vector< NodeID > band_count(bands);
+        NodeID remaining        = n;
+        double remaining_mass   = 1;
+        for( unsigned b = 0; b < bands; b++) {
+                double mass = cdf(band_radius[b + 1]) - cdf(band_radius[b]);
+                counter_rng rng(random_key(seed, 5, b));
+                band_count[b]   = b + 1 == bands ? remaining : binomial(rng, remaining, mass / remaining_mass);
+                remaining      -= band_count[b];
+                remaining_mass -= mass;
+        }
+
+        std::vector< NodeID > sectors(bands);
+        std::vector< NodeID > band_first_sector(bands + 1, 0);
+        for( unsigned b = 0; b < bands; b++) {
+                sectors[b]               = std::max< NodeID >(1, band_count[b] / 8);
+                band_first_sector[b + 1] = band_first_sector[b] + sectors[b];
+        }
+
+        // sector_start[band_first_sector[b] + s] is the first node of sector s in band b
+        std::vector< NodeID > sector_start(band_first_sector[bands] + 1, 0);
+        NodeID band_start = 0;
+        for( unsigned b = 0; b < bands; b++) {
+                std::vector< NodeID > start = cell_starts(random_key(seed, 6, b), sectors[b], band_count[b]);
+                for( NodeID s = 0; s < sectors[b]; s++) {
+                        sector_start[band_first_sector[b] + s] = band_start + start[s];
+                }
+                band_start += band_count[b];
+        }
+        sector_start[band_first_sector[bands]] = n;
+
+        std::vector< double > theta(n), cosh_r(n), sinh_r(n);
+        #pragma omp parallel
+        {
+                std::vector< std::pair< double, double > > points;
+                #pragma omp for schedule(dynamic, 64)
+                for( NodeID sector = 0; sector < band_first_sector[bands]; sector++) {
+                        unsigned b = std::upper_bound(band_first_sector.begin(), band_first_sector.end(), sector)
+                                     - band_first_sector.begin() - 1;
+                        NodeID s   = sector - band_first_sector[b];
+                        double cdf_low  = cdf(band_radius[b]);
+                        double cdf_high = cdf(band_radius[b + 1]);
+
+                        counter_rng rng(random_key(seed, 7, sector));
+                        points.clear();
+                        for( NodeID node = sector_start[sector]; node < sector_start[sector + 1]; node++) {
+                                double angle  = 2 * M_PI * (s + rng.uniform()) / sectors[b];
+                                double u      = cdf_low + rng.uniform() * (cdf_high - cdf_low);
+                                double radius = std::min(R, acosh(1 + u * norm) / alpha);
+                                points.push_back(std::make_pair(angle, radius));
+                        }
+                        std::sort(points.begin(), points.end());
+
+                        NodeID node = sector_start[sector];
+                        for( auto & point : points ) {
+                                theta[node]  = point.first;
+                                cosh_r[node] = cosh(point.second);
+                                sinh_r[node] = sinh(point.second);
+                                node++;
+                        }
+                }
+        }
+
+        build_graph(G, n, [&](NodeID node, std::vector< NodeID > & adjacent) {
+                for( unsigned b = 0; b < bands; b++) {
+                        // largest angular distance to a neighbor in band b, the bound is taken at
+                        // the inner radius of the band since it decreases with the radius
+                        double delta = M_PI;
+                        if( b > 0 && sinh_r[node] > 0 ) {
+                                double arg = (cosh_r[node] * band_cosh[b] - cosh_R) / (sinh_r[node] * band_sinh[b]);
+                                if( arg >= 1 )       delta = 0;
+                                else if( arg > -1 )  delta = acos(arg);
+                        }
+                        delta += 1e-9;
+
+                        long first = 0, last = (long)sectors[b] - 1;
+                        if( delta < M_PI ) {
+                                first = floor((theta[node] - delta) * sectors[b] / (2 * M_PI));
+                                last  = floor((theta[node] + delta) * sectors[b] / (2 * M_PI));
+                                if( last - first + 1 >= (long)sectors[b] ) {
+                                        first = 0;
+                                        last  = (long)sectors[b] - 1;
+                                }
+                        }
+
+                        for( long s = first; s <= last; s++) {
+                                NodeID sector = band_first_sector[b] + ((s % (long)sectors[b]) + sectors[b]) % sectors[b];
+                                for( NodeID target = sector_start[sector]; target < sector_start[sector + 1]; target++) {
+                                        if( target == node ) continue;
+                                        double cosh_distance = cosh_r[node] * cosh_r[target]
+                                                             - sinh_r[node] * sinh_r[target] * cos(fabs(theta[node] - theta[target]));
+                                        if( cosh_distance <= cosh_R ) adjacent.push_back(target);
+                                }
+                        }
+                }
+        });
+}
+
+bool graph_generator::generate(graph_access & G, const std::string & type, NodeID n, double avg_degree, int seed) {
+        n = std::max< NodeID >(n, 1);
+        if( type == "grid2d" ) {
+                NodeID side = std::max(1.0, round(sqrt(n)));
+                grid(G, side, side);
+        } else if( type == "grid3d" ) {
+                NodeID side = std::max(1.0, round(cbrt(n)));
+                grid(G, side, side, side);
+        } else if( type == "rgg2d" ) {
+                random_geometric(G, n, sqrt(avg_degree / (M_PI * n)), 2, seed);
+        } else if( type == "rgg3d" ) {
+                random_geometric(G, n, cbrt(3 * avg_degree / (4 * M_PI * n)), 3, seed);
+        } else if( type == "rmat" ) {
+                rmat(G, (int)round(log2(n)), avg_degree / 2, 0.57, 0.19, 0.19, seed);
+        } else if( type == "ba" ) {
+                barabasi_albert(G, n, std::max(1.0, round(avg_degree / 2)), seed);
+        } else if( type == "rhg" ) {
+                random_hyperbolic(G, n, avg_degree, 3.0, seed);
+        } else {
+                return false;
+        }
+        return true;
+}
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * graph_generator.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef GRAPH_GENERATOR_H8QZ3WLE
+#define GRAPH_GENERATOR_H8QZ3WLE
+
+#include <string>
+
+#include "definitions.h"
+#include "data_structure/graph_access.h"
+
+// Generates graphs directly in memory. All generators run in parallel and
+// draw their random numbers from counters (seed, position), hence the graph
+// only depends on the seed and not on the number of threads. Nodes and edges
+// have unit weights, self loops and parallel edges are removed.
+class graph_generator {
+        public:
+                graph_generator();
+                virtual ~graph_generator();
+
+                // x times y times z grid, every node is connected to its axis neighbors
+                static void grid(graph_access & G, NodeID x, NodeID y, NodeID z = 1);
+
+                // x times y grid in which every square is split by a diagonal, i.e. a
+                // Delaunay triangulation of the lattice
+                static void triangulated_grid(graph_access & G, NodeID x, NodeID y);
+
+                // n points in the unit square (dimension 2) or unit cube (dimension 3),
+                // points within the given radius are connected
+                static void random_geometric(graph_access & G, NodeID n, double radius, int dimension, int seed);
+
+                // 2^log_n nodes and edge_factor * 2^log_n sampled edges with the recursive
+                // quadrant probabilities a, b, c (and 1-a-b-c), the Graph 500 Kronecker
+                // generator uses a = 0.57 and b = c = 0.19
+                static void rmat(graph_access & G, int log_n, double edge_factor,
+                                 double a, double b, double c, int seed);
+
+                // preferential attachment, every node attaches to min_degree earlier nodes
+                static void barabasi_albert(graph_access & G, NodeID n, NodeID min_degree, int seed);
+
+                // threshold random hyperbolic graph with power law exponent gamma > 2
+                static void random_hyperbolic(graph_access & G, NodeID n, double avg_degree, double gamma, int seed);
+
+                // generator given by name (grid2d, grid3d, rgg2d, rgg3d, rmat, ba, rhg) with
+                // about n nodes, the other parameters are chosen to match the average degree
+                static bool generate(graph_access & G, const std::string & type, NodeID n, double avg_degree, int seed);
+};
+
+#endif /* end of include guard: GRAPH_GENERATOR_H8QZ3WLE */
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * graph_generator_random.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef GRAPH_GENERATOR_RANDOM_K3VQ8ZTW
+#define GRAPH_GENERATOR_RANDOM_K3VQ8ZTW
+
+#include <algorithm>
+#include <random>
+#include <stdint.h>
+
+// Random numbers of graph_generator and of parallel_graph_generator in ParHIP. Both
+// draw from these counters, so they build the same graph for the same parameters.
+namespace graph_generator_random {
+
+inline uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+}
+
+// the random numbers of an item (a cell, a chunk of edges, ...) only depend on the
+// seed, the kind of the item and its position
+inline uint64_t random_key(int seed, uint64_t kind, uint64_t a, uint64_t b = 0) {
+        return mix(mix(mix((uint64_t)seed + 0x9e3779b97f4a7c15ULL * (kind + 1)) ^ a) + b);
+}
+
+// splitmix64, can be used with the distributions of <random>
+struct counter_rng {
+        typedef uint64_t result_type;
+
+        explicit counter_rng(uint64_t key) : state(key) {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return ~0ULL; }
+
+        result_type operator()() {
+                state += 0x9e3779b97f4a7c15ULL;
+                return mix(state);
+        }
+
+        // uniform in [0,1)
+        double uniform() {
+                return ((*this)() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        uint64_t state;
+};
+
+inline uint64_t binomial(counter_rng & rng, uint64_t trials, double p) {
+        if( trials == 0 || p <= 0 ) return 0;
+        if( p >= 1 ) return trials;
+
+        std::binomial_distribution< uint64_t > distribution(trials, p);
+        return std::min(trials, distribution(rng));
+}
+
+}
+
+#endif /* end of include guard: GRAPH_GENERATOR_RANDOM_K3VQ8ZTW */
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <cctype>
 #include <cstring>
 #include <fcntl.h>
 #include <fstream>
+#include <omp.h>
 #include <sys/mman.h>
+#include <vector>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -146,8 +149,8 @@ void graph_from_metis_file(graph_access &G, const std::string &filename) {
 
     G.setNodeWeight(u, header.has_node_weights ? scan_uint(mapped_file) : 1);
     while (std::isdigit(mapped_file.current())) {
-      const EdgeWeight weight = (header.has_edge_weights) ? scan_uint(mapped_file) : 1;
       const EdgeID e = G.new_edge(u, scan_uint(mapped_file) - 1);
+      const EdgeWeight weight = (header.has_edge_weights) ? scan_uint(mapped_file) : 1;
       G.setEdgeWeight(e, weight);
     }
     if (mapped_file.current() == '\n') {
@@ -157,5 +160,76 @@ void graph_from_metis_file(graph_access &G, const std::string &filename) {
   G.finish_construction();
   munmap_file_from_disk(mapped_file);
 }
+
+// Reads a partition file (one block id per line, lines starting with % are
+// skipped) and sets the partition count to the largest block id + 1.
+// The file is cut into one chunk per thread at line boundaries; every chunk
+// first counts its lines and then parses them in parallel.
+inline void partition_from_file(graph_access &G, const std::string &filename) {
+  MappedFile mapped_file = mmap_file_from_disk(filename);
+  const char *contents = mapped_file.contents;
+  const std::size_t length = mapped_file.length;
+  const NodeID n = G.number_of_nodes();
+
+  const int num_chunks = omp_get_max_threads();
+  std::vector<std::size_t> chunk_begin(num_chunks + 1, length);
+  chunk_begin[0] = 0;
+  for (int c = 1; c < num_chunks; ++c) {
+    std::size_t position = std::max(chunk_begin[c - 1], length / num_chunks * c);
+    while (position < length && position > 0 && contents[position - 1] != '\n') {
+      ++position;
+    }
+    chunk_begin[c] = position;
+  }
+
+  std::vector<NodeID> lines_before(num_chunks + 1, 0);
+#pragma omp parallel for schedule(static, 1)
+  for (int c = 0; c < num_chunks; ++c) {
+    NodeID lines = 0;
+    for (std::size_t position = chunk_begin[c]; position < chunk_begin[c + 1]; ++position) {
+      if (contents[position] != '%') ++lines;
+      while (position < chunk_begin[c + 1] && contents[position] != '\n') ++position;
+    }
+    lines_before[c + 1] = lines;
+  }
+  for (int c = 0; c < num_chunks; ++c) {
+    lines_before[c + 1] += lines_before[c];
+  }
+
+  if (lines_before[num_chunks] < n) {
+    munmap_file_from_disk(mapped_file);
+    std::cerr << "Error: partition file " << filename << " has fewer lines than the graph has nodes" << std::endl;
+    std::exit(-1);
+  }
+
+  PartitionID max_block = 0;
+#pragma omp parallel for schedule(static, 1) reduction(max : max_block)
+  for (int c = 0; c < num_chunks; ++c) {
+    NodeID node = lines_before[c];
+    std::size_t position = chunk_begin[c];
+    while (position < chunk_begin[c + 1] && node < n) {
+      if (contents[position] == '%') {
+        while (position < chunk_begin[c + 1] && contents[position] != '\n') ++position;
+        ++position;
+        continue;
+      }
+
+      while (position < chunk_begin[c + 1] && contents[position] == ' ') ++position;
+      PartitionID block = 0;
+      while (position < chunk_begin[c + 1] && std::isdigit(contents[position])) {
+        block = block * 10 + (contents[position] - '0');
+        ++position;
+      }
+      while (position < chunk_begin[c + 1] && contents[position] != '\n') ++position;
+      ++position;
+
+      G.setPartitionIndex(node++, block);
+      max_block = std::max(max_block, block);
+    }
+  }
+
+  G.set_partition_count(max_block + 1);
+  munmap_file_from_disk(mapped_file);
+}
 } // namespace mmap_io
 } // namespace kahip
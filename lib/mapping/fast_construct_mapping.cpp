@@ -14,6 +14,7 @@
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "fast_construct_mapping.h"
 #include "tools/graph_extractor.h"
+#include "tools/parallel_tools.h"
 
 fast_construct_mapping::fast_construct_mapping() {
 
@@ -100,16 +101,23 @@ void fast_construct_mapping::construct_initial_mapping_topdown_internal( Partiti
         } else {
                 // extract subgraphs and recurse on them
                 group_sizes.pop_back();
+                graph_extractor ge;
+                std::vector< graph_access* > extracted_blocks;
+                std::vector< std::vector<NodeID> > mappings;
+                ge.extract_all_blocks( C, extracted_blocks, mappings, parallel_tools::max_threads(config.enable_omp));
+
                 for( PartitionID block = 0; block < num_parts; block++) {
-                        graph_extractor ge; graph_access Q;
-                        std::vector<NodeID> mapping;
-                        ge.extract_block( C, Q, block, mapping);
+                        graph_access & Q = *extracted_blocks[block];
+                        std::vector<NodeID> & mapping = mappings[block];
 
                         forall_nodes(Q, node) {
                                 mapping[node] = map_to_original[mapping[node]];
                         } endfor
 
                         construct_initial_mapping_topdown_internal( config, Q, group_sizes, count[block], mapping, perm_rank);
+
+                        delete extracted_blocks[block];
+                        std::vector<NodeID>().swap(mapping);
                 }
         }
 }
@@ -16,6 +16,7 @@
 #include "partition/uncoarsening/separator/vertex_separator_algorithm.h"
 #include "tools/graph_extractor.h"
 #include "tools/macros_assertions.h"
+#include "tools/parallel_tools.h"
 #include "tools/quality_metrics.h"
 
 nested_dissection::nested_dissection(graph_access * const G) :
@@ -52,14 +53,21 @@ void nested_dissection::perform_nested_dissection(PartitionConfig &config) {
                         // continue nested dissection
                         compute_separator(config, *active_graph);
 
+                        // extract all subgraphs at once, each one is deleted after its recursion
+                        std::vector<graph_access*> subgraphs;
+                        std::vector<std::vector<NodeID>> mappings;
+                        graph_extractor extractor;
+                        extractor.extract_all_blocks(*active_graph, subgraphs, mappings, parallel_tools::max_threads(config.enable_omp));
+
                         // perform nested dissection on subgraphs
+                        PartitionID separator_block = active_graph->getSeparatorBlock();
                         forall_blocks((*active_graph), p) {
-                                if (p != active_graph->getSeparatorBlock()) {
-                                        recurse_dissection(config, (*active_graph), p, order_begin);
+                                if (p != separator_block) {
+                                        recurse_dissection(config, subgraphs[p], mappings[p], order_begin);
                                 }
                         } endfor
                         // Perform nested dissection on separator block
-                        recurse_dissection(config, (*active_graph), active_graph->getSeparatorBlock(), order_begin);
+                        recurse_dissection(config, subgraphs[separator_block], mappings[separator_block], order_begin);
                 }
         }
 
@@ -90,19 +98,17 @@ void nested_dissection::compute_separator(PartitionConfig &config, graph_access
         partitioner.perform_partitioning(config, G);
 }
 
-void nested_dissection::recurse_dissection(PartitionConfig &config, graph_access &G, PartitionID block, NodeID &order_begin) {
-        std::vector<NodeID> mapping;
-        graph_extractor extractor;
-        graph_access subgraph;
-        extractor.extract_block(G, subgraph, block, mapping);
-        nested_dissection dissection(&subgraph, m_recursion_level + 1);
+void nested_dissection::recurse_dissection(PartitionConfig &config, graph_access *subgraph, std::vector<NodeID> &mapping, NodeID &order_begin) {
+        nested_dissection dissection(subgraph, m_recursion_level + 1);
         dissection.perform_nested_dissection(config);
+        delete subgraph;
 
         // Transfer labels from the subgraph to the reduced graph
         for (size_t i = 0; i < mapping.size(); ++i) {
                 m_reduced_label[mapping[i]] = dissection.m_label[i] + order_begin;
         }
         order_begin += mapping.size();
+        std::vector<NodeID>().swap(mapping);
 }
 
 const std::vector<NodeID>& nested_dissection::ordering() const {
@@ -46,9 +46,10 @@ private:
         // Compute a separator of the graph G
         void compute_separator(PartitionConfig &config, graph_access &G);
 
-        // Apply nested dissection to the subgraph of G induced by the partition with ID block
+        // Apply nested dissection to an extracted subgraph, mapping maps its nodes to the nodes of the parent graph.
+        // The subgraph is deleted and the mapping is released afterwards
         // new labels start at order_begin, which is updated to the value past the new largest label
-        void recurse_dissection(PartitionConfig &config, graph_access &G, PartitionID block, NodeID &order_begin);
+        void recurse_dissection(PartitionConfig &config, graph_access *subgraph, std::vector<NodeID> &mapping, NodeID &order_begin);
 
 };
 
@@ -6,6 +6,7 @@
 #include <cmath>
 #include <functional>
 #include <memory>
+#include <omp.h>
 #include <queue>
 #include <unordered_set>
 #include <utility>
@@ -14,68 +15,110 @@
 #include "node_ordering/ordering_tools.h"
 #include "node_ordering/reductions.h"
 #include "tools/macros_assertions.h"
+#include "tools/parallel_tools.h"
 #include "tools/timer.h"
 
 #include "io/graph_io.h"
 
+// Sums up the weights of the edges in [begin, end) with the same target and returns the end of the merged edges.
+// The merged edges keep the order of the first edge to each target, i.e. the order in which a sequential
+// construction adds them. 'order' is scratch memory.
+static std::vector<std::pair<NodeID, EdgeWeight>>::iterator merge_parallel_edges(std::vector<std::pair<NodeID, EdgeWeight>>::iterator begin,
+                                                                                  std::vector<std::pair<NodeID, EdgeWeight>>::iterator end,
+                                                                                  std::vector<std::pair<NodeID, EdgeID>> &order) {
+        order.clear();
+        for (auto it = begin; it != end; ++it) {
+                order.push_back({it->first, it - begin});
+        }
+        std::sort(order.begin(), order.end());
+
+        // Add later edges to the first edge with the same target and mark them as merged
+        for (size_t i = 1; i < order.size(); ++i) {
+                if (order[i].first == order[i - 1].first) {
+                        auto first = begin + order[i - 1].second;
+                        auto merged = begin + order[i].second;
+                        first->second += merged->second;
+                        merged->first = UNASSIGNED;
+                        order[i].second = order[i - 1].second;
+                }
+        }
+        return std::remove_if(begin, end, [](const std::pair<NodeID, EdgeWeight> &edge) {
+                return edge.first == UNASSIGNED;
+        });
+}
+
 /******************************/
 /* NODE CONTRACTION FUNCTIONS */
 /******************************/
 
 // Input:
 //  - 'graph_before':           the graph before contraction
-//  - 'node_groups':            the groups of nodes to be contracted
+//  - 'group_start',
+//    'group_nodes':            the groups of nodes to be contracted, group x consists of
+//                              group_nodes[group_start[x]], ..., group_nodes[group_start[x+1]-1]
 //
-// Outputs:
-//  - 'graph_after':            the graph after contraction
-//  - 'mapping':                mapping from nodes in 'graph_after' to nodes in 'graph_before'
+// Output:
+//  - 'graph_after':            the graph after contraction, node x of 'graph_after' replaces group x
 void contract_nodes(graph_access &graph_before, graph_access &graph_after,
-                    const std::vector<std::vector<NodeID>> &node_groups,
-                    std::unordered_map<NodeID, std::vector<NodeID>> &mapping) {
-        graph_after.start_construction(node_groups.size(), graph_before.number_of_edges());
+                    const std::vector<NodeID> &group_start,
+                    const std::vector<NodeID> &group_nodes) {
+        const NodeID num_groups = group_start.size() - 1;
 
+        // The edges of a group are collected at 'raw_start[group]', the sum of the degrees of its nodes
         std::vector<NodeID> reverse_map(graph_before.number_of_nodes(), 0);
-        for (const auto &group: node_groups) {
-                auto new_node_id = graph_after.new_node();
-                NodeWeight weight = 0;
-                NodeWeight offset = 0;
-                for (auto old_node_id: group) {
-                        reverse_map[old_node_id] = new_node_id;
-                        weight += graph_before.getNodeWeight(old_node_id);
-                        offset += graph_before.get_contraction_offset(old_node_id);
+        std::vector<EdgeID> raw_start(num_groups + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID group = 0; group < num_groups; ++group) {
+                for (NodeID i = group_start[group]; i < group_start[group + 1]; ++i) {
+                        reverse_map[group_nodes[i]] = group;
+                        raw_start[group] += graph_before.getNodeDegree(group_nodes[i]);
                 }
-                graph_after.setNodeWeight(new_node_id, weight);
-                graph_after.set_contraction_offset(new_node_id, offset);
-                mapping.insert({new_node_id, group});
         }
-
-        std::vector<NodeID> visited_by(graph_before.number_of_nodes(), -1); // assuming that there are less than 2^32-1 nodes
-        std::vector<EdgeID> target_edges(graph_before.number_of_nodes(), -1); // new_edge_ids for a target
-        for (NodeID contracted_node_id = 0; contracted_node_id < node_groups.size(); ++contracted_node_id) {
-                const auto &group = node_groups[contracted_node_id];
-                // All out-edges from each node in the group are potential edges in the reduced graph
-                for (auto node: group) {
-                        forall_out_edges(graph_before, edge, node) {
-                                auto target = graph_before.getEdgeTarget(edge);
-                                // don't add edges between contracted nodes
-                                if (reverse_map[target] != contracted_node_id) {
-                                        if (visited_by[reverse_map[target]] != contracted_node_id) {
-                                                // this edge hasn't been added yet
-                                                auto new_edge_id = graph_after.new_edge(contracted_node_id, reverse_map[target]);
-                                                target_edges[reverse_map[target]] = new_edge_id;
-                                                graph_after.setEdgeWeight(new_edge_id, graph_before.getEdgeWeight(edge));
-                                                visited_by[reverse_map[target]] = contracted_node_id;
-                                        } else {
-                                                // add to the edge weight of an existing edge
-                                                auto edge_id = target_edges[reverse_map[target]];
-                                                auto current_edge_weight = graph_after.getEdgeWeight(edge_id);
-                                                graph_after.setEdgeWeight(edge_id, current_edge_weight + graph_before.getEdgeWeight(edge));
+        parallel_tools::prefix_sum(raw_start);
+
+        // Edges between contracted nodes are dropped, parallel edges are merged
+        std::vector<std::pair<NodeID, EdgeWeight>> raw_edges(raw_start[num_groups]);
+        std::vector<EdgeID> first_edge(num_groups + 1, 0);
+        #pragma omp parallel
+        {
+                std::vector<std::pair<NodeID, EdgeID>> order;
+                #pragma omp for schedule(dynamic, 1024)
+                for (NodeID group = 0; group < num_groups; ++group) {
+                        auto begin = raw_edges.begin() + raw_start[group];
+                        auto last = begin;
+                        for (NodeID i = group_start[group]; i < group_start[group + 1]; ++i) {
+                                forall_out_edges(graph_before, edge, group_nodes[i]) {
+                                        auto target = reverse_map[graph_before.getEdgeTarget(edge)];
+                                        if (target != group) {
+                                                *last = {target, graph_before.getEdgeWeight(edge)};
+                                                ++last;
                                         }
-                                }
-                        } endfor
+                                } endfor
+                        }
+                        first_edge[group] = merge_parallel_edges(begin, last, order) - begin;
                 }
         }
+        parallel_tools::prefix_sum(first_edge);
 
+        graph_after.start_bulk_construction(num_groups, first_edge[num_groups]);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID group = 0; group < num_groups; ++group) {
+                NodeWeight weight = 0;
+                NodeWeight offset = 0;
+                for (NodeID i = group_start[group]; i < group_start[group + 1]; ++i) {
+                        weight += graph_before.getNodeWeight(group_nodes[i]);
+                        offset += graph_before.get_contraction_offset(group_nodes[i]);
+                }
+                graph_after.setFirstEdge(group, first_edge[group]);
+                graph_after.setNodeWeight(group, weight);
+                graph_after.set_contraction_offset(group, offset);
+
+                auto raw_edge = raw_edges.begin() + raw_start[group];
+                for (EdgeID e = first_edge[group]; e < first_edge[group + 1]; ++e, ++raw_edge) {
+                        graph_after.setEdgeTarget(e, raw_edge->first);
+                        graph_after.setEdgeWeight(e, raw_edge->second);
+                }
+        }
         graph_after.finish_construction();
 }
 
@@ -89,7 +132,7 @@ void contract_nodes(graph_access &graph_before, graph_access &graph_after,
 // actual_degree:       degree of 'node', ignoring removed nodes
 // labels:              vector to count neighbors
 // removed:             mark simplicial nodes as removed
-bool clique_test(graph_access &G, NodeID node, Gain actual_degree, std::vector<short> &labels, const std::vector<bool> &removed) {
+bool clique_test(graph_access &G, NodeID node, Gain actual_degree, std::vector<short> &labels, const std::vector<char> &removed) {
         // To test if 'node' is simplicial, we iterate through its neighbors.
         // In each iteration, we
         //  - mark the currently visited node
@@ -206,20 +249,35 @@ private:
                 buckets[bucket].pop_back();
         }
 };
-
 void SimplicialNodeReduction::apply() {
+        // The simplicial nodes are removed in the order of the degree queue, the following reductions
+        // depend on this numbering. The clique tests of all candidates run in parallel up front. A test
+        // only depends on the removed neighbors of a node, so its result is used as long as the degree
+        // of the node is unchanged. Nodes that lost a neighbor are tested again when they leave the queue.
+        const NodeID n = graph_before.number_of_nodes();
         bucket_sorter degree_queue(graph_before, degree_limit);
 
-        graph_after.start_construction(graph_before.number_of_nodes(), graph_before.number_of_edges());
+        std::vector<char> remove(n, false);
+        std::vector<char> simplicial(n, false);
+        #pragma omp parallel
+        {
+                std::vector<short> labels(n, 0);
+                #pragma omp for schedule(dynamic, 1024)
+                for (NodeID node = 0; node < n; ++node) {
+                        Count degree = graph_before.getNodeDegree(node);
+                        if (degree > 1 && degree <= degree_limit) {
+                                simplicial[node] = clique_test(graph_before, node, degree, labels, remove);
+                        }
+                }
+        }
 
-        // mapping from nodes of graph_before to nodes of graph_after
-        std::vector<NodeID> reverse_mapping(graph_before.number_of_nodes(), 0);
-        std::vector<bool> remove(graph_before.number_of_nodes(), false);
-        std::vector<short> test_labels(graph_before.number_of_nodes(), 0);
+        std::vector<short> test_labels(n, 0);
         while (degree_queue.size() > 0) {
                 auto current_degree = degree_queue.minValue();
                 NodeID node_to_test = degree_queue.deleteMin();
-                if (current_degree <= 1 || clique_test(graph_before, node_to_test, current_degree, test_labels, remove)) {
+                bool unchanged = current_degree == (Count)graph_before.getNodeDegree(node_to_test);
+                if (current_degree <= 1 ||
+                    (unchanged ? simplicial[node_to_test] : clique_test(graph_before, node_to_test, current_degree, test_labels, remove))) {
                         remove[node_to_test] = true;
                         label_first.push_back(node_to_test);
 
@@ -235,27 +293,49 @@ void SimplicialNodeReduction::apply() {
                 }
         }
 
-        forall_nodes(graph_before, node) {
-                if (!remove[node]) {
-                        auto new_node_id = graph_after.new_node();
-                        graph_after.setNodeWeight(new_node_id, graph_before.getNodeWeight(node));
-                        graph_after.set_contraction_offset(new_node_id, graph_before.get_contraction_offset(node));
-                        mapping.push_back(node);
-                        reverse_mapping[node] = new_node_id;
+        // mapping from nodes of graph_before to nodes of graph_after
+        std::vector<NodeID> reverse_mapping(n + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for (NodeID node = 0; node < n; ++node) {
+                reverse_mapping[node] = !remove[node];
+        }
+        parallel_tools::prefix_sum(reverse_mapping);
+        const NodeID n_after = reverse_mapping[n];
+
+        mapping.resize(n_after);
+        std::vector<EdgeID> first_edge(n_after + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID node = 0; node < n; ++node) {
+                if (remove[node]) {
+                        continue;
                 }
-        } endfor
-
-        // Copy edges
-        for (NodeID new_node_id = 0; new_node_id < graph_before.number_of_nodes() - label_first.size(); ++new_node_id) {
-                forall_out_edges(graph_before, edge, mapping[new_node_id]) {
+                mapping[reverse_mapping[node]] = node;
+                EdgeID degree_after = 0;
+                forall_out_edges(graph_before, edge, node) {
+                        degree_after += !remove[graph_before.getEdgeTarget(edge)];
+                } endfor
+                first_edge[reverse_mapping[node]] = degree_after;
+        }
+        parallel_tools::prefix_sum(first_edge);
+
+        // Copy nodes and edges
+        graph_after.start_bulk_construction(n_after, first_edge[n_after]);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID new_node_id = 0; new_node_id < n_after; ++new_node_id) {
+                auto node = mapping[new_node_id];
+                graph_after.setFirstEdge(new_node_id, first_edge[new_node_id]);
+                graph_after.setNodeWeight(new_node_id, graph_before.getNodeWeight(node));
+                graph_after.set_contraction_offset(new_node_id, graph_before.get_contraction_offset(node));
+                EdgeID new_edge_id = first_edge[new_node_id];
+                forall_out_edges(graph_before, edge, node) {
                         auto target = graph_before.getEdgeTarget(edge);
                         if (!remove[target]) {
-                                auto new_edge_id = graph_after.new_edge(new_node_id, reverse_mapping[target]);
+                                graph_after.setEdgeTarget(new_edge_id, reverse_mapping[target]);
                                 graph_after.setEdgeWeight(new_edge_id, graph_before.getEdgeWeight(edge));
+                                ++new_edge_id;
                         }
                 } endfor
         }
-
         graph_after.finish_construction();
 }
 
@@ -275,91 +355,191 @@ void SimplicialNodeReduction::map(std::vector<NodeID> &reduced_label, std::vecto
 /* INDISTINGUISHABLE NODES */
 /***************************/
 
+// Mixes the bits of a node id, so sums of neighbor ids rarely collide
+inline size_t node_hash(NodeID node) {
+        uint64_t x = node + 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+}
+
 size_t open_neighborhood_hash(graph_access &graph, NodeID node) {
         size_t result = 0;
         forall_out_edges(graph, edge, node) {
-                result += graph.getEdgeTarget(edge);
+                result += node_hash(graph.getEdgeTarget(edge));
         } endfor
         return result;
 }
 
 size_t closed_neighborhood_hash(graph_access &graph, NodeID node) {
-        return open_neighborhood_hash(graph, node) + node;
+        return open_neighborhood_hash(graph, node) + node_hash(node);
 }
 
-void IndistinguishableNodeReduction::apply() {
-        // Vector of hashes of closed neighborhoods
-        std::vector<size_t> hash_vector;
-        hash_vector.reserve(graph_before.number_of_nodes());
-        forall_nodes(graph_before, node) {
-                hash_vector.push_back(closed_neighborhood_hash(graph_before, node));
+// Store the sorted open or closed neighborhood of 'node' in 'neighborhood'
+void sorted_neighborhood(graph_access &graph, NodeID node, bool closed, std::vector<NodeID> &neighborhood) {
+        neighborhood.clear();
+        forall_out_edges(graph, edge, node) {
+                neighborhood.push_back(graph.getEdgeTarget(edge));
         } endfor
+        if (closed) {
+                neighborhood.push_back(node);
+        }
+        std::sort(neighborhood.begin(), neighborhood.end());
+}
 
-        // Sets of indistinguishable nodes
-        std::vector<std::vector<NodeID>> node_groups;
-        node_groups.reserve(graph_before.number_of_nodes());
-
-        // Label nodes to compare neighborhoods
-        std::vector<short> labels(graph_before.number_of_nodes(), 0);
-
-        // Set to true, if a node has been contracted
-        std::vector<bool> contracted(graph_before.number_of_nodes(), false);
+// Group the nodes that have the same open ('closed' == false) or closed neighborhood and the same adjusted degree.
+// The nodes are sorted by the hashes of their neighborhoods, only nodes with equal hashes are compared.
+// Runs of equal hashes are handled in parallel. The groups are ordered by their smallest node,
+// which is also the first node of its group.
+void group_equal_neighborhoods(graph_access &graph, bool closed,
+                               std::vector<NodeID> &group_start,
+                               std::vector<NodeID> &group_nodes) {
+        const NodeID n = graph.number_of_nodes();
+        std::vector<std::pair<size_t, NodeID>> hash_vector(n);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID node = 0; node < n; ++node) {
+                size_t hash = closed ? closed_neighborhood_hash(graph, node) : open_neighborhood_hash(graph, node);
+                hash_vector[node] = {hash, node};
+        }
+        parallel_tools::sort(hash_vector);
+
+        // 'leader' is the smallest node with the same neighborhood,
+        // 'group_size' is the size of the group for leaders and 0 for all other nodes
+        std::vector<NodeID> leader(n, UNASSIGNED);
+        std::vector<NodeID> group_size(n + 1, 0);
+        std::vector<NodeID> group_id(n + 1, 0);
+        #pragma omp parallel
+        {
+                std::vector<NodeID> neighborhood_a, neighborhood_b;
+                #pragma omp for schedule(dynamic, 1024)
+                for (NodeID first = 0; first < n; ++first) {
+                        // Each run is handled by the iteration of its first element
+                        if (first > 0 && hash_vector[first - 1].first == hash_vector[first].first) {
+                                continue;
+                        }
+                        NodeID end = first + 1;
+                        while (end < n && hash_vector[end].first == hash_vector[first].first) {
+                                end++;
+                        }
+                        for (NodeID a = first; a < end; ++a) {
+                                auto node_a = hash_vector[a].second;
+                                if (leader[node_a] != UNASSIGNED) {
+                                        continue;
+                                }
+                                leader[node_a] = node_a;
+                                group_size[node_a] = 1;
+                                group_id[node_a] = 1;
+                                if (a + 1 == end) {
+                                        break;
+                                }
 
-        // Store adjusted degrees for each node
-        std::vector<NodeWeight> degrees(graph_before.number_of_nodes(), 0);
-        forall_nodes(graph_before, node) {
-                degrees[node] = compute_reachable_set_size(graph_before, node);
-        } endfor
+                                sorted_neighborhood(graph, node_a, closed, neighborhood_a);
+                                auto degree_a = compute_reachable_set_size(graph, node_a);
+                                for (NodeID b = a + 1; b < end; ++b) {
+                                        auto node_b = hash_vector[b].second;
+                                        // node_b has been grouped before
+                                        // or the actual degrees are not equal
+                                        // or the adjusted degrees are not equal
+                                        if (leader[node_b] != UNASSIGNED ||
+                                            graph.getNodeDegree(node_a) != graph.getNodeDegree(node_b) ||
+                                            degree_a != compute_reachable_set_size(graph, node_b)) {
+                                                continue;
+                                        }
+                                        sorted_neighborhood(graph, node_b, closed, neighborhood_b);
+                                        if (neighborhood_a == neighborhood_b) {
+                                                leader[node_b] = node_a;
+                                                group_size[node_a]++;
+                                        }
+                                }
+                        }
+                }
+        }
+        parallel_tools::prefix_sum(group_size);
+        parallel_tools::prefix_sum(group_id);
+
+        const NodeID num_groups = group_id[n];
+        group_start.resize(num_groups + 1);
+        group_nodes.resize(n);
+        #pragma omp parallel for schedule(static)
+        for (NodeID node = 0; node < n; ++node) {
+                if (leader[node] == node) {
+                        group_start[group_id[node]] = group_size[node];
+                }
+        }
+        group_start[num_groups] = n;
 
-        forall_nodes(graph_before, node_a) {
-                if (contracted[node_a]) {
+        // 'group_size' now points to the next free position of each group
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID first = 0; first < n; ++first) {
+                if (first > 0 && hash_vector[first - 1].first == hash_vector[first].first) {
                         continue;
                 }
-                node_groups.push_back({node_a});
-                contracted[node_a] = true;
+                for (NodeID i = first; i < n && hash_vector[i].first == hash_vector[first].first; ++i) {
+                        auto node = hash_vector[i].second;
+                        group_nodes[group_size[leader[node]]++] = node;
+                }
+        }
+}
 
-                forall_out_edges(graph_before, edge, node_a) {
-                        labels[graph_before.getEdgeTarget(edge)] = 1;
-                } endfor
-                labels[node_a] = 1;
-                
-                forall_out_edges(graph_before, edge, node_a) {
-                        auto node_b = graph_before.getEdgeTarget(edge);
-                        // node_b hast been visited before
-                        // or the hashes are not equal
-                        // or the actual degrees are not equal
-                        // or the adjusted degrees are not equal
-                        if (contracted[node_b] ||
-                            hash_vector[node_a] != hash_vector[node_b] ||
-                            graph_before.getNodeDegree(node_a) != graph_before.getNodeDegree(node_b) ||
-                            degrees[node_a] != degrees[node_b]) {
+// Reorders the groups, group i of the result is group order[i] of the input
+void reorder_groups(const std::vector<NodeID> &order,
+                    std::vector<NodeID> &group_start,
+                    std::vector<NodeID> &group_nodes) {
+        const NodeID num_groups = order.size();
+        std::vector<NodeID> new_start(num_groups + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for (NodeID i = 0; i < num_groups; ++i) {
+                new_start[i] = group_start[order[i] + 1] - group_start[order[i]];
+        }
+        parallel_tools::prefix_sum(new_start);
+
+        std::vector<NodeID> new_nodes(group_nodes.size());
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID i = 0; i < num_groups; ++i) {
+                std::copy(group_nodes.begin() + group_start[order[i]],
+                          group_nodes.begin() + group_start[order[i] + 1],
+                          new_nodes.begin() + new_start[i]);
+        }
+        group_start.swap(new_start);
+        group_nodes.swap(new_nodes);
+}
+
+void IndistinguishableNodeReduction::apply() {
+        // Nodes are indistinguishable if they have the same closed neighborhood
+        group_equal_neighborhoods(graph_before, true, group_start, group_nodes);
+
+        // The nodes of a group are adjacent to its smallest node, they follow it in the order of its edges.
+        // This is the numbering of the sequential reduction, the following reductions depend on it.
+        const NodeID num_groups = group_start.size() - 1;
+        #pragma omp parallel
+        {
+                std::vector<NodeID> members;
+                #pragma omp for schedule(dynamic, 1024)
+                for (NodeID group = 0; group < num_groups; ++group) {
+                        NodeID next = group_start[group] + 1;
+                        if (group_start[group + 1] - next < 2) {
                                 continue;
                         }
-                        
-                        EdgeWeight count = 0;
-                        forall_out_edges(graph_before, edge_b, node_b) {
-                                count += labels[graph_before.getEdgeTarget(edge_b)];
+                        members.assign(group_nodes.begin() + next, group_nodes.begin() + group_start[group + 1]);
+                        std::sort(members.begin(), members.end());
+                        forall_out_edges(graph_before, edge, group_nodes[group_start[group]]) {
+                                auto target = graph_before.getEdgeTarget(edge);
+                                if (std::binary_search(members.begin(), members.end(), target)) {
+                                        group_nodes[next++] = target;
+                                }
                         } endfor
-                        if (count == graph_before.getNodeDegree(node_a) && count == graph_before.getNodeDegree(node_b)) {
-                                node_groups.back().push_back(node_b);
-                                contracted[node_b] = true;
-                        }
-                } endfor
-
-                forall_out_edges(graph_before, edge, node_a) {
-                        labels[graph_before.getEdgeTarget(edge)] = 0;
-                } endfor
-                labels[node_a] = 0;
-        } endfor
+                }
+        }
 
-        contract_nodes(graph_before, graph_after, node_groups, mapping);
+        contract_nodes(graph_before, graph_after, group_start, group_nodes);
 
         // Match reachable set size in reduced and original graph
-        for (NodeID new_node_id = 0; new_node_id < node_groups.size(); ++new_node_id) {
-                if (graph_before.get_contraction_offset(node_groups[new_node_id][0]) == 0) {
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID new_node_id = 0; new_node_id < graph_after.number_of_nodes(); ++new_node_id) {
+                if (graph_before.get_contraction_offset(group_nodes[group_start[new_node_id]]) == 0) {
                         continue;
                 }
-                auto reach = compute_reachable_set_size(graph_before, node_groups[new_node_id][0]);
+                auto reach = compute_reachable_set_size(graph_before, group_nodes[group_start[new_node_id]]);
                 auto new_reach_without_offset = graph_after.getNodeWeight(new_node_id) - 1;
                 forall_out_edges(graph_after, edge, new_node_id) {
                         new_reach_without_offset += graph_after.getNodeWeight(graph_after.getEdgeTarget(edge));
@@ -379,8 +559,8 @@ void IndistinguishableNodeReduction::map(std::vector<NodeID> &reduced_label, std
         for (size_t order = 0; order < orderings.size(); ++order) {
                 auto node = orderings[order];
                 NodeID count = 0;
-                for (const auto original_node: mapping.at(node)) {
-                        new_label[original_node] = order + offset + count;
+                for (NodeID i = group_start[node]; i < group_start[node + 1]; ++i) {
+                        new_label[group_nodes[i]] = order + offset + count;
                         ++count;
                 }
                 offset += count - 1;
@@ -392,80 +572,36 @@ void IndistinguishableNodeReduction::map(std::vector<NodeID> &reduced_label, std
 /*********/
 
 void TwinReduction::apply() {
-        // Vector of hashes of closed neighborhoods
-        std::vector<std::pair<size_t, NodeID>> hash_vector;
-        hash_vector.reserve(graph_before.number_of_nodes());
-        forall_nodes(graph_before, node) {
-                hash_vector.push_back({open_neighborhood_hash(graph_before, node), node});
-        } endfor
-
-        // Sort by hash
-        std::sort(hash_vector.begin(), hash_vector.end());
-
-        // Label nodes to compare neighborhoods
-        std::vector<short> labels(graph_before.number_of_nodes(), 0);
-
-        std::vector<std::vector<NodeID>> node_groups;
-        node_groups.reserve(graph_before.number_of_nodes());
-
-        // Set to true, if a node has been contracted
-        std::vector<bool> contracted(graph_before.number_of_nodes(), false);
-
-        // Store adjusted degrees for each node
-        std::vector<NodeWeight> degrees(graph_before.number_of_nodes(), 0);
-        forall_nodes(graph_before, node) {
-                degrees[node] = compute_reachable_set_size(graph_before, node);
-        } endfor
-
-        size_t first = 0, second;
-        while (first < hash_vector.size()) {
-                auto node_a = hash_vector[first].second;
-                second = first + 1;
-
-                node_groups.push_back({node_a});
-
-                forall_out_edges(graph_before, edge, node_a) {
-                        labels[graph_before.getEdgeTarget(edge)] = 1;
+        // Nodes are twins if they have the same open neighborhood
+        group_equal_neighborhoods(graph_before, false, group_start, group_nodes);
+
+        // The groups are ordered by the sum of the neighbor ids of their nodes and then by their smallest node.
+        // This is the numbering of the sequential reduction, the following reductions depend on it.
+        const NodeID num_groups = group_start.size() - 1;
+        std::vector<std::pair<size_t, NodeID>> group_keys(num_groups);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID group = 0; group < num_groups; ++group) {
+                size_t neighbor_sum = 0;
+                forall_out_edges(graph_before, edge, group_nodes[group_start[group]]) {
+                        neighbor_sum += graph_before.getEdgeTarget(edge);
                 } endfor
+                group_keys[group] = {neighbor_sum, group};
+        }
+        parallel_tools::sort(group_keys);
 
-                while (second < hash_vector.size() && hash_vector[first].first == hash_vector[second].first) {
-                        auto node_b = hash_vector[second].second;
-                        // ignore contracted nodes
-                        if (contracted[node_b]) {
-                                second++;
-                                continue;
-                        }
-                        
-                        // If neighborhoods are not equal in terms of degrees, we don't need to test
-                        if (graph_before.getNodeDegree(node_a) != graph_before.getNodeDegree(node_b) ||
-                            degrees[node_a] != degrees[node_b]) {
-                                second++;
-                                continue;
-                        }
-
-                        EdgeWeight count = 0;
-                        forall_out_edges(graph_before, edge_b, node_b) {
-                                count += labels[graph_before.getEdgeTarget(edge_b)];
-                        } endfor
-                        if (count == graph_before.getNodeDegree(node_a) && count == graph_before.getNodeDegree(node_b)) {
-                                node_groups.back().push_back(node_b);
-                                contracted[node_b] = true;
-                        }
-                        second++;
-                }
-                do {
-                        first++;
-                } while(first < hash_vector.size() && contracted[hash_vector[first].second]);
-                forall_out_edges(graph_before, edge, node_a) {
-                        labels[graph_before.getEdgeTarget(edge)] = 0;
-                } endfor
+        std::vector<NodeID> order(num_groups);
+        #pragma omp parallel for schedule(static)
+        for (NodeID i = 0; i < num_groups; ++i) {
+                order[i] = group_keys[i].second;
         }
+        reorder_groups(order, group_start, group_nodes);
 
-        contract_nodes(graph_before, graph_after, node_groups, mapping);
+        contract_nodes(graph_before, graph_after, group_start, group_nodes);
 
         // Match reachable set size in reduced and original graph
-        for (NodeID new_node_id = 0; new_node_id < node_groups.size(); ++new_node_id) {
-                auto reach = degrees[node_groups[new_node_id][0]];
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID new_node_id = 0; new_node_id < graph_after.number_of_nodes(); ++new_node_id) {
+                auto reach = compute_reachable_set_size(graph_before, group_nodes[group_start[new_node_id]]);
                 auto new_reach_without_offset = graph_after.getNodeWeight(new_node_id) - 1;
                 forall_out_edges(graph_after, edge, new_node_id) {
                         new_reach_without_offset += graph_after.getNodeWeight(graph_after.getEdgeTarget(edge));
@@ -485,8 +621,8 @@ void TwinReduction::map(std::vector<NodeID> &reduced_label, std::vector<NodeID>
         for (size_t order = 0; order < orderings.size(); ++order) {
                 auto node = orderings[order];
                 NodeID count = 0;
-                for (const auto original_node: mapping.at(node)) {
-                        new_label[original_node] = order + offset + count;
+                for (NodeID i = group_start[node]; i < group_start[node + 1]; ++i) {
+                        new_label[group_nodes[i]] = order + offset + count;
                         ++count;
                 }
                 offset += count - 1;
@@ -497,67 +633,186 @@ void TwinReduction::map(std::vector<NodeID> &reduced_label, std::vector<NodeID>
 /* PATH COMPRESSION */
 /********************/
 
-// Helper functions for finding degree-2 paths
-// Recursively walk along a path of degree-2 nodes, pushing each node into 'nodes' along the way
-
-// only detect paths of nodes with weight 1
-void degree_2_walk_weightone(graph_access &graph, NodeID start_node, std::vector<NodeID> &nodes) {
-        if (graph.getNodeWeight(start_node) != 1) {
-                return;
+// Find the maximal chains of eligible nodes in parallel. Eligible nodes have degree 2, so each chain is
+// a path or a cycle. Paths are stored from the end with the smaller id to the other end, cycles start at
+// their smallest node. Chain c consists of chain_nodes[chain_start[c]], ..., chain_nodes[chain_start[c+1]-1],
+// 'chain_of' stores the chain of each eligible node and UNASSIGNED for all other nodes.
+template <typename Eligible>
+void find_degree_2_chains(graph_access &graph, Eligible eligible,
+                          std::vector<NodeID> &chain_start,
+                          std::vector<NodeID> &chain_nodes,
+                          std::vector<NodeID> &chain_of) {
+        const NodeID n = graph.number_of_nodes();
+        std::vector<char> in_chain(n, false);
+        #pragma omp parallel for schedule(static)
+        for (NodeID node = 0; node < n; ++node) {
+                in_chain[node] = eligible(node);
         }
-        forall_out_edges(graph, edge, start_node) {
-                auto target = graph.getEdgeTarget(edge);
-                bool contained = false;
-                for (auto node: nodes) {
-                        if (target == node) {
-                                contained = true;
+
+        // The neighbor of 'node' in its chain that is not 'previous', UNASSIGNED if there is none
+        auto next = [&](NodeID previous, NodeID node) {
+                forall_out_edges(graph, edge, node) {
+                        NodeID target = graph.getEdgeTarget(edge);
+                        if (target != previous && in_chain[target]) {
+                                return target;
+                        }
+                } endfor
+                return UNASSIGNED;
+        };
+        auto is_end = [&](NodeID node) {
+                forall_out_edges(graph, edge, node) {
+                        if (!in_chain[graph.getEdgeTarget(edge)]) {
+                                return true;
                         }
+                } endfor
+                return false;
+        };
+
+        // Both ends of a path walk to the other end, the path is kept by the end with the smaller id
+        std::vector<NodeID> path_size(n + 1, 0);
+        std::vector<NodeID> path_id(n + 1, 0);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID node = 0; node < n; ++node) {
+                if (!in_chain[node] || !is_end(node)) {
+                        continue;
                 }
-                if (!contained && graph.getNodeDegree(target) == 2 && graph.getNodeWeight(target) == 1) {
-                        nodes.push_back(target);
-                        degree_2_walk_weightone(graph, target, nodes);
+                NodeID previous = UNASSIGNED;
+                NodeID current = node;
+                NodeID size = 1;
+                for (NodeID following = next(previous, current); following != UNASSIGNED; following = next(previous, current)) {
+                        previous = current;
+                        current = following;
+                        size++;
                 }
-        } endfor
-}
-
-// detect paths of nodes with any weight
-void degree_2_walk_anyweight(graph_access &graph, NodeID start_node, std::vector<NodeID> &nodes) {
-        forall_out_edges(graph, edge, start_node) {
-                auto target = graph.getEdgeTarget(edge);
-                bool contained = false;
-                for (auto node: nodes) {
-                        if (target == node) {
-                                contained = true;
-                        }
+                if (node <= current) {
+                        path_size[node] = size;
+                        path_id[node] = 1;
                 }
-                if (!contained && graph.getNodeDegree(target) == 2) {
-                        nodes.push_back(target);
-                        degree_2_walk_anyweight(graph, target, nodes);
+        }
+        parallel_tools::prefix_sum(path_size);
+        parallel_tools::prefix_sum(path_id);
+
+        const NodeID num_paths = path_id[n];
+        chain_start.resize(num_paths + 1);
+        chain_nodes.resize(path_size[n]);
+        chain_of.assign(n, UNASSIGNED);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID node = 0; node < n; ++node) {
+                if (path_id[node] == path_id[node + 1]) {
+                        continue;
                 }
-        } endfor
+                const NodeID chain = path_id[node];
+                NodeID position = path_size[node];
+                chain_start[chain] = position;
+                NodeID previous = UNASSIGNED;
+                NodeID current = node;
+                while (current != UNASSIGNED) {
+                        chain_nodes[position++] = current;
+                        chain_of[current] = chain;
+                        NodeID following = next(previous, current);
+                        previous = current;
+                        current = following;
+                }
+        }
+        chain_start[num_paths] = path_size[n];
+
+        // The remaining eligible nodes form cycles. These are whole components of the graph,
+        // so they are rare and collected sequentially.
+        for (NodeID node = 0; node < n; ++node) {
+                if (!in_chain[node] || chain_of[node] != UNASSIGNED) {
+                        continue;
+                }
+                const NodeID chain = chain_start.size() - 1;
+                NodeID previous = UNASSIGNED;
+                NodeID current = node;
+                do {
+                        chain_nodes.push_back(current);
+                        chain_of[current] = chain;
+                        NodeID following = next(previous, current);
+                        previous = current;
+                        current = following;
+                } while (current != node && current != UNASSIGNED);
+                chain_start.push_back(chain_nodes.size());
+        }
 }
 
 void PathCompression::apply() {
-        std::vector<std::vector<NodeID>> node_groups;
-        node_groups.reserve(graph_before.number_of_nodes());
-        std::vector<bool> compressed(graph_before.number_of_nodes(), false);
+        // only compress paths of nodes with weight 1
+        const NodeID n = graph_before.number_of_nodes();
+        std::vector<NodeID> chain_start, chain_nodes, chain_of;
+        find_degree_2_chains(graph_before,
+                             [this](NodeID node) {
+                                     return graph_before.getNodeDegree(node) == 2 && graph_before.getNodeWeight(node) == 1;
+                             },
+                             chain_start, chain_nodes, chain_of);
+
+        // Nodes that are not part of a chain form a group of their own,
+        // a chain becomes a group at the position of its smallest node
+        const NodeID num_chains = chain_start.size() - 1;
+        std::vector<NodeID> chain_min(num_chains);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID chain = 0; chain < num_chains; ++chain) {
+                chain_min[chain] = *std::min_element(chain_nodes.begin() + chain_start[chain],
+                                                     chain_nodes.begin() + chain_start[chain + 1]);
+        }
 
-        forall_nodes(graph_before, node) {
-                if (graph_before.getNodeDegree(node) != 2) {
-                        node_groups.push_back({node});
-                } else {
-                        if (!compressed[node]) {
-                                node_groups.push_back({node});
-                                degree_2_walk_weightone(graph_before, node, node_groups.back());
-                                for (auto compressed_node: node_groups.back()) {
-                                        compressed[compressed_node] = true;
-                                }
+        std::vector<NodeID> group_size(n + 1, 0);
+        std::vector<NodeID> group_id(n + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for (NodeID node = 0; node < n; ++node) {
+                auto chain = chain_of[node];
+                if (chain == UNASSIGNED) {
+                        group_size[node] = 1;
+                } else if (chain_min[chain] == node) {
+                        group_size[node] = chain_start[chain + 1] - chain_start[chain];
+                }
+                group_id[node] = group_size[node] > 0;
+        }
+        parallel_tools::prefix_sum(group_size);
+        parallel_tools::prefix_sum(group_id);
+
+        const NodeID num_groups = group_id[n];
+        group_start.resize(num_groups + 1);
+        group_nodes.resize(n);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID node = 0; node < n; ++node) {
+                if (group_id[node] == group_id[node + 1]) {
+                        continue;
+                }
+                group_start[group_id[node]] = group_size[node];
+                auto chain = chain_of[node];
+                auto out = group_nodes.begin() + group_size[node];
+                *out = node;
+                if (chain == UNASSIGNED) {
+                        continue;
+                }
+                // The group starts with the smallest node, which is followed by the nodes in the direction
+                // of its first neighbor in the chain and then by the nodes in the other direction.
+                // This is the order in which the sequential reduction walked the path.
+                auto first = chain_nodes.begin() + chain_start[chain];
+                auto last = chain_nodes.begin() + chain_start[chain + 1];
+                auto smallest = std::find(first, last, node);
+                NodeID first_neighbor = UNASSIGNED;
+                forall_out_edges(graph_before, edge, node) {
+                        auto target = graph_before.getEdgeTarget(edge);
+                        if (chain_of[target] == chain) {
+                                first_neighbor = target;
+                                break;
                         }
+                } endfor
+                ++out;
+                if (smallest + 1 != last && *(smallest + 1) == first_neighbor) {
+                        out = std::copy(smallest + 1, last, out);
+                        std::reverse_copy(first, smallest, out);
+                } else {
+                        out = std::reverse_copy(first, smallest, out);
+                        std::copy(smallest + 1, last, out);
                 }
-        } endfor
+        }
+        group_start[num_groups] = n;
 
         // Contract nodes, setting the weight of new nodes to 1 and their contraction offset to 0
-        contract_nodes(graph_before, graph_after, node_groups, mapping);
+        contract_nodes(graph_before, graph_after, group_start, group_nodes);
 }
 
 void PathCompression::map(std::vector<NodeID> &reduced_label, std::vector<NodeID> &new_label) const {
@@ -567,10 +822,12 @@ void PathCompression::map(std::vector<NodeID> &reduced_label, std::vector<NodeID
                 queue.insert(i, -reduced_label[i]);
         }
         NodeID offset = 0;
+        // We reverse paths and parts of paths, so each path is copied first
+        std::vector<NodeID> path;
         while (!queue.empty()) {
                 auto order = -queue.maxValue();
                 auto node = queue.deleteMax();
-                std::vector<NodeID> &path = mapping.at(node);
+                path.assign(group_nodes.begin() + group_start[node], group_nodes.begin() + group_start[node + 1]);
                 if (path.size() == 1) {
                         new_label[path[0]] = order + offset;
                 } else {
@@ -631,40 +888,52 @@ void PathCompression::map(std::vector<NodeID> &reduced_label, std::vector<NodeID
 /* DEGREE-2 NODE REMOVAL */
 /*************************/
 
-// Find the nodes to replace degree-2 nodes
+// Find the nodes to replace degree-2 nodes, these are the neighbors of the ends of their paths
 void find_replacements(graph_access &graph_before, std::vector<std::array<NodeID, 2>> &replacements) {
-        replacements.resize(graph_before.number_of_nodes(), {0, 0});
-        std::vector<NodeID> path;
-        std::vector<bool> visited(graph_before.number_of_nodes(), false);
-        forall_nodes(graph_before, node) {
-               if(!visited[node] && graph_before.getNodeDegree(node) == 2) {
-                        // Detect a path
-                        path.clear();
-                        path.push_back(node);
-                        degree_2_walk_anyweight(graph_before, node, path);
-                        // Find the non-path neighbors of the end nodes
-                        NodeID ends[2];
-                        int i = 0;
-                        for (auto path_node: path) {
-                                forall_out_edges(graph_before, edge, path_node) {
-                                        auto target = graph_before.getEdgeTarget(edge);
-                                        if (graph_before.getNodeDegree(target) != 2) {
-                                                ends[i] = target;
-                                                ++i;
-                                        }
-                                } endfor
-                        }
-                        // Set each node on the path to visited and set the found nodes as replacements
-                        for (auto path_node: path) {
-                                visited[path_node] = true;
-                                replacements[path_node][0] = ends[0];
-                                replacements[path_node][1] = ends[1];
-                        }
-                } else if (graph_before.getNodeDegree(node) != 2) {
-                        // Make the node its own replacement if it doesn't need to be replaced
+        const NodeID n = graph_before.number_of_nodes();
+        replacements.resize(n, {0, 0});
+        std::vector<NodeID> chain_start, chain_nodes, chain_of;
+        find_degree_2_chains(graph_before,
+                             [&graph_before](NodeID node) {
+                                     return graph_before.getNodeDegree(node) == 2;
+                             },
+                             chain_start, chain_nodes, chain_of);
+
+        // Make nodes their own replacement if they don't need to be replaced
+        #pragma omp parallel for schedule(static)
+        for (NodeID node = 0; node < n; ++node) {
+                if (chain_of[node] == UNASSIGNED) {
                         replacements[node][0] = replacements[node][1] = node;
                 }
-        } endfor
+        }
+
+        const NodeID num_chains = chain_start.size() - 1;
+        #pragma omp parallel for schedule(dynamic, 256)
+        for (NodeID chain = 0; chain < num_chains; ++chain) {
+                // Find the non-path neighbors of the end nodes. Cycles don't have any, their nodes are never replaced.
+                std::array<NodeID, 2> ends;
+                int i = 0;
+                auto first = chain_nodes[chain_start[chain]];
+                auto last = chain_nodes[chain_start[chain + 1] - 1];
+                for (auto end_node: {first, last}) {
+                        forall_out_edges(graph_before, edge, end_node) {
+                                auto target = graph_before.getEdgeTarget(edge);
+                                if (graph_before.getNodeDegree(target) != 2 && i < 2) {
+                                        ends[i] = target;
+                                        ++i;
+                                }
+                        } endfor
+                        if (first == last) {
+                                break;
+                        }
+                }
+                if (i < 2) {
+                        continue;
+                }
+                for (NodeID j = chain_start[chain]; j < chain_start[chain + 1]; ++j) {
+                        replacements[chain_nodes[j]] = ends;
+                }
+        }
 }
 
 void Degree2Elimination::apply() {
@@ -677,93 +946,115 @@ void Degree2Elimination::apply() {
         //      The nodes where degree = 2 and adjusted degree > 2 are contracted indistinguishable nodes.
         //      These nodes are eliminated with fill-in 1, just like regular degree-2 nodes.
         //      Eliminating based on degree instead of adjusted degree also gets rid of more nodes.
-        
-        graph_after.start_construction(graph_before.number_of_nodes(), graph_before.number_of_edges());
-        std::vector<NodeID> reverse_mapping(graph_before.number_of_nodes(), 1000000);
-        // Copy nodes of degree != 2, omit nodes of degree 2
-        forall_nodes(graph_before, node) {
+        const NodeID n = graph_before.number_of_nodes();
+
+        // Keep nodes of degree != 2, omit nodes of degree 2
+        std::vector<NodeID> reverse_mapping(n + 1, 0);
+        #pragma omp parallel for schedule(static)
+        for (NodeID node = 0; node < n; ++node) {
+                reverse_mapping[node] = graph_before.getNodeDegree(node) != 2;
+        }
+        parallel_tools::prefix_sum(reverse_mapping);
+        const NodeID n_after = reverse_mapping[n];
+
+        mapping.resize(n_after);
+        label_first.resize(n - n_after);
+        #pragma omp parallel for schedule(static)
+        for (NodeID node = 0; node < n; ++node) {
                 if (graph_before.getNodeDegree(node) != 2) {
-                        auto new_node_id = graph_after.new_node();
-                        graph_after.setNodeWeight(new_node_id, graph_before.getNodeWeight(node));
-                        graph_after.set_contraction_offset(new_node_id, graph_before.get_contraction_offset(node));
-                        reverse_mapping[node] = new_node_id;
-                        mapping.push_back(node);
+                        mapping[reverse_mapping[node]] = node;
                 } else {
-                        label_first.push_back(node);
+                        label_first[node - reverse_mapping[node]] = node;
                 }
-        } endfor
+        }
 
         std::vector<std::array<NodeID, 2>> replacements;
         find_replacements(graph_before, replacements);
 
-        std::vector<NodeID> update_nodes;
-        
-        // Copy edges, replacing targets by nodes in the 'replacements' vector if they have degree 2
-        // last_visitor stores for a node x the last node y for which an edge (y, x) has been added
-        // and the corresponding edge-id
-        std::vector<std::pair<NodeID, EdgeID>> last_visitor(graph_before.number_of_nodes(), {-1, -1});
-        forall_nodes(graph_before, source) {
-                if (graph_before.getNodeDegree(source) == 2) {
-                        continue;
-                }
-                auto new_source_id = reverse_mapping[source];
-                bool pushed = false;
-                forall_out_edges(graph_before, old_edge, source) {
-                        auto old_target = graph_before.getEdgeTarget(old_edge);
-
-                        // If a node has a neighbor that's been eliminated, set its offset to 0.
-                        // Its neighborhood is now a clique, due to the elimination process.
-                        if (graph_before.getNodeDegree(old_target) == 2) {
-                                graph_after.set_contraction_offset(new_source_id, 0);
-                                if (!pushed) {
-                                        update_nodes.push_back(new_source_id);
-                                        pushed = true;
+        // Collect the edges of each remaining node at the position of its old edges, replacing targets
+        // by nodes in the 'replacements' vector if they have degree 2. Self loops are dropped, parallel edges merged.
+        std::vector<std::pair<NodeID, EdgeWeight>> raw_edges(graph_before.number_of_edges());
+        std::vector<EdgeID> first_edge(n_after + 1, 0);
+        std::vector<char> neighbor_eliminated(n_after, false);
+        #pragma omp parallel
+        {
+                std::vector<std::pair<NodeID, EdgeID>> order;
+                #pragma omp for schedule(dynamic, 1024)
+                for (NodeID new_source_id = 0; new_source_id < n_after; ++new_source_id) {
+                        auto source = mapping[new_source_id];
+                        auto begin = raw_edges.begin() + graph_before.get_first_edge(source);
+                        auto last = begin;
+                        forall_out_edges(graph_before, old_edge, source) {
+                                auto old_target = graph_before.getEdgeTarget(old_edge);
+                                if (graph_before.getNodeDegree(old_target) == 2) {
+                                        neighbor_eliminated[new_source_id] = true;
                                 }
-                        }
 
-                        NodeID new_target_id;
-                        // Select the replacement that's not the source
-                        if (source != replacements[old_target][0]) {
-                                new_target_id = reverse_mapping[replacements[old_target][0]];
-                        } else {
-                                new_target_id = reverse_mapping[replacements[old_target][1]];
-                        }
-                        // Add an edge if it's not a self loop and the edge has not been added before
-                        if (new_target_id != new_source_id) {
-                                if (last_visitor[new_target_id].first != new_source_id) {
-                                        auto new_edge_id = graph_after.new_edge(new_source_id, new_target_id);
-                                        graph_after.setEdgeWeight(new_edge_id, graph_before.getEdgeWeight(old_edge));
-                                        last_visitor[new_target_id] = {new_source_id, new_edge_id};
+                                NodeID new_target_id;
+                                // Select the replacement that's not the source
+                                if (source != replacements[old_target][0]) {
+                                        new_target_id = reverse_mapping[replacements[old_target][0]];
                                 } else {
-                                        auto new_edge_id = last_visitor[new_target_id].second;
-                                        graph_after.setEdgeWeight(new_edge_id, graph_after.getEdgeWeight(new_edge_id) +
-                                                                               graph_before.getEdgeWeight(old_edge));
+                                        new_target_id = reverse_mapping[replacements[old_target][1]];
                                 }
-                        }
-                } endfor
-        } endfor
-
+                                if (new_target_id != new_source_id) {
+                                        *last = {new_target_id, graph_before.getEdgeWeight(old_edge)};
+                                        ++last;
+                                }
+                        } endfor
+                        first_edge[new_source_id] = merge_parallel_edges(begin, last, order) - begin;
+                }
+        }
+        parallel_tools::prefix_sum(first_edge);
+
+        graph_after.start_bulk_construction(n_after, first_edge[n_after]);
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for (NodeID new_node_id = 0; new_node_id < n_after; ++new_node_id) {
+                auto node = mapping[new_node_id];
+                graph_after.setFirstEdge(new_node_id, first_edge[new_node_id]);
+                graph_after.setNodeWeight(new_node_id, graph_before.getNodeWeight(node));
+                // If a node has a neighbor that's been eliminated, set its offset to 0.
+                // Its neighborhood is now a clique, due to the elimination process.
+                graph_after.set_contraction_offset(new_node_id, neighbor_eliminated[new_node_id] ? 0 : graph_before.get_contraction_offset(node));
+
+                auto raw_edge = raw_edges.begin() + graph_before.get_first_edge(node);
+                for (EdgeID e = first_edge[new_node_id]; e < first_edge[new_node_id + 1]; ++e, ++raw_edge) {
+                        graph_after.setEdgeTarget(e, raw_edge->first);
+                        graph_after.setEdgeWeight(e, raw_edge->second);
+                }
+        }
         graph_after.finish_construction();
 
         // There are cases in which a forward and a backward edge end up with different edge weights:
         // Consider nodes a and b that are connected by two degree-2 nodes x and y.
         // If edges a-x and a-y have weight 1 and edges b-x and b-y have weight 2, the edge a-b will have weight 1
         // and the edge b-a will have weight 2.
-        // Identify all these edges and replace their weights by the sum of the weights
-        for (const auto node: update_nodes) {
-                forall_out_edges(graph_after, forward_edge, node) {
-                        auto target = graph_after.getEdgeTarget(forward_edge);
-                        forall_out_edges(graph_after, backward_edge, target) {
-                                if (graph_after.getEdgeTarget(backward_edge) == node) {
-                                        auto forward_weight = graph_after.getEdgeWeight(forward_edge);
-                                        auto backward_weight = graph_after.getEdgeWeight(backward_edge);
-                                        if (forward_weight != backward_weight) {
-                                                graph_after.setEdgeWeight(forward_edge, forward_weight + backward_weight);
-                                                graph_after.setEdgeWeight(backward_edge, forward_weight + backward_weight);
-                                        }
+        // Identify all these edges and replace their weights by the sum of the weights.
+        // All new weights are computed before any of them is written.
+        #pragma omp parallel
+        {
+                std::vector<std::pair<EdgeID, EdgeWeight>> new_weights;
+                #pragma omp for schedule(dynamic, 1024)
+                for (NodeID node = 0; node < n_after; ++node) {
+                        forall_out_edges(graph_after, forward_edge, node) {
+                                auto target = graph_after.getEdgeTarget(forward_edge);
+                                if (!neighbor_eliminated[node] && !neighbor_eliminated[target]) {
+                                        continue;
                                 }
+                                forall_out_edges(graph_after, backward_edge, target) {
+                                        if (graph_after.getEdgeTarget(backward_edge) == node) {
+                                                auto forward_weight = graph_after.getEdgeWeight(forward_edge);
+                                                auto backward_weight = graph_after.getEdgeWeight(backward_edge);
+                                                if (forward_weight != backward_weight) {
+                                                        new_weights.push_back({forward_edge, forward_weight + backward_weight});
+                                                }
+                                        }
+                                } endfor
                         } endfor
-                } endfor
+                }
+                for (const auto &new_weight: new_weights) {
+                        graph_after.setEdgeWeight(new_weight.first, new_weight.second);
+                }
         }
 }
 
@@ -821,24 +1112,32 @@ void degree_3_walk(graph_access &graph, NodeID start_node, NodeID init_node, std
 }
 
 void TriangleContraction::apply() {
-        std::vector<std::vector<NodeID>> node_groups;
-        node_groups.reserve(graph_before.number_of_nodes());
+        // The walks depend on the nodes contracted before, so the groups are found sequentially
+        group_start.clear();
+        group_nodes.clear();
+        group_nodes.reserve(graph_before.number_of_nodes());
+        std::vector<NodeID> path;
         std::vector<bool> contracted(graph_before.number_of_nodes(), false);
         forall_nodes(graph_before, node) {
                 if (contracted[node]) {
                         continue;
-                } else if (graph_before.getNodeDegree(node) == 3) {
-                        node_groups.push_back({node});
-                        degree_3_walk(graph_before, node, node, node_groups.back(), contracted);
-                        for (auto n: node_groups.back()) {
+                }
+                group_start.push_back(group_nodes.size());
+                if (graph_before.getNodeDegree(node) == 3) {
+                        path.clear();
+                        path.push_back(node);
+                        degree_3_walk(graph_before, node, node, path, contracted);
+                        for (auto n: path) {
                                 contracted[n] = true;
+                                group_nodes.push_back(n);
                         }
                 } else {
-                        node_groups.push_back({node});
+                        group_nodes.push_back(node);
                 }
         } endfor 
+        group_start.push_back(group_nodes.size());
 
-        contract_nodes(graph_before, graph_after, node_groups, mapping);
+        contract_nodes(graph_before, graph_after, group_start, group_nodes);
 }
 
 void TriangleContraction::map(std::vector<NodeID> &reduced_label, std::vector<NodeID> &new_label) const {
@@ -851,8 +1150,8 @@ void TriangleContraction::map(std::vector<NodeID> &reduced_label, std::vector<No
         for (size_t order = 0; order < orderings.size(); ++order) {
                 auto node = orderings[order];
                 NodeID count = 0;
-                for (const auto original_node: mapping.at(node)) {
-                        new_label[original_node] = order + offset + count;
+                for (NodeID i = group_start[node]; i < group_start[node + 1]; ++i) {
+                        new_label[group_nodes[i]] = order + offset + count;
                         ++count;
                 }
                 offset += count - 1;
@@ -923,7 +1222,12 @@ bool apply_reductions(const PartitionConfig &config,
         if (config.disable_reductions || config.reduction_order.empty()) {
                 return false;
         } else {
+                // the parallel regions of the reductions use the default number of threads,
+                // which is limited to one for this call unless enable_omp is set
+                int max_threads = omp_get_max_threads();
+                omp_set_num_threads(parallel_tools::max_threads(config.enable_omp));
                 apply_reductions_internal(config, in_graph, reduction_stack, recursion_level);
+                omp_set_num_threads(max_threads);
                 return true;
         }
 }
@@ -9,7 +9,6 @@
 #include <iostream>
 #include <iomanip>
 #include <memory>
-#include <unordered_map>
 #include <vector>
 
 #include "data_structure/graph_access.h"
@@ -39,7 +38,7 @@ public:
         void operator=(reduction_stat_counter const&) = delete;
 
         inline static reduction_stat_counter &get_instance() {
-                static reduction_stat_counter instance;
+                static thread_local reduction_stat_counter instance;
                 return instance;
         }
 
@@ -177,8 +176,8 @@ public:
                 int count = 0;
                 forall_nodes(graph_after, node) {
                         auto reach = compute_reachable_set_size(graph_after, node);
-                        for (const auto old_node: mapping[node]) {
-                                auto degree = compute_reachable_set_size(graph_before, old_node);
+                        for (NodeID i = group_start[node]; i < group_start[node + 1]; ++i) {
+                                auto degree = compute_reachable_set_size(graph_before, group_nodes[i]);
                                 if (reach != degree) {
                                         count++;
                                 }
@@ -188,17 +187,19 @@ public:
         }
 
         virtual inline void print_mapping(std::ostream &stream) override {
-                for (auto it = mapping.begin(); it != mapping.end(); ++it) {
-                        for (const auto node: it->second) {
-                                stream << node << " ";
+                for (NodeID node = 0; node + 1 < group_start.size(); ++node) {
+                        for (NodeID i = group_start[node]; i < group_start[node + 1]; ++i) {
+                                stream << group_nodes[i] << " ";
                         }
                         stream << std::endl;
                 }
         }
 
 protected:
-        // Mapping from the reduced graph to groups of nodes in the original graph
-        std::unordered_map<NodeID, std::vector<NodeID>> mapping;
+        // Mapping from the reduced graph to groups of nodes in the original graph:
+        // node x of the reduced graph stands for group_nodes[group_start[x]], ..., group_nodes[group_start[x+1]-1]
+        std::vector<NodeID> group_start;
+        std::vector<NodeID> group_nodes;
 
 };
 
@@ -257,10 +258,6 @@ public:
 
         void map(std::vector<NodeID> &reduced_label, std::vector<NodeID> &new_label) const override;
 
-protected:
-        // We reverse paths and parts of paths in the map function, so we make the mapping mutable for this reduction
-        mutable std::unordered_map<NodeID, std::vector<NodeID>> mapping;
-
 };
 
 // Eliminate nodes of degree 2. This takes away a step of the min-degree algorithm.
@@ -16,12 +16,13 @@
 #include "uncoarsening/refinement/tabu_search/tabu_search.h"
 
 
-construct_partition::construct_partition() {
-                
+construct_partition::construct_partition(refinement_workspace * workspace) : m_workspace (workspace),
+                                                                             m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 construct_partition::~construct_partition() {
-                
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 void construct_partition::construct_starting_from_partition( PartitionConfig & config, graph_access & G) {
@@ -125,7 +126,7 @@ void construct_partition::createIndividuum( PartitionConfig & config, graph_acce
 	complete_boundary boundary(&G);
 	boundary.build();
 
-	tabu_search ts;
+	tabu_search ts(m_workspace);
 	PartitionConfig copy = config;
 	copy.maxIter         = G.number_of_nodes();
 
@@ -11,15 +11,21 @@
 #include "data_structure/graph_access.h"
 #include "parallel_mh/population.h"
 #include "partition_config.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class construct_partition {
 public:
-        construct_partition();
+        construct_partition( refinement_workspace * workspace = NULL );
         virtual ~construct_partition();
 
         void construct_starting_from_partition( PartitionConfig & config, graph_access & G);
         void createIndividuum( PartitionConfig & config, graph_access & G, 
                                Individuum & ind, bool output); 
+
+private:
+        // scratch memory of the tabu search, shared by repeated constructions
+        refinement_workspace* m_workspace;
+        bool m_owns_workspace;
 };
 
 
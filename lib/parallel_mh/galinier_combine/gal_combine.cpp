@@ -18,12 +18,13 @@
 #include "uncoarsening/refinement/refinement.h"
 #include "uncoarsening/refinement/tabu_search/tabu_search.h"
 
-gal_combine::gal_combine() {
-                
+gal_combine::gal_combine(refinement_workspace * workspace) : m_workspace (workspace),
+                                                             m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 gal_combine::~gal_combine() {
-                
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 
@@ -80,10 +81,10 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
                 }
         } endfor
 
-        construct_partition cp;
+        construct_partition cp(m_workspace);
         cp.construct_starting_from_partition( config, G );
 
-        refinement* refine = new mixed_refinement();
+        refinement* refine = new mixed_refinement(m_workspace);
 
         double real_epsilon = config.imbalance/100.0;
         double epsilon = random_functions::nextDouble(real_epsilon+0.005,real_epsilon+config.kabaE_internal_bal); 
@@ -93,7 +94,7 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
         complete_boundary boundary(&G);
         boundary.build();
 
-        tabu_search ts;
+        tabu_search ts(m_workspace);
         ts.perform_refinement( copy, G, boundary);
         
         //now obtain the quotient graph
@@ -10,13 +10,19 @@
 
 #include "partition_config.h"
 #include "data_structure/graph_access.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class gal_combine {
 public:
-        gal_combine();
+        gal_combine( refinement_workspace * workspace = NULL );
         virtual ~gal_combine();
 
         void perform_gal_combine( PartitionConfig & config, graph_access & G);
+
+private:
+        // scratch memory of the refinements, shared by repeated combines
+        refinement_workspace* m_workspace;
+        bool m_owns_workspace;
 };
 
 
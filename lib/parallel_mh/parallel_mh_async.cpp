@@ -117,7 +117,7 @@ void parallel_mh_async::initialize(PartitionConfig & working_config, graph_acces
         if( !working_config.mh_easy_construction) {
                 m_island->createIndividuum( working_config, G, first_one, true); 
         } else {
-                construct_partition cp;
+                construct_partition cp(&m_refinement_workspace);
                 cp.createIndividuum( working_config, G, first_one, true); 
                 std::cout <<  "created with objective " <<  first_one.objective << std::endl;
         }
@@ -236,7 +236,7 @@ EdgeWeight parallel_mh_async::perform_local_partitioning(PartitionConfig & worki
                                 m_island->createIndividuum(working_config, G, first_ind, true);
                                 m_island->insert(G, first_ind);
                         } else {
-                                construct_partition cp;
+                                construct_partition cp(&m_refinement_workspace);
                                 cp.createIndividuum( working_config, G, first_ind, true); 
 
                                 m_island->insert(G, first_ind);
@@ -297,7 +297,7 @@ EdgeWeight parallel_mh_async::perform_local_partitioning(PartitionConfig & worki
                                         if( !working_config.mh_easy_construction) {
                                                 m_island->createIndividuum(working_config, G, first_ind, true);
                                         } else {
-                                                construct_partition cp;
+                                                construct_partition cp(&m_refinement_workspace);
                                                 cp.createIndividuum( working_config, G, first_ind, true); 
                                                 std::cout <<  "created with objective " <<  first_ind.objective << std::endl;
                                         }
@@ -13,6 +13,7 @@
 #include "partition_config.h"
 #include "population.h"
 #include "timer.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class parallel_mh_async {
 public:
@@ -44,6 +45,9 @@ private:
         //island
         population* m_island;
         MPI_Comm m_communicator;
+
+        // scratch memory of the tabu search of the easy construction
+        refinement_workspace m_refinement_workspace;
 };
 
 
@@ -217,7 +217,7 @@ void population::combine(const PartitionConfig & partition_config,
 	}
 
 	if( coin ) {
-		gal_combine combine_operator;
+		gal_combine combine_operator(&m_refinement_workspace);
 		combine_operator.perform_gal_combine( config, G);
 		int* partition_map = new int[G.number_of_nodes()];
 
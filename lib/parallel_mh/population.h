@@ -14,6 +14,7 @@
 #include "data_structure/graph_access.h"
 #include "partition_config.h"
 #include "timer.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 struct Individuum {
         int* partition_map;
@@ -96,6 +97,9 @@ class population {
 
                 std::stringstream m_filebuffer_string;
                 timer   	  m_global_timer;
+
+                // scratch memory of the gal combine refinements
+                refinement_workspace m_refinement_workspace;
 };
 
 
@@ -53,7 +53,7 @@ void size_constraint_label_propagation::match_internal(const PartitionConfig & p
                                               NodeID & no_of_coarse_vertices,
                                               NodePermutationMap & permutation) {
 
-        std::vector<NodeWeight> cluster_id(G.number_of_nodes());
+        std::vector<NodeID> cluster_id(G.number_of_nodes());
         NodeWeight block_upperbound = ceil(partition_config.upper_bound_partition/(double)partition_config.cluster_coarsening_factor);
 
         label_propagation( partition_config, G, block_upperbound, cluster_id, no_of_coarse_vertices);
@@ -124,7 +124,7 @@ void size_constraint_label_propagation::ensemble_clusterings(const PartitionConf
 
 void size_constraint_label_propagation::label_propagation(const PartitionConfig & partition_config, 
                                                          graph_access & G, 
-                                                         std::vector<NodeWeight> & cluster_id, 
+                                                         std::vector<NodeID> & cluster_id, 
                                                          NodeID & no_of_blocks ) {
         NodeWeight block_upperbound = ceil(partition_config.upper_bound_partition/(double)partition_config.cluster_coarsening_factor);
 
@@ -134,7 +134,7 @@ void size_constraint_label_propagation::label_propagation(const PartitionConfig
 void size_constraint_label_propagation::label_propagation(const PartitionConfig & partition_config, 
                                                          graph_access & G, 
                                                          const NodeWeight & block_upperbound,
-                                                         std::vector<NodeWeight> & cluster_id,  
+                                                         std::vector<NodeID> & cluster_id,  
                                                          NodeID & no_of_blocks) {
         // in this case the _matching paramter is not used 
         // coarse_mappng stores cluster id and the mapping (it is identical)
@@ -197,7 +197,7 @@ void size_constraint_label_propagation::label_propagation(const PartitionConfig
 
 void size_constraint_label_propagation::create_coarsemapping(const PartitionConfig & partition_config, 
                                                              graph_access & G,
-                                                             std::vector<NodeWeight> & cluster_id,
+                                                             std::vector<NodeID> & cluster_id,
                                                              CoarseMapping & coarse_mapping) {
         forall_nodes(G, node) {
                 coarse_mapping[node] = cluster_id[node];
@@ -206,7 +206,7 @@ void size_constraint_label_propagation::create_coarsemapping(const PartitionConf
 
 void size_constraint_label_propagation::remap_cluster_ids(const PartitionConfig & partition_config, 
                                                           graph_access & G,
-                                                          std::vector<NodeWeight> & cluster_id,
+                                                          std::vector<NodeID> & cluster_id,
                                                           NodeID & no_of_coarse_vertices, bool apply_to_graph) {
 
         PartitionID cur_no_clusters = 0;
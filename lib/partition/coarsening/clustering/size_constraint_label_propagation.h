@@ -96,7 +96,7 @@ class size_constraint_label_propagation : public matching {
 
                 void label_propagation(const PartitionConfig & partition_config, 
                                 graph_access & G, 
-                                std::vector<NodeWeight> & cluster_id,
+                                std::vector<NodeID> & cluster_id,
                                 NodeID & number_of_blocks ); 
 
 };
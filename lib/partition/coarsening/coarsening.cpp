@@ -18,6 +18,7 @@
 #include "matching/gpa/gpa_matching.h"
 #include "matching/random_matching.h"
 #include "stop_rules/stop_rules.h"
+#include "tools/trace.h"
 
 coarsening::coarsening() {
 
@@ -28,6 +29,7 @@ coarsening::~coarsening() {
 }
 
 void coarsening::perform_coarsening(const PartitionConfig & partition_config, graph_access & G, graph_hierarchy & hierarchy) {
+        trace_scope coarsening_scope("coarsening");
 
         NodeID no_of_coarser_vertices = G.number_of_nodes();
         NodeID no_of_finer_vertices   = G.number_of_nodes();
@@ -58,6 +60,11 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
         unsigned int level    = 0;
         bool contraction_stop = false;
         do {
+                trace_scope level_scope("contraction level");
+                level_scope.arg("level", level);
+                level_scope.arg("nodes", finer->number_of_nodes());
+                level_scope.arg("edges", finer->number_of_edges());
+
                 graph_access* coarser = new graph_access();
                 coarse_mapping        = new CoarseMapping();
                 Matching edge_matching;
@@ -81,6 +88,9 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
                 }
 
                 hierarchy.push_back(finer, coarse_mapping);
+                level_scope.arg("coarse nodes", coarser->number_of_nodes());
+                level_scope.arg("coarse edges", coarser->number_of_edges());
+                trace::value("graph nodes", coarser->number_of_nodes());
                 contraction_stop = coarsening_stop_rule->stop(no_of_finer_vertices, no_of_coarser_vertices);
               
                 no_of_finer_vertices = no_of_coarser_vertices;
@@ -91,6 +101,7 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
         } while( contraction_stop ); 
 
         hierarchy.push_back(finer, NULL); // append the last created level
+        coarsening_scope.arg("levels", level);
 
         delete contracter;
         delete coarsening_stop_rule;
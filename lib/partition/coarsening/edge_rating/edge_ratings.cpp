@@ -5,10 +5,12 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <algorithm>
 #include <math.h>
 
 #include "edge_ratings.h"
 #include "partition_config.h"       
+#include "parallel_tools.h"
 #include "random_functions.h"
 
 edge_ratings::edge_ratings(const PartitionConfig & _partition_config) : partition_config(_partition_config){
@@ -98,54 +100,92 @@ void edge_ratings::rate(graph_access & G, unsigned level) {
         }
 }
 
-//simd implementation is possible
-void edge_ratings::compute_algdist(graph_access & G, std::vector<float> & dist) {
-        for( unsigned R = 0; R < 3; R++) {
-                std::vector<float> prev(G.number_of_nodes(), 0);
+// one block of up to B test vectors. the vectors are stored interleaved, the B values
+// of a node are consecutive, so that one pass over the edges of a node updates all
+// vectors of the block with vector instructions. prev and next have B entries per node.
+template< unsigned B >
+static void algdist_block(graph_access & G, unsigned lanes, unsigned iterations, int num_threads,
+                          std::vector<float> & prev, std::vector<float> & next,
+                          std::vector<float> & dist) {
+        const NodeID n = G.number_of_nodes();
+        const float w  = 0.5;
+
+        // the random values are drawn vector by vector as in the scalar version,
+        // unused lanes stay zero
+        std::fill(prev.begin(), prev.end(), 0);
+        for( unsigned lane = 0; lane < lanes; lane++) {
                 forall_nodes(G, node) {
-                        prev[node] = random_functions::nextDouble(-0.5,0.5); 
+                        prev[node*B + lane] = random_functions::nextDouble(-0.5,0.5); 
                 } endfor
+        }
 
-                std::vector<float> next(G.number_of_nodes(), 0);
-                float w = 0.5;
-
-                for( unsigned k = 0; k < 7; k++) {
-                        forall_nodes(G, node) {
-                                next[node] = 0;
-
-                                forall_out_edges(G, e, node) {
-                                        NodeID target = G.getEdgeTarget(e);
-                                        next[node] += prev[target] * G.getEdgeWeight(e);
-                                } endfor
-
-                                float wdegree = G.getWeightedNodeDegree(node);
-                                if(wdegree > 0) {
-                                        next[node] /= (float)wdegree;
+        for( unsigned k = 0; k < iterations; k++) {
+                #pragma omp parallel for schedule(dynamic, 1024) num_threads(num_threads)
+                for( NodeID node = 0; node < n; node++) {
+                        float sum[B];
+                        for( unsigned lane = 0; lane < B; lane++) sum[lane] = 0;
 
+                        EdgeWeight wdegree = 0;
+                        forall_out_edges(G, e, node) {
+                                const float * target_values = &prev[G.getEdgeTarget(e)*B];
+                                const EdgeWeight weight     = G.getEdgeWeight(e);
+                                #pragma omp simd
+                                for( unsigned lane = 0; lane < B; lane++) {
+                                        sum[lane] += target_values[lane] * weight;
                                 }
+                                wdegree += weight;
                         } endfor
 
-                        forall_nodes(G, node) {
-                                prev[node] = (1-w)*prev[node] + w*next[node];
-                        } endfor
-
+                        float * node_values = &next[node*B];
+                        if(wdegree > 0) {
+                                #pragma omp simd
+                                for( unsigned lane = 0; lane < B; lane++) {
+                                        node_values[lane] = sum[lane] / (float)wdegree;
+                                }
+                        } else {
+                                for( unsigned lane = 0; lane < B; lane++) node_values[lane] = sum[lane];
+                        }
                 }
 
-                forall_nodes(G, node) {
-                        forall_out_edges(G, e, node) {
-                                NodeID target = G.getEdgeTarget(e);
-                                //dist[e] = max(dist[e],fabs(prev[node] - prev[target]));
-                                dist[e] += fabs(prev[node] - prev[target]) / 7.0;
-                        } endfor
-                } endfor
+                #pragma omp parallel for simd schedule(static) num_threads(num_threads)
+                for( size_t i = 0; i < prev.size(); i++) {
+                        prev[i] = (1-w)*prev[i] + w*next[i];
+                }
         }
 
-        forall_nodes(G, node) {
+        #pragma omp parallel for schedule(dynamic, 1024) num_threads(num_threads)
+        for( NodeID node = 0; node < n; node++) {
+                const float * node_values = &prev[node*B];
                 forall_out_edges(G, e, node) {
-                        dist[e] += 0.0001;
+                        const float * target_values = &prev[G.getEdgeTarget(e)*B];
+                        for( unsigned lane = 0; lane < lanes; lane++) {
+                                dist[e] += fabs(node_values[lane] - target_values[lane]) / (double)iterations;
+                        }
                 } endfor
-        } endfor
+        }
+}
 
+void edge_ratings::compute_algdist(graph_access & G, std::vector<float> & dist) {
+        const unsigned R          = partition_config.algdist_test_vectors;
+        const unsigned iterations = partition_config.algdist_iterations;
+        const NodeID n            = G.number_of_nodes();
+        const int num_threads     = parallel_tools::max_threads(partition_config.enable_omp);
+
+        // blocks of 4 vectors for the default of 3, blocks of 8 otherwise
+        if( R <= 4 ) {
+                std::vector<float> prev(4*(size_t)n), next(4*(size_t)n);
+                algdist_block<4>(G, R, iterations, num_threads, prev, next, dist);
+        } else {
+                std::vector<float> prev(8*(size_t)n), next(8*(size_t)n);
+                for( unsigned first = 0; first < R; first += 8) {
+                        algdist_block<8>(G, std::min(8u, R - first), iterations, num_threads, prev, next, dist);
+                }
+        }
+
+        #pragma omp parallel for schedule(static) num_threads(num_threads)
+        for( EdgeID e = 0; e < G.number_of_edges(); e++) {
+                dist[e] += 0.0001;
+        }
 }
 
 
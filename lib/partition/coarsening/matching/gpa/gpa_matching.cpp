@@ -7,10 +7,12 @@
 
 #include <algorithm>
 #include <deque>
+#include <limits>
 
 #include "compare_rating.h"
 #include "gpa_matching.h"
 #include "macros_assertions.h"
+#include "parallel_tools.h"
 #include "random_functions.h"
 
 gpa_matching::gpa_matching() {
@@ -33,48 +35,42 @@ void gpa_matching::match(const PartitionConfig & partition_config,
         edge_matching.resize(G.number_of_nodes());
         coarse_mapping.resize(G.number_of_nodes());
 
-        std::vector<EdgeID> edge_permutation;
-        edge_permutation.reserve(G.number_of_edges());
         std::vector<NodeID> sources(G.number_of_edges());
-
-        init(G, partition_config, permutation, edge_matching, edge_permutation, sources);
-
-        //permutation of the edges for random tie breaking
-        if(partition_config.edge_rating_tiebreaking) {
-                PartitionConfig gpa_perm_config     = partition_config;
-                gpa_perm_config.permutation_quality = PERMUTATION_QUALITY_GOOD;
-                random_functions::permutate_entries(gpa_perm_config, edge_permutation, false);
-        }
-
-        compare_rating cmp(&G);
-        std::sort(edge_permutation.begin(), edge_permutation.end(), cmp);
-
         path_set pathset(&G, &partition_config);
 
-        //grow the paths
-        forall_edges(G, e) {
-                EdgeID curEdge = edge_permutation[e];
-                NodeID source  = sources[curEdge];
-                NodeID target  = G.getEdgeTarget(curEdge); 
-                if(target < source) continue; // get rid of double edges
+        if(partition_config.gpa_local_max_rounds > 0) {
+                init_local_max(G, partition_config, permutation, edge_matching, sources);
+                grow_paths_local_max(partition_config, G, pathset);
+        } else {
+                std::vector<EdgeID> edge_permutation;
+                edge_permutation.reserve(G.number_of_edges());
 
-                if(G.getEdgeRating(curEdge) == 0.0) {
-                        continue;
-                }
+                init(G, partition_config, permutation, edge_matching, edge_permutation, sources);
 
-                //max vertex weight constraint
-                if(G.getNodeWeight(source) + G.getNodeWeight(target) > partition_config.max_vertex_weight) {
-                        continue;
+                //permutation of the edges for random tie breaking
+                if(partition_config.edge_rating_tiebreaking) {
+                        PartitionConfig gpa_perm_config     = partition_config;
+                        gpa_perm_config.permutation_quality = PERMUTATION_QUALITY_GOOD;
+                        random_functions::permutate_entries(gpa_perm_config, edge_permutation, false);
                 }
 
-                if( partition_config.combine ) {
-                        if(G.getSecondPartitionIndex(source) != G.getSecondPartitionIndex(target) ) {
+                compare_rating cmp(&G);
+                std::sort(edge_permutation.begin(), edge_permutation.end(), cmp);
+
+                //grow the paths
+                forall_edges(G, e) {
+                        EdgeID curEdge = edge_permutation[e];
+                        NodeID source  = sources[curEdge];
+                        NodeID target  = G.getEdgeTarget(curEdge); 
+                        if(target < source) continue; // get rid of double edges
+
+                        if(!is_eligible(partition_config, G, source, target, curEdge)) {
                                 continue;
                         }
-                }
 
-                pathset.add_if_applicable(source, curEdge);
-        } endfor 
+                        pathset.add_if_applicable(source, curEdge);
+                } endfor 
+        }
 
         extract_paths_apply_matching(G, sources, edge_matching, pathset); 
 
@@ -153,6 +149,108 @@ void gpa_matching::init(graph_access & G,
 
 
 }
+
+void gpa_matching::init_local_max(graph_access & G, 
+                                  const PartitionConfig & partition_config, 
+                                  NodePermutationMap & permutation, 
+                                  Matching & edge_matching, 
+                                  std::vector<NodeID> & sources) {
+
+        #pragma omp parallel for schedule(dynamic, 1024) num_threads(parallel_tools::max_threads(partition_config.enable_omp))
+        for( NodeID n = 0; n < G.number_of_nodes(); n++) {
+                permutation[n]   = n;
+                edge_matching[n] = n;
+
+                forall_out_edges(G, e, n) {
+                        sources[e] = n;   
+
+                        if(partition_config.edge_rating == WEIGHT) {
+                                // in that case we need to copy it
+                                G.setEdgeRating(e, G.getEdgeWeight(e));
+                        }
+                } endfor
+        }
+}
+
+void gpa_matching::grow_paths_local_max(const PartitionConfig & partition_config, 
+                                        graph_access & G, 
+                                        path_set & pathset) {
+        // ties are broken by a hash of the edge so that both endpoints agree on their order,
+        // the hash is seeded from the random generator if random tie breaking is enabled
+        unsigned long long seed = 0;
+        if(partition_config.edge_rating_tiebreaking) {
+                seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+        }
+
+        std::vector<NodeID> active(G.number_of_nodes());
+        std::vector<EdgeID> candidate(G.number_of_nodes(), UNDEFINED_EDGE);
+        forall_nodes(G, node) {
+                active[node] = node;
+        } endfor
+        int num_threads = parallel_tools::max_threads(partition_config.enable_omp);
+
+        // in every round each active node selects its best applicable edge in parallel.
+        // edges selected by both of their endpoints are locally heaviest, they form a matching
+        // and are added to the path set one after the other. nodes without an applicable edge
+        // will not get one later and are dropped, nodes whose edge is still applicable keep it
+        for( unsigned round = 0; round < partition_config.gpa_local_max_rounds && !active.empty(); round++) {
+                #pragma omp parallel for schedule(dynamic, 256) num_threads(num_threads)
+                for( size_t i = 0; i < active.size(); i++) {
+                        NodeID node = active[i];
+                        if(candidate[node] != UNDEFINED_EDGE && is_free(G, pathset, node, candidate[node])) {
+                                // edges only become inapplicable, so the selected edge is still the best one
+                                continue;
+                        }
+
+                        EdgeID best_edge            = UNDEFINED_EDGE;
+                        EdgeRatingType best_rating  = 0;
+                        unsigned long long best_key = 0;
+                        forall_out_edges(G, e, node) {
+                                // the rating and the key are checked first, they do not touch the neighbor
+                                EdgeRatingType rating = G.getEdgeRating(e);
+                                if(rating == 0.0 || rating < best_rating) continue;
+
+                                NodeID target          = G.getEdgeTarget(e);
+                                unsigned long long key = edge_key(node, target, seed);
+                                if(rating == best_rating && key <= best_key) continue;
+
+                                if(!is_eligible(partition_config, G, node, target, e)) continue;
+                                if(!is_free(G, pathset, node, e)) continue;
+
+                                best_edge   = e;
+                                best_rating = rating;
+                                best_key    = key;
+                        } endfor
+                        candidate[node] = best_edge;
+                }
+
+                bool added = false;
+                for( size_t i = 0; i < active.size(); i++) {
+                        NodeID node = active[i];
+                        EdgeID e    = candidate[node];
+                        if(e == UNDEFINED_EDGE) continue;
+
+                        NodeID target = G.getEdgeTarget(e);
+                        if(target < node) continue; // the pair is handled by the smaller endpoint
+
+                        EdgeID back = candidate[target];
+                        if(back == UNDEFINED_EDGE || G.getEdgeTarget(back) != node) continue;
+
+                        added |= pathset.add_if_applicable(node, e);
+                }
+                if(!added) break;
+
+                size_t remaining = 0;
+                for( size_t i = 0; i < active.size(); i++) {
+                        NodeID node = active[i];
+                        if(candidate[node] == UNDEFINED_EDGE) continue;
+                        if(pathset.next_vertex(node) != node && pathset.prev_vertex(node) != node) continue;
+                        active[remaining++] = node;
+                }
+                active.resize(remaining);
+        }
+}
+
 void gpa_matching::extract_paths_apply_matching(graph_access & G, 
                                                 std::vector<NodeID> & sources,
                                                 Matching & edge_matching, 
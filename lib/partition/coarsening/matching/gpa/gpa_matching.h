@@ -31,6 +31,26 @@ class gpa_matching : public matching{
                           std::vector<EdgeID>  & edge_permutation,
                           std::vector<NodeID> & sources); 
 
+                void init_local_max(graph_access & G, 
+                                    const PartitionConfig & partition_config, 
+                                    NodePermutationMap & permutation, 
+                                    Matching & edge_matching,
+                                    std::vector<NodeID> & sources); 
+
+                // grows the paths from locally heaviest edges in rounds instead of sorting all edges
+                void grow_paths_local_max(const PartitionConfig & partition_config, 
+                                          graph_access & G, 
+                                          path_set & pathset);
+
+                bool is_eligible(const PartitionConfig & partition_config, 
+                                 graph_access & G, 
+                                 NodeID source, NodeID target, EdgeID e);
+
+                // the edge can be added and does not connect node to its neighbor on the path 
+                bool is_free(graph_access & G, const path_set & pathset, NodeID node, EdgeID e);
+
+                unsigned long long edge_key(NodeID source, NodeID target, unsigned long long seed);
+
                 void extract_paths_apply_matching( graph_access & G, 
                                                    std::vector<NodeID> & sources,
                                                    Matching & edge_matching, 
@@ -60,4 +80,40 @@ class gpa_matching : public matching{
 };
 
 
+inline bool gpa_matching::is_eligible(const PartitionConfig & partition_config, 
+                                      graph_access & G, 
+                                      NodeID source, NodeID target, EdgeID e) {
+        if(G.getEdgeRating(e) == 0.0) {
+                return false;
+        }
+
+        //max vertex weight constraint
+        if(G.getNodeWeight(source) + G.getNodeWeight(target) > partition_config.max_vertex_weight) {
+                return false;
+        }
+
+        if( partition_config.combine ) {
+                if(G.getSecondPartitionIndex(source) != G.getSecondPartitionIndex(target) ) {
+                        return false;
+                }
+        }
+        return true;
+}
+
+inline bool gpa_matching::is_free(graph_access & G, const path_set & pathset, NodeID node, EdgeID e) {
+        // the neighbors on the path are reached by the edges of the path (or their 
+        // reverse edges), adding those again would close a cycle of length two
+        NodeID target = G.getEdgeTarget(e);
+        if(pathset.next_vertex(node) == target || pathset.prev_vertex(node) == target) return false;
+        return pathset.is_applicable(node, e);
+}
+
+inline unsigned long long gpa_matching::edge_key(NodeID source, NodeID target, unsigned long long seed) {
+        unsigned long long x = std::min(source, target);
+        x = (x << 32) ^ std::max(source, target) ^ (seed * 0x9E3779B97F4A7C15ULL);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+}
+
 #endif /* end of include guard: GPA_MATCHING_NXLQ0SIT */
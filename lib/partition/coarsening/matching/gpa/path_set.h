@@ -29,6 +29,9 @@ class path_set {
                 // returns true iff the edge was applicable
                 bool add_if_applicable(const NodeID & source, const EdgeID & e); 
 
+                // returns true iff add_if_applicable would add the edge, does not change the set
+                bool is_applicable(const NodeID & source, const EdgeID & e) const; 
+
                 //**********
                 //Navigation
                 //**********
@@ -110,6 +113,40 @@ inline EdgeID path_set::edge_to_prev(const NodeID & v) const {
         return m_prev_edge[v];
 }
 
+inline bool path_set::is_applicable(const NodeID & source, const EdgeID & e) const {
+        graph_access & G = *pG;
+
+        NodeID target = G.getEdgeTarget(e);
+
+        if(config->graph_allready_partitioned && !config->gpa_grow_paths_between_blocks) {
+                if(G.getPartitionIndex(source) != G.getPartitionIndex(target))
+                        return false;
+        
+                if(config->combine) {
+                        if(G.getSecondPartitionIndex(source) != G.getSecondPartitionIndex(target)) {
+                                return false;
+                        }
+                }
+        }
+
+        if(not is_endpoint(source) or not is_endpoint(target)) {
+                return false;
+        }
+
+        PathID sourcePathID = m_vertex_to_path[source]; 
+        PathID targetPathID = m_vertex_to_path[target]; 
+
+        const path & source_path = m_paths[sourcePathID];
+        const path & target_path = m_paths[targetPathID];
+
+        if(source_path.is_cycle() or target_path.is_cycle()) {
+                return false;
+        }
+
+        // joining two paths or closing a cycle of even length 
+        return sourcePathID != targetPathID or source_path.get_length() % 2 == 1;
+}
+
 inline bool path_set::add_if_applicable(const NodeID & source, const EdgeID & e) {
         graph_access & G = *pG;
 
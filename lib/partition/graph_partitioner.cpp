@@ -10,12 +10,14 @@
 #include "graph_partitioner.h"
 #include "initial_partitioning/initial_partitioning.h"
 #include "quality_metrics.h"
+#include "tools/parallel_tools.h"
 #include "tools/random_functions.h"
+#include "tools/trace.h"
 #include "uncoarsening/uncoarsening.h"
 #include "uncoarsening/refinement/mixed_refinement.h"
 #include "w_cycles/wcycle_partitioner.h"
 
-graph_partitioner::graph_partitioner() {
+graph_partitioner::graph_partitioner(refinement_workspace * workspace) : m_workspace (workspace) {
 
 }
 
@@ -87,16 +89,22 @@ void graph_partitioner::perform_recursive_partitioning_kmodel_internal(Partition
         }
         if(remaining_k > 1) {
                 std::vector< PartitionID > partition_ids(G.number_of_nodes());
+                std::vector< graph_access* > extracted_blocks;
+                std::vector< std::vector<NodeID> > mappings;
+                extractor.extract_all_blocks( G, extracted_blocks, mappings, parallel_tools::max_threads(config.enable_omp));
+
                 for( PartitionID block = 0; block < num_parts; block++) {
-                        graph_extractor ge; graph_access Q;
-                        std::vector<NodeID> mapping;
-                        ge.extract_block( G, Q, block, mapping);
+                        graph_access & Q = *extracted_blocks[block];
+                        std::vector<NodeID> & mapping = mappings[block];
                         perform_recursive_partitioning_kmodel_internal( config, Q, group_sizes);
 
                         Q.set_partition_count(remaining_k);
                         forall_nodes(Q, node) {
                                 partition_ids[mapping[node]] = Q.getPartitionIndex(node) + block*remaining_k;
                         } endfor
+
+                        delete extracted_blocks[block];
+                        std::vector<NodeID>().swap(mapping);
                 }
                 forall_nodes(G, node) {
                         G.setPartitionIndex(node, partition_ids[node]);
@@ -241,13 +249,15 @@ void graph_partitioner::single_run( PartitionConfig & config, graph_access & G)
 
         for( unsigned i = 1; i <= config.global_cycle_iterations; i++) {
                 PRINT(std::cout <<  "vcycle " << i << " of " << config.global_cycle_iterations  << std::endl;)
+                trace_scope scope("vcycle");
+                scope.arg("cycle", i);
                         if(config.use_wcycles || config.use_fullmultigrid)  {
                                 wcycle_partitioner w_partitioner;
                                 w_partitioner.perform_partitioning(config, G);
                         } else {
                                 coarsening coarsen;
                                 initial_partitioning init_part;
-                                uncoarsening uncoarsen;
+                                uncoarsening uncoarsen(m_workspace);
 
                                 graph_hierarchy hierarchy;
 
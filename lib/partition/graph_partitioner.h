@@ -13,10 +13,13 @@
 #include "data_structure/graph_access.h"
 #include "partition_config.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class graph_partitioner {
 public:
-        graph_partitioner();
+        // the local searches use the given workspace instead of their own, a partitioner
+        // can then partition several graphs one after another without reallocating it
+        graph_partitioner( refinement_workspace * workspace = NULL );
         virtual ~graph_partitioner();
 
         void perform_partitioning(PartitionConfig & graph_partitioner_config, graph_access & G);
@@ -36,6 +39,7 @@ private:
         unsigned m_global_k;
 	int m_global_upper_bound;
         int m_rnd_bal;
+        refinement_workspace * m_workspace;
 };
 
 #endif /* end of include guard: PARTITION_OL9XTLU4 */
@@ -30,7 +30,7 @@ void bipartition::initial_partition( const PartitionConfig & config,
         t.restart();
         unsigned iterations = config.bipartition_tries;
         EdgeWeight best_cut = std::numeric_limits<EdgeWeight>::max();
-        int best_load       = std::numeric_limits<int>::max();
+        SignedNodeWeight best_load = std::numeric_limits<SignedNodeWeight>::max();
 
         for( unsigned i = 0; i < iterations; i++) {
                 if(config.bipartition_algorithm == BIPARTITION_BFS)  {
@@ -46,8 +46,8 @@ void bipartition::initial_partition( const PartitionConfig & config,
                 quality_metrics qm;
                 EdgeWeight curcut = qm.edge_cut(G); 
 
-                int lhs_block_weight = 0;
-                int rhs_block_weight = 0;
+                SignedNodeWeight lhs_block_weight = 0;
+                SignedNodeWeight rhs_block_weight = 0;
 
                 forall_nodes(G, node) {
                         if(G.getPartitionIndex(node) == 0) {
@@ -57,8 +57,8 @@ void bipartition::initial_partition( const PartitionConfig & config,
                         }
                 } endfor
 
-                int lhs_overload = std::max(lhs_block_weight - config.target_weights[0],0);
-                int rhs_overload = std::max(rhs_block_weight - config.target_weights[1],0);
+                SignedNodeWeight lhs_overload = std::max(lhs_block_weight - config.target_weights[0],(SignedNodeWeight)0);
+                SignedNodeWeight rhs_overload = std::max(rhs_block_weight - config.target_weights[1],(SignedNodeWeight)0);
 
                 if(curcut < best_cut || (curcut == best_cut && lhs_overload + rhs_block_weight < best_load) ) {
                         //store it
@@ -5,7 +5,10 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <atomic>
 #include <math.h>
+#include <omp.h>
+#include <vector>
 
 #include "bipartition.h"
 #include "graph_partition_assertions.h"
@@ -14,9 +17,11 @@
 #include "initial_partitioning.h"
 #include "initial_refinement/initial_refinement.h"
 #include "initial_node_separator.h"
+#include "parallel_tools.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
 #include "timer.h"
+#include "tools/trace.h"
 
 initial_partitioning::initial_partitioning() {
 
@@ -28,6 +33,9 @@ initial_partitioning::~initial_partitioning() {
 
 void initial_partitioning::perform_initial_partitioning(const PartitionConfig & config, graph_hierarchy & hierarchy) {
         graph_access& G = *hierarchy.get_coarsest();
+        trace_scope scope("initial partitioning");
+        scope.arg("nodes", G.number_of_nodes());
+        scope.arg("edges", G.number_of_edges());
         if(config.mode_node_separators) {
                 perform_initial_partitioning_separator(config, G);
         } else {
@@ -36,8 +44,7 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
 }
 
 
-void initial_partitioning::perform_initial_partitioning(const PartitionConfig & config, graph_access &  G) {
-
+initial_partitioner* initial_partitioning::create_partitioner(const PartitionConfig & config) {
         initial_partitioner* partition = NULL;
         switch(config.initial_partitioning_type) {
                 case INITIAL_PARTITIONING_RECPARTITION:
@@ -49,6 +56,10 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
 
 
         }       
+        return partition;
+}
+
+void initial_partitioning::perform_initial_partitioning(const PartitionConfig & config, graph_access &  G) {
 
         quality_metrics qm;
         EdgeWeight best_cut;
@@ -64,7 +75,6 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
         
         timer t;
         t.restart();
-        int* partition_map  = new int[G.number_of_nodes()];
         unsigned reps_to_do = (unsigned) std::max((int)ceil(config.initial_partitioning_repetitions/(double)log2(config.k)),2);
          
         if(config.initial_partitioning_repetitions == 0) {
@@ -78,24 +88,77 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
         PRINT(std::cout << "no of initial partitioning repetitions = " << reps_to_do                     << std::endl;);
         PRINT(std::cout << "no of nodes for partition = "              << G.number_of_nodes()            << std::endl;);
         if(!((config.graph_allready_partitioned && config.no_new_initial_partitioning) || config.omit_given_partitioning)) {
+                // the repetitions run concurrently, each one on its own copy of the graph and with
+                // its own seed. the result does not depend on the number of threads: the best cut
+                // of the lowest repetition wins and repetitions after a cut of zero are skipped
+                std::vector<unsigned> seeds(reps_to_do);
                 for(unsigned int rep = 0; rep < reps_to_do; rep++) {
-                        unsigned seed = random_functions::nextInt(0, std::numeric_limits<int>::max()); 
-                        PartitionConfig working_config = config;
-                        working_config.combine = false;
-                        partition->initial_partition(working_config, seed, G, partition_map);
-                        
-                        EdgeWeight cur_cut = qm.edge_cut(G, partition_map); 
-                        if(cur_cut < best_cut) {
-                                PRINT(std::cout << "log>" << "improved the current initial partitiong from " << best_cut 
-                                                << " to " << cur_cut  << std::endl;)
-
-                                forall_nodes(G, n) {
-                                        best_map[n] = partition_map[n];
-                                } endfor
-
-                                best_cut = cur_cut; 
-                                if(best_cut == 0) break;
+                        seeds[rep] = random_functions::nextInt(0, std::numeric_limits<int>::max()); 
+                }
+                unsigned continue_seed = random_functions::nextInt(0, std::numeric_limits<int>::max()); 
+
+                int num_threads = std::min(parallel_tools::max_threads(config.enable_omp), (int)reps_to_do);
+                std::vector<EdgeWeight> thread_best_cut(num_threads, std::numeric_limits<EdgeWeight>::max());
+                std::vector<unsigned> thread_best_rep(num_threads, reps_to_do);
+                std::vector< std::vector<int> > thread_best_map(num_threads);
+                std::atomic<unsigned> first_perfect_rep(reps_to_do);
+
+                #pragma omp parallel num_threads(num_threads)
+                {
+                        int id = omp_get_thread_num();
+                        graph_access G_copy;
+                        if(id > 0) G.copy(G_copy);
+                        graph_access & local_G = id == 0 ? G : G_copy;
+
+                        quality_metrics local_qm;
+                        initial_partitioner* partition = create_partitioner(config);
+                        std::vector<int> partition_map(G.number_of_nodes());
+
+                        #pragma omp for schedule(dynamic, 1)
+                        for(unsigned int rep = 0; rep < reps_to_do; rep++) {
+                                if(rep > first_perfect_rep.load()) continue;
+
+                                random_functions::setSeed(seeds[rep]);
+                                PartitionConfig working_config = config;
+                                working_config.combine = false;
+                                partition->initial_partition(working_config, seeds[rep], local_G, &partition_map[0]);
+
+                                EdgeWeight cur_cut = local_qm.edge_cut(local_G, &partition_map[0]); 
+                                if(cur_cut < thread_best_cut[id]) {
+                                        thread_best_cut[id] = cur_cut;
+                                        thread_best_rep[id] = rep;
+                                        thread_best_map[id].swap(partition_map);
+                                        partition_map.resize(G.number_of_nodes());
+                                }
+
+                                if(cur_cut == 0) {
+                                        unsigned perfect_rep = first_perfect_rep.load();
+                                        while(rep < perfect_rep && !first_perfect_rep.compare_exchange_weak(perfect_rep, rep));
+                                }
                         }
+                        delete partition;
+                }
+                random_functions::setSeed(continue_seed);
+
+                int best_thread = -1;
+                for( int id = 0; id < num_threads; id++) {
+                        if(thread_best_rep[id] == reps_to_do) continue;
+                        if(best_thread == -1 
+                        || thread_best_cut[id] < thread_best_cut[best_thread]
+                        || (thread_best_cut[id] == thread_best_cut[best_thread] && thread_best_rep[id] < thread_best_rep[best_thread])) {
+                                best_thread = id;
+                        }
+                }
+
+                if(best_thread != -1 && thread_best_cut[best_thread] < best_cut) {
+                        PRINT(std::cout << "log>" << "improved the current initial partitiong from " << best_cut 
+                                        << " to " << thread_best_cut[best_thread]  << std::endl;)
+
+                        forall_nodes(G, n) {
+                                best_map[n] = thread_best_map[best_thread][n];
+                        } endfor
+
+                        best_cut = thread_best_cut[best_thread]; 
                 }
 
                 forall_nodes(G, n) {
@@ -123,9 +186,7 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
 
         ASSERT_TRUE(graph_partition_assertions::assert_graph_has_kway_partition(config, G));
 
-        delete[] partition_map;
         delete[] best_map;
-        delete partition;
 }
 
 void initial_partitioning::perform_initial_partitioning_separator(const PartitionConfig & config, graph_access &  G) {
@@ -9,6 +9,7 @@
 #define INITIAL_PARTITIONING_D7VA0XO9
 
 #include "data_structure/graph_hierarchy.h"
+#include "initial_partitioner.h"
 #include "partition_config.h"
 
 class initial_partitioning {
@@ -18,6 +19,9 @@ public:
         void perform_initial_partitioning(const PartitionConfig & config, graph_hierarchy & hierarchy);
         void perform_initial_partitioning(const PartitionConfig & config, graph_access &  G);
         void perform_initial_partitioning_separator(const PartitionConfig & config, graph_access &  G);
+
+private:
+        initial_partitioner* create_partitioner(const PartitionConfig & config);
 };
 
 
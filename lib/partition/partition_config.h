@@ -25,6 +25,11 @@ struct PartitionConfig
         bool edge_rating_tiebreaking;
 
         EdgeRating edge_rating;
+
+        // test vectors and smoothing iterations of the algebraic distance rating
+        unsigned algdist_test_vectors;
+
+        unsigned algdist_iterations;
         
         PermutationQuality permutation_quality;
 
@@ -43,6 +48,10 @@ struct PartitionConfig
 	NodeWeight work_load;
 
         unsigned aggressive_random_levels;
+
+        // gpa grows its paths from locally heaviest edges in this many parallel rounds
+        // instead of sorting all edges, 0 uses the sorted sequential growth
+        unsigned gpa_local_max_rounds;
         
         bool disable_max_vertex_weight_constraint;
 
@@ -124,6 +133,8 @@ struct PartitionConfig
 
         double flow_region_factor;
 
+        unsigned flow_piercing_steps;
+
         bool gpa_grow_paths_between_blocks;
 
         //=======================================
@@ -283,6 +294,14 @@ struct PartitionConfig
 
         std::string filename_output;
 
+        std::string trace_filename;
+
+        std::string generator;
+
+        NodeID generator_nodes;
+
+        double generator_avg_degree;
+
         bool kaffpa_perfectly_balance;
 
         bool mode_node_separators;
@@ -304,6 +323,13 @@ struct PartitionConfig
 
         bool label_propagation_refinement;
 
+        // run the label propagation refinement with all OpenMP threads. strict balance
+        // reserves the weight in the target block before a move, relaxed balance only
+        // checks it and may overload blocks by concurrent moves
+        bool parallel_label_propagation_refinement;
+
+        LabelPropagationBalance label_propagation_refinement_balance;
+
         double balance_factor;
 
         bool cluster_coarsening_during_ip;
@@ -359,11 +385,11 @@ struct PartitionConfig
         // variables controling the size of the blocks during 
         // multilevel recursive bisection
         // (for the case where k is not a power of 2)
-        std::vector<int> target_weights;
+        std::vector<SignedNodeWeight> target_weights;
 
         bool initial_bipartitioning;
 
-        int grow_target;
+        SignedNodeWeight grow_target;
 
 
         //=======================================
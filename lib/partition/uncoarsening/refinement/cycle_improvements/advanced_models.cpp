@@ -18,7 +18,7 @@
 #include "uncoarsening/refinement/kway_graph_refinement/kway_stop_rule.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/vertex_moved_hashtable.h"
 
-unsigned long advanced_models::conflicts = 0;
+thread_local unsigned long advanced_models::conflicts = 0;
 
 
 advanced_models::advanced_models() {
@@ -141,12 +141,6 @@ bool advanced_models::compute_vertex_movements_rebalance( PartitionConfig & conf
         //*************************************************************************************
         //solve shortest path problem in model 
         //*************************************************************************************
-        //check wether t is reachable from s by performing a bfs
-	std::deque<NodeID>* bfsqueue = new std::deque<NodeID>;
-        std::vector<bool> touched(cycle_problem.number_of_nodes(), false);
-        bfsqueue->push_back(s);
-        touched[s] = true;
-
         cycle_search cs;
         std::vector<NodeID> path;
         cs.find_shortest_path(cycle_problem, s, t, path);
@@ -47,7 +47,7 @@ class advanced_models {
                                 NodeID & s, NodeID & t, 
                                 augmented_Qgraph & aqg);
 
-                static unsigned long conflicts;
+                static thread_local unsigned long conflicts;
         private:
                 inline
                         bool build_ultra_model( PartitionConfig & config, 
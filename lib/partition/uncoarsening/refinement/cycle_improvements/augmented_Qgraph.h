@@ -74,6 +74,12 @@ public:
         // commit a pairwise local search
         void commit_pairwise_local_search( boundary_pair & pair, pairwise_local_search & pls);
 
+        // access to the stored local searches, used to keep them over several rounds
+        std::vector<pairwise_local_search> & get_local_searches( boundary_pair & pair) { return m_aqg[pair].local_searches; };
+        bool contains_pair( boundary_pair & pair) { return m_aqg.find(pair) != m_aqg.end(); };
+        void clear_pair( boundary_pair & pair) { m_aqg.erase(pair); };
+        void clear() { m_aqg.clear(); };
+
         //query wether to local searches are conflicted
         bool check_conflict( const  PartitionConfig & config, 
                              PartitionID & lhs, PartitionID & rhs, 
@@ -145,6 +151,10 @@ void augmented_Qgraph::prepare( PartitionConfig & config, graph_access & G, grap
                         bp.lhs = lhs;
                         bp.rhs = rhs;
 
+                        // the searches may have been prepared before
+                        m_aqg[bp].search_to_use.clear();
+                        m_aqg[bp].search_gain.clear();
+                        m_aqg[bp].search_num_moves.clear();
                         if( m_aqg[bp].local_searches.size() == 0 ) continue;
 
                         //estimate the maximum load difference from lhs to rhs on this edge
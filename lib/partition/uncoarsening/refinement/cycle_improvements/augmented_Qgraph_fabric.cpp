@@ -6,10 +6,14 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <deque>
+#include <limits>
+#include <omp.h>
 
 #include "algorithms/cycle_search.h"
 #include "augmented_Qgraph_fabric.h"
 #include "data_structure/priority_queues/bucket_pq.h"
+#include "parallel_tools.h"
 #include "partition_snapshooter.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
@@ -17,7 +21,7 @@
 #include "uncoarsening/refinement/kway_graph_refinement/kway_stop_rule.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/vertex_moved_hashtable.h"
 
-augmented_Qgraph_fabric::augmented_Qgraph_fabric() {
+augmented_Qgraph_fabric::augmented_Qgraph_fabric() : m_incremental(false) {
 }
 
 augmented_Qgraph_fabric::~augmented_Qgraph_fabric() {
@@ -31,6 +35,30 @@ void augmented_Qgraph_fabric::cleanup_eligible() {
         m_tomake_eligible.clear();
  }
 
+void augmented_Qgraph_fabric::init_eligible(PartitionConfig & config, graph_access & G) {
+        if(m_eligible.size() != G.number_of_nodes()) {
+                m_eligible.assign(G.number_of_nodes(), true);
+                m_tomake_eligible.clear();
+                m_kept_neighborhood.assign(G.number_of_nodes(), false);
+                m_changed.assign(G.number_of_nodes(), false);
+                m_commit_block.assign(G.number_of_nodes(), INVALID_PARTITION);
+                m_incremental = false;
+        } else {
+                cleanup_eligible();
+        }
+
+        // the maximum degree is computed lazily, so this has to happen before the searches run concurrently
+        EdgeWeight max_degree = G.getMaxDegree();
+        m_workspaces.resize(std::max((int)m_workspaces.size(), parallel_tools::max_threads(config.enable_omp)));
+        for( unsigned i = 0; i < m_workspaces.size(); i++) {
+                if(m_workspaces[i].moved_to.size() != G.number_of_nodes()) {
+                        m_workspaces[i].moved_to.assign(G.number_of_nodes(), INVALID_PARTITION);
+                }
+                m_workspaces[i].queue_lhs.reset(max_degree);
+                m_workspaces[i].queue_rhs.reset(max_degree);
+        }
+}
+
 bool augmented_Qgraph_fabric::build_augmented_quotient_graph( PartitionConfig & config, 
                                                               graph_access & G, 
                                                               complete_boundary & boundary, 
@@ -39,14 +67,9 @@ bool augmented_Qgraph_fabric::build_augmented_quotient_graph( PartitionConfig &
 
         graph_access G_bar;
         boundary.getUnderlyingQuotientGraph(G_bar); 
-        if(m_eligible.size() != G.number_of_nodes()) {
-                m_eligible.resize(G.number_of_nodes());
-                forall_nodes(G, node) {
-                        m_eligible[node] = true;
-                } endfor
-        } else {
-                cleanup_eligible();
-        }
+        init_eligible(config, G);
+        // the searches are done from scratch, so a following update can not reuse them
+        m_incremental = false;
 
         if(!rebalance) {
                 std::vector<block_pair_difference> vec_bpd;
@@ -61,24 +84,7 @@ bool augmented_Qgraph_fabric::build_augmented_quotient_graph( PartitionConfig &
                         } endfor 
                 } endfor
 
-
-                for( unsigned j = 0; j < config.kaba_packing_iterations; j++) {
-                        random_functions::permutate_vector_good_small(vec_bpd);
-                        bool variant_to_use = plus;
-                        for( unsigned i = 0; i < vec_bpd.size(); i++) {
-                                boundary_pair bp;
-                                bp.k   = config.k;
-                                bp.lhs = vec_bpd[i].lhs;
-                                bp.rhs = vec_bpd[i].rhs;
-
-                                if( plus && config.kaba_flip_packings) {
-                                        //best of both worlds
-                                        variant_to_use = random_functions::nextBool();
-                                }
-
-                                local_search( config, variant_to_use, G, boundary, aqg, bp, s);
-                        }
-                }
+                perform_local_searches( config, G, boundary, aqg, vec_bpd, s, plus);
         } else {
                 std::vector<block_pair_difference> vec_bpd;
                 bool graph_model_will_be_feasable = false;
@@ -111,7 +117,7 @@ bool augmented_Qgraph_fabric::build_augmented_quotient_graph( PartitionConfig &
 
                 if( !graph_model_will_be_feasable) {
                         // fall back solution
-			std::deque<NodeID>* bfsqueue = new std::deque<NodeID>;
+                        std::deque<NodeID> bfsqueue;
                         std::vector< int > parent(G_bar.number_of_nodes(), -1); 
 
                         std::vector<NodeID> start_vertices;
@@ -126,25 +132,23 @@ bool augmented_Qgraph_fabric::build_augmented_quotient_graph( PartitionConfig &
 
                         random_functions::permutate_vector_good_small(start_vertices);
                         for( unsigned i = 0; i < start_vertices.size(); i++) {
-                                bfsqueue->push_back(start_vertices[i]);
+                                bfsqueue.push_back(start_vertices[i]);
                                 parent[start_vertices[i]] = start_vertices[i];
                         }
 
-                        while(!bfsqueue->empty()) {
-                                NodeID lhs = bfsqueue->front();
-                                bfsqueue->pop_front();
+                        while(!bfsqueue.empty()) {
+                                NodeID lhs = bfsqueue.front();
+                                bfsqueue.pop_front();
 
                                 forall_out_edges(G_bar, e, lhs) {
                                         NodeID rhs = G_bar.getEdgeTarget(e);
 
                                         if(parent[rhs] == -1 && boundary.getDirectedBoundary(lhs, lhs, rhs).size() > 0) {
                                                 parent[rhs] = lhs;
-                                                bfsqueue->push_back(rhs);
+                                                bfsqueue.push_back(rhs);
                                         }
                                 } endfor
                         }
-
-                        delete bfsqueue;
                     
                         int cur_block;
                         int start_block;
@@ -201,139 +205,451 @@ bool augmented_Qgraph_fabric::build_augmented_quotient_graph( PartitionConfig &
                                 } 
                                 allready_performed_local_search[config.k*bp.lhs+bp.rhs] = true;
                         } 
-                        for( unsigned j = 0; j < config.kaba_packing_iterations; j++) {
-                                random_functions::permutate_vector_good_small(vec_bpd);
+                } 
 
-                                for( unsigned i = 0; i < vec_bpd.size(); i++) {
-                                        boundary_pair bp;
-                                        bp.k   = config.k;
-                                        bp.lhs = vec_bpd[i].lhs;
-                                        bp.rhs = vec_bpd[i].rhs;
+                perform_local_searches( config, G, boundary, aqg, vec_bpd, s, false);
+
+        }
 
-                                        local_search( config, false, G, boundary, aqg, bp, s);
+        return false;
+}
+
+void augmented_Qgraph_fabric::update_augmented_quotient_graph( PartitionConfig & config, 
+                                                               graph_access & G, 
+                                                               complete_boundary & boundary, 
+                                                               augmented_Qgraph & aqg, 
+                                                               unsigned & s) {
+        graph_access G_bar;
+        boundary.getUnderlyingQuotientGraph(G_bar); 
+        init_eligible(config, G);
+
+        // the movements performed since the last call are taken from the stored searches,
+        // hence the moved nodes are found by looking at the nodes of these searches
+        std::vector<NodeID> moved_nodes;
+        std::vector<bool> touched_block(config.k, false);
+        if(m_incremental) {
+                for( unsigned i = 0; i < m_searched_pairs.size(); i++) {
+                        std::vector<pairwise_local_search> & searches = aqg.get_local_searches(m_searched_pairs[i]);
+                        for( unsigned j = 0; j < searches.size(); j++) {
+                                for( unsigned l = 0; l < searches[j].vertex_movements.size(); l++) {
+                                        NodeID node = searches[j].vertex_movements[l];
+                                        if(G.getPartitionIndex(node) != m_commit_block[node]) {
+                                                touched_block[m_commit_block[node]]     = true;
+                                                touched_block[G.getPartitionIndex(node)] = true;
+                                                moved_nodes.push_back(node);
+                                        }
                                 }
                         }
-                } else {
-                        for( unsigned j = 0; j < config.kaba_packing_iterations; j++) {
-                                random_functions::permutate_vector_good_small(vec_bpd);
+                }
+        }
 
-                                for( unsigned i = 0; i < vec_bpd.size(); i++) {
-                                        boundary_pair bp;
-                                        bp.k   = config.k;
-                                        bp.lhs = vec_bpd[i].lhs;
-                                        bp.rhs = vec_bpd[i].rhs;
+        std::vector<boundary_pair> searched_pairs;
+        if(moved_nodes.empty()) {
+                // nothing has been moved, so the searches are redone with new random choices
+                aqg.clear();
+        } else {
+                std::vector<NodeID> changed_nodes;
+                for( unsigned i = 0; i < moved_nodes.size(); i++) {
+                        NodeID node = moved_nodes[i];
+                        if(!m_changed[node]) { m_changed[node] = true; changed_nodes.push_back(node); }
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if(!m_changed[target]) { m_changed[target] = true; changed_nodes.push_back(target); }
+                        } endfor
+                }
+
+                // a search stays valid if neither its nodes nor their neighbors have been moved.
+                // the pairs of touched blocks are searched again since their boundaries changed
+                for( unsigned i = 0; i < m_searched_pairs.size(); i++) {
+                        boundary_pair & bp = m_searched_pairs[i];
+                        std::vector<pairwise_local_search> & searches = aqg.get_local_searches(bp);
+                        bool valid = !touched_block[bp.lhs] && !touched_block[bp.rhs];
+                        for( unsigned j = 0; j < searches.size() && valid; j++) {
+                                for( unsigned l = 0; l < searches[j].vertex_movements.size(); l++) {
+                                        if(m_changed[searches[j].vertex_movements[l]]) {
+                                                valid = false;
+                                                break;
+                                        }
+                                }
+                        }
+
+                        if(!valid) {
+                                aqg.clear_pair(bp);
+                                continue;
+                        }
 
-                                        local_search( config, false, G, boundary, aqg, bp, s);
+                        searched_pairs.push_back(bp);
+                        for( unsigned j = 0; j < searches.size(); j++) {
+                                for( unsigned l = 0; l < searches[j].vertex_movements.size(); l++) {
+                                        block_neighborhood(G, searches[j].vertex_movements[l]);
                                 }
                         }
                 }
 
+                for( unsigned i = 0; i < changed_nodes.size(); i++) {
+                        m_changed[changed_nodes[i]] = false;
+                }
         }
 
-        return false;
+        std::vector<block_pair_difference> vec_bpd;
+        forall_nodes(G_bar, lhs) {
+                forall_out_edges(G_bar, e, lhs) {
+                        EdgeID rhs = G_bar.getEdgeTarget(e);
+
+                        boundary_pair bp;
+                        bp.k   = config.k;
+                        bp.lhs = lhs;
+                        bp.rhs = rhs;
+                        if(aqg.contains_pair(bp)) continue;
+
+                        block_pair_difference bpd;
+                        bpd.lhs = lhs;
+                        bpd.rhs = rhs;
+                        vec_bpd.push_back(bpd);
+                        searched_pairs.push_back(bp);
+                } endfor 
+        } endfor
+
+        perform_local_searches( config, G, boundary, aqg, vec_bpd, s, false);
+
+        m_searched_pairs.swap(searched_pairs);
+        m_incremental = true;
+}
+
+void augmented_Qgraph_fabric::perform_local_searches( PartitionConfig & config, 
+                                                      graph_access & G, 
+                                                      complete_boundary & boundary,
+                                                      augmented_Qgraph & aqg,
+                                                      std::vector<block_pair_difference> & vec_bpd,
+                                                      unsigned s,
+                                                      bool plus) {
+        std::vector<pairwise_search_task> tasks(vec_bpd.size());
+        std::vector<unsigned> block_batch(config.k, 0);
+        std::vector<unsigned> pending;
+        std::vector<unsigned> batch;
+        std::vector<unsigned> deferred;
+        unsigned batch_id = 0;
+
+        for( unsigned j = 0; j < config.kaba_packing_iterations; j++) {
+                random_functions::permutate_vector_good_small(vec_bpd);
+
+                pending.clear();
+                for( unsigned i = 0; i < vec_bpd.size(); i++) {
+                        pairwise_search_task & task = tasks[i];
+                        task.pair.k   = config.k;
+                        task.pair.lhs = vec_bpd[i].lhs;
+                        task.pair.rhs = vec_bpd[i].rhs;
+                        task.plus     = plus;
+
+                        if( plus && config.kaba_flip_packings) {
+                                //best of both worlds
+                                task.plus = random_functions::nextBool();
+                        }
+                        task.seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+                        pending.push_back(i);
+                }
+
+                // the searches of a batch work on pairwise distinct blocks and run concurrently, each with its own seed.
+                // they are committed in the order of the round, a search that conflicts with a search committed 
+                // before it is repeated in the next batch. the result does not depend on the number of threads
+                while(!pending.empty()) {
+                        batch_id++;
+                        batch.clear();
+                        deferred.clear();
+                        for( unsigned i = 0; i < pending.size(); i++) {
+                                pairwise_search_task & task = tasks[pending[i]];
+                                if(block_batch[task.pair.lhs] == batch_id || block_batch[task.pair.rhs] == batch_id) {
+                                        deferred.push_back(pending[i]);
+                                        continue;
+                                }
+                                block_batch[task.pair.lhs] = batch_id;
+                                block_batch[task.pair.rhs] = batch_id;
+                                prepare_search_task(config, boundary, task);
+                                batch.push_back(pending[i]);
+                        }
+
+                        unsigned continue_seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+                        int num_threads        = std::min(parallel_tools::max_threads(config.enable_omp), (int)batch.size());
+                        #pragma omp parallel num_threads(num_threads)
+                        {
+                                pairwise_search_workspace & ws = m_workspaces[omp_get_thread_num()];
+
+                                #pragma omp for schedule(dynamic, 1)
+                                for( unsigned i = 0; i < batch.size(); i++) {
+                                        pairwise_search_task & task = tasks[batch[i]];
+                                        random_functions::setSeed(task.seed);
+                                        run_search_task(config, G, ws, task, s);
+                                }
+                        }
+                        random_functions::setSeed(continue_seed);
+
+                        pending.clear();
+                        for( unsigned i = 0; i < batch.size(); i++) {
+                                if(!commit_search_task(config, G, boundary, aqg, tasks[batch[i]])) {
+                                        pending.push_back(batch[i]);
+                                }
+                        }
+                        for( unsigned i = 0; i < m_kept_touched.size(); i++) {
+                                m_kept_neighborhood[m_kept_touched[i]] = false;
+                        }
+                        m_kept_touched.clear();
+                        pending.insert(pending.end(), deferred.begin(), deferred.end());
+                }
+        }
+}
+
+bool augmented_Qgraph_fabric::local_search(PartitionConfig & config, 
+                                           bool plus,
+                                           graph_access & G, 
+                                           complete_boundary & boundary,
+                                           augmented_Qgraph & aqg,
+                                           boundary_pair & pair,
+                                           unsigned s ) {
+        pairwise_search_task task;
+        task.pair = pair;
+        task.plus = plus;
+
+        prepare_search_task(config, boundary, task);
+        run_search_task(config, G, m_workspaces[0], task, s);
+        commit_search_task(config, G, boundary, aqg, task);
+
+        return task.found_start_node;
 }
 
-bool augmented_Qgraph_fabric::construct_local_searches_on_qgraph_edge( PartitionConfig & config, graph_access & G, 
-                                                                       complete_boundary & boundary, augmented_Qgraph & aqg, 
-                                                                       boundary_pair & pair, 
-                                                                       unsigned s,
-                                                                       bool plus) {
-        PartitionID lhs = pair.lhs;
-        PartitionID rhs = pair.rhs;
+void augmented_Qgraph_fabric::prepare_search_task( PartitionConfig & config, 
+                                                   complete_boundary & boundary, 
+                                                   pairwise_search_task & task) {
+        PartitionID lhs = task.pair.lhs;
+        PartitionID rhs = task.pair.rhs;
 
         //initialize todo list
+        task.lhs_boundary.clear();
         PartialBoundary & lhs_b = boundary.getDirectedBoundary(lhs, lhs, rhs);
-        std::vector<NodeID> lhs_boundary; // todo list
         forall_boundary_nodes(lhs_b, node) {
                 if(m_eligible[node]) {
-                        lhs_boundary.push_back(node);
+                        task.lhs_boundary.push_back(node);
                 }
         } endfor
 
-        if(lhs_boundary.size() == 0) {  
+        task.input_cut = boundary.getEdgeCut(lhs, rhs);
+}
+
+void augmented_Qgraph_fabric::run_search_task( PartitionConfig & config, 
+                                               graph_access & G, 
+                                               pairwise_search_workspace & ws,
+                                               pairwise_search_task & task,
+                                               unsigned s) {
+        PartitionID lhs = task.pair.lhs;
+        PartitionID rhs = task.pair.rhs;
+
+        task.found_start_node = false;
+        task.pls              = pairwise_local_search();
+        task.kept_nodes.clear();
+        task.kept_blocks.clear();
+
+        if(task.lhs_boundary.size() == 0) {  
                 //nothing todo 
-                return false; 
+                return; 
         }
 
-        //commons = kway_graph_refinement_commons::getInstance(config);
-        for( unsigned i = 0; i < 1; i++) {
+        NodeID start_node = task.lhs_boundary[0];
+        find_eligible_start_node( G, lhs, rhs, task.lhs_boundary, m_eligible, start_node);
 
-                if(lhs_boundary.size() == 0) return false;
+        if(!m_eligible[start_node]) return; // in this case the lhs_boundary was empty and we cant move a node
+        task.found_start_node = true;
 
-                pairwise_local_search pls;
+        if(task.plus) {
+                more_locallized_search(config, G, ws, lhs, rhs, task.input_cut, start_node, s, task);
+        } else {
+                directed_more_locallized_search(config, G, ws, lhs, rhs, task.input_cut, start_node, s, task);
+        }
 
-                NodeID start_node = lhs_boundary[0];
-                find_eligible_start_node( G, lhs, rhs,  lhs_boundary, m_eligible, start_node);
-                
-                if(!m_eligible[start_node]) return false; // in this case the lhs_boundary was empty and we cant move a node
+        //undo the movements
+        for( unsigned i = 0; i < ws.moved.size(); i++) {
+                ws.moved_to[ws.moved[i]] = INVALID_PARTITION;
+        }
+        ws.moved.clear();
+}
 
-                if(plus) {
-                        more_locallized_search(config, G,  boundary, lhs, rhs, start_node, s, pls);
-                } else {
-                        directed_more_locallized_search(config, G,  boundary, lhs, rhs, start_node, s, pls);
-                }
+bool augmented_Qgraph_fabric::commit_search_task( PartitionConfig & config, 
+                                                  graph_access & G, 
+                                                  complete_boundary & boundary, 
+                                                  augmented_Qgraph & aqg,
+                                                  pairwise_search_task & task) {
+        if(!task.found_start_node) return true;
+
+        std::vector<NodeID> & vertex_movements = task.pls.vertex_movements;
+        for( unsigned i = 0; i < task.kept_nodes.size(); i++) {
+                NodeID node = task.kept_nodes[i];
+                if(!m_eligible[node] || m_kept_neighborhood[node]) return false;
+        }
+        for( unsigned i = 0; i < vertex_movements.size(); i++) {
+                NodeID node = vertex_movements[i];
+                if(!m_eligible[node] || m_kept_neighborhood[node]) return false;
+        }
 
-                aqg.commit_pairwise_local_search(pair, pls);
+        // the movements of the plus variant that improved the cut are not undone
+        for( unsigned i = 0; i < task.kept_nodes.size(); i++) {
+                NodeID node      = task.kept_nodes[i];
+                PartitionID from = G.getPartitionIndex(node);
+                PartitionID to   = task.kept_blocks[i];
+                perform_simple_move( config, G, boundary, node, from, to);
 
-                if( plus ) {
-                        // keep things simple
-                        boundary_pair opp_pair = pair;
-                        std::swap(opp_pair.lhs, opp_pair.rhs);
-                        aqg.commit_pairwise_local_search(opp_pair, pls);
-                }
+                m_eligible[node] = false;
+                m_tomake_eligible.push_back(node);
+
+                // the gains of the nodes around it changed, searches of the same batch using them are repeated
+                m_kept_neighborhood[node] = true;
+                m_kept_touched.push_back(node);
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        if(!m_kept_neighborhood[target]) {
+                                m_kept_neighborhood[target] = true;
+                                m_kept_touched.push_back(target);
+                        }
+                } endfor
+        }
+
+        //block the moved nodes and their neighbors to avoid conflicts
+        for( unsigned i = 0; i < vertex_movements.size(); i++) {
+                NodeID node = vertex_movements[i];
+                m_commit_block[node] = G.getPartitionIndex(node);
+                block_neighborhood(G, node);
+        }
+
+        aqg.commit_pairwise_local_search(task.pair, task.pls);
+
+        if( task.plus ) {
+                // keep things simple
+                boundary_pair opp_pair = task.pair;
+                std::swap(opp_pair.lhs, opp_pair.rhs);
+                aqg.commit_pairwise_local_search(opp_pair, task.pls);
         }
         return true;
 }
 
-//this method performes a directed localized local search and UNDOs them
-//these searches are for the augmented qgraph structure for balanced graph partitioning
+void augmented_Qgraph_fabric::block_neighborhood(graph_access & G, NodeID node) {
+        if(m_eligible[node]) m_tomake_eligible.push_back(node);
+        m_eligible[node] = false;
+
+        forall_out_edges(G, e, node) {
+                NodeID target = G.getEdgeTarget(e);
+                if(m_eligible[target]) m_tomake_eligible.push_back(target);
+                m_eligible[target] = false;
+        } endfor
+}
+
+void augmented_Qgraph_fabric::int_ext_degree( graph_access & G, 
+                                              pairwise_search_workspace & ws, 
+                                              NodeID node, 
+                                              PartitionID lhs, 
+                                              PartitionID rhs, 
+                                              EdgeWeight & int_degree, 
+                                              EdgeWeight & ext_degree) {
+        int_degree = 0;
+        ext_degree = 0;
+
+        forall_out_edges(G, e, node) {
+                PartitionID targets_partition = block_of(G, ws, G.getEdgeTarget(e));
+
+                if(targets_partition == lhs) {
+                        int_degree += G.getEdgeWeight(e); 
+                } else if(targets_partition == rhs) {
+                        ext_degree += G.getEdgeWeight(e);
+                }
+        } endfor
+}
+
+void augmented_Qgraph_fabric::move_node(graph_access & G, 
+                                        pairwise_search_workspace & ws,
+                                        NodeID node, 
+                                        refinement_pq * queue, 
+                                        refinement_pq * to_queue, 
+                                        PartitionID from, 
+                                        PartitionID to) {
+        ws.moved_to[node] = to;
+        ws.moved.push_back(node);
+
+        //update gain of neighbors, to_queue is NULL if only nodes of from are moved
+        forall_out_edges(G, e, node) {
+                NodeID target          = G.getEdgeTarget(e);
+                PartitionID target_pid = block_of(G, ws, target);
+
+                refinement_pq* cur_queue = NULL;
+                if(target_pid == from) {
+                        cur_queue = queue;         
+                } else if (target_pid == to) {
+                        cur_queue = to_queue;
+                } 
+                if(cur_queue == NULL) continue;
+        
+                EdgeWeight int_degree = 0;
+                EdgeWeight ext_degree = 0;
+
+                PartitionID other_pid = target_pid == from ? to : from;
+                int_ext_degree(G, ws, target, target_pid, other_pid, int_degree, ext_degree); 
+                Gain gain = ext_degree - int_degree;
+
+                if(cur_queue->contains(target)) {
+                        if(ext_degree > 0) {
+                                cur_queue->changeKey(target, gain);
+                        } else {
+                                cur_queue->deleteNode(target);
+                        }
+                } else {
+                        if(ext_degree > 0 && is_eligible(ws, target)) {
+                                cur_queue->insert(target, gain);
+                        } 
+                }
+
+        } endfor
+}
+
+//this method performes a directed localized local search on the nodes of the workspace,
+//the caller undoes the movements. these searches are for the augmented qgraph structure for balanced graph partitioning
 void augmented_Qgraph_fabric::directed_more_locallized_search(PartitionConfig & config, graph_access & G, 
-                                                   complete_boundary & boundary,  
-                                                   PartitionID & lhs, PartitionID & rhs,
-                                                   NodeID start_node, unsigned & number_of_swaps, pairwise_local_search & pls) {
+                                                              pairwise_search_workspace & ws,
+                                                              PartitionID lhs, PartitionID rhs, EdgeWeight input_cut,
+                                                              NodeID start_node, unsigned number_of_swaps, 
+                                                              pairwise_search_task & task) {
 
-        //commons = kway_graph_refinement_commons::getInstance(config);
-        EdgeWeight max_degree = G.getMaxDegree();
-        refinement_pq* queue  = new bucket_pq(max_degree);
+        refinement_pq* queue = &ws.queue_lhs;
+        queue->clear();
 
         EdgeWeight int_degree = 0;
         EdgeWeight ext_degree = 0;
-        m_twfm.int_ext_degree(G, start_node, lhs, rhs, int_degree, ext_degree);
+        int_ext_degree(G, ws, start_node, lhs, rhs, int_degree, ext_degree);
 
         Gain gain = ext_degree - int_degree; 
         queue->insert(start_node, gain);
-        
-        if(queue->empty()) {delete queue; return;}
 
         ////roll forwards
-        int movements    = 0;
-        int overall_gain = 0;
+        int movements     = 0;
+        Gain overall_gain = 0;
 
-        kway_stop_rule* stopping_rule = new kway_simple_stop_rule(config);
+        kway_simple_stop_rule stopping_rule(config);
 
         int min_cut_index    = 0;
         int step_limit       = 200;
-        EdgeWeight input_cut = boundary.getEdgeCut(lhs, rhs);
         EdgeWeight min_cut   = input_cut;
-        PartitionID from     = lhs;
-        PartitionID to       = rhs;
+        pairwise_local_search & pls = task.pls;
 
         for(movements = 0; movements < (int)number_of_swaps; movements++) {
                 if( queue->empty() ) {
                         break;
                 }
-                if( stopping_rule->search_should_stop(min_cut_index, movements, step_limit) ) break;
+                if( stopping_rule.search_should_stop(min_cut_index, movements, step_limit) ) break;
 
 
                 Gain gain   = queue->maxValue();
                 NodeID node = queue->deleteMax();
 
-                move_node(config, G, node, queue, boundary, from, to);
+                move_node(G, ws, node, queue, NULL, lhs, rhs);
 
                 overall_gain += gain;
                 input_cut -= gain;
         
-                stopping_rule->push_statistics(gain);
+                stopping_rule.push_statistics(gain);
 
                 if(input_cut < min_cut) {
                         min_cut_index = movements;
@@ -341,45 +657,27 @@ void augmented_Qgraph_fabric::directed_more_locallized_search(PartitionConfig &
                 }
 
                 pls.vertex_movements.push_back(node);
-                pls.block_movements.push_back(to);
+                pls.block_movements.push_back(rhs);
                 pls.gains.push_back(overall_gain);
-                m_tomake_eligible.push_back(node);
         }
-
-        ////roll backwards
-        int idx = pls.vertex_movements.size()-1;
-        for(; idx >= 0; idx--) {
-                NodeID node = pls.vertex_movements[idx];
-                move_node(config, G, node,  queue, boundary, to, from);
-
-                //block the neighboring nodes to avoid conflicts
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        if(m_eligible[target]) m_tomake_eligible.push_back(target);
-                        m_eligible[target] = false;
-                } endfor
-        }
-        delete queue;
-        delete stopping_rule;
 }
 
-//this method performes a directed localized local search and UNDOs them
-//these searches are for the augmented qgraph structure for balanced graph partitioning
+//this method performes a localized local search that moves nodes in both directions on the nodes of the workspace,
+//the caller undoes the movements. these searches are for the augmented qgraph structure for balanced graph partitioning
 void augmented_Qgraph_fabric::more_locallized_search(PartitionConfig & config, graph_access & G, 
-                                                   complete_boundary & boundary,
-                                                   PartitionID & lhs, PartitionID & rhs,
-                                                   NodeID start_node, unsigned & number_of_swaps, pairwise_local_search & pls) {
+                                                     pairwise_search_workspace & ws,
+                                                     PartitionID lhs, PartitionID rhs, EdgeWeight input_cut,
+                                                     NodeID start_node, unsigned number_of_swaps, 
+                                                     pairwise_search_task & task) {
 
-        //commons = kway_graph_refinement_commons::getInstance(config);
-        refinement_pq* queue_lhs = NULL;
-        refinement_pq* queue_rhs = NULL;
-        EdgeWeight max_degree = G.getMaxDegree();
-        queue_lhs = new bucket_pq(max_degree);
-        queue_rhs = new bucket_pq(max_degree);
+        refinement_pq* queue_lhs = &ws.queue_lhs;
+        refinement_pq* queue_rhs = &ws.queue_rhs;
+        queue_lhs->clear();
+        queue_rhs->clear();
 
         EdgeWeight int_degree = 0;
         EdgeWeight ext_degree = 0;
-        m_twfm.int_ext_degree(G, start_node, lhs, rhs, int_degree, ext_degree);
+        int_ext_degree(G, ws, start_node, lhs, rhs, int_degree, ext_degree);
 
         Gain gain = ext_degree - int_degree; 
         queue_lhs->insert(start_node, gain);
@@ -392,7 +690,7 @@ void augmented_Qgraph_fabric::more_locallized_search(PartitionConfig & config, g
         forall_out_edges(G, e, start_node) {
                 NodeID target = G.getEdgeTarget(e);
                 if( G.getPartitionIndex(target) == rhs && m_eligible[target]) {
-                        m_twfm.int_ext_degree(G, target, rhs, lhs, int_degree, ext_degree);
+                        int_ext_degree(G, ws, target, rhs, lhs, int_degree, ext_degree);
                         if( ext_degree - int_degree > max_gain ) {
                                 max_gain = ext_degree - int_degree;
                                 start_node_rhs = target;
@@ -405,32 +703,32 @@ void augmented_Qgraph_fabric::more_locallized_search(PartitionConfig & config, g
                 queue_rhs->insert(start_node_rhs, max_gain);
         }
         
-        if(queue_lhs->empty() || queue_rhs->empty()) {delete queue_lhs; delete queue_rhs; return;}
+        if(queue_lhs->empty() || queue_rhs->empty()) return;
         // queues initalized
 
         ////roll forwards
-        int movements = 0;
-        int overall_gain = 0;
+        int movements     = 0;
+        Gain overall_gain = 0;
 
-        kway_stop_rule* stopping_rule = new kway_simple_stop_rule(config);
+        kway_simple_stop_rule stopping_rule(config);
 
         int min_cut_index    = 0;
         int step_limit       = 200;
-        EdgeWeight input_cut = boundary.getEdgeCut(lhs, rhs);
         EdgeWeight min_cut   = input_cut;
         PartitionID from     = lhs;
         PartitionID to       = rhs;
+        pairwise_local_search & pls = task.pls;
 
         refinement_pq * queue = NULL;
         refinement_pq * to_queue = NULL;
 
-        int diff = 0;
+        SignedNodeWeight diff = 0;
 
         for(movements = 0; movements < (int)number_of_swaps; movements++) {
                 if( queue_lhs->empty() || queue_rhs->empty()) {
                         break;
                 }
-                if( stopping_rule->search_should_stop(min_cut_index, movements, step_limit) ) break;
+                if( stopping_rule.search_should_stop(min_cut_index, movements, step_limit) ) break;
 
 
                 Gain gain_lhs   = queue_lhs->maxValue();
@@ -514,16 +812,22 @@ void augmented_Qgraph_fabric::more_locallized_search(PartitionConfig & config, g
                 }
 
 
-                move_node(config, G, node,  queue, to_queue, boundary, from, to);
+                move_node(G, ws, node,  queue, to_queue, from, to);
 
                 overall_gain += gain;
                 input_cut    -= gain;
         
-                stopping_rule->push_statistics(gain);
+                stopping_rule.push_statistics(gain);
 
                 if(input_cut < min_cut && diff == 0) {
                         min_cut = input_cut;
 
+                        // these movements improve the cut without changing the balance, they are kept
+                        task.kept_nodes.insert(task.kept_nodes.end(), pls.vertex_movements.begin(), pls.vertex_movements.end());
+                        task.kept_blocks.insert(task.kept_blocks.end(), pls.block_movements.begin(), pls.block_movements.end());
+                        task.kept_nodes.push_back(node);
+                        task.kept_blocks.push_back(to);
+
                         pls.vertex_movements.clear();
                         pls.block_movements.clear();
                         pls.gains.clear();
@@ -532,28 +836,5 @@ void augmented_Qgraph_fabric::more_locallized_search(PartitionConfig & config, g
                         pls.block_movements.push_back(to);
                         pls.gains.push_back(overall_gain);
                 }
-                m_tomake_eligible.push_back(node);
         }
-
-        ////roll backwards
-        int idx = pls.vertex_movements.size()-1;
-        //int idx = movements-1;
-        for(; idx >= 0; idx--) {
-                NodeID node      = pls.vertex_movements[idx];
-                PartitionID from = G.getPartitionIndex(node);
-                PartitionID to   = from == lhs ? rhs : lhs;
-                perform_simple_move( config, G, boundary, node, from, to);
-
-                //block the neighboring nodes to avoid conflicts
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        if(m_eligible[target]) m_tomake_eligible.push_back(target);
-                        m_eligible[target] = false;
-                } endfor
-        }
-
-        delete queue_lhs;
-        delete queue_rhs;
-        delete stopping_rule;
 }
-
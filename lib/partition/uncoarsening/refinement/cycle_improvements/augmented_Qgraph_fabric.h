@@ -12,11 +12,39 @@
 #include <vector>
 
 #include "augmented_Qgraph.h"
+#include "data_structure/priority_queues/bucket_pq.h"
 #include "definitions.h"
 #include "uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement_commons.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/two_way_fm.h"
 #include "uncoarsening/refinement/refinement.h"
 
+// state of a single pairwise local search, the searches of a packing round are
+// first run concurrently and then committed one after another in the round's order
+struct pairwise_search_task {
+        boundary_pair            pair;
+        bool                     plus;
+        int                      seed;
+        EdgeWeight               input_cut;
+        std::vector<NodeID>      lhs_boundary;
+        bool                     found_start_node;
+        pairwise_local_search    pls;
+        // moves of the plus variant that improved the cut and are kept 
+        std::vector<NodeID>      kept_nodes;
+        std::vector<PartitionID> kept_blocks;
+};
+
+// per thread data of the searches. the searches do not change the graph or the boundary,
+// the nodes moved by the current search are recorded in moved_to instead
+struct pairwise_search_workspace {
+        std::vector<PartitionID> moved_to;
+        std::vector<NodeID>      moved;
+        bucket_pq                queue_lhs;
+        bucket_pq                queue_rhs;
+
+        pairwise_search_workspace() : queue_lhs(0), queue_rhs(0) {
+        }
+};
+
 class augmented_Qgraph_fabric {
         public:
                 augmented_Qgraph_fabric( );
@@ -30,16 +58,27 @@ class augmented_Qgraph_fabric {
                                                      augmented_Qgraph & aqg,
                                                      unsigned & s, bool rebalance, bool plus = false);
 
+                //updates an augmented quotient graph that has been filled by a previous call on the same graph.
+                //only block pairs that are touched by the movements performed since then are searched again,
+                //if nothing has been moved all searches are redone
+                void update_augmented_quotient_graph( PartitionConfig & config, 
+                                                      graph_access & G, 
+                                                      complete_boundary & boundary, 
+                                                      augmented_Qgraph & aqg,
+                                                      unsigned & s);
+
                 void cleanup_eligible();
 
         private:
-                bool construct_local_searches_on_qgraph_edge( PartitionConfig & config, 
-                                                              graph_access & G, 
-                                                              complete_boundary & boundary,
-                                                              augmented_Qgraph & aqg,
-                                                              boundary_pair & pair,
-                                                              unsigned s,
-                                                              bool plus);
+                void init_eligible(PartitionConfig & config, graph_access & G);
+
+                void perform_local_searches( PartitionConfig & config, 
+                                             graph_access & G, 
+                                             complete_boundary & boundary,
+                                             augmented_Qgraph & aqg,
+                                             std::vector<block_pair_difference> & vec_bpd,
+                                             unsigned s,
+                                             bool plus);
 
                 bool local_search(PartitionConfig & config, 
                                   bool  plus,
@@ -49,39 +88,58 @@ class augmented_Qgraph_fabric {
                                   boundary_pair & bp,
                                   unsigned s);
 
+                void prepare_search_task( PartitionConfig & config, 
+                                          complete_boundary & boundary, 
+                                          pairwise_search_task & task);
+
+                void run_search_task( PartitionConfig & config, 
+                                      graph_access & G, 
+                                      pairwise_search_workspace & ws,
+                                      pairwise_search_task & task,
+                                      unsigned s);
+
+                //returns false if the search conflicts with the searches committed before
+                bool commit_search_task( PartitionConfig & config, 
+                                         graph_access & G, 
+                                         complete_boundary & boundary, 
+                                         augmented_Qgraph & aqg,
+                                         pairwise_search_task & task);
+
+                void block_neighborhood(graph_access & G, NodeID node);
 
                 void directed_more_locallized_search(PartitionConfig & config, graph_access & G, 
-                                complete_boundary & boundary, 
-                                PartitionID & lhs, PartitionID & rhs,
-                                NodeID start_node, unsigned & number_of_swaps, pairwise_local_search & pls);
+                                pairwise_search_workspace & ws,
+                                PartitionID lhs, PartitionID rhs, EdgeWeight input_cut,
+                                NodeID start_node, unsigned number_of_swaps, pairwise_search_task & task);
 
-        public:
                 void more_locallized_search(PartitionConfig & config, graph_access & G, 
-                                complete_boundary & boundary, 
-                                PartitionID & lhs, PartitionID & rhs,
-                                NodeID start_node, unsigned & number_of_swaps, pairwise_local_search & pls);
-        private:
-                void directed_more_locallized_search_all_bnd(PartitionConfig & config, graph_access & G, 
-                                complete_boundary & boundary,  
-                                PartitionID & lhs, PartitionID & rhs,
-                                unsigned & number_of_swaps, pairwise_local_search & pls);
-
-                void move_node(PartitionConfig & config, 
-                               graph_access & G, 
-                               NodeID & node, 
-                               refinement_pq * queue, 
-                               complete_boundary & boundary, 
-                               PartitionID & from, 
-                               PartitionID & to);
+                                pairwise_search_workspace & ws,
+                                PartitionID lhs, PartitionID rhs, EdgeWeight input_cut,
+                                NodeID start_node, unsigned number_of_swaps, pairwise_search_task & task);
 
-                void move_node(PartitionConfig & config, 
-                               graph_access & G, 
-                               NodeID & node, 
+                void move_node(graph_access & G, 
+                               pairwise_search_workspace & ws,
+                               NodeID node, 
                                refinement_pq * queue, 
                                refinement_pq * to_queue, 
-                               complete_boundary & boundary, 
-                               PartitionID & from, 
-                               PartitionID & to);
+                               PartitionID from, 
+                               PartitionID to);
+
+                PartitionID block_of(graph_access & G, pairwise_search_workspace & ws, NodeID node) {
+                        return ws.moved_to[node] != INVALID_PARTITION ? ws.moved_to[node] : G.getPartitionIndex(node);
+                }
+
+                bool is_eligible(pairwise_search_workspace & ws, NodeID node) {
+                        return m_eligible[node] && ws.moved_to[node] == INVALID_PARTITION;
+                }
+
+                void int_ext_degree( graph_access & G, 
+                                     pairwise_search_workspace & ws, 
+                                     NodeID node, 
+                                     PartitionID lhs, 
+                                     PartitionID rhs, 
+                                     EdgeWeight & int_degree, 
+                                     EdgeWeight & ext_degree);
 
                 Gain find_eligible_start_node( graph_access  & G, 
                                                PartitionID & lhs, 
@@ -105,10 +163,21 @@ class augmented_Qgraph_fabric {
                                           PartitionID & from, 
                                           PartitionID & to);
 
-                kway_graph_refinement_commons* commons;
                 two_way_fm          m_twfm;
                 std::vector<bool>   m_eligible;
                 std::vector<NodeID> m_tomake_eligible;
+
+                std::vector<pairwise_search_workspace> m_workspaces;
+                // nodes next to the moves kept by the searches committed in the current batch
+                std::vector<bool>   m_kept_neighborhood;
+                std::vector<NodeID> m_kept_touched;
+
+                // incremental updates: block of the nodes of the committed searches at commit time
+                // and the block pairs that have been searched by the last build
+                bool                               m_incremental;
+                std::vector<PartitionID>           m_commit_block;
+                std::vector<boundary_pair>         m_searched_pairs;
+                std::vector<bool>                  m_changed;
 };
 
 
@@ -274,140 +343,6 @@ void augmented_Qgraph_fabric::perform_simple_move( PartitionConfig & config,
 
 }
 
-inline 
-void augmented_Qgraph_fabric::move_node(PartitionConfig & config, 
-                                        graph_access &  G, 
-                                        NodeID & node, 
-                                        refinement_pq * queue, 
-                                        refinement_pq * to_queue, 
-                                        complete_boundary & boundary, 
-                                        PartitionID & from, 
-                                        PartitionID & to) {
-
-        G.setPartitionIndex(node, to);        
-        m_eligible[node] = false;
-
-        boundary_pair pair;
-        pair.k   = config.k;
-        pair.lhs = from;
-        pair.rhs = to;
-
-        boundary.postMovedBoundaryNodeUpdates(node, &pair, true, true);
-
-        NodeWeight this_nodes_weight = G.getNodeWeight(node);
-        boundary.setBlockNoNodes(from, boundary.getBlockNoNodes(from)-1);
-        boundary.setBlockNoNodes(to,   boundary.getBlockNoNodes(to)+1);
-        boundary.setBlockWeight( from, boundary.getBlockWeight(from)-this_nodes_weight);
-        boundary.setBlockWeight( to,   boundary.getBlockWeight(to)+this_nodes_weight);
-
-        ASSERT_TRUE(boundary.assert_bnodes_in_boundaries());
-        ASSERT_TRUE(boundary.assert_boundaries_are_bnodes());
-
-        //update gain of neighbors / the boundaries have allready been updated
-        refinement_pq* cur_queue = NULL;
-
-        forall_out_edges(G, e, node) {
-                NodeID target = G.getEdgeTarget(e);
-                if(G.getPartitionIndex(target) == from) {
-                        cur_queue = queue;         
-                } else if (G.getPartitionIndex(target) == to) {
-                        cur_queue = to_queue;
-                } else { continue; }
-        
-                EdgeWeight int_degree = 0;
-                EdgeWeight ext_degree = 0;
-
-                PartitionID target_pid = G.getPartitionIndex(target);
-                PartitionID other_pid  = target_pid == from ? to : from;
-
-                m_twfm.int_ext_degree(G, target, target_pid, other_pid, int_degree, ext_degree); 
-                Gain gain = ext_degree - int_degree;
-
-                if(cur_queue->contains(target)) {
-                        if(ext_degree > 0) {
-                                cur_queue->changeKey(target, gain);
-                        } else {
-                                cur_queue->deleteNode(target);
-                        }
-                } else {
-                        if(ext_degree > 0) {
-                                if(m_eligible[target]) {
-                                        cur_queue->insert(target, gain);
-                                } 
-                        } 
-                }
-
-        } endfor
-}
-
-inline 
-void augmented_Qgraph_fabric::move_node(PartitionConfig & config, 
-                                        graph_access &  G, 
-                                        NodeID & node, 
-                                        refinement_pq * queue, 
-                                        complete_boundary & boundary, 
-                                        PartitionID & from, 
-                                        PartitionID & to) {
-
-        G.setPartitionIndex(node, to);        
-        m_eligible[node] = false;
-
-        boundary_pair pair;
-        pair.k   = config.k;
-        pair.lhs = from;
-        pair.rhs = to;
-
-        boundary.postMovedBoundaryNodeUpdates(node, &pair, true, true);
-
-        NodeWeight this_nodes_weight = G.getNodeWeight(node);
-        boundary.setBlockNoNodes(from, boundary.getBlockNoNodes(from)-1);
-        boundary.setBlockNoNodes(to,   boundary.getBlockNoNodes(to)+1);
-        boundary.setBlockWeight( from, boundary.getBlockWeight(from)-this_nodes_weight);
-        boundary.setBlockWeight( to,   boundary.getBlockWeight(to)+this_nodes_weight);
-
-        ASSERT_TRUE(boundary.assert_bnodes_in_boundaries());
-        ASSERT_TRUE(boundary.assert_boundaries_are_bnodes());
-
-        //update gain of neighbors / the boundaries have allready been updated
-        forall_out_edges(G, e, node) {
-                NodeID target = G.getEdgeTarget(e);
-                if(G.getPartitionIndex(target) != from) continue;
-        
-                EdgeWeight int_degree = 0;
-                EdgeWeight ext_degree = 0;
-
-                m_twfm.int_ext_degree(G, target, from, to, int_degree, ext_degree); 
-                Gain gain = ext_degree - int_degree;
-
-                if(queue->contains(target)) {
-                        if(ext_degree > 0) {
-                                queue->changeKey(target, gain);
-                        } else {
-                                queue->deleteNode(target);
-                        }
-                } else {
-                        if(ext_degree > 0) {
-                                if(m_eligible[target]) {
-                                        queue->insert(target, gain);
-                                } 
-                        } 
-                }
-
-        } endfor
-}
-
-
-inline
-bool augmented_Qgraph_fabric::local_search(PartitionConfig & config, 
-                                        bool plus,
-                                        graph_access & G, 
-                                        complete_boundary & boundary,
-                                        augmented_Qgraph & aqg,
-                                        boundary_pair & pair,
-                                        unsigned s ) {
-        return construct_local_searches_on_qgraph_edge( config, G, boundary, aqg, pair, s, plus);
-}
-
 #endif /* end of include guard: AUGMENTED_QGRAPH_FABRIC_MULTITRY_FM_PVGY97EW*/
 
 
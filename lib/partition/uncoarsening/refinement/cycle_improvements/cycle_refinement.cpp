@@ -11,6 +11,7 @@
 #include "augmented_Qgraph_fabric.h"
 #include "cycle_refinement.h"
 #include "quality_metrics.h"
+#include "tools/trace.h"
 
 cycle_refinement::cycle_refinement() {
 
@@ -23,6 +24,7 @@ cycle_refinement::~cycle_refinement() {
 EdgeWeight cycle_refinement::perform_refinement(PartitionConfig & partition_config, 
                 graph_access & G, 
                 complete_boundary & boundary) {
+        trace_scope scope("cycle refinement");
         Gain overall_gain = 0;
         PartitionConfig copy = partition_config;
 
@@ -61,9 +63,10 @@ EdgeWeight cycle_refinement::greedy_ultra_model(PartitionConfig & partition_conf
         bool overloaded        = false;
         unsigned unsucc_count  = 0;
 
+        // the searches of block pairs that are not touched by a performed cycle are kept for the next round
+        augmented_Qgraph aqg;
         do {
-                augmented_Qgraph aqg;
-                augmented_fabric.build_augmented_quotient_graph(partition_config, G, boundary, aqg, s, false);
+                augmented_fabric.update_augmented_quotient_graph(partition_config, G, boundary, aqg, s);
                 something_changed = m_advanced_modelling.compute_vertex_movements_ultra_model(partition_config, 
                                                                                               G,
                                                                                               boundary, 
@@ -6,24 +6,28 @@
  *****************************************************************************/
 
 #include <algorithm>
-#include <unordered_map>
 
 #include "kway_graph_refinement.h"
 #include "kway_graph_refinement_core.h"
 #include "kway_stop_rule.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
+#include "tools/trace.h"
 
-kway_graph_refinement::kway_graph_refinement() {
+kway_graph_refinement::kway_graph_refinement(refinement_workspace * workspace) : m_workspace (workspace),
+                                                                                 m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 kway_graph_refinement::~kway_graph_refinement() {
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 EdgeWeight kway_graph_refinement::perform_refinement(PartitionConfig & config, graph_access & G, 
                                                      complete_boundary & boundary) {
 
-        kway_graph_refinement_core refinement_core;
+        trace_scope scope("kway refinement");
+        kway_graph_refinement_core refinement_core(m_workspace);
         
         EdgeWeight overall_improvement = 0;
         int max_number_of_swaps        = (int)(G.number_of_nodes());
@@ -32,7 +36,8 @@ EdgeWeight kway_graph_refinement::perform_refinement(PartitionConfig & config, g
         for( unsigned i = 0; i < config.kway_rounds || sth_changed; i++) {
                 EdgeWeight improvement = 0;    
 
-                boundary_starting_nodes start_nodes;
+                boundary_starting_nodes & start_nodes = m_workspace->start_nodes;
+                start_nodes.clear();
                 setup_start_nodes(config, G, boundary, start_nodes);
 
                 if(start_nodes.size() == 0) return 0; // nothing to refine
@@ -41,7 +46,7 @@ EdgeWeight kway_graph_refinement::perform_refinement(PartitionConfig & config, g
                 int step_limit = (int)((config.kway_fm_search_limit/100.0)*max_number_of_swaps);
                 step_limit = std::max(step_limit, 15);
 
-                vertex_moved_hashtable moved_idx; 
+                vertex_moved_hashtable & moved_idx = m_workspace->moved_idx(G);
                 improvement += refinement_core.single_kway_refinement_round(config, G, boundary, 
                                                                             start_nodes, step_limit, 
                                                                             moved_idx);
@@ -54,6 +59,7 @@ EdgeWeight kway_graph_refinement::perform_refinement(PartitionConfig & config, g
 
         ASSERT_TRUE(overall_improvement >= 0); 
 
+        scope.arg("improvement", overall_improvement);
         return (EdgeWeight) overall_improvement; 
 }
 
@@ -61,7 +67,8 @@ void kway_graph_refinement::setup_start_nodes(PartitionConfig & config, graph_ac
         QuotientGraphEdges quotient_graph_edges;
         boundary.getQuotientGraphEdges(quotient_graph_edges);
 
-        std::unordered_map<NodeID, bool> allready_contained;
+        m_workspace->reserve(G.number_of_nodes());
+        std::vector<bool> & allready_contained = m_workspace->node_marks;
 
         for( unsigned i = 0; i < quotient_graph_edges.size(); i++) {
                 boundary_pair & ret_value = quotient_graph_edges[i];
@@ -71,7 +78,7 @@ void kway_graph_refinement::setup_start_nodes(PartitionConfig & config, graph_ac
                 PartialBoundary & partial_boundary_lhs = boundary.getDirectedBoundary(lhs, lhs, rhs);
                 forall_boundary_nodes(partial_boundary_lhs, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), lhs);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end() ) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
@@ -80,12 +87,16 @@ void kway_graph_refinement::setup_start_nodes(PartitionConfig & config, graph_ac
                 PartialBoundary & partial_boundary_rhs = boundary.getDirectedBoundary(rhs, lhs, rhs);
                 forall_boundary_nodes(partial_boundary_rhs, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), rhs);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end()) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
                 } endfor
         }
+
+        for( unsigned i = 0; i < start_nodes.size(); i++) {
+                allready_contained[start_nodes[i]] = false;
+        }
 }
 
 
@@ -16,10 +16,11 @@
 #include "random_functions.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/vertex_moved_hashtable.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class kway_graph_refinement : public refinement {
         public:
-                kway_graph_refinement( );
+                kway_graph_refinement( refinement_workspace * workspace = NULL );
                 virtual ~kway_graph_refinement();
 
                 EdgeWeight perform_refinement(PartitionConfig & config, 
@@ -30,6 +31,10 @@ class kway_graph_refinement : public refinement {
                                        graph_access & G, 
                                        complete_boundary & boundary,  
                                        boundary_starting_nodes & start_nodes);
+
+        private:
+                refinement_workspace* m_workspace;
+                bool m_owns_workspace;
 };
 
 #endif /* end of include guard: KWAY_GRAPH_REFINEMENT_PVGY97EW */
@@ -7,18 +7,20 @@
 
 #include <algorithm>
 
-#include "data_structure/priority_queues/bucket_pq.h"
-#include "data_structure/priority_queues/maxNodeHeap.h"
 #include "kway_graph_refinement_core.h"
 #include "kway_stop_rule.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
+#include "tools/trace.h"
 
-kway_graph_refinement_core::kway_graph_refinement_core() : commons (NULL){
+kway_graph_refinement_core::kway_graph_refinement_core(refinement_workspace * workspace) : commons (NULL),
+                                                                                           m_workspace (workspace),
+                                                                                           m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 kway_graph_refinement_core::~kway_graph_refinement_core() {
-        if( commons != NULL)  delete commons;
+        if( m_owns_workspace ) delete m_workspace;
 }
 EdgeWeight kway_graph_refinement_core::single_kway_refinement_round(PartitionConfig & config, 
                                                                     graph_access & G, 
@@ -53,23 +55,20 @@ EdgeWeight kway_graph_refinement_core::single_kway_refinement_round_internal(Par
                                                                     bool compute_touched_partitions,
                                                                     std::unordered_map<PartitionID, PartitionID> &  touched_blocks) {
 
-        if( commons == NULL ) commons = new kway_graph_refinement_commons(config);
-
-        refinement_pq* queue = NULL;
-        if(config.use_bucket_queues) {
-                EdgeWeight max_degree = G.getMaxDegree();
-                queue                 = new bucket_pq(max_degree);
-        } else {
-                queue                 = new maxNodeHeap(); 
-        }
+        commons              = m_workspace->commons(config);
+        refinement_pq* queue = m_workspace->queue(config, G);
 
         init_queue_with_boundary(config, G, start_nodes, queue, moved_idx);  
         
-        if(queue->empty()) {delete queue; return 0;}
+        if(queue->empty()) return 0;
+        NodeID initial_queue_size = queue->size();
 
-        std::vector<NodeID> transpositions;
-        std::vector<PartitionID> from_partitions;
-        std::vector<PartitionID> to_partitions;
+        std::vector<NodeID> & transpositions       = m_workspace->transpositions;
+        std::vector<PartitionID> & from_partitions = m_workspace->from_partitions;
+        std::vector<PartitionID> & to_partitions   = m_workspace->to_partitions;
+        transpositions.clear();
+        from_partitions.clear();
+        to_partitions.clear();
 
         int max_number_of_swaps = (int)(G.number_of_nodes());
         int min_cut_index       = -1;
@@ -138,6 +137,10 @@ EdgeWeight kway_graph_refinement_core::single_kway_refinement_round_internal(Par
         ASSERT_TRUE(boundary.assert_bnodes_in_boundaries());
         ASSERT_TRUE(boundary.assert_boundaries_are_bnodes());
 
+        trace::count(TRACE_FM_ROUNDS, 1);
+        trace::count(TRACE_NODES_MOVED, min_cut_index + 1);
+        trace::count(TRACE_QUEUE_OPERATIONS, initial_queue_size + movements);
+
         //roll backwards
         for(number_of_swaps--; number_of_swaps>min_cut_index; number_of_swaps--) {
                 ASSERT_TRUE(transpositions.size() > 0);
@@ -165,7 +168,6 @@ EdgeWeight kway_graph_refinement_core::single_kway_refinement_round_internal(Par
         ASSERT_TRUE(boundary.assert_bnodes_in_boundaries());
         ASSERT_TRUE(boundary.assert_boundaries_are_bnodes());
 
-        delete queue;
         delete stopping_rule;
         return initial_cut - best_cut; 
 }
@@ -184,7 +186,7 @@ void kway_graph_refinement_core::init_queue_with_boundary(const PartitionConfig
         for( unsigned int i = 0; i < bnd_nodes.size(); i++) {
                 NodeID node = bnd_nodes[i];
 
-                if( moved_idx.find(node) == moved_idx.end() ) {
+                if( !moved_idx.contains(node) ) {
                         PartitionID max_gainer;
                         EdgeWeight ext_degree;
                         //compute gain
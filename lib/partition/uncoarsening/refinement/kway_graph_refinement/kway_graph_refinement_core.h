@@ -17,10 +17,11 @@
 #include "tools/random_functions.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/vertex_moved_hashtable.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class kway_graph_refinement_core  {
         public:
-                kway_graph_refinement_core( );
+                kway_graph_refinement_core( refinement_workspace * workspace = NULL );
                 virtual ~kway_graph_refinement_core();
 
                 EdgeWeight single_kway_refinement_round(PartitionConfig & config, 
@@ -76,6 +77,8 @@ class kway_graph_refinement_core  {
                                                       std::vector<bool> & partition_move_valid); 
                 
                 kway_graph_refinement_commons* commons;
+                refinement_workspace* m_workspace;
+                bool m_owns_workspace;
 };
 
 inline bool kway_graph_refinement_core::move_node(PartitionConfig & config, 
@@ -125,7 +128,7 @@ inline bool kway_graph_refinement_core::move_node(PartitionConfig & config,
                 Gain gain = commons->compute_gain(G, target, targets_max_gainer, ext_degree);
 
                 if(queue->contains(target)) {
-                        assert(moved_idx.find(target) != moved_idx.end());
+                        assert(moved_idx.contains(target));
                         if(ext_degree > 0) {
                                 queue->changeKey(target, gain);
                         } else {
@@ -133,7 +136,7 @@ inline bool kway_graph_refinement_core::move_node(PartitionConfig & config,
                         }
                 } else {
                         if(ext_degree > 0) {
-                                if(moved_idx.find(target) == moved_idx.end()) {
+                                if(!moved_idx.contains(target)) {
                                         queue->insert(target, gain);
                                         moved_idx[target].index = NOT_MOVED;
                                 } 
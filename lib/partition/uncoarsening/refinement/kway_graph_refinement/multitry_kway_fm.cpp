@@ -15,20 +15,19 @@
 #include "random_functions.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/vertex_moved_hashtable.h"
 
-multitry_kway_fm::multitry_kway_fm() {
-        commons = NULL;
+multitry_kway_fm::multitry_kway_fm(refinement_workspace * workspace) : m_workspace (workspace),
+                                                                       m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 multitry_kway_fm::~multitry_kway_fm() {
-        if( commons != NULL) delete commons;
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 int multitry_kway_fm::perform_refinement(PartitionConfig & config, graph_access & G, 
                                          complete_boundary & boundary, unsigned rounds, 
                                          bool init_neighbors, unsigned alpha) {
         
-        if( commons == NULL ) commons = new kway_graph_refinement_commons(config);
-        
         unsigned tmp_alpha                = config.kway_adaptive_limits_alpha;
         KWayStopRule tmp_stop             = config.kway_stop_rule;
         config.kway_adaptive_limits_alpha = alpha;
@@ -36,15 +35,18 @@ int multitry_kway_fm::perform_refinement(PartitionConfig & config, graph_access
 
         int overall_improvement = 0;
         for( unsigned i = 0; i < rounds; i++) {
-                boundary_starting_nodes start_nodes;
-                boundary.setup_start_nodes_all(G, start_nodes);
+                boundary_starting_nodes & start_nodes = m_workspace->start_nodes;
+                start_nodes.clear();
+                m_workspace->reserve(G.number_of_nodes());
+                boundary.setup_start_nodes_all(G, start_nodes, m_workspace->node_marks);
                 if(start_nodes.size() == 0) {  
                         return 0; 
                 }// nothing to refine
 
                 //now we do something with the start nodes
                 //convert it into a list
-                std::vector<NodeID> todolist;
+                std::vector<NodeID> & todolist = m_workspace->todolist;
+                todolist.clear();
                 for(unsigned i = 0; i < start_nodes.size(); i++) {
                         todolist.push_back(start_nodes[i]);
                 }
@@ -72,8 +74,6 @@ int multitry_kway_fm::perform_refinement_around_parts(PartitionConfig & config,
                                                       unsigned alpha, 
                                                       PartitionID & lhs, PartitionID & rhs, 
                                                       std::unordered_map<PartitionID, PartitionID> & touched_blocks) {
-        if( commons == NULL ) commons = new kway_graph_refinement_commons(config);
-
         unsigned tmp_alpha                = config.kway_adaptive_limits_alpha;
         KWayStopRule tmp_stop             = config.kway_stop_rule;
         config.kway_adaptive_limits_alpha = alpha;
@@ -81,13 +81,16 @@ int multitry_kway_fm::perform_refinement_around_parts(PartitionConfig & config,
         int overall_improvement           = 0;
 
         for( unsigned i = 0; i < config.local_multitry_rounds; i++) {
-                boundary_starting_nodes start_nodes;
-                boundary.setup_start_nodes_around_blocks(G, lhs, rhs, start_nodes);
+                boundary_starting_nodes & start_nodes = m_workspace->start_nodes;
+                start_nodes.clear();
+                m_workspace->reserve(G.number_of_nodes());
+                boundary.setup_start_nodes_around_blocks(G, lhs, rhs, start_nodes, m_workspace->node_marks);
                 
                 if(start_nodes.size() == 0) {  return 0; }// nothing to refine
 
                 //now we do something with the start nodes
-                std::vector<NodeID> todolist;
+                std::vector<NodeID> & todolist = m_workspace->todolist;
+                todolist.clear();
                 for(unsigned i = 0; i < start_nodes.size(); i++) {
                         todolist.push_back(start_nodes[i]);
                 }
@@ -113,12 +116,12 @@ int multitry_kway_fm::start_more_locallized_search(PartitionConfig & config, gra
                                                    std::vector<NodeID> & todolist) {
 
         random_functions::permutate_vector_good(todolist, false);
-        if( commons == NULL ) commons = new kway_graph_refinement_commons(config);
+        kway_graph_refinement_commons* commons = m_workspace->commons(config);
         
-        kway_graph_refinement_core refinement_core;
+        kway_graph_refinement_core refinement_core(m_workspace);
         int local_step_limit = 0;
 
-        vertex_moved_hashtable moved_idx;
+        vertex_moved_hashtable & moved_idx = m_workspace->moved_idx(G);
         unsigned idx            = todolist.size()-1;
         int overall_improvement = 0;
         
@@ -130,14 +133,15 @@ int multitry_kway_fm::start_more_locallized_search(PartitionConfig & config, gra
                 EdgeWeight extdeg = 0;
                 commons->compute_gain(G, node, maxgainer, extdeg);
 
-                if(moved_idx.find(node) == moved_idx.end() && extdeg > 0) { 
-                        boundary_starting_nodes real_start_nodes;
+                if(!moved_idx.contains(node) && extdeg > 0) { 
+                        boundary_starting_nodes & real_start_nodes = m_workspace->local_start_nodes;
+                        real_start_nodes.clear();
                         real_start_nodes.push_back(node);
 
                         if(init_neighbors) {
                                 forall_out_edges(G, e, node) {
                                         NodeID target = G.getEdgeTarget(e);
-                                        if(moved_idx.find(target) == moved_idx.end()) {
+                                        if(!moved_idx.contains(target)) {
                                                 extdeg = 0;                                        
                                                 commons->compute_gain(G, target, maxgainer, extdeg);
                                                 if(extdeg > 0) {
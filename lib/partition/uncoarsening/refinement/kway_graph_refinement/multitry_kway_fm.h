@@ -13,10 +13,11 @@
 #include "definitions.h"
 #include "kway_graph_refinement_commons.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class multitry_kway_fm {
         public:
-                multitry_kway_fm( );
+                multitry_kway_fm( refinement_workspace * workspace = NULL );
                 virtual ~multitry_kway_fm();
 
                 int perform_refinement(PartitionConfig & config, graph_access & G, 
@@ -38,7 +39,8 @@ class multitry_kway_fm {
                                                  std::unordered_map<PartitionID, PartitionID> & touched_blocks, 
                                                  std::vector<NodeID> & todolist);
 
-                kway_graph_refinement_commons* commons;
+                refinement_workspace* m_workspace;
+                bool m_owns_workspace;
 };
 
 #endif /* end of include guard: MULTITRY_KWAYFM_PVGY97EW  */
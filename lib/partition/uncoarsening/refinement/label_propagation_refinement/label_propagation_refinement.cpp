@@ -5,47 +5,62 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <atomic>
+#include <limits>
+#include <omp.h>
 
 #include "label_propagation_refinement.h"
 #include "partition/coarsening/clustering/node_ordering.h"
 #include "tools/random_functions.h"
+#include "tools/trace.h"
 
-label_propagation_refinement::label_propagation_refinement() {
-                
+label_propagation_refinement::label_propagation_refinement(refinement_workspace * workspace) : m_workspace (workspace),
+                                                                                               m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 label_propagation_refinement::~label_propagation_refinement() {
-                
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 EdgeWeight label_propagation_refinement::perform_refinement(PartitionConfig & partition_config, 
                                                             graph_access & G, 
                                                             complete_boundary & boundary) {
+        if(partition_config.parallel_label_propagation_refinement) {
+                return perform_parallel_refinement(partition_config, G);
+        }
+
+        trace_scope scope("label propagation refinement");
         NodeWeight block_upperbound = partition_config.upper_bound_partition;
 
         // in this case the _matching paramter is not used 
         // coarse_mappng stores cluster id and the mapping (it is identical)
         std::vector<PartitionID> hash_map(partition_config.k,0);
-        std::vector<NodeID> permutation(G.number_of_nodes());
         std::vector<NodeWeight> cluster_sizes(partition_config.k, 0);
 
+        m_workspace->reserve(G.number_of_nodes());
+        std::vector<NodeID> & permutation = m_workspace->permutation;
+        permutation.resize(G.number_of_nodes());
+
         node_ordering n_ordering;
         n_ordering.order_nodes(partition_config, G, permutation);
 
-        std::queue< NodeID > * Q             = new std::queue< NodeID >();
-        std::queue< NodeID > * next_Q        = new std::queue< NodeID >();
-        std::vector<bool> * Q_contained      = new std::vector<bool>(G.number_of_nodes(), false);
-        std::vector<bool> * next_Q_contained = new std::vector<bool> (G.number_of_nodes(), false);
+        // fifo queues, a queue is processed from the front and cleared afterwards
+        std::vector<NodeID> * Q              = &m_workspace->lp_queue;
+        std::vector<NodeID> * next_Q         = &m_workspace->lp_next_queue;
+        std::vector<bool> * Q_contained      = &m_workspace->lp_queued;
+        std::vector<bool> * next_Q_contained = &m_workspace->lp_next_queued;
+        Q->clear();
+        next_Q->clear();
         forall_nodes(G, node) {
                 cluster_sizes[G.getPartitionIndex(node)] += G.getNodeWeight(node);
-                Q->push(permutation[node]);
+                Q->push_back(permutation[node]);
         } endfor
 
         for( int j = 0; j < partition_config.label_iterations_refinement; j++) {
                 unsigned int change_counter = 0;
-                while( !Q->empty() ) {
-                        NodeID node = Q->front();
-                        Q->pop();
+                for( unsigned head = 0; head < Q->size(); head++) {
+                        NodeID node = (*Q)[head];
                         (*Q_contained)[node] = false;
 
                         //now move the node to the cluster that is most common in the neighborhood
@@ -85,23 +100,25 @@ EdgeWeight label_propagation_refinement::perform_refinement(PartitionConfig & pa
                                 forall_out_edges(G, e, node) {
                                         NodeID target = G.getEdgeTarget(e);
                                         if(!(*next_Q_contained)[target]) {
-                                                next_Q->push(target);
+                                                next_Q->push_back(target);
                                                 (*next_Q_contained)[target] = true;
                                         } 
                                 } endfor
                         }
                 } 
+                Q->clear();
 
                 std::swap( Q, next_Q);
                 std::swap( Q_contained, next_Q_contained);
+                trace::count(TRACE_NODES_MOVED, change_counter);
 
         }
-        
 
-        delete Q;
-        delete next_Q;
-        delete Q_contained;
-        delete next_Q_contained;
+        // leave the flags of the workspace unset
+        for( unsigned i = 0; i < Q->size(); i++) {
+                (*Q_contained)[(*Q)[i]] = false;
+        }
+        Q->clear();
 
 
         // in this case the _matching paramter is not used 
@@ -154,3 +171,156 @@ EdgeWeight label_propagation_refinement::perform_refinement(PartitionConfig & pa
         return 0;
 
 }
+
+// replaces the coin flip of the sequential version, the threads cannot share the random generator
+static inline bool tie_break(unsigned long long seed, int round, NodeID node, PartitionID block) {
+        unsigned long long x = seed ^ ((unsigned long long)round << 48) ^ ((unsigned long long)node << 16) ^ block;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return (x ^ (x >> 31)) & 1;
+}
+
+EdgeWeight label_propagation_refinement::perform_parallel_refinement(PartitionConfig & partition_config, 
+                                                                     graph_access & G) {
+        trace_scope scope("parallel label propagation refinement");
+        NodeWeight block_upperbound = partition_config.upper_bound_partition;
+        bool strict_balance         = partition_config.label_propagation_refinement_balance == LP_BALANCE_STRICT;
+        int num_threads             = omp_get_max_threads();
+        scope.arg("threads", num_threads);
+
+        m_workspace->reserve(G.number_of_nodes());
+        m_workspace->lp_thread_ratings.resize(num_threads);
+        m_workspace->lp_thread_queues.resize(num_threads);
+
+        // the threads read the blocks of neighbors that other threads move, hence the blocks
+        // live in atomics during the rounds and are written back to G at the end
+        std::vector< std::atomic<PartitionID> > & blocks = m_workspace->lp_parallel_blocks;
+        std::vector< std::atomic<NodeWeight> > block_weights(partition_config.k);
+        #pragma omp parallel
+        {
+                std::vector<EdgeWeight> & hash_map = m_workspace->lp_thread_ratings[omp_get_thread_num()];
+                hash_map.assign(partition_config.k, 0);
+
+                #pragma omp for schedule(static)
+                for( NodeID node = 0; node < G.number_of_nodes(); node++) {
+                        blocks[node].store(G.getPartitionIndex(node), std::memory_order_relaxed);
+                        hash_map[G.getPartitionIndex(node)] += G.getNodeWeight(node);
+                }
+
+                for( PartitionID block = 0; block < partition_config.k; block++) {
+                        block_weights[block].fetch_add(hash_map[block], std::memory_order_relaxed);
+                        hash_map[block] = 0;
+                }
+        }
+
+        std::vector<NodeID> & permutation = m_workspace->permutation;
+        permutation.resize(G.number_of_nodes());
+
+        node_ordering n_ordering;
+        n_ordering.order_nodes(partition_config, G, permutation);
+
+        // the active nodes of a round are processed concurrently, every thread collects the 
+        // neighbors of its moved nodes and the flags make sure that a node is queued once
+        std::vector<NodeID> * Q                             = &m_workspace->lp_queue;
+        std::vector<NodeID> * next_Q                        = &m_workspace->lp_next_queue;
+        std::vector< std::atomic<bool> > * Q_contained      = &m_workspace->lp_parallel_queued;
+        std::vector< std::atomic<bool> > * next_Q_contained = &m_workspace->lp_parallel_next_queued;
+        Q->assign(permutation.begin(), permutation.end());
+        next_Q->clear();
+
+        unsigned long long seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+        for( int j = 0; j < partition_config.label_iterations_refinement && !Q->empty(); j++) {
+                long change_counter = 0;
+
+                #pragma omp parallel reduction(+:change_counter)
+                {
+                        std::vector<EdgeWeight> & hash_map = m_workspace->lp_thread_ratings[omp_get_thread_num()];
+                        std::vector<NodeID> & local_next_Q = m_workspace->lp_thread_queues[omp_get_thread_num()];
+                        local_next_Q.clear();
+
+                        // the blocks of the neighbors are read once, so that both sweeps see the
+                        // same blocks even if other threads move the neighbors in between
+                        std::vector<PartitionID> neighbor_blocks;
+
+                        #pragma omp for schedule(dynamic, 256)
+                        for( size_t head = 0; head < Q->size(); head++) {
+                                NodeID node = (*Q)[head];
+                                (*Q_contained)[node].store(false, std::memory_order_relaxed);
+
+                                neighbor_blocks.clear();
+                                forall_out_edges(G, e, node) {
+                                        NodeID target         = G.getEdgeTarget(e);
+                                        PartitionID cur_block = blocks[target].load(std::memory_order_relaxed);
+                                        hash_map[cur_block] += G.getEdgeWeight(e);
+                                        neighbor_blocks.push_back(cur_block);
+                                } endfor
+
+                                PartitionID my_block   = blocks[node].load(std::memory_order_relaxed);
+                                PartitionID max_block  = my_block;
+                                NodeWeight node_weight = G.getNodeWeight(node);
+
+                                EdgeWeight max_value = 0;
+                                for( PartitionID cur_block : neighbor_blocks ) {
+                                        EdgeWeight cur_value  = hash_map[cur_block];
+                                        if((cur_value > max_value || (cur_value == max_value && tie_break(seed, j, node, cur_block))) 
+                                        && (block_weights[cur_block].load(std::memory_order_relaxed) + node_weight < block_upperbound 
+                                            || (cur_block == my_block && block_weights[my_block].load(std::memory_order_relaxed) <= block_upperbound)))
+                                        {
+                                                max_value = cur_value;
+                                                max_block = cur_block;
+                                        }
+
+                                        hash_map[cur_block] = 0;
+                                }
+
+                                if(max_block == my_block) continue;
+
+                                if(strict_balance) {
+                                        // reserve the weight, another thread may have filled the block since the check
+                                        NodeWeight weight = block_weights[max_block].load(std::memory_order_relaxed);
+                                        bool reserved     = false;
+                                        while(!reserved && weight + node_weight < block_upperbound) {
+                                                reserved = block_weights[max_block].compare_exchange_weak(weight, weight + node_weight, 
+                                                                                                          std::memory_order_relaxed);
+                                        }
+                                        if(!reserved) continue;
+                                } else {
+                                        block_weights[max_block].fetch_add(node_weight, std::memory_order_relaxed);
+                                }
+                                block_weights[my_block].fetch_sub(node_weight, std::memory_order_relaxed);
+                                blocks[node].store(max_block, std::memory_order_relaxed);
+                                change_counter++;
+
+                                forall_out_edges(G, e, node) {
+                                        NodeID target = G.getEdgeTarget(e);
+                                        if(!(*next_Q_contained)[target].exchange(true, std::memory_order_relaxed)) {
+                                                local_next_Q.push_back(target);
+                                        }
+                                } endfor
+                        }
+                }
+
+                for( int t = 0; t < num_threads; t++) {
+                        std::vector<NodeID> & local_next_Q = m_workspace->lp_thread_queues[t];
+                        next_Q->insert(next_Q->end(), local_next_Q.begin(), local_next_Q.end());
+                }
+                Q->clear();
+
+                std::swap( Q, next_Q);
+                std::swap( Q_contained, next_Q_contained);
+                trace::count(TRACE_NODES_MOVED, change_counter);
+        }
+
+        // leave the flags of the workspace unset
+        for( unsigned i = 0; i < Q->size(); i++) {
+                (*Q_contained)[(*Q)[i]].store(false, std::memory_order_relaxed);
+        }
+        Q->clear();
+
+        #pragma omp parallel for schedule(static)
+        for( NodeID node = 0; node < G.number_of_nodes(); node++) {
+                G.setPartitionIndex(node, blocks[node].load(std::memory_order_relaxed));
+        }
+
+        return 0;
+}
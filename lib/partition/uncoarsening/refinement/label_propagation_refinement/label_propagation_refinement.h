@@ -11,15 +11,23 @@
 
 #include "definitions.h"
 #include "../refinement.h"
+#include "../refinement_workspace.h"
 
 class label_propagation_refinement : public refinement {
 public:
-        label_propagation_refinement();
+        label_propagation_refinement( refinement_workspace * workspace = NULL );
         virtual ~label_propagation_refinement();
 
         virtual EdgeWeight perform_refinement(PartitionConfig & config, 
                                               graph_access & G, 
                                               complete_boundary & boundary); 
+
+private:
+        EdgeWeight perform_parallel_refinement(PartitionConfig & config, 
+                                               graph_access & G);
+
+        refinement_workspace* m_workspace;
+        bool m_owns_workspace;
 };
 
 
@@ -11,18 +11,19 @@
 #include "mixed_refinement.h"
 #include "quotient_graph_refinement/quotient_graph_refinement.h"
 
-mixed_refinement::mixed_refinement() {
-
+mixed_refinement::mixed_refinement(refinement_workspace * workspace) : m_workspace (workspace),
+                                                                       m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 mixed_refinement::~mixed_refinement() {
-
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 EdgeWeight mixed_refinement::perform_refinement(PartitionConfig & config, graph_access & G, complete_boundary & boundary) {
-        refinement* refine              = new quotient_graph_refinement();
-        refinement* kway                = new kway_graph_refinement();
-        multitry_kway_fm* multitry_kway = new multitry_kway_fm();
+        refinement* refine              = new quotient_graph_refinement(m_workspace);
+        refinement* kway                = new kway_graph_refinement(m_workspace);
+        multitry_kway_fm* multitry_kway = new multitry_kway_fm(m_workspace);
         cycle_refinement* cycle_refine  = new cycle_refinement();
 
         EdgeWeight overall_improvement = 0; 
@@ -10,15 +10,20 @@
 
 #include "definitions.h"
 #include "refinement.h"
+#include "refinement_workspace.h"
 
 class mixed_refinement : public refinement {
 public:
-        mixed_refinement( );
+        mixed_refinement( refinement_workspace * workspace = NULL );
         virtual ~mixed_refinement();
 
         virtual EdgeWeight perform_refinement(PartitionConfig & config, 
                                               graph_access & G, 
                                               complete_boundary & boundary); 
+
+private:
+        refinement_workspace* m_workspace;
+        bool m_owns_workspace;
 };
 
 
@@ -8,6 +8,8 @@
 #ifndef PARTITION_ACCEPT_RULE_4RXUS4P9
 #define PARTITION_ACCEPT_RULE_4RXUS4P9
 
+#include <cstdlib>
+
 #include "partition_config.h"
 #include "random_functions.h"
 
@@ -58,7 +60,7 @@ normal_partition_accept_rule::normal_partition_accept_rule(PartitionConfig & con
         best_cut            = initial_cut;
         cur_lhs_part_weight = initial_lhs_part_weight;
         cur_rhs_part_weight = initial_rhs_part_weight;
-        difference          = abs((int)cur_lhs_part_weight - (int)cur_rhs_part_weight);
+        difference          = std::abs((SignedNodeWeight)cur_lhs_part_weight - (SignedNodeWeight)cur_rhs_part_weight);
 }
 
 bool normal_partition_accept_rule::accept_partition(PartitionConfig & config, 
@@ -68,7 +70,7 @@ bool normal_partition_accept_rule::accept_partition(PartitionConfig & config,
                 const PartitionID lhs, 
                 const PartitionID rhs, 
                 bool & rebalance) {
-        NodeWeight cur_diff            = abs((int)lhs_part_weight - (int)rhs_part_weight);
+        NodeWeight cur_diff            = std::abs((SignedNodeWeight)lhs_part_weight - (SignedNodeWeight)rhs_part_weight);
         bool better_cut_within_balance = edge_cut < best_cut;
 
         if(config.softrebalance) {
@@ -118,8 +120,8 @@ class ip_partition_accept_rule : public partition_accept_rule {
                                       bool & rebalance);
         private:
                 EdgeWeight best_cut;
-                int cur_lhs_overload;
-                int cur_rhs_overload;
+                SignedNodeWeight cur_lhs_overload;
+                SignedNodeWeight cur_rhs_overload;
 };
 
 ip_partition_accept_rule::ip_partition_accept_rule(PartitionConfig & config, 
@@ -130,8 +132,8 @@ ip_partition_accept_rule::ip_partition_accept_rule(PartitionConfig & config,
                 const PartitionID rhs) {
 
         best_cut            = initial_cut;
-        cur_lhs_overload = std::max( (int)initial_lhs_part_weight - config.target_weights[lhs],0);
-        cur_rhs_overload = std::max( (int)initial_rhs_part_weight - config.target_weights[rhs],0);
+        cur_lhs_overload = std::max( (SignedNodeWeight)initial_lhs_part_weight - config.target_weights[lhs],(SignedNodeWeight)0);
+        cur_rhs_overload = std::max( (SignedNodeWeight)initial_rhs_part_weight - config.target_weights[rhs],(SignedNodeWeight)0);
 }
 
 bool ip_partition_accept_rule::accept_partition(PartitionConfig & config, 
@@ -143,8 +145,8 @@ bool ip_partition_accept_rule::accept_partition(PartitionConfig & config,
                 bool & rebalance) {
         bool better_cut_within_balance = edge_cut <= best_cut;
 
-        int act_lhs_overload = std::max( (int)lhs_part_weight - config.target_weights[lhs],0);
-        int act_rhs_overload = std::max( (int)rhs_part_weight - config.target_weights[rhs],0);
+        SignedNodeWeight act_lhs_overload = std::max( (SignedNodeWeight)lhs_part_weight - config.target_weights[lhs],(SignedNodeWeight)0);
+        SignedNodeWeight act_rhs_overload = std::max( (SignedNodeWeight)rhs_part_weight - config.target_weights[rhs],(SignedNodeWeight)0);
 
         better_cut_within_balance = better_cut_within_balance && 
                                     act_lhs_overload == 0 && act_rhs_overload == 0; 
@@ -12,7 +12,7 @@ class queue_selection_strategy {
         public:
 		queue_selection_strategy(PartitionConfig & config) : m_config ( config ) {};
 		virtual ~queue_selection_strategy()  {};
-                virtual void selectQueue(int lhs_part_weight, int rhs_part_weight, 
+                virtual void selectQueue(SignedNodeWeight lhs_part_weight, SignedNodeWeight rhs_part_weight, 
                                 PartitionID lhs, PartitionID rhs, 
                                 PartitionID & from, PartitionID & to,
                                 refinement_pq * lhs_queue, refinement_pq * rhs_queue, 
@@ -26,7 +26,7 @@ class queue_selection_strategy {
 class queue_selection_diffusion : public queue_selection_strategy {
         public:
 		queue_selection_diffusion(PartitionConfig & config) : queue_selection_strategy(config) {};
-                inline void selectQueue(int lhs_part_weight, int rhs_part_weight, 
+                inline void selectQueue(SignedNodeWeight lhs_part_weight, SignedNodeWeight rhs_part_weight, 
                                 PartitionID lhs, PartitionID rhs, 
                                 PartitionID & from, PartitionID & to,
                                 refinement_pq * lhs_queue, refinement_pq * rhs_queue, 
@@ -48,7 +48,7 @@ class queue_selection_diffusion : public queue_selection_strategy {
 class queue_selection_topgain : public queue_selection_strategy {
         public:
 		queue_selection_topgain(PartitionConfig & config) : queue_selection_strategy(config) {};
-                inline void selectQueue(int lhs_part_weight, int rhs_part_weight, 
+                inline void selectQueue(SignedNodeWeight lhs_part_weight, SignedNodeWeight rhs_part_weight, 
                                 PartitionID lhs, PartitionID rhs, 
                                 PartitionID & from, PartitionID & to,
                                 refinement_pq * lhs_queue, refinement_pq * rhs_queue, 
@@ -96,7 +96,7 @@ class queue_selection_topgain_diffusion : public queue_selection_strategy {
                   delete qdiff;
           };
 
-          inline void selectQueue(int lhs_part_weight, int rhs_part_weight, 
+          inline void selectQueue(SignedNodeWeight lhs_part_weight, SignedNodeWeight rhs_part_weight, 
                                 PartitionID lhs, PartitionID rhs, 
                                 PartitionID & from, PartitionID & to,
                                 refinement_pq * lhs_queue, refinement_pq * rhs_queue, 
@@ -156,13 +156,13 @@ class queue_selection_diffusion_block_targets : public queue_selection_strategy
                         delete qdiff;
                 }
 
-                inline void selectQueue(int lhs_part_weight, int rhs_part_weight, 
+                inline void selectQueue(SignedNodeWeight lhs_part_weight, SignedNodeWeight rhs_part_weight, 
                                 PartitionID lhs, PartitionID rhs, 
                                 PartitionID & from, PartitionID & to,
                                 refinement_pq * lhs_queue, refinement_pq * rhs_queue, 
                                 refinement_pq** from_queue, refinement_pq** to_queue ) {
-			int lhs_overload = std::max( lhs_part_weight - m_config.target_weights[0],0);
-			int rhs_overload = std::max( rhs_part_weight - m_config.target_weights[1],0);
+			SignedNodeWeight lhs_overload = std::max( lhs_part_weight - m_config.target_weights[0],(SignedNodeWeight)0);
+			SignedNodeWeight rhs_overload = std::max( rhs_part_weight - m_config.target_weights[1],(SignedNodeWeight)0);
                         if( lhs_overload == 0 && rhs_overload == 0) {
                                 qdiff->selectQueue(lhs_part_weight, rhs_part_weight, 
                                                 lhs, rhs, 
@@ -13,15 +13,17 @@
 #include "random_functions.h"
 #include "search_stop_rule.h"
 #include "tools/quality_metrics.h"
+#include "tools/trace.h"
 #include "two_way_fm.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/partial_boundary.h"
 
-two_way_fm::two_way_fm() {
-
+two_way_fm::two_way_fm(refinement_workspace * workspace) : m_workspace (workspace),
+                                                           m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 two_way_fm::~two_way_fm() {
-
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 EdgeWeight two_way_fm::perform_refinement(PartitionConfig & cfg, 
@@ -37,33 +39,28 @@ EdgeWeight two_way_fm::perform_refinement(PartitionConfig & cfg,
 
         PartitionConfig config = cfg;//copy it since we make changes on that 
         if(lhs_start_nodes.size() == 0 or rhs_start_nodes.size() == 0) return 0; // nothing to refine
+        trace_scope scope("2-way fm");
 
         quality_metrics qm;
         ASSERT_NEQ(pair->lhs, pair->rhs);
         ASSERT_TRUE(assert_directed_boundary_condition(G, boundary, pair->lhs, pair->rhs));
         ASSERT_EQ( cut, qm.edge_cut(G, pair->lhs, pair->rhs));
 
-        refinement_pq* lhs_queue = NULL;
-        refinement_pq* rhs_queue = NULL;
-        if(config.use_bucket_queues) {
-                EdgeWeight max_degree = G.getMaxDegree();
-                lhs_queue = new bucket_pq(max_degree); 
-                rhs_queue = new bucket_pq(max_degree); 
-        } else {
-                lhs_queue = new maxNodeHeap(); 
-                rhs_queue = new maxNodeHeap(); 
-        }
+        refinement_pq* lhs_queue = m_workspace->queue(config, G, 0);
+        refinement_pq* rhs_queue = m_workspace->queue(config, G, 1);
 
         init_queue_with_boundary(config, G, lhs_start_nodes, lhs_queue, pair->lhs, pair->rhs);  
         init_queue_with_boundary(config, G, rhs_start_nodes, rhs_queue, pair->rhs, pair->lhs);  
+        NodeID initial_queue_size = lhs_queue->size() + rhs_queue->size();
 
         queue_selection_strategy* topgain_queue_select = new queue_selection_topgain(config);
         queue_selection_strategy* diffusion_queue_select = new queue_selection_diffusion(config);
         queue_selection_strategy* diffusion_queue_select_block_target = new queue_selection_diffusion_block_targets(config);
         
-        vertex_moved_hashtable moved_idx; 
+        vertex_moved_hashtable & moved_idx = m_workspace->moved_idx(G);
 
-        std::vector<NodeID> transpositions;
+        std::vector<NodeID> & transpositions = m_workspace->transpositions;
+        transpositions.clear();
 
         EdgeWeight inital_cut   = cut;
         int max_number_of_swaps = (int)(boundary.getBlockNoNodes(pair->lhs) + boundary.getBlockNoNodes(pair->rhs));
@@ -160,6 +157,10 @@ EdgeWeight two_way_fm::perform_refinement(PartitionConfig & cfg,
 
         ASSERT_TRUE(assert_directed_boundary_condition(G, boundary, pair->lhs, pair->rhs)); 
         ASSERT_EQ( cut, qm.edge_cut(G, pair->lhs, pair->rhs));
+
+        trace::count(TRACE_FM_ROUNDS, 1);
+        trace::count(TRACE_NODES_MOVED, min_cut_index + 1);
+        trace::count(TRACE_QUEUE_OPERATIONS, initial_queue_size + number_of_swaps);
         
         //roll backwards
         for(number_of_swaps--; number_of_swaps > min_cut_index; number_of_swaps--) {
@@ -206,8 +207,6 @@ EdgeWeight two_way_fm::perform_refinement(PartitionConfig & cfg,
         boundary.setBlockWeight(pair->lhs, lhs_part_weight);
         boundary.setBlockWeight(pair->rhs, rhs_part_weight);
 
-        delete lhs_queue;
-        delete rhs_queue;
         delete topgain_queue_select;
         delete diffusion_queue_select;
         delete diffusion_queue_select_block_target;
@@ -218,6 +217,7 @@ EdgeWeight two_way_fm::perform_refinement(PartitionConfig & cfg,
         ASSERT_TRUE(assert_directed_boundary_condition(G, boundary, pair->lhs, pair->rhs)); 
         ASSERT_TRUE(  (int)inital_cut-(int)best_cut >= 0 || cfg.rebalance); 
         // the computed partition shouldnt have a edge cut which is worse than the initial one
+        scope.arg("improvement", inital_cut-best_cut);
         return inital_cut-best_cut;
 }
 
@@ -17,12 +17,13 @@
 #include "uncoarsening/refinement/quotient_graph_refinement/complete_boundary.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/partial_boundary.h"
 #include "uncoarsening/refinement/quotient_graph_refinement/two_way_refinement.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 #include "vertex_moved_hashtable.h"
 
 
 class two_way_fm : public two_way_refinement {
         public:
-                two_way_fm( );
+                two_way_fm( refinement_workspace * workspace = NULL );
                 virtual ~two_way_fm();
                 EdgeWeight perform_refinement(PartitionConfig & config, 
                                 graph_access & G, 
@@ -102,6 +103,8 @@ class two_way_fm : public two_way_refinement {
                                                         PartitionID rhs);
 #endif
 
+                refinement_workspace* m_workspace;
+                bool m_owns_workspace;
 };
 
 inline bool two_way_fm::int_ext_degree( graph_access & G, 
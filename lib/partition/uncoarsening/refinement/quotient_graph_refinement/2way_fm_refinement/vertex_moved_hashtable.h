@@ -8,18 +8,12 @@
 #ifndef VMOVEDHT_4563r97820954
 #define VMOVEDHT_4563r97820954
 
-#include <unordered_map>
+#include <algorithm>
+#include <vector>
 
 #include "definitions.h"
 #include "limits.h"
 
-struct compare_nodes {
-        bool operator()(const NodeID lhs, const NodeID rhs) const {
-                return (lhs == rhs);
-        }
-};
-
-
 const NodeID NOT_MOVED = std::numeric_limits<NodeID>::max();
 const NodeID MOVED = 0;
 
@@ -30,12 +24,55 @@ struct moved_index {
        }
 };
 
-struct hash_nodes {
-       size_t operator()(const NodeID idx) const {
-                return idx;
-       }
-};
+// the nodes a local search has touched together with their moved state.
+// entries live in an array indexed by the node ids, the touched nodes are
+// remembered so that clear() is linear in the number of touched nodes and the
+// table can be reused by all local searches on a level without allocations.
+class vertex_moved_hashtable {
+        public:
+                vertex_moved_hashtable() {};
+                virtual ~vertex_moved_hashtable() {};
+
+                // the table grows on demand, reserving the number of nodes avoids that
+                void reserve(NodeID n) {
+                        if( m_entries.size() < n ) {
+                                m_entries.resize(n);
+                                m_contained.resize(n, false);
+                        }
+                }
 
-typedef std::unordered_map<const NodeID, moved_index, hash_nodes, compare_nodes> vertex_moved_hashtable;
+                bool contains(NodeID node) const {
+                        return node < m_contained.size() && m_contained[node];
+                }
+
+                // inserts the node as NOT_MOVED if it is not contained yet
+                moved_index & operator[](NodeID node) {
+                        if( !contains(node) ) {
+                                if( node >= m_entries.size() ) {
+                                        reserve(std::max(node + 1, 2 * (NodeID) m_entries.size()));
+                                }
+                                m_contained[node] = true;
+                                m_entries[node]   = moved_index();
+                                m_touched.push_back(node);
+                        }
+                        return m_entries[node];
+                }
+
+                NodeID size() const {
+                        return m_touched.size();
+                }
+
+                void clear() {
+                        for( unsigned i = 0; i < m_touched.size(); i++) {
+                                m_contained[m_touched[i]] = false;
+                        }
+                        m_touched.clear();
+                }
+
+        private:
+                std::vector< moved_index > m_entries;
+                std::vector< bool >        m_contained;
+                std::vector< NodeID >      m_touched;
+};
 
 #endif
@@ -56,10 +56,13 @@ class complete_boundary {
                 inline void setup_start_nodes(graph_access & G, PartitionID partition, 
                                               boundary_pair & bp, boundary_starting_nodes & start_nodes); 
 
+                // node_marks has an entry per node of G, all false, and is left that way
                 inline void setup_start_nodes_around_blocks(graph_access & G, PartitionID & lhs, PartitionID & rhs,
-                                                            boundary_starting_nodes & start_nodes);
+                                                            boundary_starting_nodes & start_nodes,
+                                                            std::vector<bool> & node_marks);
 
-                inline void setup_start_nodes_all(graph_access & G, boundary_starting_nodes & start_nodes);
+                inline void setup_start_nodes_all(graph_access & G, boundary_starting_nodes & start_nodes,
+                                                  std::vector<bool> & node_marks);
 
                 inline void get_max_norm();
                 inline void getUnderlyingQuotientGraph( graph_access & qgraph );
@@ -424,21 +427,22 @@ inline void complete_boundary::getNeighbors(PartitionID & block, std::vector<Par
 
 void complete_boundary::setup_start_nodes_around_blocks(graph_access & G, 
                                                         PartitionID & lhs, PartitionID & rhs, 
-                                                        boundary_starting_nodes & start_nodes) {
+                                                        boundary_starting_nodes & start_nodes,
+                                                        std::vector<bool> & allready_contained) {
 
+        unsigned first_new = start_nodes.size();
         std::vector<PartitionID> lhs_neighbors;
         getNeighbors(lhs, lhs_neighbors);
 
         std::vector<PartitionID> rhs_neighbors;
         getNeighbors(rhs, rhs_neighbors);
 
-        std::unordered_map<NodeID, bool> allready_contained;
         for( unsigned i = 0; i < lhs_neighbors.size(); i++) {
                 PartitionID neighbor = lhs_neighbors[i];
                 PartialBoundary & partial_boundary_lhs = getDirectedBoundary(lhs, lhs, neighbor);
                 forall_boundary_nodes(partial_boundary_lhs, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), lhs);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end() ) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
@@ -447,7 +451,7 @@ void complete_boundary::setup_start_nodes_around_blocks(graph_access & G,
                 PartialBoundary & partial_boundary_neighbor = getDirectedBoundary(neighbor, lhs, neighbor);
                 forall_boundary_nodes(partial_boundary_neighbor, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), neighbor);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end()) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
@@ -459,7 +463,7 @@ void complete_boundary::setup_start_nodes_around_blocks(graph_access & G,
                 PartialBoundary & partial_boundary_rhs = getDirectedBoundary(rhs, rhs, neighbor);
                 forall_boundary_nodes(partial_boundary_rhs, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), rhs);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end() ) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
@@ -468,21 +472,25 @@ void complete_boundary::setup_start_nodes_around_blocks(graph_access & G,
                 PartialBoundary & partial_boundary_neighbor = getDirectedBoundary(neighbor, rhs, neighbor);
                 forall_boundary_nodes(partial_boundary_neighbor, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), neighbor);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end()) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
                 } endfor
         }
+
+        for( unsigned i = first_new; i < start_nodes.size(); i++) {
+                allready_contained[start_nodes[i]] = false;
+        }
 }
 
 
-void complete_boundary::setup_start_nodes_all(graph_access & G, boundary_starting_nodes & start_nodes) {
+void complete_boundary::setup_start_nodes_all(graph_access & G, boundary_starting_nodes & start_nodes,
+                                              std::vector<bool> & allready_contained) {
+        unsigned first_new = start_nodes.size();
         QuotientGraphEdges quotient_graph_edges;
         getQuotientGraphEdges(quotient_graph_edges);
 
-        std::unordered_map<NodeID, bool> allready_contained;
-        
         for( unsigned i = 0; i < quotient_graph_edges.size(); i++) {
                 boundary_pair & ret_value = quotient_graph_edges[i];
                 PartitionID lhs = ret_value.lhs; 
@@ -491,7 +499,7 @@ void complete_boundary::setup_start_nodes_all(graph_access & G, boundary_startin
                 PartialBoundary & partial_boundary_lhs = getDirectedBoundary(lhs, lhs, rhs);
                 forall_boundary_nodes(partial_boundary_lhs, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), lhs);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end() ) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
@@ -500,12 +508,16 @@ void complete_boundary::setup_start_nodes_all(graph_access & G, boundary_startin
                 PartialBoundary & partial_boundary_rhs = getDirectedBoundary(rhs, lhs, rhs);
                 forall_boundary_nodes(partial_boundary_rhs, cur_bnd_node) {
                         ASSERT_EQ(G.getPartitionIndex(cur_bnd_node), rhs);
-                        if(allready_contained.find(cur_bnd_node) == allready_contained.end()) { 
+                        if(!allready_contained[cur_bnd_node]) { 
                                 start_nodes.push_back(cur_bnd_node);
                                 allready_contained[cur_bnd_node] = true;
                         }
                 } endfor
         }
+
+        for( unsigned i = first_new; i < start_nodes.size(); i++) {
+                allready_contained[start_nodes[i]] = false;
+        }
 }
 
 inline void complete_boundary::fastComputeQuotientGraph( graph_access & Q_bar, const NodeID & no_of_blocks) {
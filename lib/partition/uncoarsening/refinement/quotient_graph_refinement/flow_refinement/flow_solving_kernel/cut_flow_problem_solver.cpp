@@ -5,6 +5,7 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -17,10 +18,12 @@
 #include "most_balanced_minimum_cuts/most_balanced_minimum_cuts.h"
 #include "data_structure/flow_graph.h"
 #include "io/graph_io.h"
+#include "tools/random_functions.h"
+#include "tools/trace.h"
 
 
 
-cut_flow_problem_solver::cut_flow_problem_solver() {
+cut_flow_problem_solver::cut_flow_problem_solver() : m_infinite_capacity(0) {
 }
 
 cut_flow_problem_solver::~cut_flow_problem_solver() {
@@ -100,6 +103,7 @@ EdgeWeight cut_flow_problem_solver::convert_ds( const PartitionConfig & config,
         NodeID source = n-2;
         NodeID sink   = n-1;
         idx = 0;
+        FlowType total_capacity = 0;
 
         //add LHS stripe to flow problem
         for( unsigned i = 0; i < lhs_boundary_stripe.size(); i++, idx++) {
@@ -109,6 +113,7 @@ EdgeWeight cut_flow_problem_solver::convert_ds( const PartitionConfig & config,
                         if(G.getPartitionIndex(G.getEdgeTarget(e)) == BOUNDARY_STRIPE_NODE)  {
                                 NodeID targetID     = old_to_new[G.getEdgeTarget(e)];
                                 fG.new_edge(sourceID, targetID, G.getEdgeWeight(e));
+                                total_capacity += G.getEdgeWeight(e);
                         }
                 } endfor
         }
@@ -121,12 +126,15 @@ EdgeWeight cut_flow_problem_solver::convert_ds( const PartitionConfig & config,
                         if(G.getPartitionIndex(G.getEdgeTarget(e)) == BOUNDARY_STRIPE_NODE)  {
                                 NodeID targetID     = old_to_new[G.getEdgeTarget(e)];
                                 fG.new_edge(sourceID, targetID, G.getEdgeWeight(e));
+                                total_capacity += G.getEdgeWeight(e);
                         }
                 } endfor
         }
 
         ////connect source and target with outer boundary nodes 
-        FlowType max_capacity = std::numeric_limits<FlowType>::max();
+        // more than any cut, the excesses in push relabel can not overflow with this capacity
+        m_infinite_capacity = total_capacity + 1;
+        FlowType max_capacity = m_infinite_capacity;
         for(unsigned i = 0; i < outer_lhs_boundary.size(); i++) {
                 NodeID targetID = outer_lhs_boundary[i];
                 fG.new_edge(source, targetID, max_capacity);
@@ -136,6 +144,7 @@ EdgeWeight cut_flow_problem_solver::convert_ds( const PartitionConfig & config,
                 NodeID sourceID = outer_rhs_boundary[i];
                 fG.new_edge(sourceID, sink, max_capacity);
         }
+        fG.finish_construction();
 
         return true;
 }
@@ -148,20 +157,79 @@ EdgeWeight cut_flow_problem_solver::get_min_flow_max_cut(const PartitionConfig &
                                                       std::vector<NodeID> & rhs_boundary_stripe,
                                                       std::vector<NodeID> & new_to_old_ids,
                                                       EdgeWeight & initial_cut,
+                                                      NodeWeight & lhs_part_weight,
+                                                      NodeWeight & lhs_stripe_weight,
                                                       NodeWeight & rhs_part_weight,
                                                       NodeWeight & rhs_stripe_weight,
                                                       std::vector<NodeID> & new_rhs_nodes) {
 
-        flow_graph fG;
+        flow_graph & fG = m_flow_graph;
         bool do_sth = convert_ds(config, G, lhs, rhs, lhs_boundary_stripe, rhs_boundary_stripe, new_to_old_ids, fG );
 
         if(!do_sth) return initial_cut;
 
-        push_relabel pr;
         NodeID source = fG.number_of_nodes()-2;
         NodeID sink   = fG.number_of_nodes()-1;
+        trace::count(TRACE_FLOW_PROBLEMS, 1);
+        trace::count(TRACE_FLOW_PROBLEM_NODES, fG.number_of_nodes());
+        trace::count(TRACE_FLOW_PROBLEM_EDGES, fG.number_of_edges());
+
         std::vector< NodeID > source_set;
-        FlowType flowvalue = pr.solve_max_flow_min_cut( fG, source, sink, true, source_set);
+        FlowType flowvalue = m_solver.solve_max_flow_min_cut( fG, source, sink, true, source_set);
+        compute_rhs_nodes(config, G, new_to_old_ids, source_set, rhs_part_weight, rhs_stripe_weight, new_rhs_nodes);
+
+        if(config.flow_piercing_steps == 0) return flowvalue;
+
+        // piercing: as long as the cut violates the balance constraint, a node of the overloaded side 
+        // is connected to the opposite terminal and the existing flow is augmented. 
+        // the cut value can only increase, so we stop as soon as it is not better than the initial cut.
+        std::vector< NodeID > pierced_rhs_nodes = new_rhs_nodes;
+        FlowType pierced_flowvalue = flowvalue;
+        for( unsigned step = 0; step <= config.flow_piercing_steps; step++) {
+                if( pierced_flowvalue >= initial_cut ) break;
+
+                NodeWeight new_rhs_stripe_weight = 0;
+                for( NodeID node : pierced_rhs_nodes ) {
+                        if( node < source ) new_rhs_stripe_weight += G.getNodeWeight(new_to_old_ids[node]);
+                }
+                NodeWeight new_lhs_stripe_weight = lhs_stripe_weight + rhs_stripe_weight - new_rhs_stripe_weight;
+                NodeWeight new_lhs_part_weight   = lhs_part_weight - lhs_stripe_weight + new_lhs_stripe_weight;
+                NodeWeight new_rhs_part_weight   = rhs_part_weight - rhs_stripe_weight + new_rhs_stripe_weight;
+
+                bool lhs_overloaded = new_lhs_part_weight >= config.upper_bound_partition;
+                bool rhs_overloaded = new_rhs_part_weight >= config.upper_bound_partition;
+                if( !lhs_overloaded && !rhs_overloaded ) {
+                        if( step > 0 ) {
+                                new_rhs_nodes.swap(pierced_rhs_nodes);
+                                return pierced_flowvalue;
+                        }
+                        break;
+                }
+
+                if( step == config.flow_piercing_steps ) break;
+                if( step == 0 ) add_terminal_edges();
+                if( !pierce(G, new_to_old_ids, pierced_rhs_nodes, lhs_overloaded) ) break;
+
+                pierced_flowvalue = m_solver.resume_max_flow_min_cut( fG, source, sink, true, source_set);
+                if( pierced_flowvalue >= initial_cut ) break;
+
+                pierced_rhs_nodes.clear();
+                compute_rhs_nodes(config, G, new_to_old_ids, source_set, rhs_part_weight, rhs_stripe_weight, pierced_rhs_nodes);
+        }
+
+        return flowvalue;
+}
+
+void cut_flow_problem_solver::compute_rhs_nodes(const PartitionConfig & config, 
+                                                graph_access & G, 
+                                                std::vector<NodeID> & new_to_old_ids,
+                                                std::vector<NodeID> & source_set,
+                                                NodeWeight & rhs_part_weight,
+                                                NodeWeight & rhs_stripe_weight,
+                                                std::vector<NodeID> & new_rhs_nodes) {
+        flow_graph & fG = m_flow_graph;
+        NodeID source = fG.number_of_nodes()-2;
+        NodeID sink   = fG.number_of_nodes()-1;
 
         std::vector< bool > new_rhs_flag(fG.number_of_nodes(), true);
         for( unsigned int i = 0; i < source_set.size(); i++) {
@@ -188,7 +256,7 @@ EdgeWeight cut_flow_problem_solver::get_min_flow_max_cut(const PartitionConfig &
                         forall_out_edges(fG, e, node) {
                                 NodeID target = fG.getEdgeTarget(node, e);
                                 if( fG.getEdgeCapacity(node, e) > 0 ) {
-                                        if( fG.getEdgeFlow(node, e) < (FlowType) fG.getEdgeCapacity(node, e)) {
+                                        if( fG.getEdgeFlow(node, e) < fG.getEdgeCapacity(node, e)) {
                                                 residualGraph.new_edge(node, target);
                                         } else {
                                                 forall_out_edges(fG, e_bar, target) {
@@ -206,12 +274,134 @@ EdgeWeight cut_flow_problem_solver::get_min_flow_max_cut(const PartitionConfig &
                 residualGraph.setNodeWeight(sink, 0);
                 residualGraph.finish_construction();
                 NodeWeight average_partition_weight = ceil(config.work_load / config.k);
-                NodeWeight perfect_rhs_stripe_weight = abs((int)average_partition_weight - (int)rhs_part_weight+(int) rhs_stripe_weight);
+                NodeWeight perfect_rhs_stripe_weight = std::abs((SignedNodeWeight)average_partition_weight - (SignedNodeWeight)rhs_part_weight+(SignedNodeWeight) rhs_stripe_weight);
                 
                 most_balanced_minimum_cuts mbmc;
                 mbmc.compute_good_balanced_min_cut(residualGraph, config, perfect_rhs_stripe_weight, new_rhs_nodes);
         }
-        
-        return flowvalue;
+}
+
+void cut_flow_problem_solver::add_terminal_edges() {
+        flow_graph & fG = m_flow_graph;
+        NodeID source = fG.number_of_nodes()-2;
+        NodeID sink   = fG.number_of_nodes()-1;
+
+        std::vector< bool > has_source_edge(fG.number_of_nodes(), false);
+        forall_out_edges(fG, e, source) {
+                has_source_edge[fG.getEdgeTarget(source, e)] = true;
+        } endfor
+
+        for( NodeID node = 0; node < source; node++) {
+                bool has_sink_edge = false;
+                forall_out_edges(fG, e, node) {
+                        if( fG.getEdgeTarget(node, e) == sink ) has_sink_edge = true;
+                } endfor
+
+                if(!has_source_edge[node]) fG.new_edge(source, node, 0);
+                if(!has_sink_edge)         fG.new_edge(node, sink, 0);
+        }
+        // the current flow is kept
+        fG.finish_construction();
+}
+
+bool cut_flow_problem_solver::pierce(graph_access & G,
+                                     std::vector<NodeID> & new_to_old_ids,
+                                     std::vector<NodeID> & new_rhs_nodes,
+                                     bool lhs_overloaded) {
+        flow_graph & fG = m_flow_graph;
+        NodeID source = fG.number_of_nodes()-2;
+        NodeID sink   = fG.number_of_nodes()-1;
+
+        std::vector< bool > is_rhs(fG.number_of_nodes(), false);
+        for( NodeID node : new_rhs_nodes ) {
+                is_rhs[node] = true;
+        }
+        is_rhs[sink] = true;
+
+        // nodes that already are connected to one of the terminals can not be pierced 
+        // (the source edges are reverse edges of the nodes)
+        std::vector< bool > is_terminal_node(fG.number_of_nodes(), false);
+        forall_out_edges(fG, e, source) {
+                if( fG.getEdgeCapacity(source, e) > 0 ) is_terminal_node[fG.getEdgeTarget(source, e)] = true;
+        } endfor
+        for( NodeID node = 0; node < source; node++) {
+                forall_out_edges(fG, e, node) {
+                        if( fG.getEdgeTarget(node, e) == sink && fG.getEdgeCapacity(node, e) > 0 ) is_terminal_node[node] = true;
+                } endfor
+        }
+
+        // nodes from which the sink is reachable in the residual graph (backward bfs)
+        // piercing a node of the other kind does not increase the flow
+        std::vector< bool > reaches_sink(fG.number_of_nodes(), false);
+        std::vector< bool > reached_from_source(fG.number_of_nodes(), false);
+        std::vector< NodeID > queue;
+        queue.push_back(sink);
+        reaches_sink[sink] = true;
+        for( unsigned head = 0; head < queue.size(); head++) {
+                NodeID node = queue[head];
+                forall_out_edges(fG, e, node) {
+                        NodeID target = fG.getEdgeTarget(node, e);
+                        EdgeID rev_e  = fG.getReverseEdge(node, e);
+                        if( !reaches_sink[target] && fG.getEdgeCapacity(target, rev_e) - fG.getEdgeFlow(target, rev_e) > 0 ) {
+                                reaches_sink[target] = true;
+                                queue.push_back(target);
+                        }
+                } endfor
+        }
+        queue.clear();
+        queue.push_back(source);
+        reached_from_source[source] = true;
+        for( unsigned head = 0; head < queue.size(); head++) {
+                NodeID node = queue[head];
+                forall_out_edges(fG, e, node) {
+                        NodeID target = fG.getEdgeTarget(node, e);
+                        if( !reached_from_source[target] && fG.getEdgeCapacity(node, e) - fG.getEdgeFlow(node, e) > 0 ) {
+                                reached_from_source[target] = true;
+                                queue.push_back(target);
+                        }
+                } endfor
+        }
+
+        // candidates are the nodes of the overloaded side that are adjacent to the other side
+        std::vector< NodeID > candidates;
+        std::vector< NodeID > augmenting_candidates;
+        for( NodeID node = 0; node < source; node++) {
+                if( is_terminal_node[node] || is_rhs[node] == lhs_overloaded ) continue;
+
+                bool at_cut = false;
+                forall_out_edges(fG, e, node) {
+                        NodeID target = fG.getEdgeTarget(node, e);
+                        if( target < source && is_rhs[target] != is_rhs[node] ) {
+                                at_cut = true;
+                                break;
+                        }
+                } endfor
+                if( !at_cut ) continue;
+
+                bool augmenting = lhs_overloaded ? reached_from_source[node] : reaches_sink[node];
+                if( augmenting ) {
+                        augmenting_candidates.push_back(node);
+                } else {
+                        candidates.push_back(node);
+                }
+        }
+        if( candidates.empty() ) candidates.swap(augmenting_candidates);
+        if( candidates.empty() ) return false;
+
+        NodeID node = candidates[random_functions::nextInt(0, candidates.size()-1)];
+        FlowType max_capacity = m_infinite_capacity;
+        forall_out_edges(fG, e, node) {
+                NodeID target = fG.getEdgeTarget(node, e);
+                if( lhs_overloaded && target == sink ) {
+                        fG.setEdgeCapacity(node, e, max_capacity);
+                        return true;
+                } 
+                if( !lhs_overloaded && target == source ) {
+                        fG.setEdgeCapacity(source, fG.getReverseEdge(node, e), max_capacity);
+                        return true;
+                }
+        } endfor
+
+        return false;
 }
 
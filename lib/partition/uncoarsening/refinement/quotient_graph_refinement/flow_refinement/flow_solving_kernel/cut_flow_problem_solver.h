@@ -9,6 +9,7 @@
 #define CUT_FLOW_PROBLEM_SOLVER_4P49OMM
 
 #include "partition_config.h"
+#include "algorithms/push_relabel.h"
 #include "data_structure/flow_graph.h"
 
 class cut_flow_problem_solver  {
@@ -24,6 +25,8 @@ class cut_flow_problem_solver  {
                                                 std::vector<NodeID> & rhs_boundary_stripe,
                                                 std::vector<NodeID> & new_to_old_ids,
                                                 EdgeWeight & initial_cut,
+                                                NodeWeight & lhs_part_weight,
+                                                NodeWeight & lhs_stripe_weight,
                                                 NodeWeight & rhs_part_weight,
                                                 NodeWeight & rhs_stripe_weight,
                                                 std::vector<NodeID> & new_rhs_nodes);               
@@ -47,6 +50,31 @@ class cut_flow_problem_solver  {
                                       std::vector<NodeID> & new_to_old_ids,              
                                       flow_graph & rG); 
 
+                // derives the nodes of the flow graph that are assigned to rhs from the current maximum flow 
+                void compute_rhs_nodes(const PartitionConfig & config, 
+                                       graph_access & G, 
+                                       std::vector<NodeID> & new_to_old_ids,
+                                       std::vector<NodeID> & source_set,
+                                       NodeWeight & rhs_part_weight,
+                                       NodeWeight & rhs_stripe_weight,
+                                       std::vector<NodeID> & new_rhs_nodes);
+
+                // adds zero capacity edges from the source and to the sink for all nodes that do not have them
+                void add_terminal_edges();
+
+                // connects a boundary node of the overloaded side to the opposite terminal
+                // returns false if there is no node left that can be pierced
+                bool pierce(graph_access & G,
+                            std::vector<NodeID> & new_to_old_ids,
+                            std::vector<NodeID> & new_rhs_nodes,
+                            bool lhs_overloaded);
+
+                // kept across calls so that consecutive flow problems reuse the allocated buffers
+                flow_graph   m_flow_graph;
+                push_relabel m_solver;
+
+                // capacity of the terminal edges, larger than the sum of all other capacities
+                FlowType     m_infinite_capacity;
 };
 
 
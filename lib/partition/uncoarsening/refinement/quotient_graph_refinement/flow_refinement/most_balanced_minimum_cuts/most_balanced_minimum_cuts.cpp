@@ -5,6 +5,7 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <cstdlib>
 #include <unordered_map>
 
 #include "algorithms/strongly_connected_components.h"
@@ -97,7 +98,7 @@ void most_balanced_minimum_cuts::compute_new_rhs( graph_access & scc_graph,
         }
 
         std::vector<int> tmp_comp_for_rhs;
-        int best_diff = std::numeric_limits<int>::max();
+        SignedNodeWeight best_diff = std::numeric_limits<SignedNodeWeight>::max();
         for(unsigned i = 0; i < config.toposort_iterations; i++) {
                 topological_sort ts;
                 std::vector<NodeID> sorted_sequence;
@@ -106,8 +107,8 @@ void most_balanced_minimum_cuts::compute_new_rhs( graph_access & scc_graph,
                 tmp_comp_for_rhs.clear();
 
                 bool t_contained   = false;
-                int cur_rhs_weight = 0;
-                int diff           = std::numeric_limits<int>::max();
+                SignedNodeWeight cur_rhs_weight = 0;
+                SignedNodeWeight diff           = std::numeric_limits<SignedNodeWeight>::max();
                 for( unsigned idx = 0; idx < sorted_sequence.size(); idx++) {
                         int cur_component = sorted_sequence[idx];
 
@@ -118,14 +119,14 @@ void most_balanced_minimum_cuts::compute_new_rhs( graph_access & scc_graph,
                         }
 
                         if(valid_to_add[cur_component]) {
-                                int tmpdiff = optimal_rhs_stripe_weight - cur_rhs_weight - comp_weights[cur_component];
+                                SignedNodeWeight tmpdiff = optimal_rhs_stripe_weight - cur_rhs_weight - comp_weights[cur_component];
                                 bool would_break = tmpdiff <= 0 && t_contained;
                                 if(!would_break) {
                                         tmp_comp_for_rhs.push_back(cur_component);
                                         cur_rhs_weight += comp_weights[cur_component];
                                 } else {
                                         //decide wether we should add this component now
-                                        if(abs(tmpdiff) < abs(diff)) {
+                                        if(std::abs(tmpdiff) < std::abs(diff)) {
                                                 //add it 
                                                 tmp_comp_for_rhs.push_back(cur_component);
                                                 cur_rhs_weight += comp_weights[cur_component];
@@ -143,8 +144,8 @@ void most_balanced_minimum_cuts::compute_new_rhs( graph_access & scc_graph,
                        
                 }
 
-                if(abs(diff) < best_diff) {
-                        best_diff    = abs(diff);
+                if(std::abs(diff) < best_diff) {
+                        best_diff    = std::abs(diff);
                         comp_for_rhs = tmp_comp_for_rhs;
                 }
         }
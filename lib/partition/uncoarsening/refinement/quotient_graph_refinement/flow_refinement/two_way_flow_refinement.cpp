@@ -5,6 +5,7 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -15,6 +16,7 @@
 #include "flow_solving_kernel/cut_flow_problem_solver.h"
 #include "quality_metrics.h"
 #include "two_way_flow_refinement.h"
+#include "tools/trace.h"
 
 two_way_flow_refinement::two_way_flow_refinement() {
 
@@ -35,6 +37,7 @@ EdgeWeight two_way_flow_refinement::perform_refinement(PartitionConfig & config,
                                                        EdgeWeight & cut,
                                                        bool & something_changed) {
 
+        trace_scope scope("flow refinement");
         EdgeWeight retval  =  iterativ_flow_iteration(config, G, boundary, lhs_pq_start_nodes, rhs_pq_start_nodes, 
                                                       refinement_pair, lhs_part_weight, rhs_part_weight, cut, something_changed);
 
@@ -42,6 +45,7 @@ EdgeWeight two_way_flow_refinement::perform_refinement(PartitionConfig & config,
                 something_changed = true;
         }
 
+        scope.arg("improvement", retval);
         return retval;
 }
 
@@ -79,6 +83,7 @@ EdgeWeight two_way_flow_refinement::iterativ_flow_iteration(PartitionConfig & co
         }
 
         NodeWeight average_partition_weight = ceil(config.work_load / config.k);
+        cut_flow_problem_solver fsolve;
         while(cur_improvement > 0 && iteration < max_iterations) {
                 NodeWeight upper_bound_no_lhs = (NodeWeight)std::max((100.0+region_factor*config.imbalance)/100.0*(average_partition_weight) - rhs_part_weight,0.0);
                 NodeWeight upper_bound_no_rhs = (NodeWeight)std::max((100.0+region_factor*config.imbalance)/100.0*(average_partition_weight) - lhs_part_weight,0.0);
@@ -112,11 +117,12 @@ EdgeWeight two_way_flow_refinement::iterativ_flow_iteration(PartitionConfig & co
                 std::vector<NodeID> new_rhs_nodes;
                 std::vector<NodeID> new_to_old_ids;
 
-                cut_flow_problem_solver fsolve;
                 EdgeWeight new_cut = fsolve.get_min_flow_max_cut(config, G, 
                                                                 lhs, rhs, 
                                                                 lhs_boundary_stripe, rhs_boundary_stripe, 
                                                                 new_to_old_ids, best_cut, 
+                                                                lhs_part_weight,
+                                                                lhs_stripe_weight,
                                                                 rhs_part_weight,
                                                                 rhs_stripe_weight,
                                                                 new_rhs_nodes);
@@ -147,14 +153,14 @@ EdgeWeight two_way_flow_refinement::iterativ_flow_iteration(PartitionConfig & co
                                 new_lhs_stripe_weight += G.getNodeWeight(rhs_boundary_stripe[i]);
                         }
                 }
-                new_lhs_part_weight = boundary.getBlockWeight(lhs) + ((int)new_lhs_stripe_weight-(int)lhs_stripe_weight) ;
-                new_rhs_part_weight = boundary.getBlockWeight(rhs) + ((int)new_rhs_stripe_weight-(int)rhs_stripe_weight) ;
+                new_lhs_part_weight = boundary.getBlockWeight(lhs) + ((SignedNodeWeight)new_lhs_stripe_weight-(SignedNodeWeight)lhs_stripe_weight) ;
+                new_rhs_part_weight = boundary.getBlockWeight(rhs) + ((SignedNodeWeight)new_rhs_stripe_weight-(SignedNodeWeight)rhs_stripe_weight) ;
 
                 bool partition_is_feasable = false;
                 if(config.most_balanced_minimum_cuts) {
                        partition_is_feasable = new_lhs_part_weight < config.upper_bound_partition 
                                              && new_rhs_part_weight < config.upper_bound_partition 
-                                             && (new_cut < best_cut || abs((int)new_lhs_part_weight - (int) new_rhs_part_weight) < abs((int)lhs_part_weight - (int)rhs_part_weight));
+                                             && (new_cut < best_cut || std::abs((SignedNodeWeight)new_lhs_part_weight - (SignedNodeWeight)new_rhs_part_weight) < std::abs((SignedNodeWeight)lhs_part_weight - (SignedNodeWeight)rhs_part_weight));
                 } else {
                        partition_is_feasable = new_lhs_part_weight < config.upper_bound_partition 
                                             && new_rhs_part_weight < config.upper_bound_partition && new_cut < best_cut;
@@ -274,8 +280,8 @@ void two_way_flow_refinement::apply_partition_and_update_boundary( const Partiti
 
 
         // ********** fix the boundary data structure *****************  
-        boundary.setBlockWeight(lhs, boundary.getBlockWeight(lhs) + ((int)new_lhs_stripe_weight-(int)lhs_stripe_weight) );
-        boundary.setBlockWeight(rhs, boundary.getBlockWeight(rhs) + ((int)new_rhs_stripe_weight-(int)rhs_stripe_weight) );
+        boundary.setBlockWeight(lhs, boundary.getBlockWeight(lhs) + ((SignedNodeWeight)new_lhs_stripe_weight-(SignedNodeWeight)lhs_stripe_weight) );
+        boundary.setBlockWeight(rhs, boundary.getBlockWeight(rhs) + ((SignedNodeWeight)new_rhs_stripe_weight-(SignedNodeWeight)rhs_stripe_weight) );
 
         boundary.setBlockNoNodes(lhs, boundary.getBlockNoNodes(lhs) + ((int)new_lhs_stripe_no_nodes -(int)lhs_boundary_stripe.size()) );
         boundary.setBlockNoNodes(rhs, boundary.getBlockNoNodes(rhs) + ((int)new_rhs_stripe_no_nodes -(int)rhs_boundary_stripe.size()) );
@@ -12,17 +12,19 @@
 #include "flow_refinement/two_way_flow_refinement.h"
 #include "quality_metrics.h"
 #include "quotient_graph_refinement.h"
+#include "tools/trace.h"
 #include "quotient_graph_scheduling/active_block_quotient_graph_scheduler.h"
 #include "quotient_graph_scheduling/simple_quotient_graph_scheduler.h"
 #include "uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement.h"
 #include "uncoarsening/refinement/kway_graph_refinement/multitry_kway_fm.h"
 
-quotient_graph_refinement::quotient_graph_refinement() {
-
+quotient_graph_refinement::quotient_graph_refinement(refinement_workspace * workspace) : m_workspace (workspace),
+                                                                                         m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 quotient_graph_refinement::~quotient_graph_refinement() {
-
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 void quotient_graph_refinement::setup_start_nodes(graph_access & G, 
@@ -46,6 +48,7 @@ void quotient_graph_refinement::setup_start_nodes(graph_access & G,
 
 
 EdgeWeight quotient_graph_refinement::perform_refinement(PartitionConfig & config, graph_access & G, complete_boundary & boundary) {
+        trace_scope scope("quotient graph refinement");
 
         ASSERT_TRUE(boundary.assert_bnodes_in_boundaries());
         ASSERT_TRUE(boundary.assert_boundaries_are_bnodes());
@@ -106,8 +109,9 @@ EdgeWeight quotient_graph_refinement::perform_refinement(PartitionConfig & confi
 
                 EdgeWeight multitry_improvement = 0;
                 if(config.refinement_scheduling_algorithm == REFINEMENT_SCHEDULING_ACTIVE_BLOCKS_REF_KWAY ) {
-                        multitry_kway_fm kway_ref;
-                        std::unordered_map<PartitionID, PartitionID> touched_blocks;
+                        multitry_kway_fm kway_ref(m_workspace);
+                        std::unordered_map<PartitionID, PartitionID> & touched_blocks = m_workspace->touched_blocks;
+                        touched_blocks.clear();
 
                         multitry_improvement = kway_ref.perform_refinement_around_parts(cfg, G, 
                                                                                 boundary, true, 
@@ -134,6 +138,7 @@ EdgeWeight quotient_graph_refinement::perform_refinement(PartitionConfig & confi
         } while(!scheduler->hasFinished());
 
         delete scheduler;
+        scope.arg("improvement", overall_improvement);
         return overall_improvement;
 }
 
@@ -148,13 +153,13 @@ EdgeWeight quotient_graph_refinement::perform_a_two_way_refinement(PartitionConf
                                                                    EdgeWeight & initial_cut_value,
                                                                    bool & something_changed) {
 
-        two_way_fm pair_wise_refinement;
+        two_way_fm pair_wise_refinement(m_workspace);
         two_way_flow_refinement pair_wise_flow;
 
-        std::vector<NodeID> lhs_bnd_nodes;
+        std::vector<NodeID> & lhs_bnd_nodes = m_workspace->lhs_start_nodes;
         setup_start_nodes(G, lhs, bp, boundary, lhs_bnd_nodes); 
 
-        std::vector<NodeID> rhs_bnd_nodes; 
+        std::vector<NodeID> & rhs_bnd_nodes = m_workspace->rhs_start_nodes;
         setup_start_nodes(G, rhs, bp, boundary, rhs_bnd_nodes);
 
         something_changed      = false;
@@ -10,10 +10,11 @@
 
 #include "definitions.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class quotient_graph_refinement : public refinement {
         public:
-                quotient_graph_refinement( );
+                quotient_graph_refinement( refinement_workspace * workspace = NULL );
                 virtual ~quotient_graph_refinement();
 
                 EdgeWeight perform_refinement(PartitionConfig & config, graph_access & G, complete_boundary & boundary);
@@ -36,6 +37,8 @@ class quotient_graph_refinement : public refinement {
                                                         EdgeWeight & cut,
                                                         bool & something_changed); 
 
+                refinement_workspace* m_workspace;
+                bool m_owns_workspace;
 };
 
 
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * refinement_workspace.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include "refinement_workspace.h"
+
+refinement_workspace::refinement_workspace() : tabu_until(0, 0),
+                                               tabu_gamma(0, 0),
+                                               m_reserved_nodes(0),
+                                               m_bucket_queue_lhs(0),
+                                               m_bucket_queue_rhs(0),
+                                               m_commons(NULL),
+                                               m_tabu_queue(NULL) {
+}
+
+refinement_workspace::~refinement_workspace() {
+        if( m_commons != NULL ) delete m_commons;
+        if( m_tabu_queue != NULL ) delete m_tabu_queue;
+}
+
+void refinement_workspace::reserve(NodeID n) {
+        if( n <= m_reserved_nodes ) return;
+        m_reserved_nodes = n;
+
+        m_bucket_queue_lhs.reserve_index(n);
+        m_bucket_queue_rhs.reserve_index(n);
+        m_heap_lhs.reserve_index(n);
+        m_heap_rhs.reserve_index(n);
+        m_moved_idx.reserve(n);
+
+        node_marks.resize(n, false);
+        lp_queued.resize(n, false);
+        lp_next_queued.resize(n, false);
+        permutation.reserve(n);
+        lp_queue.reserve(n);
+        lp_next_queue.reserve(n);
+
+        // atomics cannot be moved, the flags are reallocated (all false) instead of resized
+        std::vector< std::atomic<PartitionID> >(n).swap(lp_parallel_blocks);
+        std::vector< std::atomic<bool> >(n).swap(lp_parallel_queued);
+        std::vector< std::atomic<bool> >(n).swap(lp_parallel_next_queued);
+}
+
+refinement_pq * refinement_workspace::queue(const PartitionConfig & config, graph_access & G, unsigned slot) {
+        reserve(G.number_of_nodes());
+        if(config.use_bucket_queues) {
+                bucket_pq & queue = slot == 0 ? m_bucket_queue_lhs : m_bucket_queue_rhs;
+                queue.reset(G.getMaxDegree());
+                return &queue;
+        } else {
+                maxNodeHeap & queue = slot == 0 ? m_heap_lhs : m_heap_rhs;
+                queue.clear();
+                return &queue;
+        }
+}
+
+vertex_moved_hashtable & refinement_workspace::moved_idx(graph_access & G) {
+        reserve(G.number_of_nodes());
+        m_moved_idx.clear();
+        return m_moved_idx;
+}
+
+tabu_bucket_queue & refinement_workspace::tabu_queue(PartitionConfig & config, graph_access & G) {
+        if( m_tabu_queue == NULL ) {
+                m_tabu_queue = new tabu_bucket_queue(config, G.getMaxDegree(), G.number_of_nodes());
+        } else {
+                m_tabu_queue->reset(config, G.getMaxDegree(), G.number_of_nodes());
+        }
+        return *m_tabu_queue;
+}
+
+kway_graph_refinement_commons * refinement_workspace::commons(PartitionConfig & config) {
+        if( m_commons == NULL ) {
+                m_commons = new kway_graph_refinement_commons(config);
+        } else if( m_commons->getUnderlyingK() != config.k ) {
+                m_commons->init(config);
+        }
+        return m_commons;
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * refinement_workspace.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef REFINEMENT_WORKSPACE_K3T8WQ5N
+#define REFINEMENT_WORKSPACE_K3T8WQ5N
+
+#include <atomic>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/normal_matrix.h"
+#include "data_structure/priority_queues/bucket_pq.h"
+#include "data_structure/priority_queues/maxNodeHeap.h"
+#include "definitions.h"
+#include "partition_config.h"
+#include "uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement_commons.h"
+#include "uncoarsening/refinement/quotient_graph_refinement/2way_fm_refinement/vertex_moved_hashtable.h"
+#include "uncoarsening/refinement/tabu_search/tabu_bucket_queue.h"
+
+// Scratch memory of the local searches. One workspace is created per uncoarsening
+// and reserved for the finest graph, the refinement algorithms then draw their
+// queues, moved tables and node lists from it instead of allocating them for every
+// search. Everything handed out is sized for the graph at hand but may contain
+// data of the previous search: the users clear the lists they use, flag arrays
+// are all false when handed out and have to be reset by whoever sets them.
+class refinement_workspace {
+        public:
+                refinement_workspace();
+                virtual ~refinement_workspace();
+
+                // sizes the node indexed structures for graphs with up to n nodes
+                void reserve(NodeID n);
+
+                // an empty queue for a search on G, a bucket queue if config.use_bucket_queues is set.
+                // the two slots are used by searches that need two queues at the same time
+                refinement_pq * queue(const PartitionConfig & config, graph_access & G, unsigned slot = 0);
+
+                // an empty moved table for a search on G
+                vertex_moved_hashtable & moved_idx(graph_access & G);
+
+                // an empty tabu queue for a search on G
+                tabu_bucket_queue & tabu_queue(PartitionConfig & config, graph_access & G);
+
+                // gain computation shared by the k-way searches
+                kway_graph_refinement_commons * commons(PartitionConfig & config);
+
+                // the moves of a k-way search (two_way_fm only uses transpositions)
+                std::vector<NodeID>      transpositions;
+                std::vector<PartitionID> from_partitions;
+                std::vector<PartitionID> to_partitions;
+
+                // start nodes of kway_graph_refinement and multitry_kway_fm rounds
+                std::vector<NodeID> start_nodes;
+                std::vector<NodeID> todolist;
+                std::vector<NodeID> local_start_nodes;
+
+                // start nodes of the pairwise refinements
+                std::vector<NodeID> lhs_start_nodes;
+                std::vector<NodeID> rhs_start_nodes;
+                std::unordered_map<PartitionID, PartitionID> touched_blocks;
+
+                // node flags, all false when handed out
+                std::vector<bool> node_marks;
+
+                // label propagation refinement
+                std::vector<NodeID> permutation;
+                std::vector<NodeID> lp_queue;
+                std::vector<NodeID> lp_next_queue;
+                std::vector<bool>   lp_queued;
+                std::vector<bool>   lp_next_queued;
+
+                // parallel label propagation refinement, the scratch vectors are per thread.
+                // the blocks of the nodes are shadowed by atomics while the threads move them
+                std::vector< std::atomic<PartitionID> > lp_parallel_blocks;
+                std::vector< std::atomic<bool> >       lp_parallel_queued;
+                std::vector< std::atomic<bool> >       lp_parallel_next_queued;
+                std::vector< std::vector<EdgeWeight> > lp_thread_ratings;
+                std::vector< std::vector<NodeID> >     lp_thread_queues;
+
+                // tabu search
+                std::vector<PartitionID> best_map;
+                std::vector<PartitionID> cur_state;
+                std::vector< std::pair<NodeID, PartitionID> > undo_buffer;
+                normal_matrix            tabu_until;  // node x block -> iteration until the move is tabu
+                normal_matrix            tabu_gamma;  // node x block -> number of edges into the block
+
+        private:
+                NodeID                          m_reserved_nodes;
+                bucket_pq                       m_bucket_queue_lhs;
+                bucket_pq                       m_bucket_queue_rhs;
+                maxNodeHeap                     m_heap_lhs;
+                maxNodeHeap                     m_heap_rhs;
+                vertex_moved_hashtable          m_moved_idx;
+                kway_graph_refinement_commons * m_commons;
+                tabu_bucket_queue             * m_tabu_queue;
+};
+
+
+#endif /* end of include guard: REFINEMENT_WORKSPACE_K3T8WQ5N */
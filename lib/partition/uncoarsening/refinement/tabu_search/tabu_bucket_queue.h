@@ -23,6 +23,9 @@ class tabu_bucket_queue  {
 
                 virtual ~tabu_bucket_queue() { delete m_queue_index; delete m_gains;};
 
+                // empties the queue and prepares it for another graph, the memory is kept
+                void reset( PartitionConfig & config, const EdgeWeight & gain_span, NodeID number_of_nodes );
+
                 NodeID size();  
                 void insert(NodeID id, PartitionID block, Gain gain); 
                 bool empty();
@@ -60,6 +63,20 @@ inline tabu_bucket_queue::tabu_bucket_queue( PartitionConfig & config,
         m_buckets.resize(2*m_gain_span+1);
 }
 
+inline void tabu_bucket_queue::reset( PartitionConfig & config, 
+                                      const EdgeWeight & gain_span_input, 
+                                      NodeID number_of_nodes ) {
+        m_elements    = 0;
+        m_gain_span   = gain_span_input;
+        m_max_idx     = 0;
+        m_queue_index->reset( number_of_nodes, config.k);
+        m_gains->reset( number_of_nodes, config.k);
+        for( unsigned i = 0; i < m_buckets.size(); i++) {
+                m_buckets[i].clear();
+        }
+        m_buckets.resize(2*m_gain_span+1);
+}
+
 inline NodeID tabu_bucket_queue::size() {
         return m_elements;  
 }
@@ -14,12 +14,13 @@
 #include "uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement_commons.h"
 #include "uncoarsening/refinement/kway_graph_refinement/kway_stop_rule.h"
 
-tabu_search::tabu_search() {
-                
+tabu_search::tabu_search(refinement_workspace * workspace) : m_workspace (workspace),
+                                                             m_owns_workspace (workspace == NULL) {
+        if( m_owns_workspace ) m_workspace = new refinement_workspace();
 }
 
 tabu_search::~tabu_search() {
-                
+        if( m_owns_workspace ) delete m_workspace;
 }
 
 EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_access & G, complete_boundary & boundary) {
@@ -27,24 +28,26 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
         EdgeWeight input_cut = qm.edge_cut(G);
         EdgeWeight cur_cut   = input_cut;
         EdgeWeight best_cut  = input_cut;
-        std::vector< PartitionID > bestmap(G.number_of_nodes(), 0);
+        std::vector< PartitionID > & bestmap = m_workspace->best_map;
+        bestmap.resize(G.number_of_nodes());
         forall_nodes(G, node) {
                 bestmap[node] = G.getPartitionIndex(node);
         } endfor
         
 
-        EdgeWeight max_degree        = G.getMaxDegree();
-        tabu_bucket_queue* queue     = new tabu_bucket_queue(config, max_degree, G.number_of_nodes());
-        tabu_moves_queue* tabu_moves = new tabu_moves_queue();
+        tabu_bucket_queue & queue    = m_workspace->tabu_queue(config, G);
+        tabu_moves_queue tabu_moves;
 
-        matrix* T     = new normal_matrix(G.number_of_nodes(), config.k);
-        matrix* gamma = new normal_matrix(G.number_of_nodes(), config.k);
+        normal_matrix & T            = m_workspace->tabu_until;
+        normal_matrix & gamma        = m_workspace->tabu_gamma;
+        T.reset(G.number_of_nodes(), config.k);
+        gamma.reset(G.number_of_nodes(), config.k);
 
         forall_nodes(G, node) {
                 forall_out_edges(G, e, node) {
                         NodeID target            = G.getEdgeTarget(e);
                         PartitionID target_block = G.getPartitionIndex(target);
-                        gamma->set_xy( node, target_block, gamma->get_xy(node, target_block) + 1);
+                        gamma.set_xy( node, target_block, gamma.get_xy(node, target_block) + 1);
                 } endfor
         } endfor
 
@@ -61,10 +64,10 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
 
                 if(is_bnd) {
                         for( unsigned block = 0; block < config.k; block++) {
-                                if( gamma->get_xy(node, block) > 0  && G.getPartitionIndex(node) != block) {
-                                        queue->insert(node, block, gamma->get_xy(node, block) - gamma->get_xy(node, G.getPartitionIndex(node)));
+                                if( gamma.get_xy(node, block) > 0  && G.getPartitionIndex(node) != block) {
+                                        queue.insert(node, block, gamma.get_xy(node, block) - gamma.get_xy(node, G.getPartitionIndex(node)));
                                 } else {
-                                        tabu_moves->insert(node, block, 0);
+                                        tabu_moves.insert(node, block, 0);
                                 }       
                         }
                 }
@@ -74,16 +77,18 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
         config.maxT                  = random_functions::nextInt(50, 3000);
         unsigned iteration_limit     = std::min((int)(2*G.number_of_nodes()), 40000);
 
-        std::vector< std::pair<NodeID, PartitionID > > undo_buffer;
+        std::vector< std::pair<NodeID, PartitionID > > & undo_buffer = m_workspace->undo_buffer;
+        undo_buffer.clear();
         undo_buffer.reserve(G.number_of_edges());
 
-        std::vector<PartitionID> cur_state(G.number_of_nodes());
+        std::vector<PartitionID> & cur_state = m_workspace->cur_state;
+        cur_state.resize(G.number_of_nodes());
         int best_idx = -1; int round_counter = -1; unsigned iteration = 0;
 
         for( iteration = 0, round_counter = 0; iteration < config.maxIter; iteration++) {
-                if(!queue->empty()) {
-                        Gain gain                          = queue->maxValue();
-                        std::pair< NodeID, PartitionID > p = queue->deleteMax();
+                if(!queue.empty()) {
+                        Gain gain                          = queue.maxValue();
+                        std::pair< NodeID, PartitionID > p = queue.deleteMax();
                         NodeID node                        = p.first;
                         NodeID block                       = p.second;
                         NodeID from                        = G.getPartitionIndex(node);
@@ -94,8 +99,8 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
 
                                 forall_out_edges(G, e, node) {
                                         NodeID target = G.getEdgeTarget(e);
-                                        gamma->set_xy( target, from, gamma->get_xy(target, from) - 1);
-                                        gamma->set_xy( target, block, gamma->get_xy(target, block) + 1);
+                                        gamma.set_xy( target, from, gamma.get_xy(target, from) - 1);
+                                        gamma.set_xy( target, block, gamma.get_xy(target, block) + 1);
                                 } endfor
 
                                 forall_out_edges(G, e, node) {
@@ -103,15 +108,15 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
                                         PartitionID target_block = G.getPartitionIndex(target);
 
                                         for( unsigned i = 0; i < config.k; i++) {
-                                                if(queue->contains( target, i )) {
-                                                        if( gamma->get_xy(target, i) == 0) {
-                                                                queue->deleteNode(target, i);
+                                                if(queue.contains( target, i )) {
+                                                        if( gamma.get_xy(target, i) == 0) {
+                                                                queue.deleteNode(target, i);
                                                         } else {
-                                                                queue->changeKey(target, i, gamma->get_xy(target, i) - gamma->get_xy(target, target_block));
+                                                                queue.changeKey(target, i, gamma.get_xy(target, i) - gamma.get_xy(target, target_block));
                                                         }
                                                 } else {
-                                                        if( gamma->get_xy(target, i) > 0 && T->get_xy(target, i) < (int)iteration) {
-                                                                queue->insert(target, i, gamma->get_xy(target, i) - gamma->get_xy(target, target_block));
+                                                        if( gamma.get_xy(target, i) > 0 && T.get_xy(target, i) < (int)iteration) {
+                                                                queue.insert(target, i, gamma.get_xy(target, i) - gamma.get_xy(target, target_block));
                                                         }
                                                 }
                                         }
@@ -128,15 +133,15 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
 
                                 forall_out_edges(G, e, node) {
                                         for( unsigned i = 0; i < config.k; i++) {
-						if(queue->contains( node, i)) {
-							if( gamma->get_xy(node, i) ==  0) {
-								queue->deleteNode(node,i);
+						if(queue.contains( node, i)) {
+							if( gamma.get_xy(node, i) ==  0) {
+								queue.deleteNode(node,i);
 							} else {
-								queue->changeKey(node, i, gamma->get_xy(node, i) - gamma->get_xy(node, block));
+								queue.changeKey(node, i, gamma.get_xy(node, i) - gamma.get_xy(node, block));
 							}
 						} else {
-							if(gamma->get_xy(node, i) > 0 && T->get_xy(node, i) < (int)iteration) {
-								queue->insert(node, i, gamma->get_xy(node, i) - gamma->get_xy(node, block));
+							if(gamma.get_xy(node, i) > 0 && T.get_xy(node, i) < (int)iteration) {
+								queue.insert(node, i, gamma.get_xy(node, i) - gamma.get_xy(node, block));
 							}
 						}
                                         }
@@ -149,19 +154,19 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
                         unsigned tenure = config.maxT;//random_functions::nextInt( config.maxT, 2*config.maxT); 
                         tenure = compute_tenure(iteration, tenure);
                         unsigned small_offset = random_functions::nextInt(1,3);
-                        T->set_xy(node, block, iteration + tenure + small_offset);
-                        tabu_moves->insert(node, block, iteration + tenure + small_offset);
-                        if( T->get_xy( node, from) < (int)iteration ) {
-                                T->set_xy(node, from, iteration + tenure);
-                                tabu_moves->insert(node, from, iteration + tenure);
+                        T.set_xy(node, block, iteration + tenure + small_offset);
+                        tabu_moves.insert(node, block, iteration + tenure + small_offset);
+                        if( T.get_xy( node, from) < (int)iteration ) {
+                                T.set_xy(node, from, iteration + tenure);
+                                tabu_moves.insert(node, from, iteration + tenure);
                         }
 
-                        if(queue->contains(node, from) ) {
-                               queue->deleteNode(node, from);
+                        if(queue.contains(node, from) ) {
+                               queue.deleteNode(node, from);
                         }
 
-                        if(queue->contains(node, block) ) {
-                               queue->deleteNode(node, block);
+                        if(queue.contains(node, block) ) {
+                               queue.deleteNode(node, block);
                         }
 
                 }
@@ -201,19 +206,19 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
                 }
 
                 //reinsert the buffer
-                if( !tabu_moves->empty() ) {
-                        while( tabu_moves->minValue() <= (int)iteration ) {
-                                std::pair< NodeID, PartitionID > p = tabu_moves->deleteMin();
+                if( !tabu_moves.empty() ) {
+                        while( tabu_moves.minValue() <= (int)iteration ) {
+                                std::pair< NodeID, PartitionID > p = tabu_moves.deleteMin();
                                 NodeID node = p.first; 
                                 NodeID block = p.second; 
 
                                 if( block  == G.getPartitionIndex(node) ) {
                                         unsigned tenure = compute_tenure(iteration, config.maxT);
-                                        T->set_xy(node, block, iteration + tenure);
-                                        tabu_moves->insert(node, block,iteration + tenure);
+                                        T.set_xy(node, block, iteration + tenure);
+                                        tabu_moves.insert(node, block,iteration + tenure);
                                 } else {
-					if(gamma->get_xy(node, block) > 0) {
-	                                        queue->insert( p.first, p.second,  gamma->get_xy(node, block) - gamma->get_xy(node, G.getPartitionIndex(node)));
+					if(gamma.get_xy(node, block) > 0) {
+	                                        queue.insert( p.first, p.second,  gamma.get_xy(node, block) - gamma.get_xy(node, G.getPartitionIndex(node)));
 					}
                                 }
                         }
@@ -240,10 +245,5 @@ EdgeWeight tabu_search::perform_refinement(PartitionConfig & config, graph_acces
                 G.setPartitionIndex(node, bestmap[node]);
         } endfor
 
-        delete T;
-        delete gamma;
-        delete queue;
-        delete tabu_moves;
-
         return 0; 
 }
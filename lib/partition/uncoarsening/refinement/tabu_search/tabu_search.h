@@ -13,10 +13,11 @@
 #include "definitions.h"
 #include "uncoarsening/refinement/kway_graph_refinement/kway_graph_refinement_commons.h"
 #include "uncoarsening/refinement/refinement.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class tabu_search : public refinement {
         public:
-                tabu_search();
+                tabu_search( refinement_workspace * workspace = NULL );
                 virtual ~tabu_search();
 
                 virtual EdgeWeight perform_refinement(PartitionConfig & config, 
@@ -60,6 +61,8 @@ class tabu_search : public refinement {
 
                 kway_graph_refinement_commons* commons;
                 matrix* m;
+                refinement_workspace* m_workspace;
+                bool m_owns_workspace;
 };
 
 
@@ -24,10 +24,15 @@ class area_bfs {
 				std::vector< NodeID > & reached_nodes) {
 
 
+			// the markers are per thread, a thread that did not prepare them starts with an empty array
+			if( m_deepth.size() < G.number_of_nodes() ) {
+				m_deepth.resize(G.number_of_nodes(), 0);
+			}
+
 			// for correctness, in practice will almost never be called
 			if( round == std::numeric_limits<int>::max()) {
 				round = 0;
-				for( int i = 0; m_deepth.size(); i++) {
+				for( unsigned int i = 0; i < m_deepth.size(); i++) {
 					m_deepth[i] = 0;
 				}
 			}
@@ -49,12 +54,12 @@ class area_bfs {
 			NodeWeight size_sep = block_weights[2];
 
 			NodeWeight accumulated_weight = 0;
-			NodeID upper_bound_no_nodes;
+			NodeWeight upper_bound_no_nodes;
 
 			if( block == 0 ) {
-				upper_bound_no_nodes = std::max((int)(config.region_factor_node_separators*config.upper_bound_partition - size_rhs - size_sep), 0);
+				upper_bound_no_nodes = std::max(config.region_factor_node_separators*config.upper_bound_partition - size_rhs - size_sep, 0.0);
 			} else {
-				upper_bound_no_nodes = std::max((int)(config.region_factor_node_separators*config.upper_bound_partition - size_lhs - size_sep), 0);
+				upper_bound_no_nodes = std::max(config.region_factor_node_separators*config.upper_bound_partition - size_lhs - size_sep, 0.0);
 			}
 			upper_bound_no_nodes = std::min(upper_bound_no_nodes, block_weights[block]-1);
 
@@ -79,8 +84,8 @@ class area_bfs {
 			}
 		}
 
-		static std::vector<int> m_deepth;
-		static int round;
+		static thread_local std::vector<int> m_deepth;
+		static thread_local int round;
 
 };
 
@@ -269,7 +269,7 @@ NodeWeight vertex_separator_algorithm::improve_vertex_separator_internal(const P
         std::vector< NodeID > forward_mapping; // maps a node from rG to original G
         build_flow_problem(config, G, lhs_nodes, rhs_nodes, start_nodes, rG, forward_mapping, source, sink);
 
-	push_relabel mfmc_solver; std::vector<NodeID> source_set;
+	push_relabel mfmc_solver(false); std::vector<NodeID> source_set;
         bool compute_source_set = !config.most_balanced_minimum_cuts_node_sep;
 	FlowType value =  mfmc_solver.solve_max_flow_min_cut(rG, source, sink, compute_source_set, source_set);
 
@@ -426,7 +426,7 @@ NodeWeight vertex_separator_algorithm::improve_vertex_separator_internal(const P
         std::vector< NodeID > forward_mapping; // maps a node from rG to original G
         build_flow_problem(config, G, lhs_nodes, rhs_nodes, input_separator, rG, forward_mapping, source, sink);
 
-	push_relabel mfmc_solver; std::vector<NodeID> source_set;
+	push_relabel mfmc_solver(false); std::vector<NodeID> source_set;
         bool compute_source_set = !config.most_balanced_minimum_cuts_node_sep;
 	FlowType value =  mfmc_solver.solve_max_flow_min_cut(rG, source, sink, compute_source_set, source_set);
 
@@ -34,7 +34,7 @@ void vertex_separator_flow_solver::find_separator(const PartitionConfig & config
         std::vector<NodeID> new_to_old_ids; flow_graph fG;
         build_flow_pb(config, G, lhs, rhs, lhs_nodes, rhs_nodes, new_to_old_ids, fG);
 
-        push_relabel pr;
+        push_relabel pr(false);
         NodeID source = fG.number_of_nodes() - 2;
         NodeID sink   = fG.number_of_nodes() - 1;
 
@@ -136,6 +136,7 @@ bool vertex_separator_flow_solver::build_flow_pb( const PartitionConfig & config
                 NodeID sourceID = old_to_new[rhs_nodes[i]];
                 fG.new_edge(sourceID, sink, G.getNodeWeight(rhs_nodes[i]));
         }
+        fG.finish_construction();
 
         return true;
 }
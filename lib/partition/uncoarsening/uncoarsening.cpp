@@ -14,12 +14,14 @@
 #include "refinement/node_separators/localized_fm_ns_local_search.h"
 #include "refinement/label_propagation_refinement/label_propagation_refinement.h"
 #include "refinement/refinement.h"
+#include "refinement/refinement_workspace.h"
 #include "separator/vertex_separator_algorithm.h"
 #include "tools/random_functions.h"
+#include "tools/trace.h"
 #include "uncoarsening.h"
 
 
-uncoarsening::uncoarsening() {
+uncoarsening::uncoarsening(refinement_workspace * workspace) : m_workspace (workspace) {
 
 }
 
@@ -28,6 +30,7 @@ uncoarsening::~uncoarsening() {
 }
 
 int uncoarsening::perform_uncoarsening(const PartitionConfig & config, graph_hierarchy & hierarchy) {
+        trace_scope scope("uncoarsening");
 
         if(config.mode_node_separators) {
                 if( config.faster_ns ) {
@@ -46,10 +49,15 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
         PartitionConfig cfg     = config;
         refinement* refine      = NULL;
 
+        // scratch memory of the local searches, shared by all levels
+        refinement_workspace local_workspace;
+        refinement_workspace & workspace = m_workspace != NULL ? *m_workspace : local_workspace;
+        workspace.reserve(hierarchy.get_finest()->number_of_nodes());
+
         if(config.label_propagation_refinement) {
-                refine      = new label_propagation_refinement();
+                refine      = new label_propagation_refinement(&workspace);
         } else {
-                refine      = new mixed_refinement();
+                refine      = new mixed_refinement(&workspace);
         }
 
         graph_access * coarsest = hierarchy.get_coarsest();
@@ -63,7 +71,12 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
         }
         double factor = config.balance_factor;
         cfg.upper_bound_partition = ((!hierarchy.isEmpty()) * factor +1.0)*config.upper_bound_partition;
-        improvement += (int)refine->perform_refinement(cfg, *coarsest, *coarser_boundary);
+        {
+                trace_scope level_scope("refinement level");
+                level_scope.arg("nodes", coarsest->number_of_nodes());
+                level_scope.arg("edges", coarsest->number_of_edges());
+                improvement += (int)refine->perform_refinement(cfg, *coarsest, *coarser_boundary);
+        }
 
         NodeID coarser_no_nodes = coarsest->number_of_nodes();
         graph_access* finest    = NULL;
@@ -72,6 +85,9 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
 
         while(!hierarchy.isEmpty()) {
                 graph_access* G = hierarchy.pop_finer_and_project();
+                trace_scope level_scope("refinement level");
+                level_scope.arg("nodes", G->number_of_nodes());
+                level_scope.arg("edges", G->number_of_edges());
 
                 PRINT(std::cout << "log>" << "unrolling graph with " << G->number_of_nodes()<<  std::endl;)
                 
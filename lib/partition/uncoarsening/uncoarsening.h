@@ -10,16 +10,21 @@
 
 #include "data_structure/graph_hierarchy.h"
 #include "partition_config.h"
+#include "uncoarsening/refinement/refinement_workspace.h"
 
 class uncoarsening {
 public:
-        uncoarsening( );
+        // the refinement of cuts uses workspace if given, a workspace of its own otherwise
+        uncoarsening( refinement_workspace * workspace = NULL );
         virtual ~uncoarsening();
         
         int perform_uncoarsening(const PartitionConfig & config, graph_hierarchy & hierarchy);
         int perform_uncoarsening_cut(const PartitionConfig & config, graph_hierarchy & hierarchy);
         int perform_uncoarsening_nodeseparator(const PartitionConfig & config, graph_hierarchy & hierarchy);
         int perform_uncoarsening_nodeseparator_fast(const PartitionConfig & config, graph_hierarchy & hierarchy);
+
+private:
+        refinement_workspace * m_workspace;
 };
 
 
@@ -5,57 +5,71 @@
  * Author: Daniel Seemaier <daniel.seemaier@student.kit.edu>
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
+#include <algorithm>
+#include <limits>
+#include <omp.h>
+
 #include "spac.h"
+#include "tools/parallel_tools.h"
 
 spac::spac(graph_access &input_graph, EdgeWeight infinity)
         : m_input_graph(input_graph),  m_split_graph(), m_infinity(infinity), m_reverse_edge() {
 }
 
+// number of edges of a split vertex: its dominant edge plus the auxiliary edges
+// that connect it to its neighbours in the cycle around the input vertex
+static inline EdgeID split_vertex_degree(NodeID deg) {
+    if (deg == 2) return 2;
+    if (deg > 2) return 3;
+    return 1;
+}
+
 graph_access &spac::construct_split_graph() {
     find_reverse_edges();
 
-    // find number of degree 1 and 2 vertices
-    NodeID number_of_deg1_vertices = 0;
-    NodeID number_of_deg2_vertices = 0;
-    for (NodeID v = 0; v < m_input_graph.number_of_nodes(); ++v) {
-        //NodeID deg = m_input_graph.getNodeDegree(v);
+    const NodeID n = m_input_graph.number_of_nodes();
+    const NodeID split_n = m_input_graph.number_of_edges(); // two times the number of edges
 
-        if (m_input_graph.getNodeDegree(v) == 1) {
-            ++number_of_deg1_vertices;
-        } else if (m_input_graph.getNodeDegree(v) == 2) {
-            ++number_of_deg2_vertices;
-        }
+    // the split vertices of u occupy a consecutive range of the adjacency array,
+    // a prefix sum over their degrees yields where the range of each input vertex starts
+    std::vector<EdgeID> offset(n + 1, 0);
+    #pragma omp parallel for schedule(static)
+    for (NodeID u = 0; u < n; ++u) {
+        NodeID deg = m_input_graph.getNodeDegree(u);
+        offset[u] = deg * split_vertex_degree(deg);
     }
+    parallel_tools::prefix_sum(offset);
 
-    // calculation of the dimension of the split graph
-    NodeID split_n = m_input_graph.number_of_edges(); // two times the number of edges
-    EdgeID split_m = 3 * m_input_graph.number_of_edges() - 2 * (number_of_deg1_vertices + number_of_deg2_vertices);
-    m_split_graph.start_construction(split_n, split_m);
+    const EdgeID split_m = offset[n];
+    m_split_graph.start_bulk_construction(split_n, split_m);
 
-    for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
+    // every input vertex writes its own split vertices, thus the graph is identical to
+    // the one obtained by adding the split vertices one after another
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (NodeID u = 0; u < n; ++u) {
         NodeID deg = m_input_graph.getNodeDegree(u);
+        EdgeID split_edge = offset[u];
 
         for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
             EdgeID nth_edge_at_u = (e - m_input_graph.get_first_edge(u));
 
-            NodeID split_node = m_split_graph.new_node();
-            assert(e == split_node);
+            NodeID split_node = e;
+            m_split_graph.setFirstEdge(split_node, split_edge);
             m_split_graph.setNodeWeight(split_node, 1);
 
-            EdgeID dominant_edge = m_split_graph.new_edge(split_node, m_reverse_edge[e]);
-            m_split_graph.setEdgeWeight(dominant_edge, m_infinity);
+            m_split_graph.setEdgeTarget(split_edge, m_reverse_edge[e]);
+            m_split_graph.setEdgeWeight(split_edge++, m_infinity);
 
             if (deg == 2) {
-                EdgeID auxiliary_edge;
-                if (nth_edge_at_u == 0) { // split split vertex
-                    auxiliary_edge = m_split_graph.new_edge(split_node, split_node + 1);
+                if (nth_edge_at_u == 0) { // first split vertex
+                    m_split_graph.setEdgeTarget(split_edge, split_node + 1);
                 } else { // second split vertex
                     assert(e + 1 == m_input_graph.get_first_invalid_edge(u));
                     assert(split_node > 0);
 
-                    auxiliary_edge = m_split_graph.new_edge(split_node, split_node - 1);
+                    m_split_graph.setEdgeTarget(split_edge, split_node - 1);
                 }
-                m_split_graph.setEdgeWeight(auxiliary_edge, 1);
+                m_split_graph.setEdgeWeight(split_edge++, 1);
             } else if (deg > 2) {
                 // calculate offsets between split_node and the next / prev node in the cycle
                 int prev_offset = -1;
@@ -66,15 +80,21 @@ graph_access &spac::construct_split_graph() {
                     next_offset = -(deg - 1);
                 }
 
-                m_split_graph.setEdgeWeight(m_split_graph.new_edge(split_node, split_node + prev_offset), 1);
-                m_split_graph.setEdgeWeight(m_split_graph.new_edge(split_node, split_node + next_offset), 1);
+                m_split_graph.setEdgeTarget(split_edge, split_node + prev_offset);
+                m_split_graph.setEdgeWeight(split_edge++, 1);
+                m_split_graph.setEdgeTarget(split_edge, split_node + next_offset);
+                m_split_graph.setEdgeWeight(split_edge++, 1);
             } else {
                 // nothing to do for leaves
                 assert(deg == 1);
             }
         }
+
+        assert(split_edge == offset[u + 1]);
     }
 
+    m_split_graph.finish_construction();
+
 #ifndef NDEBUG
     for (NodeID u = 0; u < m_split_graph.number_of_nodes(); ++u) {
         assert(m_split_graph.getNodeDegree(u) > 0);
@@ -85,7 +105,6 @@ graph_access &spac::construct_split_graph() {
     }
 #endif
 
-    m_split_graph.finish_construction();
     return m_split_graph;
 }
 
@@ -177,36 +196,44 @@ void spac::find_reverse_edges() {
         return;
     }
 
-    const EdgeID guard = std::numeric_limits<EdgeID>::max();
-    m_reverse_edge.resize(m_input_graph.number_of_edges(), guard);
+    compute_reverse_edges(m_input_graph, m_reverse_edge);
+}
 
-    for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
-        for (EdgeID e_uv = m_input_graph.get_first_edge(u); e_uv < m_input_graph.get_first_invalid_edge(u); ++e_uv) {
-            NodeID v = m_input_graph.getEdgeTarget(e_uv);
+void spac::compute_reverse_edges(graph_access &G, std::vector<EdgeID> &reverse_edge) {
+    const NodeID n = G.number_of_nodes();
+    const EdgeID guard = std::numeric_limits<EdgeID>::max();
+    reverse_edge.assign(G.number_of_edges(), guard);
 
-            if (u < v) {
-                assert(m_reverse_edge[e_uv] == guard);
-            } else {
-                assert(m_reverse_edge[e_uv] != guard);
-                continue;
-            }
+    // copy of the adjacency array with every adjacency list sorted by target,
+    // the reverse edge of (u, v) is then found by a binary search in the list of v
+    // (target and position in the adjacency list are packed into one word to make the comparisons cheap)
+    std::vector<uint64_t> sorted_edges(G.number_of_edges());
 
-#ifndef NDEBUG
-            bool found_reverse_edge = false;
-#endif
-            for (EdgeID e_vu = m_input_graph.get_first_edge(v); e_vu < m_input_graph.get_first_invalid_edge(v); ++e_vu) {
-                if (m_input_graph.getEdgeTarget(e_vu) == u) {
-                    m_reverse_edge[e_uv] = e_vu;
-                    m_reverse_edge[e_vu] = e_uv;
-#ifndef NDEBUG
-                    found_reverse_edge = true;
-#endif
-                    break;
-                }
-            }
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (NodeID u = 0; u < n; ++u) {
+        for (EdgeID e = G.get_first_edge(u); e < G.get_first_invalid_edge(u); ++e) {
+            sorted_edges[e] = ((uint64_t) G.getEdgeTarget(e) << 32) | (uint64_t) (e - G.get_first_edge(u));
+        }
+        std::sort(sorted_edges.begin() + G.get_first_edge(u), sorted_edges.begin() + G.get_first_invalid_edge(u));
+    }
 
-            assert(found_reverse_edge);
-            assert(m_reverse_edge[e_uv] != guard);
+    // only the endpoint with the smaller id searches, hence no two threads write the same entry
+    #pragma omp parallel for schedule(dynamic, 1024)
+    for (NodeID u = 0; u < n; ++u) {
+        for (EdgeID e_uv = G.get_first_edge(u); e_uv < G.get_first_invalid_edge(u); ++e_uv) {
+            NodeID v = G.getEdgeTarget(e_uv);
+            if (u >= v) continue;
+
+            auto begin = sorted_edges.begin() + G.get_first_edge(v);
+            auto end = sorted_edges.begin() + G.get_first_invalid_edge(v);
+            auto it = std::lower_bound(begin, end, (uint64_t) u << 32);
+
+            assert(it != end && (NodeID) (*it >> 32) == u);
+            EdgeID e_vu = G.get_first_edge(v) + (EdgeID) (*it & 0xFFFFFFFF);
+            reverse_edge[e_uv] = e_vu;
+            reverse_edge[e_vu] = e_uv;
         }
     }
+
+    assert(std::find(reverse_edge.begin(), reverse_edge.end(), guard) == reverse_edge.end());
 }
@@ -25,6 +25,9 @@ public:
 
     unsigned calculate_vertex_cut(const std::vector<PartitionID> &edge_partition);
 
+    // reverse_edge[e] is the edge (v, u) for e = (u, v), computed in parallel
+    static void compute_reverse_edges(graph_access &G, std::vector<EdgeID> &reverse_edge);
+
 private:
     void find_reverse_edges();
 
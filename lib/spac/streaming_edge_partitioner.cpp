@@ -0,0 +1,213 @@
+/******************************************************************************
+ * streaming_edge_partitioner.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+
+#include "streaming_edge_partitioner.h"
+
+streaming_edge_partitioner::streaming_edge_partitioner(graph_access &input_graph, PartitionID k, double imbalance,
+                                                       double lambda)
+        : m_input_graph(input_graph), m_k(k), m_lambda(lambda) {
+    const NodeID n = m_input_graph.number_of_nodes();
+    const EdgeID m = m_input_graph.number_of_edges() / 2;
+    m_max_block_size = std::max<EdgeID>(1, std::ceil((1 + imbalance) * m / (double) k));
+
+    // a vertex of degree d has edges in at most min(d, k) blocks
+    m_replica_start.resize(n + 1);
+    m_replica_start[0] = 0;
+    for (NodeID u = 0; u < n; ++u) {
+        m_replica_start[u + 1] = m_replica_start[u] + std::min<EdgeID>(m_input_graph.getNodeDegree(u), k);
+    }
+    m_replica_size.resize(n, 0);
+    m_replica_block.resize(m_replica_start[n]);
+    m_replica_count.resize(m_replica_start[n]);
+    m_partial_degree.resize(n, 0);
+
+    m_block_size.resize(k, 0);
+    m_min_size = 0;
+    m_max_size = 0;
+    m_blocks_with_min_size = k;
+    m_min_block_cursor = 0;
+}
+
+std::vector<PartitionID> streaming_edge_partitioner::perform_partitioning(const std::vector<EdgeID> &reverse_edge) {
+    std::vector<PartitionID> edge_partition(m_input_graph.number_of_edges());
+    std::vector<PartitionID> candidates;
+    const double epsilon = 1;
+
+    for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
+        for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
+            NodeID v = m_input_graph.getEdgeTarget(e);
+            if (u >= v) continue;
+
+            ++m_partial_degree[u];
+            ++m_partial_degree[v];
+            double theta_u = m_partial_degree[u] / (double) (m_partial_degree[u] + m_partial_degree[v]);
+            double theta_v = 1 - theta_u;
+
+            // blocks without edges of u and v only differ in the balance term, hence the
+            // smallest block is the only one of them that has to be scored
+            candidates.clear();
+            candidates.push_back(smallest_block());
+            for (EdgeID slot = m_replica_start[u]; slot < m_replica_start[u] + m_replica_size[u]; ++slot) {
+                candidates.push_back(m_replica_block[slot]);
+            }
+            for (EdgeID slot = m_replica_start[v]; slot < m_replica_start[v] + m_replica_size[v]; ++slot) {
+                candidates.push_back(m_replica_block[slot]);
+            }
+
+            PartitionID best_block = candidates[0];
+            double best_score = -1;
+            for (PartitionID p : candidates) {
+                if (m_block_size[p] >= m_max_block_size && p != candidates[0]) continue;
+
+                // the replication term favours the block of the endpoint with the higher (partial) degree
+                double score = m_lambda * (m_max_size - m_block_size[p]) / (epsilon + m_max_size - m_min_size);
+                if (replica_count(u, p) > 0) score += 1 + (1 - theta_u);
+                if (replica_count(v, p) > 0) score += 1 + (1 - theta_v);
+
+                if (score > best_score || (score == best_score && m_block_size[p] < m_block_size[best_block])) {
+                    best_score = score;
+                    best_block = p;
+                }
+            }
+
+            // block sizes only grow while streaming, thus the minimum is maintained by counting the blocks that have it
+            if (m_block_size[best_block] == m_min_size && --m_blocks_with_min_size == 0) {
+                ++m_min_size;
+                m_blocks_with_min_size = std::count(m_block_size.begin(), m_block_size.end(), m_min_size) + 1;
+            }
+            assign(e, reverse_edge[e], u, v, best_block, edge_partition);
+            m_max_size = std::max(m_max_size, m_block_size[best_block]);
+        }
+    }
+
+    return edge_partition;
+}
+
+void streaming_edge_partitioner::perform_local_search(std::vector<PartitionID> &edge_partition,
+                                                      const std::vector<EdgeID> &reverse_edge, unsigned rounds) {
+    std::vector<PartitionID> candidates;
+
+    for (unsigned round = 0; round < rounds; ++round) {
+        EdgeID moved = 0;
+
+        for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
+            for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
+                NodeID v = m_input_graph.getEdgeTarget(e);
+                if (u >= v) continue;
+
+                // the vertex cut can only decrease if the edge is the last one of u or v in its block
+                PartitionID from = edge_partition[e];
+                int loss = (replica_count(u, from) == 1) + (replica_count(v, from) == 1);
+                if (loss == 0) continue;
+
+                candidates.clear();
+                for (EdgeID slot = m_replica_start[u]; slot < m_replica_start[u] + m_replica_size[u]; ++slot) {
+                    candidates.push_back(m_replica_block[slot]);
+                }
+                for (EdgeID slot = m_replica_start[v]; slot < m_replica_start[v] + m_replica_size[v]; ++slot) {
+                    candidates.push_back(m_replica_block[slot]);
+                }
+
+                PartitionID best_block = from;
+                int best_gain = 0;
+                for (PartitionID p : candidates) {
+                    if (p == from || m_block_size[p] >= m_max_block_size) continue;
+
+                    int gain = loss - (replica_count(u, p) == 0) - (replica_count(v, p) == 0);
+                    if (gain > best_gain || (gain == best_gain && m_block_size[p] < m_block_size[best_block])) {
+                        best_gain = gain;
+                        best_block = p;
+                    }
+                }
+
+                // moves without gain are only done if they improve the balance
+                if (best_block == from || (best_gain == 0 && m_block_size[best_block] + 1 >= m_block_size[from])) {
+                    continue;
+                }
+
+                remove_replica(u, from);
+                remove_replica(v, from);
+                --m_block_size[from];
+                assign(e, reverse_edge[e], u, v, best_block, edge_partition);
+                ++moved;
+            }
+        }
+
+        if (moved == 0) break;
+    }
+}
+
+unsigned streaming_edge_partitioner::calculate_vertex_cut() {
+    unsigned cost = 0;
+    for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
+        if (m_replica_size[u] > 0) {
+            cost += m_replica_size[u] - 1;
+        }
+    }
+
+    return cost;
+}
+
+EdgeID streaming_edge_partitioner::replica_count(NodeID u, PartitionID p) {
+    for (EdgeID slot = m_replica_start[u]; slot < m_replica_start[u] + m_replica_size[u]; ++slot) {
+        if (m_replica_block[slot] == p) {
+            return m_replica_count[slot];
+        }
+    }
+
+    return 0;
+}
+
+void streaming_edge_partitioner::add_replica(NodeID u, PartitionID p) {
+    for (EdgeID slot = m_replica_start[u]; slot < m_replica_start[u] + m_replica_size[u]; ++slot) {
+        if (m_replica_block[slot] == p) {
+            ++m_replica_count[slot];
+            return;
+        }
+    }
+
+    EdgeID slot = m_replica_start[u] + m_replica_size[u]++;
+    assert(slot < m_replica_start[u + 1]);
+    m_replica_block[slot] = p;
+    m_replica_count[slot] = 1;
+}
+
+void streaming_edge_partitioner::remove_replica(NodeID u, PartitionID p) {
+    for (EdgeID slot = m_replica_start[u]; slot < m_replica_start[u] + m_replica_size[u]; ++slot) {
+        if (m_replica_block[slot] == p) {
+            if (--m_replica_count[slot] == 0) {
+                // keep the slots in use consecutive
+                EdgeID last = m_replica_start[u] + --m_replica_size[u];
+                m_replica_block[slot] = m_replica_block[last];
+                m_replica_count[slot] = m_replica_count[last];
+            }
+            return;
+        }
+    }
+
+    assert(false);
+}
+
+void streaming_edge_partitioner::assign(EdgeID e, EdgeID e_rev, NodeID u, NodeID v, PartitionID p,
+                                        std::vector<PartitionID> &edge_partition) {
+    edge_partition[e] = p;
+    edge_partition[e_rev] = p;
+    add_replica(u, p);
+    add_replica(v, p);
+    ++m_block_size[p];
+}
+
+PartitionID streaming_edge_partitioner::smallest_block() {
+    while (m_block_size[m_min_block_cursor] != m_min_size) {
+        m_min_block_cursor = (m_min_block_cursor + 1) % m_k;
+    }
+
+    return m_min_block_cursor;
+}
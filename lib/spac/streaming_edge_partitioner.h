@@ -0,0 +1,68 @@
+/******************************************************************************
+ * streaming_edge_partitioner.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef KAHIP_STREAMING_EDGE_PARTITIONER_H
+#define KAHIP_STREAMING_EDGE_PARTITIONER_H
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+
+// Partitions the edges of the input graph without building the split graph:
+// a single HDRF pass assigns every edge to a block, afterwards edges are moved
+// to blocks of their endpoints as long as the vertex cut decreases.
+// Note that this local search works on the vertex cut directly, it is not the
+// SPAC model (partitioning the split graph), so the results are usually worse
+// than the ones of the split graph partitioning.
+class streaming_edge_partitioner {
+public:
+    streaming_edge_partitioner(graph_access &input_graph, PartitionID k, double imbalance, double lambda);
+
+    // returns the block of every (directed) edge, both directions of an edge are in the same block
+    std::vector<PartitionID> perform_partitioning(const std::vector<EdgeID> &reverse_edge);
+
+    // greedy local search, moves edges between blocks of their endpoints if this reduces the vertex cut,
+    // stops after rounds passes or if nothing moved
+    void perform_local_search(std::vector<PartitionID> &edge_partition, const std::vector<EdgeID> &reverse_edge,
+                              unsigned rounds);
+
+    unsigned calculate_vertex_cut();
+
+private:
+    // number of edges of vertex u that are assigned to block p
+    EdgeID replica_count(NodeID u, PartitionID p);
+    void add_replica(NodeID u, PartitionID p);
+    void remove_replica(NodeID u, PartitionID p);
+
+    void assign(EdgeID e, EdgeID e_rev, NodeID u, NodeID v, PartitionID p, std::vector<PartitionID> &edge_partition);
+    PartitionID smallest_block();
+
+    graph_access &m_input_graph;
+    PartitionID m_k;
+    double m_lambda;
+    EdgeID m_max_block_size;
+
+    // blocks that contain edges of a vertex, vertex u owns the slots
+    // [m_replica_start[u], m_replica_start[u+1]) of which the first m_replica_size[u] are in use
+    std::vector<EdgeID> m_replica_start;
+    std::vector<PartitionID> m_replica_size;
+    std::vector<PartitionID> m_replica_block;
+    std::vector<EdgeID> m_replica_count;
+
+    // number of edges of a vertex that have been streamed so far
+    std::vector<EdgeID> m_partial_degree;
+
+    // number of undirected edges per block
+    std::vector<EdgeID> m_block_size;
+    EdgeID m_min_size;
+    EdgeID m_max_size;
+    PartitionID m_blocks_with_min_size;
+    PartitionID m_min_block_cursor;
+};
+
+#endif // KAHIP_STREAMING_EDGE_PARTITIONER_H
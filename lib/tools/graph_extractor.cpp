@@ -5,7 +5,9 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <algorithm>
 #include <unordered_map>
+
 #include "graph_extractor.h"
 
 
@@ -22,19 +24,27 @@ void graph_extractor::extract_block(graph_access & G,
                                     PartitionID block, 
                                     std::vector<NodeID> & mapping) {
 
-        // build reverse mapping
-        std::vector<NodeID> reverse_mapping;
+        // build reverse mapping and count the size of the block, so that
+        // only the memory of the block and not the one of G is reserved
+        std::vector<NodeID> reverse_mapping(G.number_of_nodes());
         NodeID nodes = 0;
+        EdgeID edges = 0;
         NodeID dummy_node = G.number_of_nodes() + 1;
         forall_nodes(G, node) {
                 if(G.getPartitionIndex(node) == block) {
-                        reverse_mapping.push_back(nodes++);
+                        reverse_mapping[node] = nodes++;
+                        forall_out_edges(G, e, node) {
+                                if( G.getPartitionIndex( G.getEdgeTarget(e) ) == block ) {
+                                        edges++;
+                                }
+                        } endfor
                 } else {
-                        reverse_mapping.push_back(dummy_node);
+                        reverse_mapping[node] = dummy_node;
                 }
         } endfor
 
-        extracted_block.start_construction(nodes, G.number_of_edges());
+        extracted_block.start_construction(nodes, edges);
+        mapping.reserve(mapping.size() + nodes);
 
         forall_nodes(G, node) {
                 if(G.getPartitionIndex(node) == block) {
@@ -55,6 +65,97 @@ void graph_extractor::extract_block(graph_access & G,
         extracted_block.finish_construction();
 }
 
+void graph_extractor::extract_all_blocks(graph_access & G, 
+                                         std::vector<graph_access*> & extracted_blocks, 
+                                         std::vector< std::vector<NodeID> > & mappings,
+                                         int num_threads) {
+
+        PartitionID k = G.get_partition_count();
+        NodeID n      = G.number_of_nodes();
+
+        // the nodes are split into chunks of consecutive nodes, the result does not depend on their number
+        num_threads       = std::max(1, num_threads);
+        NodeID chunk_size = std::max((NodeID)1, (NodeID)((n + num_threads - 1) / num_threads));
+        NodeID chunks     = (n + chunk_size - 1) / chunk_size;
+
+        // first pass: number of nodes and edges of every block in every chunk, 
+        // new_id is the id of a node in its block relative to its chunk
+        std::vector<NodeID> new_id(n);
+        std::vector<NodeID> chunk_nodes((size_t)chunks*k, 0);
+        std::vector<EdgeID> chunk_edges((size_t)chunks*k, 0);
+
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+        for( NodeID chunk = 0; chunk < chunks; chunk++) {
+                NodeID begin   = chunk*chunk_size;
+                NodeID last    = std::min(n, begin + chunk_size);
+                NodeID* nodes  = &chunk_nodes[(size_t)chunk*k];
+                EdgeID* edges  = &chunk_edges[(size_t)chunk*k];
+                for( NodeID node = begin; node < last; node++) {
+                        PartitionID block = G.getPartitionIndex(node);
+                        new_id[node]      = nodes[block]++;
+                        forall_out_edges(G, e, node) {
+                                if( G.getPartitionIndex( G.getEdgeTarget(e) ) == block ) {
+                                        edges[block]++;
+                                }
+                        } endfor
+                }
+        }
+
+        // turn the counts into offsets of the chunks in the blocks
+        std::vector<NodeID> block_nodes(k, 0);
+        std::vector<EdgeID> block_edges(k, 0);
+        for( PartitionID block = 0; block < k; block++) {
+                for( NodeID chunk = 0; chunk < chunks; chunk++) {
+                        size_t idx         = (size_t)chunk*k + block;
+                        NodeID cur_nodes   = chunk_nodes[idx];
+                        EdgeID cur_edges   = chunk_edges[idx];
+                        chunk_nodes[idx]   = block_nodes[block];
+                        chunk_edges[idx]   = block_edges[block];
+                        block_nodes[block] += cur_nodes;
+                        block_edges[block] += cur_edges;
+                }
+        }
+
+        extracted_blocks.resize(k);
+        mappings.resize(k);
+        for( PartitionID block = 0; block < k; block++) {
+                extracted_blocks[block] = new graph_access();
+                extracted_blocks[block]->start_bulk_construction(block_nodes[block], block_edges[block]);
+                mappings[block].resize(block_nodes[block]);
+        }
+
+        // second pass: every chunk writes its nodes and edges to the positions computed above
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+        for( NodeID chunk = 0; chunk < chunks; chunk++) {
+                NodeID begin = chunk*chunk_size;
+                NodeID last  = std::min(n, begin + chunk_size);
+                std::vector<EdgeID> next_edge(chunk_edges.begin() + (size_t)chunk*k, chunk_edges.begin() + (size_t)(chunk+1)*k);
+                for( NodeID node = begin; node < last; node++) {
+                        PartitionID block  = G.getPartitionIndex(node);
+                        graph_access & Q   = *extracted_blocks[block];
+                        NodeID new_node    = chunk_nodes[(size_t)chunk*k + block] + new_id[node];
+
+                        mappings[block][new_node] = node;
+                        Q.setNodeWeight(new_node, G.getNodeWeight(node));
+                        Q.setFirstEdge(new_node, next_edge[block]);
+
+                        forall_out_edges(G, e, node) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if( G.getPartitionIndex( target ) == block ) {
+                                        NodeID target_chunk = target / chunk_size;
+                                        EdgeID new_edge     = next_edge[block]++;
+                                        Q.setEdgeTarget(new_edge, chunk_nodes[(size_t)target_chunk*k + block] + new_id[target]);
+                                        Q.setEdgeWeight(new_edge, G.getEdgeWeight(e));
+                                }
+                        } endfor
+                }
+        }
+
+        for( PartitionID block = 0; block < k; block++) {
+                extracted_blocks[block]->finish_construction();
+        }
+}
+
 
 void graph_extractor::extract_two_blocks(graph_access & G, 
                                          graph_access & extracted_block_lhs, 
@@ -72,24 +173,34 @@ void graph_extractor::extract_two_blocks(graph_access & G,
         std::vector<NodeID> reverse_mapping_rhs;
         NodeID nodes_lhs     = 0;
         NodeID nodes_rhs     = 0;
+        EdgeID edges_lhs     = 0;
+        EdgeID edges_rhs     = 0;
         partition_weight_lhs = 0;
         partition_weight_rhs = 0;
         NodeID dummy_node    = G.number_of_nodes() + 1;
 
+        reverse_mapping_lhs.resize(G.number_of_nodes());
+        reverse_mapping_rhs.resize(G.number_of_nodes());
         forall_nodes(G, node) {
                 if(G.getPartitionIndex(node) == lhs) {
-                        reverse_mapping_lhs.push_back(nodes_lhs++);
-                        reverse_mapping_rhs.push_back(dummy_node);
+                        reverse_mapping_lhs[node] = nodes_lhs++;
+                        reverse_mapping_rhs[node] = dummy_node;
                         partition_weight_lhs += G.getNodeWeight(node);
+                        forall_out_edges(G, e, node) {
+                                if( G.getPartitionIndex( G.getEdgeTarget(e) ) == lhs) edges_lhs++;
+                        } endfor
                 } else {
-                        reverse_mapping_rhs.push_back(nodes_rhs++);
-                        reverse_mapping_lhs.push_back(dummy_node);
+                        reverse_mapping_rhs[node] = nodes_rhs++;
+                        reverse_mapping_lhs[node] = dummy_node;
                         partition_weight_rhs += G.getNodeWeight(node);
+                        forall_out_edges(G, e, node) {
+                                if( G.getPartitionIndex( G.getEdgeTarget(e) ) == rhs) edges_rhs++;
+                        } endfor
                 }
         } endfor
 
-        extracted_block_lhs.start_construction(nodes_lhs, G.number_of_edges());
-        extracted_block_rhs.start_construction(nodes_rhs, G.number_of_edges());
+        extracted_block_lhs.start_construction(nodes_lhs, edges_lhs);
+        extracted_block_rhs.start_construction(nodes_rhs, edges_rhs);
 
         forall_nodes(G, node) {
                 if(G.getPartitionIndex(node) == lhs) {
@@ -8,6 +8,8 @@
 #ifndef GRAPH_EXTRACTOR_PDUTVIEF
 #define GRAPH_EXTRACTOR_PDUTVIEF
 
+#include <vector>
+
 #include "data_structure/graph_access.h"
 #include "definitions.h"
 
@@ -21,6 +23,14 @@ class graph_extractor {
                                    PartitionID block, 
                                    std::vector<NodeID> & mapping);
 
+                // extracts the subgraphs of all blocks of G in one sweep with num_threads threads, the graphs 
+                // are the same as the ones of extract_block. extracted_blocks[block] is allocated here and has to 
+                // be deleted by the caller, mappings[block] maps its nodes to the nodes of G
+                void extract_all_blocks(graph_access & G, 
+                                        std::vector<graph_access*> & extracted_blocks, 
+                                        std::vector< std::vector<NodeID> > & mappings,
+                                        int num_threads);
+
                 void extract_two_blocks(graph_access & G, 
                                         graph_access & extracted_block_lhs, 
                                         graph_access & extracted_block_rhs, 
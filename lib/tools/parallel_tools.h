@@ -0,0 +1,90 @@
+/******************************************************************************
+ * parallel_tools.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PARALLEL_TOOLS_R7WX2KQD
+#define PARALLEL_TOOLS_R7WX2KQD
+
+#include <algorithm>
+#include <cstddef>
+#include <omp.h>
+#include <vector>
+
+// OpenMP building blocks of the parallel graph constructions, the work is split
+// into omp_get_max_threads() blocks.
+namespace parallel_tools {
+
+// number of threads of the parallel parts of the partitioner, they run sequentially
+// unless enable_omp is set
+inline int max_threads(bool enable_omp) {
+        return enable_omp ? omp_get_max_threads() : 1;
+}
+
+// turns values[i] into the sum of values[0..i-1], computed blockwise in parallel
+template< typename T >
+void prefix_sum(std::vector< T > & values) {
+        const std::size_t size       = values.size();
+        const std::size_t blocks     = std::max(1, omp_get_max_threads());
+        const std::size_t block_size = (size + blocks - 1) / blocks;
+        std::vector< T > block_sum(blocks + 1, 0);
+
+        #pragma omp parallel for schedule(static, 1)
+        for( std::size_t b = 0; b < blocks; b++) {
+                T sum = 0;
+                for( std::size_t i = b * block_size; i < std::min(size, (b + 1) * block_size); i++) {
+                        sum += values[i];
+                }
+                block_sum[b + 1] = sum;
+        }
+
+        for( std::size_t b = 0; b < blocks; b++) {
+                block_sum[b + 1] += block_sum[b];
+        }
+
+        #pragma omp parallel for schedule(static, 1)
+        for( std::size_t b = 0; b < blocks; b++) {
+                T sum = block_sum[b];
+                for( std::size_t i = b * block_size; i < std::min(size, (b + 1) * block_size); i++) {
+                        T value   = values[i];
+                        values[i] = sum;
+                        sum      += value;
+                }
+        }
+}
+
+// sorts the blocks of values in parallel and merges them pairwise, the result
+// equals std::sort for types whose equal elements are indistinguishable
+template< typename T >
+void sort(std::vector< T > & values) {
+        const std::size_t size   = values.size();
+        const std::size_t blocks = std::max(1, omp_get_max_threads());
+        if( blocks == 1 || size < 4096 ) {
+                std::sort(values.begin(), values.end());
+                return;
+        }
+        const std::size_t block_size = (size + blocks - 1) / blocks;
+
+        #pragma omp parallel for schedule(static, 1)
+        for( std::size_t b = 0; b < blocks; b++) {
+                std::sort(values.begin() + std::min(size, b * block_size),
+                          values.begin() + std::min(size, (b + 1) * block_size));
+        }
+
+        for( std::size_t width = block_size; width < size; width *= 2) {
+                const std::size_t merges = (size + 2 * width - 1) / (2 * width);
+                #pragma omp parallel for schedule(static, 1)
+                for( std::size_t i = 0; i < merges; i++) {
+                        std::size_t lo = i * 2 * width;
+                        std::inplace_merge(values.begin() + lo,
+                                           values.begin() + std::min(size, lo + width),
+                                           values.begin() + std::min(size, lo + 2 * width));
+                }
+        }
+}
+
+}
+
+#endif /* end of include guard: PARALLEL_TOOLS_R7WX2KQD */
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <omp.h>
 
 #include "quality_metrics.h"
 #include "data_structure/union_find.h"
@@ -312,6 +313,71 @@ double quality_metrics::edge_balance(graph_access &G, const std::vector<Partitio
     return percentage;
 }
 
+partition_metrics quality_metrics::evaluate(graph_access & G) {
+        const NodeID n         = G.number_of_nodes();
+        const PartitionID k    = G.get_partition_count();
+        const int num_threads  = omp_get_max_threads();
+
+        // per thread: block weights, block degrees and block communication volumes
+        std::vector< std::vector<long> > thread_block_values(num_threads, std::vector<long>(3*k, 0));
+        long edge_cut         = 0;
+        NodeID boundary_nodes = 0;
+
+        #pragma omp parallel reduction(+:edge_cut, boundary_nodes)
+        {
+                std::vector<long> & block_values = thread_block_values[omp_get_thread_num()];
+
+                // blocks adjacent to the current node are marked with its id + 1
+                std::vector<NodeID> marked(k, 0);
+
+                #pragma omp for schedule(dynamic, 1024)
+                for( NodeID node = 0; node < n; node++) {
+                        PartitionID block = G.getPartitionIndex(node);
+                        marked[block]     = node + 1;
+                        long adjacent_blocks = 0;
+
+                        forall_out_edges(G, e, node) {
+                                PartitionID target_block = G.getPartitionIndex(G.getEdgeTarget(e));
+                                if( target_block != block ) {
+                                        edge_cut += G.getEdgeWeight(e);
+                                }
+                                if( marked[target_block] != node + 1 ) {
+                                        marked[target_block] = node + 1;
+                                        adjacent_blocks++;
+                                }
+                        } endfor
+
+                        if( adjacent_blocks > 0 ) boundary_nodes++;
+                        block_values[block]       += G.getNodeWeight(node);
+                        block_values[k + block]   += G.getNodeDegree(node);
+                        block_values[2*k + block] += adjacent_blocks;
+                }
+        }
+
+        std::vector<long> block_values(3*k, 0);
+        for( int t = 0; t < num_threads; t++) {
+                for( PartitionID i = 0; i < 3*k; i++) {
+                        block_values[i] += thread_block_values[t][i];
+                }
+        }
+
+        long total_weight = std::accumulate(block_values.begin(), block_values.begin() + k, 0L);
+        long total_degree = std::accumulate(block_values.begin() + k, block_values.begin() + 2*k, 0L);
+
+        partition_metrics metrics;
+        metrics.edge_cut                   = edge_cut / 2;
+        metrics.boundary_nodes             = boundary_nodes;
+        metrics.balance                    = *std::max_element(block_values.begin(), block_values.begin() + k)
+                                             / ceil(total_weight / (double)k);
+        metrics.balance_edges              = *std::max_element(block_values.begin() + k, block_values.begin() + 2*k)
+                                             / ceil(total_degree / (double)k);
+        metrics.max_communication_volume   = *std::max_element(block_values.begin() + 2*k, block_values.end());
+        metrics.min_communication_volume   = *std::min_element(block_values.begin() + 2*k, block_values.end());
+        metrics.total_communication_volume = std::accumulate(block_values.begin() + 2*k, block_values.end(), 0L);
+
+        return metrics;
+}
+
 double quality_metrics::balance_edges(graph_access& G) {
         std::vector<PartitionID> part_weights(G.get_partition_count(), 0);
 
@@ -13,6 +13,17 @@
 #include "data_structure/matrix/matrix.h"
 #include "partition_config.h"
 
+// all metrics reported by the evaluator, see quality_metrics::evaluate
+struct partition_metrics {
+        long edge_cut;
+        NodeID boundary_nodes;
+        double balance;
+        double balance_edges;
+        long max_communication_volume;
+        long min_communication_volume;
+        long total_communication_volume;
+};
+
 class quality_metrics {
 public:
         quality_metrics();
@@ -34,6 +45,9 @@ public:
         double balance_separator(graph_access & G);
         double edge_balance(graph_access &G, const std::vector<PartitionID> &edge_partition);
 
+        // computes the metrics above in a single parallel sweep over the graph
+        partition_metrics evaluate(graph_access & G);
+
         NodeWeight total_qap(graph_access & C, matrix & D, std::vector< NodeID > & rank_assign);
         NodeWeight total_qap(matrix & C, matrix & D, std::vector< NodeID > & rank_assign);
 };
@@ -162,12 +162,8 @@ class random_functions {
                 }
 
                 static double nextDouble(double lb, double rb) {
-                        double rnbr   = (double) rand() / (double) RAND_MAX; // rnd in 0,1
-                        double length = rb - lb;
-                        rnbr         *= length;
-                        rnbr         += lb;
-
-                        return rnbr; 
+                        std::uniform_real_distribution<double> A(lb,rb);
+                        return A(m_mt); 
                 }
 
                 static void setSeed(int seed) {
@@ -177,8 +173,10 @@ class random_functions {
                 }
 
         private:
-                static int m_seed;
-                static MersenneTwister m_mt;
+                // every thread has its own generator, threads other than the main thread
+                // have to be seeded before they draw numbers that should be reproducible
+                static thread_local int m_seed;
+                static thread_local MersenneTwister m_mt;
 };
 
 #endif /* end of include guard: RANDOM_FUNCTIONS_RMEPKWYT */
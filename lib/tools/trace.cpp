@@ -0,0 +1,102 @@
+/******************************************************************************
+ * trace.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <fstream>
+#include <iomanip>
+#include <omp.h>
+
+#include "trace.h"
+
+static const char * counter_names[TRACE_COUNTER_COUNT] = {
+        "nodes moved",
+        "fm rounds",
+        "queue operations",
+        "flow problems",
+        "flow problem nodes",
+        "flow problem edges"
+};
+
+std::atomic<bool> trace::m_enabled(false);
+int trace::m_process_id = 0;
+std::chrono::steady_clock::time_point trace::m_start;
+thread_local long trace::m_counters[TRACE_COUNTER_COUNT];
+std::mutex trace::m_mutex;
+std::vector<trace::event> trace::m_events;
+
+void trace::enable(int process_id) {
+        if(enabled()) return;
+
+        m_process_id = process_id;
+        m_start      = std::chrono::steady_clock::now();
+        m_enabled.store(true, std::memory_order_release);
+}
+
+double trace::now() {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+void trace::record(event & e) {
+        e.thread_id = omp_get_thread_num();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.push_back(std::move(e));
+}
+
+void trace::value(const char * name, long value) {
+        if(!enabled()) return;
+
+        event e;
+        e.name     = name;
+        e.phase    = 'C';
+        e.start    = now();
+        e.duration = 0;
+        e.args.push_back(std::make_pair("value", value));
+        record(e);
+}
+
+bool trace::write(const std::string & filename) {
+        std::ofstream f(filename.c_str());
+        if(!f) return false;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        f << std::fixed << std::setprecision(3);
+        f << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for( unsigned i = 0; i < m_events.size(); i++) {
+                const event & e = m_events[i];
+                f << "{\"name\":\"" << e.name << "\",\"ph\":\"" << e.phase << "\",\"ts\":" << e.start;
+                if(e.phase == 'X') f << ",\"dur\":" << e.duration;
+                f << ",\"pid\":" << m_process_id << ",\"tid\":" << e.thread_id << ",\"args\":{";
+                for( unsigned j = 0; j < e.args.size(); j++) {
+                        f << (j > 0 ? "," : "") << "\"" << e.args[j].first << "\":" << e.args[j].second;
+                }
+                f << "}}" << (i + 1 < m_events.size() ? ",\n" : "\n");
+        }
+        f << "]}\n";
+
+        return f.good();
+}
+
+void trace_scope::begin(const char * name) {
+        m_name  = name;
+        for( int c = 0; c < TRACE_COUNTER_COUNT; c++) {
+                m_counters_at_start[c] = trace::m_counters[c];
+        }
+        m_start = trace::now();
+}
+
+void trace_scope::end() {
+        trace::event e;
+        e.name     = m_name;
+        e.phase    = 'X';
+        e.start    = m_start;
+        e.duration = trace::now() - m_start;
+        e.args     = std::move(m_args);
+        for( int c = 0; c < TRACE_COUNTER_COUNT; c++) {
+                long delta = trace::m_counters[c] - m_counters_at_start[c];
+                if(delta != 0) e.args.push_back(std::make_pair(counter_names[c], delta));
+        }
+        trace::record(e);
+}
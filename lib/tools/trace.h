@@ -0,0 +1,104 @@
+/******************************************************************************
+ * trace.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef TRACE_7RQ2LXVB
+#define TRACE_7RQ2LXVB
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// counters that are attached to every scope during which they changed
+enum TraceCounter {
+        TRACE_NODES_MOVED,
+        TRACE_FM_ROUNDS,
+        TRACE_QUEUE_OPERATIONS,
+        TRACE_FLOW_PROBLEMS,
+        TRACE_FLOW_PROBLEM_NODES,
+        TRACE_FLOW_PROBLEM_EDGES,
+        TRACE_COUNTER_COUNT
+};
+
+// Records scoped timings, counters and values of a run and writes them in the
+// Chrome trace format (chrome://tracing, ui.perfetto.dev). Nothing is recorded
+// unless enable() was called, then every instrumented place costs one branch.
+// KaHIP and ParHIP share this class. Events of all threads are collected, the
+// counters are kept per thread, so a scope only sees the changes of its own
+// thread and concurrent partitioner calls do not mix their counts.
+class trace {
+        friend class trace_scope;
+        public:
+                // process_id distinguishes the processes of a distributed run
+                static void enable(int process_id = 0);
+
+                static inline bool enabled() {
+                        return m_enabled.load(std::memory_order_acquire);
+                }
+
+                static inline void count(TraceCounter counter, long delta) {
+                        if(enabled()) m_counters[counter] += delta;
+                }
+
+                // samples a quantity, e.g. the number of nodes of the current level
+                static void value(const char * name, long value);
+
+                static bool write(const std::string & filename);
+
+        private:
+                struct event {
+                        const char * name;
+                        char phase;
+                        int thread_id;
+                        double start;
+                        double duration;
+                        std::vector< std::pair<const char *, long> > args;
+                };
+
+                // microseconds since enable()
+                static double now();
+                static void record(event & e);
+
+                // m_process_id and m_start are set before m_enabled
+                static std::atomic<bool> m_enabled;
+                static int m_process_id;
+                static std::chrono::steady_clock::time_point m_start;
+                static thread_local long m_counters[TRACE_COUNTER_COUNT];
+                static std::mutex m_mutex;
+                static std::vector<event> m_events;
+};
+
+// Records the time between construction and destruction as one event.
+// Names and argument keys have to be string literals.
+class trace_scope {
+        public:
+                explicit trace_scope(const char * name) : m_active(trace::enabled()) {
+                        if(m_active) begin(name);
+                }
+
+                ~trace_scope() {
+                        if(m_active) end();
+                }
+
+                void arg(const char * key, long value) {
+                        if(m_active) m_args.push_back(std::make_pair(key, value));
+                }
+
+        private:
+                void begin(const char * name);
+                void end();
+
+                bool m_active;
+                const char * m_name;
+                double m_start;
+                long m_counters_at_start[TRACE_COUNTER_COUNT];
+                std::vector< std::pair<const char *, long> > m_args;
+};
+
+#endif /* end of include guard: TRACE_7RQ2LXVB */
@@ -1,6 +1,197 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
 #include "../../interface/kaHIP_interface.h"
+#include "../../interface/kaHIP_interface_64.h"
+
+namespace {
+
+// An int array handed to the interface. One dimensional contiguous buffers of 32 bit ints
+// (numpy arrays, array.array, memoryviews, ...) are used in place. Buffers of other integer
+// types are converted once, as are Python sequences. None gives a NULL array.
+class int_array {
+        public:
+                int_array(const pybind11::object & obj, const char * name) : m_data(NULL), m_size(0) {
+                        if( obj.is_none() ) return;
+
+                        if( !PyObject_CheckBuffer(obj.ptr()) ) {
+                                for (auto it : obj)
+                                        m_copy.push_back(pybind11::cast<int>(it));
+
+                                m_data = m_copy.data();
+                                m_size = m_copy.size();
+                                return;
+                        }
+
+                        m_buffer = pybind11::reinterpret_borrow<pybind11::buffer>(obj).request();
+                        if( m_buffer.ndim != 1 ) {
+                                throw pybind11::value_error(std::string(name) + " has to be one dimensional");
+                        }
+                        m_size = m_buffer.shape[0];
+
+                        std::string format = m_buffer.format;
+                        if( !format.empty() && std::string("@=<").find(format[0]) != std::string::npos ) {
+                                format = format.substr(1);
+                        }
+                        if( format.size() != 1 || std::string("bBhHiIlLqQnN").find(format[0]) == std::string::npos ) {
+                                throw pybind11::type_error(std::string(name) + " has to contain integers");
+                        }
+                        bool is_signed = islower(format[0]);
+
+                        if( is_signed && m_buffer.itemsize == sizeof(int) && (m_size <= 1 || m_buffer.strides[0] == sizeof(int)) ) {
+                                m_data = (int*) m_buffer.ptr;
+                                return;
+                        }
+
+                        m_copy.resize(m_size);
+                        const char * entry = (const char*) m_buffer.ptr;
+                        for( ssize_t i = 0; i < m_size; i++, entry += m_buffer.strides[0]) {
+                                long long value = read_integer(entry, m_buffer.itemsize, is_signed);
+                                if( value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max() ) {
+                                        throw pybind11::value_error(std::string(name) + " contains values that do not fit into 32 bit ints");
+                                }
+                                m_copy[i] = (int) value;
+                        }
+                        m_data = m_copy.data();
+                }
+
+                int* data() { return m_data; }
+                ssize_t size() const { return m_size; }
+                bool empty() const { return m_data == NULL; }
+
+        private:
+                static long long read_integer(const char * entry, ssize_t itemsize, bool is_signed) {
+                        switch( itemsize ) {
+                                case 1: return is_signed ? (long long) *(const signed char*) entry : (long long) *(const unsigned char*) entry;
+                                case 2: return is_signed ? (long long) *(const short*) entry       : (long long) *(const unsigned short*) entry;
+                                case 4: return is_signed ? (long long) *(const int*) entry         : (long long) *(const unsigned int*) entry;
+                                default: {
+                                        unsigned long long value = *(const unsigned long long*) entry;
+                                        if( !is_signed && value > (unsigned long long) std::numeric_limits<long long>::max() ) {
+                                                return std::numeric_limits<long long>::max();
+                                        }
+                                        return (long long) value;
+                                }
+                        }
+                }
+
+                int*                  m_data;
+                ssize_t               m_size;
+                pybind11::buffer_info m_buffer; // keeps the buffer alive while it is used in place
+                std::vector<int>      m_copy;
+};
+
+// the arrays of a graph in metis format, vwgt and adjcwgt are optional
+class graph_arrays {
+        public:
+                graph_arrays(const pybind11::object & vwgt_obj,
+                             const pybind11::object & xadj_obj,
+                             const pybind11::object & adjcwgt_obj,
+                             const pybind11::object & adjncy_obj) : vwgt(vwgt_obj, "vwgt"),
+                                                                    xadj(xadj_obj, "xadj"),
+                                                                    adjcwgt(adjcwgt_obj, "adjcwgt"),
+                                                                    adjncy(adjncy_obj, "adjncy") {
+                        if( xadj.size() < 1 ) {
+                                throw pybind11::value_error("xadj has to contain n+1 entries");
+                        }
+                        n = xadj.size() - 1;
+                        int m = xadj.data()[n];
+                        if( adjncy.size() < m ) {
+                                throw pybind11::value_error("adjncy has to contain xadj[n] entries");
+                        }
+                        if( !vwgt.empty() && vwgt.size() < n ) {
+                                throw pybind11::value_error("vwgt has to contain n entries");
+                        }
+                        if( !adjcwgt.empty() && adjcwgt.size() < m ) {
+                                throw pybind11::value_error("adjcwgt has to contain xadj[n] entries");
+                        }
+                }
+
+                int       n;
+                int_array vwgt;
+                int_array xadj;
+                int_array adjcwgt;
+                int_array adjncy;
+};
+
+// The arrays of a graph given as one dimensional contiguous 64 bit int buffers (numpy int64
+// arrays, ...). Such graphs are handed to the 64 bit interface in place, in_place() is false
+// if any of the arrays has another layout. vwgt and adjcwgt can be None.
+class graph_arrays_64 {
+        public:
+                graph_arrays_64(const pybind11::object & vwgt_obj,
+                                const pybind11::object & xadj_obj,
+                                const pybind11::object & adjcwgt_obj,
+                                const pybind11::object & adjncy_obj) : n(0), vwgt(NULL), xadj(NULL),
+                                                                       adjcwgt(NULL), adjncy(NULL),
+                                                                       m_in_place(false) {
+                        ssize_t xadj_size = 0, adjncy_size = 0, vwgt_size = 0, adjcwgt_size = 0;
+                        if( !use_in_place(xadj_obj, m_xadj, xadj, xadj_size) ) return;
+                        if( !use_in_place(adjncy_obj, m_adjncy, adjncy, adjncy_size) ) return;
+                        if( !vwgt_obj.is_none() && !use_in_place(vwgt_obj, m_vwgt, vwgt, vwgt_size) ) return;
+                        if( !adjcwgt_obj.is_none() && !use_in_place(adjcwgt_obj, m_adjcwgt, adjcwgt, adjcwgt_size) ) return;
+                        m_in_place = true;
+
+                        if( xadj_size < 1 ) {
+                                throw pybind11::value_error("xadj has to contain n+1 entries");
+                        }
+                        n = xadj_size - 1;
+                        int64_t m = xadj[n];
+                        if( adjncy_size < m ) {
+                                throw pybind11::value_error("adjncy has to contain xadj[n] entries");
+                        }
+                        if( vwgt != NULL && vwgt_size < n ) {
+                                throw pybind11::value_error("vwgt has to contain n entries");
+                        }
+                        if( adjcwgt != NULL && adjcwgt_size < m ) {
+                                throw pybind11::value_error("adjcwgt has to contain xadj[n] entries");
+                        }
+                }
+
+                bool in_place() const { return m_in_place; }
+
+                int64_t  n;
+                int64_t* vwgt;
+                int64_t* xadj;
+                int64_t* adjcwgt;
+                int64_t* adjncy;
+
+        private:
+                static bool use_in_place(const pybind11::object & obj, pybind11::buffer_info & buffer, int64_t* & data, ssize_t & size) {
+                        if( obj.is_none() || !PyObject_CheckBuffer(obj.ptr()) ) return false;
 
+                        buffer = pybind11::reinterpret_borrow<pybind11::buffer>(obj).request();
+                        std::string format = buffer.format;
+                        if( !format.empty() && std::string("@=<").find(format[0]) != std::string::npos ) {
+                                format = format.substr(1);
+                        }
+                        if( buffer.ndim != 1 || format.size() != 1 || std::string("lqn").find(format[0]) == std::string::npos
+                            || buffer.itemsize != sizeof(int64_t) || (buffer.shape[0] > 1 && buffer.strides[0] != sizeof(int64_t)) ) {
+                                return false;
+                        }
+
+                        data = (int64_t*) buffer.ptr;
+                        size = buffer.shape[0];
+                        return true;
+                }
+
+                pybind11::buffer_info m_vwgt; // keep the buffers alive while they are used in place
+                pybind11::buffer_info m_xadj;
+                pybind11::buffer_info m_adjcwgt;
+                pybind11::buffer_info m_adjncy;
+                bool                  m_in_place;
+};
+
+}
+
+// the interface calls run without the GIL, the arrays are only touched by KaHIP meanwhile
 pybind11::object wrap_kaffpa(
                 const pybind11::object &vwgt,
                 const pybind11::object &xadj,
@@ -11,38 +202,213 @@ pybind11::object wrap_kaffpa(
                 bool supress_output,
                 int seed,
                 int mode) {
-        int n = pybind11::len(xadj) - 1;
-        std::vector<int> xadjv, adjncyv, vwgtv, adjwgtv;
-        for (auto it : xadj) 
-                xadjv.push_back(pybind11::cast<int>(*it)); 
+        // int64 graphs go to the 64 bit interface without being copied
+        graph_arrays_64 graph64(vwgt, xadj, adjwgt, adjncy);
+        if( graph64.in_place() ) {
+                pybind11::array_t<int> part(graph64.n);
+                int* part_data   = part.mutable_data();
+                int64_t edge_cut = 0;
+
+                {
+                        pybind11::gil_scoped_release release;
+                        kaffpa_64(&graph64.n, graph64.vwgt, graph64.xadj,
+                                  graph64.adjcwgt, graph64.adjncy, &nparts,
+                                  &imbalance, supress_output,
+                                  seed, mode, & edge_cut, part_data);
+                }
+
+                return pybind11::make_tuple(edge_cut, part);
+        }
+
+        graph_arrays graph(vwgt, xadj, adjwgt, adjncy);
+        pybind11::array_t<int> part(graph.n);
+        int* part_data   = part.mutable_data();
+        int edge_cut     = 0;
+
+        {
+                pybind11::gil_scoped_release release;
+                kaffpa(&graph.n, graph.vwgt.data(), graph.xadj.data(),
+                       graph.adjcwgt.data(), graph.adjncy.data(), &nparts,
+                       &imbalance, supress_output,
+                       seed, mode, & edge_cut, part_data);
+        }
+
+        return pybind11::make_tuple(edge_cut, part);
+}
+
+pybind11::object wrap_kaffpa_balance_NE(
+                const pybind11::object &vwgt,
+                const pybind11::object &xadj,
+                const pybind11::object &adjwgt,
+                const pybind11::object &adjncy,
+                int nparts,
+                double imbalance,
+                bool supress_output,
+                int seed,
+                int mode) {
+        // int64 graphs go to the 64 bit interface without being copied
+        graph_arrays_64 graph64(vwgt, xadj, adjwgt, adjncy);
+        if( graph64.in_place() ) {
+                pybind11::array_t<int> part(graph64.n);
+                int* part_data   = part.mutable_data();
+                int64_t edge_cut = 0;
+
+                {
+                        pybind11::gil_scoped_release release;
+                        kaffpa_balance_NE_64(&graph64.n, graph64.vwgt, graph64.xadj,
+                                             graph64.adjcwgt, graph64.adjncy, &nparts,
+                                             &imbalance, supress_output,
+                                             seed, mode, & edge_cut, part_data);
+                }
+
+                return pybind11::make_tuple(edge_cut, part);
+        }
+
+        graph_arrays graph(vwgt, xadj, adjwgt, adjncy);
+        pybind11::array_t<int> part(graph.n);
+        int* part_data   = part.mutable_data();
+        int edge_cut     = 0;
 
-        for (auto it : adjncy) 
-                adjncyv.push_back(pybind11::cast<int>(*it)); 
+        {
+                pybind11::gil_scoped_release release;
+                kaffpa_balance_NE(&graph.n, graph.vwgt.data(), graph.xadj.data(),
+                                  graph.adjcwgt.data(), graph.adjncy.data(), &nparts,
+                                  &imbalance, supress_output,
+                                  seed, mode, & edge_cut, part_data);
+        }
 
-        for (auto it : vwgt) 
-                vwgtv.push_back(pybind11::cast<int>(*it)); 
+        return pybind11::make_tuple(edge_cut, part);
+}
 
-        for (auto it : adjwgt) 
-                adjwgtv.push_back(pybind11::cast<int>(*it)); 
+pybind11::object wrap_process_mapping(
+                const pybind11::object &vwgt,
+                const pybind11::object &xadj,
+                const pybind11::object &adjwgt,
+                const pybind11::object &adjncy,
+                const pybind11::object &hierarchy_parameter,
+                const pybind11::object &distance_parameter,
+                int mode_partitioning,
+                int mode_mapping,
+                double imbalance,
+                bool supress_output,
+                int seed) {
+        graph_arrays graph(vwgt, xadj, adjwgt, adjncy);
+        int_array hierarchy(hierarchy_parameter, "hierarchy_parameter");
+        int_array distance(distance_parameter, "distance_parameter");
+        if( hierarchy.size() != distance.size() || hierarchy.size() == 0 ) {
+                throw pybind11::value_error("hierarchy_parameter and distance_parameter have to be of the same nonzero length");
+        }
+        int hierarchy_depth = hierarchy.size();
 
-        int* part        = new int[n];
+        pybind11::array_t<int> part(graph.n);
+        int* part_data   = part.mutable_data();
         int edge_cut     = 0;
+        int qap          = 0;
+
+        {
+                pybind11::gil_scoped_release release;
+                process_mapping(&graph.n, graph.vwgt.data(), graph.xadj.data(),
+                                graph.adjcwgt.data(), graph.adjncy.data(),
+                                hierarchy.data(), distance.data(), hierarchy_depth,
+                                mode_partitioning, mode_mapping, &imbalance,
+                                supress_output, seed, &edge_cut, &qap, part_data);
+        }
+
+        return pybind11::make_tuple(edge_cut, qap, part);
+}
+
+pybind11::object wrap_node_separator(
+                const pybind11::object &vwgt,
+                const pybind11::object &xadj,
+                const pybind11::object &adjwgt,
+                const pybind11::object &adjncy,
+                int nparts,
+                double imbalance,
+                bool supress_output,
+                int seed,
+                int mode) {
+        graph_arrays graph(vwgt, xadj, adjwgt, adjncy);
+        int num_separator_vertices = 0;
+        int* separator             = NULL;
+
+        {
+                pybind11::gil_scoped_release release;
+                node_separator(&graph.n, graph.vwgt.data(), graph.xadj.data(),
+                               graph.adjcwgt.data(), graph.adjncy.data(), &nparts,
+                               &imbalance, supress_output, seed, mode,
+                               &num_separator_vertices, &separator);
+        }
 
-        kaffpa(&n, &vwgtv[0], &xadjv[0], 
-               &adjwgtv[0], &adjncyv[0], &nparts, 
-               &imbalance, supress_output, 
-               seed, mode, & edge_cut, part);
+        // the separator is allocated by the interface
+        pybind11::array_t<int> separator_array(num_separator_vertices);
+        std::copy(separator, separator + num_separator_vertices, separator_array.mutable_data());
+        delete[] separator;
 
-        pybind11::list returnblocksArray; 
-        for (int i = 0; i<n; ++i) 
-                returnblocksArray.append(part[i]); 
+        return pybind11::make_tuple(num_separator_vertices, separator_array);
+}
+
+pybind11::object wrap_reduced_nd(
+                const pybind11::object &xadj,
+                const pybind11::object &adjncy,
+                bool supress_output,
+                int seed,
+                int mode) {
+        graph_arrays graph(pybind11::none(), xadj, pybind11::none(), adjncy);
+        pybind11::array_t<int> ordering(graph.n);
+        int* ordering_data = ordering.mutable_data();
 
-        delete[] part;
+        {
+                pybind11::gil_scoped_release release;
+                reduced_nd(&graph.n, graph.xadj.data(), graph.adjncy.data(),
+                           supress_output, seed, mode, ordering_data);
+        }
 
-        return pybind11::make_tuple(edge_cut, returnblocksArray);
+        return ordering;
 }
 
 PYBIND11_MODULE(kahip, m) {
-        m.doc() = "pybind11 example plugin"; // optional module docstring
-        m.def("kaffpa", &wrap_kaffpa, "A function that partitions a graph.");
+        m.doc() = "Python bindings of KaHIP -- Karlsruhe High Quality Partitioning. "
+                  "Graphs are given in metis format, the arrays can be numpy arrays or other buffers "
+                  "or lists. vwgt and adjcwgt can be None. 32 bit int arrays are used without copying. "
+                  "kaffpa and kaffpa_balance_NE hand graphs whose arrays are all contiguous int64 arrays "
+                  "to the 64 bit interface without copying, all other arrays are copied into 32 bit ints.";
+
+        m.attr("FAST")                 = FAST;
+        m.attr("ECO")                  = ECO;
+        m.attr("STRONG")               = STRONG;
+        m.attr("FASTSOCIAL")           = FASTSOCIAL;
+        m.attr("ECOSOCIAL")            = ECOSOCIAL;
+        m.attr("STRONGSOCIAL")         = STRONGSOCIAL;
+        m.attr("MAPMODE_MULTISECTION") = MAPMODE_MULTISECTION;
+        m.attr("MAPMODE_BISECTION")    = MAPMODE_BISECTION;
+
+        m.def("kaffpa", &wrap_kaffpa,
+              "Partitions a graph, returns the edge cut and the blocks of the nodes.",
+              pybind11::arg("vwgt"), pybind11::arg("xadj"), pybind11::arg("adjcwgt"), pybind11::arg("adjncy"),
+              pybind11::arg("nblocks"), pybind11::arg("imbalance"), pybind11::arg("suppress_output"),
+              pybind11::arg("seed"), pybind11::arg("mode"));
+
+        m.def("kaffpa_balance_NE", &wrap_kaffpa_balance_NE,
+              "Partitions a graph with a balance constraint on nodes and edges, returns the edge cut and the blocks of the nodes.",
+              pybind11::arg("vwgt"), pybind11::arg("xadj"), pybind11::arg("adjcwgt"), pybind11::arg("adjncy"),
+              pybind11::arg("nblocks"), pybind11::arg("imbalance"), pybind11::arg("suppress_output"),
+              pybind11::arg("seed"), pybind11::arg("mode"));
+
+        m.def("process_mapping", &wrap_process_mapping,
+              "Maps a graph onto a hierarchy of processors, returns the edge cut, the qap objective and the blocks of the nodes.",
+              pybind11::arg("vwgt"), pybind11::arg("xadj"), pybind11::arg("adjcwgt"), pybind11::arg("adjncy"),
+              pybind11::arg("hierarchy_parameter"), pybind11::arg("distance_parameter"),
+              pybind11::arg("mode_partitioning"), pybind11::arg("mode_mapping"), pybind11::arg("imbalance"),
+              pybind11::arg("suppress_output"), pybind11::arg("seed"));
+
+        m.def("node_separator", &wrap_node_separator,
+              "Computes a node separator, returns its size and its nodes.",
+              pybind11::arg("vwgt"), pybind11::arg("xadj"), pybind11::arg("adjcwgt"), pybind11::arg("adjncy"),
+              pybind11::arg("nblocks"), pybind11::arg("imbalance"), pybind11::arg("suppress_output"),
+              pybind11::arg("seed"), pybind11::arg("mode"));
+
+        m.def("reduced_nd", &wrap_reduced_nd,
+              "Computes a nested dissection ordering of an unweighted graph, returns the ordering.",
+              pybind11::arg("xadj"), pybind11::arg("adjncy"), pybind11::arg("suppress_output"),
+              pybind11::arg("seed"), pybind11::arg("mode"));
 }
@@ -60,14 +60,14 @@ inline void configuration::standard( PPartitionConfig & partition_config ) {
         partition_config.evolutionary_time_limit 	        = 0; 
         partition_config.log_num_verts                          = 16;
         partition_config.edge_factor                            = 16;
-        partition_config.generate_rgg                           = false; 
-        partition_config.generate_ba                            = false; 
+        partition_config.generator                              = "";
         partition_config.comm_rounds                            = 128; 
         partition_config.label_iterations                       = 4;
         partition_config.label_iterations_coarsening            = 3;
         partition_config.label_iterations_refinement            = 6;
         partition_config.cluster_coarsening_factor              = 14;
         partition_config.initial_partitioning_algorithm         = KAFFPAEFASTSNW;
+        partition_config.initial_partitioning_pes               = 0;
         partition_config.stop_factor                            = 14000;
         partition_config.vcycle                                 = false;
         partition_config.num_vcycles                            = 2;
@@ -87,7 +87,9 @@ inline void configuration::standard( PPartitionConfig & partition_config ) {
 	partition_config.save_partition 			= false;
 	partition_config.save_partition_binary 			= false;
         partition_config.vertex_degree_weights                  = false;
+        partition_config.compact_input_graph                    = false;
         partition_config.converter_evaluate                     = false;
+        partition_config.trace_filename                         = "";
 }
 
 #endif /* end of include guard: CONFIGURATION_3APG5V7Z */
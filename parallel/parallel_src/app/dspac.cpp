@@ -115,13 +115,13 @@ int main(int argn, char **argv) {
     if( partition_config.save_partition ) {
             parallel_vector_io pvio;
             std::string filename("tmpedgepartition.txtp");
-            pvio.writePartitionSimpleParallel(split_graph, filename);
+            pvio.writePartitionSimpleParallelMPIIO(split_graph, filename);
     }
 
     if( partition_config.save_partition_binary ) {
             parallel_vector_io pvio;
             std::string filename("tmpedgepartition.binp");
-            pvio.writePartitionBinaryParallelPosix(partition_config, split_graph, filename);
+            pvio.writePartitionBinaryParallelMPIIO(split_graph, filename);
     }
 
     MPI_Barrier(MPI_COMM_WORLD);
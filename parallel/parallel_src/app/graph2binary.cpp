@@ -25,10 +25,11 @@ int main(int argn, char **argv)
         MPI_Comm_rank( MPI_COMM_WORLD, &rank);
         MPI_Comm_size( MPI_COMM_WORLD, &size);
 
-        if(argn != 3) {
+        bool compressed = argn == 4 && string(argv[3]) == "--compressed";
+        if(argn != 3 && !compressed) {
                 if( rank == ROOT ) {
                         std::cout <<  "usage: " ;
-                        std::cout <<  "graph2binary metisfile outputfilename"  << std::endl;
+                        std::cout <<  "graph2binary metisfile outputfilename [--compressed]"  << std::endl;
                 }
                 MPI_Finalize();
                 return 0;
@@ -48,7 +49,11 @@ int main(int argn, char **argv)
         parallel_graph_access G;
         PPartitionConfig config;
         parallel_graph_io::readGraphWeighted(config, G, graph_filename, rank, size, MPI_COMM_WORLD);
-        parallel_graph_io::writeGraphSequentiallyBinary(G, filename);
+        if( compressed ) {
+                parallel_graph_io::writeGraphSequentiallyBinaryCompressed(G, filename);
+        } else {
+                parallel_graph_io::writeGraphSequentiallyBinary(G, filename);
+        }
 
         MPI_Finalize();
         return 0;
@@ -24,10 +24,11 @@ int main(int argn, char **argv)
         MPI_Comm_rank( MPI_COMM_WORLD, &rank);
         MPI_Comm_size( MPI_COMM_WORLD, &size);
 
-        if(argn != 3) {
+        bool compressed = argn == 4 && string(argv[3]) == "--compressed";
+        if(argn != 3 && !compressed) {
                 if( rank == ROOT ) {
                         std::cout <<  "usage: " ;
-                        std::cout <<  "graph2binary_external metisfile outputfilename"  << std::endl;
+                        std::cout <<  "graph2binary_external metisfile outputfilename [--compressed]"  << std::endl;
                 }
                 MPI_Finalize();
                 return 0;
@@ -43,7 +44,11 @@ int main(int argn, char **argv)
         string filename(argv[2]);
 
         std::cout <<  "Reading and writing graph " << graph_filename  << std::endl;
-        parallel_graph_io::writeGraphExternallyBinary(graph_filename, filename);
+        if( compressed ) {
+                parallel_graph_io::writeGraphExternallyBinaryCompressed(graph_filename, filename);
+        } else {
+                parallel_graph_io::writeGraphExternallyBinary(graph_filename, filename);
+        }
         
         MPI_Finalize();
         return 0;
@@ -19,6 +19,7 @@
 #include "communication/dummy_operations.h"
 #include "data_structure/parallel_graph_access.h"
 #include "distributed_partitioning/distributed_partitioner.h"
+#include "io/parallel_graph_generator.h"
 #include "io/parallel_graph_io.h"
 #include "io/parallel_vector_io.h"
 #include "macros_assertions.h"
@@ -26,6 +27,7 @@
 #include "partition_config.h"
 #include "random_functions.h"
 #include "timer.h"
+#include "trace.h"
 #include "tools/distributed_quality_metrics.h"
 
 int main(int argn, char **argv) {
@@ -72,12 +74,20 @@ int main(int argn, char **argv) {
                 }
 
                 partition_config.stop_factor /= partition_config.k;
+                int generator_seed = partition_config.seed;
                 if(rank != 0) partition_config.seed = partition_config.seed*size+rank; 
 
                 srand(partition_config.seed);
 
                 parallel_graph_access G(communicator);
-                parallel_graph_io::readGraphWeighted(partition_config, G, graph_filename, rank, size, communicator);
+                if( partition_config.compact_input_graph ) G.enable_compact_edges();
+                if( !partition_config.generator.empty() ) {
+                        NodeID n = (NodeID)1 << partition_config.log_num_verts;
+                        parallel_graph_generator::generate(G, partition_config.generator, n, 2.0*partition_config.edge_factor, 
+                                                           generator_seed, communicator);
+                } else {
+                        parallel_graph_io::readGraphWeighted(partition_config, G, graph_filename, rank, size, communicator);
+                }
                 //parallel_graph_io::readGraphWeightedFlexible(G, graph_filename, rank, size, communicator);
                 if( rank == ROOT ) std::cout <<  "took " <<  t.elapsed()  << std::endl;
                 if( rank == ROOT ) std::cout <<  "n:" <<  G.number_of_global_nodes() << " m: " <<  G.number_of_global_edges()  << std::endl;
@@ -137,12 +147,23 @@ int main(int argn, char **argv) {
                 }
 
 
+                if( partition_config.trace_filename != "" ) {
+                        trace::enable(rank);
+                }
+
                 distributed_partitioner dpart;
                 dpart.perform_partitioning( communicator, partition_config, G);
 
                 MPI_Barrier(communicator);
 
                 double running_time = t.elapsed();
+                if( trace::enabled() ) {
+                        std::stringstream trace_filename;
+                        trace_filename << partition_config.trace_filename << "." << rank;
+                        if(!trace::write(trace_filename.str())) {
+                                std::cerr <<  "could not write trace to " << trace_filename.str()  << std::endl;
+                        }
+                }
                 distributed_quality_metrics qm;
                 EdgeWeight edge_cut = qm.edge_cut( G, communicator );
                 double balance  = qm.balance( partition_config, G, communicator );
@@ -180,13 +201,13 @@ int main(int argn, char **argv) {
                 if( partition_config.save_partition ) {
                         parallel_vector_io pvio;
                         std::string filename("tmppartition.txtp");
-                        pvio.writePartitionSimpleParallel(G, filename);
+                        pvio.writePartitionSimpleParallelMPIIO(G, filename);
                 }
 
                 if( partition_config.save_partition_binary ) {
                         parallel_vector_io pvio;
                         std::string filename("tmppartition.binp");
-                        pvio.writePartitionBinaryParallelPosix(partition_config, G, filename);
+                        pvio.writePartitionBinaryParallelMPIIO(G, filename);
                 }
         }
 
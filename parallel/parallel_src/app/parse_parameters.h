@@ -21,7 +21,12 @@ int parse_parameters(int argn, char **argv,
 
         // Setup argtable parameters.
         struct arg_lit *help                           = arg_lit0(NULL, "help","Print help.");
+#ifdef PARALLEL_LABEL_COMPRESSION
+        // parhip can generate the graph instead (see --generator)
+        struct arg_str *filename                       = arg_str0(NULL, NULL, "FILE", "Path to graph file to partition.");
+#else
         struct arg_str *filename                       = arg_str1(NULL, NULL, "FILE", "Path to graph file to partition.");
+#endif
         struct arg_str *input_partition_filename       = arg_str1(NULL, "input_partition", "FILE", "Path to partition file to convert.");
         struct arg_int *user_seed                      = arg_int0(NULL, "seed", NULL, "Seed to use for the PRNG.");
         struct arg_int *k                              = arg_int1(NULL, "k", NULL, "Number of blocks to partition the graph.");
@@ -38,12 +43,18 @@ int parse_parameters(int argn, char **argv,
         struct arg_int *num_tries                      = arg_int0(NULL, "num_tries", NULL, "Number of repetitions to perform.");
         struct arg_int *binary_io_window_size 	       = arg_int0(NULL, "binary_io_window_size", NULL, "Binary IO window size.");
         struct arg_rex *initial_partitioning_algorithm = arg_rex0(NULL, "initial_partitioning_algorithm", "^(kaffpaEstrong|kaffpaEeco|kaffpaEfast|fastsocial|ecosocial|strongsocial|random)$", "PARTITIONER", REG_EXTENDED, "Initial partitioning algorithm to use. One of {kaffpaEstrong, kaffpaEeco, kaffpaEfast, fastsocial, ecosocial, strongsocial, random)." );
+        struct arg_int *initial_partitioning_pes       = arg_int0(NULL, "initial_partitioning_pes", NULL, "Number of PEs that gather the coarsest graph and run the initial partitioner. Default: 0 (all PEs).");
         struct arg_int *num_vcycles                    = arg_int0(NULL, "num_vcycles", NULL, "Number of vcycles to perform.");
         struct arg_lit *no_refinement_in_last_iteration= arg_lit0(NULL, "no_refinement_in_last_iteration","No local search during last v-cycle.");
         struct arg_lit *converter_evaluate             = arg_lit0(NULL, "evaluate","Enable this tag the partition to be evaluated.");
         struct arg_lit *save_partition		       = arg_lit0(NULL, "save_partition","Enable this tag if you want to store the partition to disk.");
         struct arg_lit *save_partition_binary	       = arg_lit0(NULL, "save_partition_binary","Enable this tag if you want to store the partition to disk in a binary format.");
         struct arg_lit *vertex_degree_weights          = arg_lit0(NULL, "vertex_degree_weights","Use 1+deg(v) as vertex weights.");
+        struct arg_lit *compact_input_graph            = arg_lit0(NULL, "compact_input_graph","Store the input graph with 32 bit edge targets and implicit unit edge weights to reduce memory.");
+        struct arg_str *trace_filename                 = arg_str0(NULL, "trace_file", NULL, "Write a trace of the multilevel phases (Chrome trace JSON) to this file, one file per PE with the rank appended.");
+        struct arg_rex *generator                      = arg_rex0(NULL, "generator", "^(grid2d|grid3d|rgg2d|rgg3d|rmat|ba|rhg)$", "TYPE", REG_EXTENDED, "Generate the graph instead of reading FILE. One of {grid2d, grid3d, rgg2d, rgg3d, rmat, ba, rhg}.");
+        struct arg_int *log_num_verts                  = arg_int0(NULL, "log_num_verts", NULL, "The generated graph has about 2^log_num_verts nodes. Default: 16.");
+        struct arg_int *edge_factor                    = arg_int0(NULL, "edge_factor", NULL, "The generated graph has about edge_factor * 2^log_num_verts edges. Default: 16.");
         struct arg_rex *node_ordering                  = arg_rex0(NULL, "node_ordering", "^(random|degree|leastghostnodesfirst_degree|degree_leastghostnodesfirst)$", "VARIANT", REG_EXTENDED, "Type of node ordering to use for the clustering algorithm. (Default: degree) [random|degree|leastghostnodesfirst_degree|degree_leastghostnodesfirst]." );
         struct arg_rex *preconfiguration               = arg_rex1(NULL, "preconfiguration", "^(ecosocial|fastsocial|ultrafastsocial|ecomesh|fastmesh|ultrafastmesh)$", "VARIANT", REG_EXTENDED, "Use a preconfiguration. (Default: fast) [ecosocial|fastsocial|ultrafastsocial|ecomesh|fastmesh|ultrafastmesh]." );
         struct arg_dbl *ht_fill_factor                 = arg_dbl0(NULL, "ht_fill_factor", NULL, "");
@@ -54,7 +65,8 @@ int parse_parameters(int argn, char **argv,
         void* argtable[] = {
 #ifdef PARALLEL_LABEL_COMPRESSION
                 help, filename, user_seed, k, inbalance, preconfiguration, vertex_degree_weights,
-		save_partition, save_partition_binary,
+		save_partition, save_partition_binary, initial_partitioning_pes, compact_input_graph,
+                trace_filename, generator, log_num_verts, edge_factor,
 #elif defined TOOLBOX 
                 help, filename, k_opt, input_partition_filename, save_partition, save_partition_binary, converter_evaluate,
 #endif 
@@ -107,7 +119,7 @@ int parse_parameters(int argn, char **argv,
         if(filename->count > 0) {
                 graph_filename = filename->sval[0];
         } else {
-                if(partition_config.generate_rgg == false && partition_config.generate_ba == false) {
+                if(generator->count == 0) {
                         printf("You must specify a filename or enable the graph generator tag.\n");
                         return 1;
                 }
@@ -148,6 +160,26 @@ int parse_parameters(int argn, char **argv,
                 partition_config.vertex_degree_weights = true;
         }
 
+        if(compact_input_graph->count > 0) {
+                partition_config.compact_input_graph = true;
+        }
+
+        if(trace_filename->count > 0) {
+                partition_config.trace_filename = trace_filename->sval[0];
+        }
+
+        if(generator->count > 0) {
+                partition_config.generator = generator->sval[0];
+        }
+
+        if(log_num_verts->count > 0) {
+                partition_config.log_num_verts = log_num_verts->ival[0];
+        }
+
+        if(edge_factor->count > 0) {
+                partition_config.edge_factor = edge_factor->ival[0];
+        }
+
 	if(converter_evaluate->count > 0) {
 		partition_config.converter_evaluate = true;
 	}
@@ -180,6 +212,10 @@ int parse_parameters(int argn, char **argv,
                 partition_config.binary_io_window_size = binary_io_window_size->ival[0];
         }
 
+        if (initial_partitioning_pes->count > 0) {
+                partition_config.initial_partitioning_pes = initial_partitioning_pes->ival[0];
+        }
+
         if (num_vcycles->count > 0) {
                 partition_config.num_vcycles = num_vcycles->ival[0];
         }
@@ -89,14 +89,14 @@ int main(int argn, char **argv) {
                 if(rank == ROOT) std::cout <<  "saving text partition"  << std::endl;
                 parallel_vector_io pvio;
                 std::string filename("tmppartition.txtp");
-                pvio.writePartitionSimpleParallel(G, filename);
+                pvio.writePartitionSimpleParallelMPIIO(G, filename);
         }
 
         if( partition_config.save_partition_binary ) {
                 if(rank == ROOT) std::cout <<  "saving binary partition"  << std::endl;
                 parallel_vector_io pvio;
                 std::string filename("tmppartition.binp");
-                pvio.writePartitionBinaryParallelPosix(partition_config, G, filename);
+                pvio.writePartitionBinaryParallelMPIIO(G, filename);
         }
 
         MPI_Barrier(MPI_COMM_WORLD);
@@ -217,44 +217,37 @@ void mpi_tools::distribute_local_graph( MPI_Comm communicator, PPartitionConfig
         delete[] adjwgt;
 }
 
-void mpi_tools::alltoallv( void * sendbuf, 
-                ULONG sendcounts[], ULONG displs[], 
-                const MPI_Datatype & sendtype, void * recvbuf,
-                ULONG recvcounts[], ULONG rdispls[],
-                const MPI_Datatype & recvtype, MPI_Comm communicator ) {
-
+void mpi_tools::scatter_local_graph_labels( MPI_Comm communicator, complete_graph_access & Q, 
+                                            parallel_graph_access & G) {
         int rank, size;
         MPI_Comm_rank( communicator, &rank);
         MPI_Comm_size( communicator, &size);
-        
-        bool no_special_case = true;
-        for( int i = 0; i < size && no_special_case; i++) {
-                if( sendcounts[i] > std::numeric_limits< int >::max()) no_special_case = false;
-                if( recvcounts[i] > std::numeric_limits< int >::max()) no_special_case = false;
-        }
-        if( displs[size]  > std::numeric_limits< int >::max()) no_special_case = false;
-        if( rdispls[size] > std::numeric_limits< int >::max()) no_special_case = false;
-
-        if( no_special_case ) {
-                int sbktsize[size];
-                int rbktsize[size];
-                int sdispl[size+1];
-                int rdispl[size+1];
-
-                for( int i = 0; i < size; i++) {
-                        sbktsize[i] = sendcounts[i];
-                        rbktsize[i] = recvcounts[i];
-                }
 
-                for( int i = 0; i <= size; i++) {
-                        sdispl[i] = displs[i];
-                        rdispl[i] = rdispls[i];
+        // the nodes of Q are ordered by global id, i.e. PE i owns a consecutive range of them
+        int local_n = G.number_of_local_nodes();
+        std::vector< int > counts(size, 0);
+        std::vector< int > displs(size, 0);
+        MPI_Gather(&local_n, 1, MPI_INT, &counts[0], 1, MPI_INT, ROOT, communicator);
+
+        std::vector< NodeID > labels;
+        if( rank == ROOT ) {
+                for( int i = 1; i < size; i++) {
+                        displs[i] = displs[i-1] + counts[i-1];
                 }
 
-                MPI_Alltoallv(sendbuf, sbktsize, sdispl, MPI_UNSIGNED_LONG_LONG, 
-                              recvbuf, rbktsize, rdispl, MPI_UNSIGNED_LONG_LONG, communicator);
-        } else {
-                if( rank == ROOT ) { std::cout <<  "special case all to all with counts > sizeof(int)! not tested yet!"  << std::endl; exit(0);}
+                labels.resize(Q.number_of_local_nodes());
+                forall_local_nodes(Q, node) {
+                        labels[node] = Q.getNodeLabel(node);
+                } endfor
         }
-}
 
+        std::vector< NodeID > local_labels(std::max(local_n, 1));
+        MPI_Scatterv( rank == ROOT ? &labels[0] : NULL, &counts[0], &displs[0], MPI_UNSIGNED_LONG_LONG, 
+                      &local_labels[0], local_n, MPI_UNSIGNED_LONG_LONG, ROOT, communicator);
+
+        forall_local_nodes(G, node) {
+                G.setNodeLabel(node, local_labels[node]);
+        } endfor
+
+        G.update_ghost_node_data_global(); // exchange the labels of ghost nodes
+}
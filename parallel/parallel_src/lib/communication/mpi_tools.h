@@ -10,6 +10,11 @@
 #ifndef MPI_TOOLS_HMESDXF2
 #define MPI_TOOLS_HMESDXF2
 
+#include <algorithm>
+#include <limits>
+#include <mpi.h>
+#include <vector>
+
 #include "data_structure/parallel_graph_access.h"
 #include "partition_config.h"
 
@@ -30,8 +35,13 @@ public:
         // G is output (on every other PE)
         void distribute_local_graph( MPI_Comm communicator, PPartitionConfig & config, complete_graph_access & G);
 
+        // Q is input (only on ROOT, as collected by collect_parallel_graph_to_local_graph)
+        // every PE receives the labels of its local nodes in G, ghost node labels are updated afterwards
+        void scatter_local_graph_labels( MPI_Comm communicator, complete_graph_access & Q, parallel_graph_access & G);
+
         // alltoallv that can send more than int-count elements
-        void alltoallv( void * sendbuf, 
+        // the displacement arrays have size+1 entries, the last one is the total number of elements
+        static void alltoallv( void * sendbuf, 
                         ULONG sendcounts[], ULONG displs[], 
                         const MPI_Datatype & sendtype, void * recvbuf,
                         ULONG recvcounts[], ULONG rdispls[],
@@ -39,7 +49,7 @@ public:
                 alltoallv( sendbuf, sendcounts, displs, sendtype, recvbuf, recvcounts, rdispls, recvtype, MPI_COMM_WORLD);
         };
 
-        void alltoallv( void * sendbuf, 
+        static void alltoallv( void * sendbuf, 
                        ULONG sendcounts[], ULONG displs[], 
                        const MPI_Datatype & sendtype, void * recvbuf,
                        ULONG recvcounts[], ULONG rdispls[],
@@ -48,5 +58,73 @@ public:
 
 };
 
+inline
+void mpi_tools::alltoallv( void * sendbuf, 
+                ULONG sendcounts[], ULONG displs[], 
+                const MPI_Datatype & sendtype, void * recvbuf,
+                ULONG recvcounts[], ULONG rdispls[],
+                const MPI_Datatype & recvtype, MPI_Comm communicator ) {
+
+        int size;
+        MPI_Comm_size( communicator, &size);
+        
+        int no_special_case = true;
+        for( int i = 0; i < size && no_special_case; i++) {
+                if( sendcounts[i] > std::numeric_limits< int >::max()) no_special_case = false;
+                if( recvcounts[i] > std::numeric_limits< int >::max()) no_special_case = false;
+        }
+        if( displs[size]  > std::numeric_limits< int >::max()) no_special_case = false;
+        if( rdispls[size] > std::numeric_limits< int >::max()) no_special_case = false;
+        // all PEs have to take the same path
+        MPI_Allreduce(MPI_IN_PLACE, &no_special_case, 1, MPI_INT, MPI_LAND, communicator);
+
+        if( no_special_case ) {
+                int sbktsize[size];
+                int rbktsize[size];
+                int sdispl[size+1];
+                int rdispl[size+1];
+
+                for( int i = 0; i < size; i++) {
+                        sbktsize[i] = sendcounts[i];
+                        rbktsize[i] = recvcounts[i];
+                }
+
+                for( int i = 0; i <= size; i++) {
+                        sdispl[i] = displs[i];
+                        rdispl[i] = rdispls[i];
+                }
+
+                MPI_Alltoallv(sendbuf, sbktsize, sdispl, sendtype, 
+                              recvbuf, rbktsize, rdispl, recvtype, communicator);
+        } else {
+                // point to point messages of at most int-count elements, the buffers are addressed with 64 bit offsets
+                // messages between two PEs arrive in the order they were sent, so the pieces of a bucket stay in order
+                MPI_Aint lb, send_extent, recv_extent;
+                MPI_Type_get_extent(sendtype, &lb, &send_extent);
+                MPI_Type_get_extent(recvtype, &lb, &recv_extent);
+
+                const ULONG max_count = std::numeric_limits< int >::max();
+                const int tag         = 23*size;
+                std::vector< MPI_Request > requests;
+                for( int i = 0; i < size; i++) {
+                        for( ULONG offset = 0; offset < recvcounts[i]; offset += max_count) {
+                                requests.push_back(MPI_Request());
+                                MPI_Irecv((char*)recvbuf + (rdispls[i] + offset) * recv_extent, 
+                                          std::min(max_count, recvcounts[i] - offset), recvtype, 
+                                          i, tag, communicator, &requests.back());
+                        }
+                }
+                for( int i = 0; i < size; i++) {
+                        for( ULONG offset = 0; offset < sendcounts[i]; offset += max_count) {
+                                requests.push_back(MPI_Request());
+                                MPI_Isend((char*)sendbuf + (displs[i] + offset) * send_extent, 
+                                          std::min(max_count, sendcounts[i] - offset), sendtype, 
+                                          i, tag, communicator, &requests.back());
+                        }
+                }
+                MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+        }
+}
+
 
 #endif /* end of include guard: MPI_TOOLS_HMESDXF2 */
@@ -16,7 +16,7 @@ ULONG parallel_graph_access::m_comm_rounds_up = 128;
 parallel_graph_access::parallel_graph_access( MPI_Comm communicator ) : m_num_local_nodes(0), 
                                                  from(0), 
                                                  to(0),
-                                                 m_num_ghost_nodes(0), m_max_node_degree(0), m_bm(NULL) {
+                                                 m_num_ghost_nodes(0), m_max_node_degree(0), m_compact_edges(false), m_bm(NULL) {
 
 
                 m_communicator = communicator;
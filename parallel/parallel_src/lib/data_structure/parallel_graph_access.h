@@ -10,6 +10,7 @@
 
 
 #include <mpi.h>
+#include <limits>
 #include <unordered_map>
 #include <iostream>
 #include <ostream>
@@ -190,7 +191,7 @@ public:
         parallel_graph_access( ) : m_num_local_nodes(0), 
                                      from(0), 
                                      to(0),
-                                     m_num_ghost_nodes(0), m_max_node_degree(0), m_bm(NULL)  { 
+                                     m_num_ghost_nodes(0), m_max_node_degree(0), m_compact_edges(false), m_bm(NULL)  { 
                                              m_communicator = MPI_COMM_WORLD;
                                              MPI_Comm_rank( m_communicator, &rank);
                                              MPI_Comm_size( m_communicator, &size);
@@ -222,7 +223,18 @@ public:
                 //resizes property arrays
                 m_nodes.resize(n+1);
                 m_nodes_data.resize(n+1);
-                m_edges.resize(m);
+
+                // ghost nodes get the local ids n+1, n+2, ... and there is at most one per edge,
+                // use the wide layout if the local ids may not fit into 32 bits
+                if( m_compact_edges && (unsigned long long)n + m + 1 >= std::numeric_limits<UINT>::max() ) {
+                        m_compact_edges = false;
+                }
+                if( m_compact_edges ) {
+                        m_compact_targets.resize(m);
+                        m_compact_weights.clear();
+                } else {
+                        m_edges.resize(m);
+                }
 
                 m_nodes[node].firstEdge = e;
                 m_divisor = ceil(global_n / (double)size);
@@ -283,22 +295,22 @@ public:
 
         EdgeID new_edge(NodeID source, NodeID target) {
                 ASSERT_TRUE(m_building_graph);
-                ASSERT_TRUE(e < m_edges.size());
+                ASSERT_TRUE(e < number_of_local_edges());
 
                 // build ghost nodes on the fly
                 if( from <= target && target <= to) {
-                        m_edges[e].local_target = target - from; 
+                        setEdgeTarget(e, target - from); 
                 } else {
                         m_nodes_data[source].is_interface_node = true;
 
                         // check wether this is already a ghost node
                         if(m_global_to_local_id.find(target) != m_global_to_local_id.end()) {
                                 // this node is already a ghost node
-                                m_edges[e].local_target = m_global_to_local_id[target]; 
+                                setEdgeTarget(e, m_global_to_local_id[target]); 
                         } else {
                                 // we need to create a new ghost node
                                 m_global_to_local_id[target] = m_num_nodes++;
-                                m_edges[e].local_target      = m_global_to_local_id[target]; 
+                                setEdgeTarget(e, m_global_to_local_id[target]); 
 
                                 //create the ghost node in the array
                                 Node dummy;
@@ -347,7 +359,16 @@ public:
 
 
         void finish_construction() {
-                m_edges.resize(e);
+                if( m_compact_edges ) {
+                        m_compact_targets.resize(e);
+                        m_compact_targets.shrink_to_fit();
+                        if( !m_compact_weights.empty() ) {
+                                m_compact_weights.resize(e);
+                                m_compact_weights.shrink_to_fit();
+                        }
+                } else {
+                        m_edges.resize(e);
+                }
                 m_building_graph = false;
 
                 //fill isolated sources at the end
@@ -364,6 +385,19 @@ public:
 	NodeID get_max_degree() {
 		return m_max_node_degree;
 	}
+
+        // has to be called before start_construction
+        // edge targets are then stored as 32 bit local ids and edge weights are 
+        // only stored once an edge weight different from one is set. If n+m of the
+        // local graph exceeds 32 bits the normal layout is used instead
+        void enable_compact_edges() {
+                ASSERT_TRUE(m_edges.empty());
+                m_compact_edges = true;
+        }
+
+        bool has_compact_edges() {
+                return m_compact_edges;
+        }
         /* ============================================================= */
         /* methods handeling balance */
         /* ============================================================= */
@@ -382,7 +416,7 @@ public:
         NodeID number_of_local_nodes() {return m_num_local_nodes;};
         NodeID number_of_ghost_nodes() {return m_nodes.size() - m_num_local_nodes - 1;};
         NodeID number_of_global_nodes() {return m_global_n;};
-        EdgeID number_of_local_edges() {return m_edges.size();};
+        EdgeID number_of_local_edges() {return m_compact_edges ? m_compact_targets.size() : m_edges.size();};
         EdgeID number_of_global_edges() {return m_global_m;};
         void set_number_of_global_edges( EdgeID global_edges) {m_global_m = global_edges;};
 
@@ -434,6 +468,7 @@ public:
         void setEdgeWeight(EdgeID e, EdgeWeight weight); 
 
         NodeID getEdgeTarget(EdgeID e);
+        void setEdgeTarget(EdgeID e, NodeID target);
 
         //methods for non-local / ghost nodes only
         //these methods are usally called to communicate data
@@ -482,7 +517,11 @@ public:
 
                 unsigned int memoryTotal = 0;
                 memoryTotal += printMemoryUsage(out, "nodes", (m_nodes.size()-1) * (sizeof(Node)+sizeof(NodeData)+sizeof(NodeID)+sizeof(AdditionalNonLocalNodeData)));
-                memoryTotal += printMemoryUsage(out, "edges", (m_edges.size()-1) * sizeof(Edge));
+                if( m_compact_edges ) {
+                        memoryTotal += printMemoryUsage(out, "edges", m_compact_targets.size() * sizeof(UINT) + m_compact_weights.size() * sizeof(EdgeWeight));
+                } else {
+                        memoryTotal += printMemoryUsage(out, "edges", (m_edges.size()-1) * sizeof(Edge));
+                }
 
                 printMemoryUsage(out, "TOTAL", memoryTotal);
                 out << std::endl;
@@ -512,6 +551,11 @@ private:
         std::vector<NodeData>                   m_nodes_data;
         std::vector<Edge>                       m_edges;
 
+        // compact edge representation (see enable_compact_edges) 
+        // m_compact_weights is empty as long as all edge weights are one
+        std::vector<UINT>                       m_compact_targets;
+        std::vector<EdgeWeight>                 m_compact_weights;
+
         //Ghost Node Stuff
         std::vector<AdditionalNonLocalNodeData> m_add_non_local_node_data;
 
@@ -547,6 +591,8 @@ private:
 	NodeID m_max_node_degree;
 	NodeID m_cur_degree;
 
+        bool m_compact_edges;
+
         PEID size;
         PEID rank;
 
@@ -656,6 +702,9 @@ inline bool parallel_graph_access::is_local_node(NodeID node) {
 }
 
 inline EdgeWeight parallel_graph_access::getEdgeWeight(EdgeID e) {
+        if( m_compact_edges ) {
+                return m_compact_weights.empty() ? 1 : m_compact_weights[e];
+        }
 #ifdef NDEBUG
         return m_edges[e].weight;
 #else
@@ -664,6 +713,14 @@ inline EdgeWeight parallel_graph_access::getEdgeWeight(EdgeID e) {
 }
 
 inline void parallel_graph_access::setEdgeWeight(EdgeID e, EdgeWeight weight) {
+        if( m_compact_edges ) {
+                if( m_compact_weights.empty() ) {
+                        if( weight == 1 ) return;
+                        m_compact_weights.resize(m_compact_targets.size(), 1);
+                }
+                m_compact_weights[e] = weight;
+                return;
+        }
 #ifdef NDEBUG
         m_edges[e].weight = weight;
 #else
@@ -672,6 +729,9 @@ inline void parallel_graph_access::setEdgeWeight(EdgeID e, EdgeWeight weight) {
 }
 
 inline NodeID parallel_graph_access::getEdgeTarget(EdgeID e){
+        if( m_compact_edges ) {
+                return m_compact_targets[e];
+        }
 #ifdef NDEBUG
         return m_edges[e].local_target;        
 #else
@@ -679,6 +739,20 @@ inline NodeID parallel_graph_access::getEdgeTarget(EdgeID e){
 #endif
 }
 
+inline void parallel_graph_access::setEdgeTarget(EdgeID e, NodeID target){
+        if( m_compact_edges ) {
+                // holds since start_construction chose the compact layout only for small local ids
+                ASSERT_LT(target, (NodeID)std::numeric_limits<UINT>::max());
+                m_compact_targets[e] = target;
+                return;
+        }
+#ifdef NDEBUG
+        m_edges[e].local_target = target;        
+#else
+        m_edges.at(e).local_target = target;        
+#endif
+}
+
 //function should only be called for ghost nodes
 inline PEID parallel_graph_access::getTargetPE(NodeID node) {
 #ifdef NDEBUG
@@ -722,7 +796,7 @@ inline int* parallel_graph_access::UNSAFE_metis_style_xadj_array() {
 inline int* parallel_graph_access::UNSAFE_metis_style_adjncy_array() {
         int * adjncy    = new int[number_of_local_edges()];
         forall_local_edges((*this), e) {
-                adjncy[e] = m_edges[e].local_target;
+                adjncy[e] = getEdgeTarget(e);
         } endfor 
 
         return adjncy;
@@ -741,7 +815,7 @@ inline int* parallel_graph_access::UNSAFE_metis_style_vwgt_array() {
 inline int* parallel_graph_access::UNSAFE_metis_style_adjwgt_array() {
         int * adjwgt    = new int[number_of_local_edges()];
         forall_local_edges((*this), e) {
-                adjwgt[e] = m_edges[e].weight;
+                adjwgt[e] = getEdgeWeight(e);
         } endfor 
 
         return adjwgt;
@@ -17,6 +17,7 @@
 #include "stop_rule.h"
 #include "tools/distributed_quality_metrics.h"
 #include "tools/random_functions.h"
+#include "tools/trace.h"
 #include "data_structure/linear_probing_hashmap.h"
 
 std::vector< NodeID > distributed_partitioner::m_cf = std::vector< NodeID >();
@@ -73,7 +74,11 @@ void distributed_partitioner::perform_partitioning( MPI_Comm communicator, PPart
                         config.label_iterations_refinement = 0;
                 }
 
-                vcycle( communicator, config, G );
+                {
+                        trace_scope scope("vcycle");
+                        scope.arg("cycle", cycle);
+                        vcycle( communicator, config, G );
+                }
 
                 if( rank == ROOT ) {
                         PRINT(std::cout <<  "log>cycle: " << m_cycle << " uncoarsening took " << m_t.elapsed()  << std::endl;)
@@ -155,9 +160,17 @@ void distributed_partitioner::vcycle( MPI_Comm communicator, PPartitionConfig &
         config.upper_bound_cluster = config.upper_bound_partition/(1.0*config.cluster_coarsening_factor);
         G.init_balance_management( config );
 
-        //parallel_label_compress< std::unordered_map< NodeID, NodeWeight> > plc;
-        parallel_label_compress< linear_probing_hashmap  > plc;
-        plc.perform_parallel_label_compression ( config, G, true);
+        {
+                trace_scope scope("label compression");
+                scope.arg("level", m_level);
+                scope.arg("global nodes", G.number_of_global_nodes());
+                scope.arg("global edges", G.number_of_global_edges());
+                scope.arg("local nodes", G.number_of_local_nodes());
+
+                //parallel_label_compress< std::unordered_map< NodeID, NodeWeight> > plc;
+                parallel_label_compress< linear_probing_hashmap  > plc;
+                plc.perform_parallel_label_compression ( config, G, true);
+        }
 
 #ifndef NOOUTPUT
         if( rank == ROOT ) {
@@ -169,6 +182,9 @@ void distributed_partitioner::vcycle( MPI_Comm communicator, PPartitionConfig &
         t.restart();
 
         {
+                trace_scope scope("contraction");
+                scope.arg("level", m_level);
+
                 parallel_contraction parallel_contract;
                 parallel_contract.contract_to_distributed_quotient( communicator, config, G, Q); // contains one Barrier
 
@@ -179,6 +195,8 @@ void distributed_partitioner::vcycle( MPI_Comm communicator, PPartitionConfig &
                 }
         
                 MPI_Barrier(communicator);
+                scope.arg("coarse global nodes", Q.number_of_global_nodes());
+                scope.arg("coarse global edges", Q.number_of_global_edges());
         }
               
 
@@ -205,8 +223,14 @@ void distributed_partitioner::vcycle( MPI_Comm communicator, PPartitionConfig &
 #endif
                 t.restart();
 
-                initial_partitioning_algorithm ip;
-                ip.perform_partitioning( communicator, config, Q );
+                {
+                        trace_scope scope("initial partitioning");
+                        scope.arg("global nodes", Q.number_of_global_nodes());
+                        scope.arg("global edges", Q.number_of_global_edges());
+
+                        initial_partitioning_algorithm ip;
+                        ip.perform_partitioning( communicator, config, Q );
+                }
 
 #ifndef NOOUTPUT
                 if( rank == ROOT ) {
@@ -225,8 +249,13 @@ void distributed_partitioner::vcycle( MPI_Comm communicator, PPartitionConfig &
 #endif
 
         t.restart();
-        parallel_projection parallel_project;
-        parallel_project.parallel_project( communicator, G, Q ); // contains a Barrier
+        {
+                trace_scope scope("projection");
+                scope.arg("level", m_level);
+
+                parallel_projection parallel_project;
+                parallel_project.parallel_project( communicator, G, Q ); // contains a Barrier
+        }
 
 #ifndef NOOUTPUT
         if( rank == ROOT ) {
@@ -238,6 +267,10 @@ void distributed_partitioner::vcycle( MPI_Comm communicator, PPartitionConfig &
         config.label_iterations = config.label_iterations_refinement;
 
         if( config.label_iterations != 0 ) {
+                trace_scope scope("label propagation refinement");
+                scope.arg("level", m_level);
+                scope.arg("local nodes", G.number_of_local_nodes());
+
                 config.total_num_labels = config.k;
                 config.upper_bound_cluster = config.upper_bound_partition;
 
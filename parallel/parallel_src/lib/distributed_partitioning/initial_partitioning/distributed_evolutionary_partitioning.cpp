@@ -27,9 +27,47 @@ void distributed_evolutionary_partitioning::perform_partitioning( MPI_Comm commu
         parallel_graph_access Q_bar;
         distributed_quality_metrics dqm;
         mpitools.collect_parallel_graph_to_local_graph( communicator, config, Q, Q_bar);
-        mpitools.distribute_local_graph( communicator, config, Q_bar);
 
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
 
+        if( config.initial_partitioning_pes <= 0 || config.initial_partitioning_pes >= size ) {
+                mpitools.distribute_local_graph( communicator, config, Q_bar);
+                partition_local_graph( communicator, config, Q_bar);
+
+                parallel_projection parallel_project_init;
+                parallel_project_init.initial_assignment( Q, Q_bar );
+        } else {
+                // only the first PEs hold a copy of the coarsest graph 
+                // the remaining PEs receive the labels of their local nodes from ROOT
+                MPI_Comm ip_communicator;
+                int color = rank < config.initial_partitioning_pes ? 0 : MPI_UNDEFINED;
+                MPI_Comm_split( communicator, color, rank, &ip_communicator);
+
+                if( ip_communicator != MPI_COMM_NULL ) {
+                        mpitools.distribute_local_graph( ip_communicator, config, Q_bar);
+                        partition_local_graph( ip_communicator, config, Q_bar);
+                        MPI_Comm_free( &ip_communicator );
+                }
+
+                mpitools.scatter_local_graph_labels( communicator, Q_bar, Q);
+        }
+
+#ifndef NOOUTPUT
+        EdgeWeight edgecut = dqm.edge_cut(Q, communicator); 
+        double balance     = dqm.balance(config, Q, communicator);
+        if( rank == (int)ROOT) {
+                std::cout <<  "log>cur edge cut " <<  edgecut  << std::endl;
+                std::cout <<  "log>cur balance  " <<  balance << std::endl;
+        }
+#endif
+}
+
+void distributed_evolutionary_partitioning::partition_local_graph( MPI_Comm communicator, PPartitionConfig & config, 
+                                                                   complete_graph_access & Q_bar) {
+
+        distributed_quality_metrics dqm;
 
         int n       = Q_bar.number_of_local_nodes();
         int nparts  = config.k;    // k-way partitioning.
@@ -175,18 +213,6 @@ void distributed_evolutionary_partitioning::perform_partitioning( MPI_Comm commu
                 }
         }
 
-        parallel_projection parallel_project_init;
-        parallel_project_init.initial_assignment( Q, Q_bar );
-
-#ifndef NOOUTPUT
-        edgecut = dqm.edge_cut(Q, communicator); 
-        balance = dqm.balance(config, Q, communicator);
-        if( rank == (int)ROOT) {
-                std::cout <<  "log>cur edge cut " <<  edgecut  << std::endl;
-                std::cout <<  "log>cur balance  " <<  balance << std::endl;
-        }
-#endif
-
         delete[] xadj;
         delete[] adjncy;
         delete[] vwgt;
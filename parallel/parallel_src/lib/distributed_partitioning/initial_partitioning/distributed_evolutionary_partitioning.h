@@ -17,6 +17,10 @@ public:
         virtual ~distributed_evolutionary_partitioning();
 
         void perform_partitioning( MPI_Comm communicator, PPartitionConfig & config, parallel_graph_access & G);
+
+private:
+        // runs kaffpaE on a coarsest graph that is replicated on every PE of the communicator
+        void partition_local_graph( MPI_Comm communicator, PPartitionConfig & config, complete_graph_access & Q_bar);
 };
 
 #endif /* end of include guard: DISTRIBUTED_EVOLUTIONARY_PARTITIONING_OJ2RIKR7 */
@@ -0,0 +1,617 @@
+/******************************************************************************
+ * parallel_graph_generator.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <omp.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "communication/mpi_tools.h"
+#include "io/graph_generator_random.h" // shared with graph_generator in KaHIP
+#include "parallel_graph_generator.h"
+
+parallel_graph_generator::parallel_graph_generator() {
+
+}
+
+parallel_graph_generator::~parallel_graph_generator() {
+
+}
+
+namespace {
+
+using namespace graph_generator_random;
+
+// count points are split over the cells [0, cells) by recursive binomial splits. the
+// functions below follow single paths of that recursion, i.e. a PE only computes the
+// cells it needs.
+
+// number of points in cell, first is set to the number of points in the cells before it
+NodeID cell_count(uint64_t key, uint64_t cells, NodeID count, uint64_t cell, NodeID & first) {
+        uint64_t lo = 0, hi = cells;
+        first = 0;
+        while( hi - lo > 1 ) {
+                uint64_t mid = lo + (hi - lo) / 2;
+                counter_rng rng(mix(key ^ mix(lo)) + hi);
+                NodeID left = binomial(rng, count, (mid - lo) / (double)(hi - lo));
+                if( cell < mid ) {
+                        hi     = mid;
+                        count  = left;
+                } else {
+                        lo     = mid;
+                        first += left;
+                        count -= left;
+                }
+        }
+        return count;
+}
+
+// the cell that contains the point with the given index (index < count)
+uint64_t locate_cell(uint64_t key, uint64_t cells, NodeID count, NodeID index) {
+        uint64_t lo = 0, hi = cells;
+        while( hi - lo > 1 ) {
+                uint64_t mid = lo + (hi - lo) / 2;
+                counter_rng rng(mix(key ^ mix(lo)) + hi);
+                NodeID left = binomial(rng, count, (mid - lo) / (double)(hi - lo));
+                if( index < left ) {
+                        hi     = mid;
+                        count  = left;
+                } else {
+                        lo     = mid;
+                        index -= left;
+                        count -= left;
+                }
+        }
+        return lo;
+}
+
+void split_range(uint64_t key, uint64_t lo, uint64_t hi, NodeID count, NodeID offset,
+                 uint64_t want_lo, uint64_t want_hi, std::vector< NodeID > & start) {
+        if( hi <= want_lo || lo >= want_hi ) return;
+        if( hi - lo == 1 ) {
+                start[lo - want_lo] = offset;
+                if( lo + 1 == want_hi ) start[want_hi - want_lo] = offset + count;
+                return;
+        }
+
+        uint64_t mid = lo + (hi - lo) / 2;
+        counter_rng rng(mix(key ^ mix(lo)) + hi);
+        NodeID left = binomial(rng, count, (mid - lo) / (double)(hi - lo));
+        split_range(key, lo, mid, left, offset, want_lo, want_hi, start);
+        split_range(key, mid, hi, count - left, offset + left, want_lo, want_hi, start);
+}
+
+// first point of the cells want_lo..want_hi-1, the last entry is the end of cell want_hi-1
+std::vector< NodeID > cell_starts(uint64_t key, uint64_t cells, NodeID count, uint64_t want_lo, uint64_t want_hi) {
+        std::vector< NodeID > start(want_hi - want_lo + 1, 0);
+        split_range(key, 0, cells, count, 0, want_lo, want_hi, start);
+        return start;
+}
+
+// PE p owns the nodes p*ceil(n/size) to (p+1)*ceil(n/size)-1
+void local_range(NodeID n, MPI_Comm communicator, NodeID & from, NodeID & local_n) {
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
+
+        NodeID nodes_per_pe = ceil(n / (double)size);
+        from    = rank * nodes_per_pe;
+        local_n = from < n ? std::min(n - 1, (rank + 1) * nodes_per_pe - 1) - from + 1 : 0;
+}
+
+// adjacency[i] are the sorted global neighbors of the local node i
+void build_graph(parallel_graph_access & G, NodeID n, std::vector< std::vector< NodeID > > & adjacency,
+                 MPI_Comm communicator) {
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
+
+        NodeID nodes_per_pe = ceil(n / (double)size);
+        NodeID from         = rank * nodes_per_pe;
+        NodeID to           = std::min((rank + 1) * nodes_per_pe - 1, n - 1);
+        NodeID local_n      = adjacency.size();
+
+        EdgeID local_m = 0;
+        for( NodeID i = 0; i < local_n; i++) {
+                local_m += adjacency[i].size();
+        }
+        EdgeID global_m = 0;
+        MPI_Allreduce(&local_m, &global_m, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+
+        G.start_construction(local_n, local_m, n, global_m);
+        G.set_range(from, to);
+
+        std::vector< NodeID > vertex_dist( size+1, 0 );
+        for( PEID peID = 0; peID <= size; peID++) {
+                vertex_dist[peID] = peID * nodes_per_pe; // from positions
+        }
+        G.set_range_array(vertex_dist);
+
+        for( NodeID i = 0; i < local_n; i++) {
+                NodeID node = G.new_node();
+                G.setNodeWeight(node, 1);
+                G.setNodeLabel(node, from+node);
+                G.setSecondPartitionIndex(node, 0);
+
+                for( NodeID target : adjacency[i] ) {
+                        EdgeID e = G.new_edge(node, target);
+                        G.setEdgeWeight(e, 1);
+                }
+                std::vector< NodeID >().swap(adjacency[i]);
+        }
+
+        G.finish_construction();
+        MPI_Barrier(communicator);
+}
+
+// neighbors(node, adjacent) appends the global neighbors of the global node
+template< typename Neighbors >
+void build_graph(parallel_graph_access & G, NodeID n, NodeID from, NodeID local_n, Neighbors neighbors,
+                 MPI_Comm communicator) {
+        std::vector< std::vector< NodeID > > adjacency(local_n);
+        #pragma omp parallel for schedule(dynamic, 256)
+        for( NodeID i = 0; i < local_n; i++) {
+                neighbors(from + i, adjacency[i]);
+                std::sort(adjacency[i].begin(), adjacency[i].end());
+        }
+
+        build_graph(G, n, adjacency, communicator);
+}
+
+// sends every undirected edge to the owners of both endpoints and builds the graph from
+// the received edges, self loops and duplicates are removed
+void build_graph(parallel_graph_access & G, NodeID n, std::vector< std::pair< NodeID, NodeID > > & edges,
+                 MPI_Comm communicator) {
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
+
+        NodeID from, local_n;
+        local_range(n, communicator, from, local_n);
+        NodeID nodes_per_pe = ceil(n / (double)size);
+
+        // counts and displacements are 64 bit, a PE can send more than 2^31 ids to another PE
+        std::vector< ULONG > send_counts(size, 0), send_displs(size+1, 0);
+        std::vector< ULONG > recv_counts(size, 0), recv_displs(size+1, 0);
+        for( auto & edge : edges ) {
+                if( edge.first == edge.second ) continue;
+                send_counts[edge.first / nodes_per_pe]  += 2;
+                send_counts[edge.second / nodes_per_pe] += 2;
+        }
+        for( PEID i = 1; i <= size; i++) {
+                send_displs[i] = send_displs[i-1] + send_counts[i-1];
+        }
+
+        std::vector< NodeID > send_buffer(send_displs[size]);
+        std::vector< ULONG > position(send_displs);
+        for( auto & edge : edges ) {
+                if( edge.first == edge.second ) continue;
+                ULONG & source_position = position[edge.first / nodes_per_pe];
+                send_buffer[source_position++] = edge.first;
+                send_buffer[source_position++] = edge.second;
+
+                ULONG & target_position = position[edge.second / nodes_per_pe];
+                send_buffer[target_position++] = edge.second;
+                send_buffer[target_position++] = edge.first;
+        }
+        std::vector< std::pair< NodeID, NodeID > >().swap(edges);
+
+        MPI_Alltoall(&send_counts[0], 1, MPI_UNSIGNED_LONG_LONG, &recv_counts[0], 1, MPI_UNSIGNED_LONG_LONG, communicator);
+        for( PEID i = 1; i <= size; i++) {
+                recv_displs[i] = recv_displs[i-1] + recv_counts[i-1];
+        }
+
+        std::vector< NodeID > recv_buffer(recv_displs[size]);
+        mpi_tools::alltoallv(send_buffer.data(), &send_counts[0], &send_displs[0], MPI_UNSIGNED_LONG_LONG,
+                             recv_buffer.data(), &recv_counts[0], &recv_displs[0], MPI_UNSIGNED_LONG_LONG, communicator);
+        std::vector< NodeID >().swap(send_buffer);
+
+        std::vector< std::vector< NodeID > > adjacency(local_n);
+        for( std::size_t i = 0; i < recv_buffer.size(); i += 2) {
+                adjacency[recv_buffer[i] - from].push_back(recv_buffer[i+1]);
+        }
+        std::vector< NodeID >().swap(recv_buffer);
+
+        #pragma omp parallel for schedule(dynamic, 1024)
+        for( NodeID i = 0; i < local_n; i++) {
+                std::sort(adjacency[i].begin(), adjacency[i].end());
+                adjacency[i].erase(std::unique(adjacency[i].begin(), adjacency[i].end()), adjacency[i].end());
+        }
+
+        build_graph(G, n, adjacency, communicator);
+}
+
+}
+
+void parallel_graph_generator::grid(parallel_graph_access & G, NodeID x, NodeID y, NodeID z, MPI_Comm communicator) {
+        x = std::max< NodeID >(x, 1);
+        y = std::max< NodeID >(y, 1);
+        z = std::max< NodeID >(z, 1);
+
+        NodeID n = x * y * z;
+        NodeID from, local_n;
+        local_range(n, communicator, from, local_n);
+
+        build_graph(G, n, from, local_n, [&](NodeID node, std::vector< NodeID > & adjacent) {
+                NodeID i = node % x;
+                NodeID j = (node / x) % y;
+                NodeID k = node / (x * y);
+                if( k > 0 )     adjacent.push_back(node - x * y);
+                if( j > 0 )     adjacent.push_back(node - x);
+                if( i > 0 )     adjacent.push_back(node - 1);
+                if( i + 1 < x ) adjacent.push_back(node + 1);
+                if( j + 1 < y ) adjacent.push_back(node + x);
+                if( k + 1 < z ) adjacent.push_back(node + x * y);
+        }, communicator);
+}
+
+void parallel_graph_generator::random_geometric(parallel_graph_access & G, NodeID n, double radius, int dimension, int seed,
+                                                MPI_Comm communicator) {
+        dimension = dimension == 3 ? 3 : 2;
+
+        double max_cells_per_dim = floor(pow(std::max< NodeID >(n, 1), 1.0 / dimension) + 1e-9);
+        NodeID cells_per_dim     = std::max(1.0, std::min(floor(1 / radius), max_cells_per_dim));
+        uint64_t cells           = dimension == 3 ? (uint64_t)cells_per_dim * cells_per_dim * cells_per_dim
+                                                  : (uint64_t)cells_per_dim * cells_per_dim;
+        const uint64_t key       = random_key(seed, 1, dimension);
+
+        NodeID from, local_n;
+        local_range(n, communicator, from, local_n);
+
+        // cells are numbered row by row, so the cells adjacent to the local cells are at
+        // most halo cells away. the points of these cells are generated on every PE
+        // that needs them.
+        uint64_t first_cell = 0;
+        NodeID first_point  = 0;
+        std::vector< NodeID > cell_start;
+        std::vector< double > coordinate;
+        std::vector< uint64_t > node_cell;
+        if( local_n > 0 ) {
+                uint64_t halo      = (dimension == 3 ? (uint64_t)cells_per_dim * cells_per_dim : 0) + cells_per_dim + 1;
+                uint64_t own_first = locate_cell(key, cells, n, from);
+                uint64_t own_last  = locate_cell(key, cells, n, from + local_n - 1);
+                uint64_t last_cell = std::min(cells, own_last + halo + 1);
+                first_cell         = own_first > halo ? own_first - halo : 0;
+
+                cell_start  = cell_starts(key, cells, n, first_cell, last_cell);
+                first_point = cell_start[0];
+                coordinate.resize(dimension * (std::size_t)(cell_start.back() - first_point));
+                node_cell.resize(cell_start.back() - first_point);
+
+                #pragma omp parallel for schedule(dynamic, 64)
+                for( uint64_t cell = first_cell; cell < last_cell; cell++) {
+                        counter_rng rng(random_key(seed, 2, cell));
+                        uint64_t cell_coordinate[3] = {cell % cells_per_dim,
+                                                       (cell / cells_per_dim) % cells_per_dim,
+                                                       cell / ((uint64_t)cells_per_dim * cells_per_dim)};
+                        for( NodeID node = cell_start[cell - first_cell]; node < cell_start[cell - first_cell + 1]; node++) {
+                                for( int d = 0; d < dimension; d++) {
+                                        coordinate[dimension * (std::size_t)(node - first_point) + d] = (cell_coordinate[d] + rng.uniform()) / cells_per_dim;
+                                }
+                                node_cell[node - first_point] = cell;
+                        }
+                }
+        }
+
+        double squared_radius = radius * radius;
+        int z_range = dimension == 3 ? 1 : 0;
+        build_graph(G, n, from, local_n, [&](NodeID node, std::vector< NodeID > & adjacent) {
+                uint64_t cell = node_cell[node - first_point];
+                long cx = cell % cells_per_dim;
+                long cy = (cell / cells_per_dim) % cells_per_dim;
+                long cz = cell / ((uint64_t)cells_per_dim * cells_per_dim);
+                const double * p = &coordinate[dimension * (std::size_t)(node - first_point)];
+
+                for( long dz = -z_range; dz <= z_range; dz++) {
+                        for( long dy = -1; dy <= 1; dy++) {
+                                for( long dx = -1; dx <= 1; dx++) {
+                                        long x = cx + dx, y = cy + dy, z = cz + dz;
+                                        if( x < 0 || y < 0 || z < 0 || x >= (long)cells_per_dim
+                                         || y >= (long)cells_per_dim || z >= (long)cells_per_dim ) continue;
+
+                                        uint64_t neighbor_cell = ((uint64_t)z * cells_per_dim + y) * cells_per_dim + x - first_cell;
+                                        for( NodeID target = cell_start[neighbor_cell]; target < cell_start[neighbor_cell + 1]; target++) {
+                                                if( target == node ) continue;
+                                                const double * q = &coordinate[dimension * (std::size_t)(target - first_point)];
+                                                double distance = 0;
+                                                for( int d = 0; d < dimension; d++) {
+                                                        distance += (p[d] - q[d]) * (p[d] - q[d]);
+                                                }
+                                                if( distance <= squared_radius ) adjacent.push_back(target);
+                                        }
+                                }
+                        }
+                }
+        }, communicator);
+}
+
+void parallel_graph_generator::rmat(parallel_graph_access & G, int log_n, double edge_factor,
+                                    double a, double b, double c, int seed, MPI_Comm communicator) {
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
+
+        log_n = std::max(1, std::min(62, log_n));
+        NodeID n         = (NodeID)1 << log_n;
+        uint64_t samples = std::max(0.0, edge_factor) * n;
+
+        // the chunks of samples are dealt out to the PEs
+        const uint64_t chunk_size = 1 << 16;
+        uint64_t chunks      = (samples + chunk_size - 1) / chunk_size;
+        uint64_t first_chunk = chunks * rank / size;
+        uint64_t last_chunk  = chunks * (rank + 1) / size;
+        uint64_t first       = first_chunk * chunk_size;
+        std::vector< std::pair< NodeID, NodeID > > edges(std::min(samples, last_chunk * chunk_size) - std::min(samples, first));
+
+        #pragma omp parallel for schedule(dynamic)
+        for( uint64_t chunk = first_chunk; chunk < last_chunk; chunk++) {
+                counter_rng rng(random_key(seed, 3, chunk));
+                for( uint64_t i = chunk * chunk_size; i < std::min(samples, (chunk + 1) * chunk_size); i++) {
+                        NodeID source = 0, target = 0;
+                        for( int bit = 0; bit < log_n; bit++) {
+                                double r = rng.uniform();
+                                if( r < a ) continue;
+                                if( r < a + b ) {
+                                        target |= (NodeID)1 << bit;
+                                } else if( r < a + b + c ) {
+                                        source |= (NodeID)1 << bit;
+                                } else {
+                                        source |= (NodeID)1 << bit;
+                                        target |= (NodeID)1 << bit;
+                                }
+                        }
+                        edges[i - first] = std::make_pair(source, target);
+                }
+        }
+
+        build_graph(G, n, edges, communicator);
+}
+
+void parallel_graph_generator::barabasi_albert(parallel_graph_access & G, NodeID n, NodeID min_degree, int seed,
+                                               MPI_Comm communicator) {
+        min_degree = std::max< NodeID >(min_degree, 1);
+
+        NodeID from, local_n;
+        local_range(n, communicator, from, local_n);
+
+        // see graph_generator::barabasi_albert, every PE generates the edges of its nodes
+        std::vector< std::pair< NodeID, NodeID > > edges(local_n * min_degree);
+        #pragma omp parallel for schedule(static)
+        for( NodeID i = 0; i < local_n; i++) {
+                NodeID node = from + i;
+                for( NodeID j = 0; j < min_degree; j++) {
+                        uint64_t position = 2 * ((uint64_t)node * min_degree + j) + 1;
+                        do {
+                                position = random_key(seed, 4, position) % position;
+                        } while( position % 2 == 1 );
+
+                        edges[i * min_degree + j] = std::make_pair(node, (NodeID)(position / 2 / min_degree));
+                }
+        }
+
+        build_graph(G, n, edges, communicator);
+}
+
+void parallel_graph_generator::random_hyperbolic(parallel_graph_access & G, NodeID n, double avg_degree, double gamma, int seed,
+                                                 MPI_Comm communicator) {
+        // see graph_generator::random_hyperbolic for the model and the bands and sectors
+        const double alpha  = std::max(0.51, (gamma - 1) / 2);
+        const double xi     = alpha / (alpha - 0.5);
+        const double R      = std::max(1e-3, 2 * log(2 * xi * xi * n / (M_PI * std::max(avg_degree, 1e-3))));
+        const double cosh_R = cosh(R);
+        const double norm   = cosh(alpha * R) - 1;
+        auto cdf = [&](double r) { return (cosh(alpha * r) - 1) / norm; };
+
+        const unsigned bands = std::max(1, (int)ceil(alpha * R / log(2)));
+        std::vector< double > band_radius(bands + 1), band_cosh(bands + 1), band_sinh(bands + 1);
+        for( unsigned b = 0; b <= bands; b++) {
+                band_radius[b] = R * b / bands;
+                band_cosh[b]   = cosh(band_radius[b]);
+                band_sinh[b]   = sinh(band_radius[b]);
+        }
+
+        std::vector< NodeID > band_count(bands);
+        NodeID remaining        = n;
+        double remaining_mass   = 1;
+        for( unsigned b = 0; b < bands; b++) {
+                double mass = cdf(band_radius[b + 1]) - cdf(band_radius[b]);
+                counter_rng rng(random_key(seed, 5, b));
+                band_count[b]   = b + 1 == bands ? remaining : binomial(rng, remaining, mass / remaining_mass);
+                remaining      -= band_count[b];
+                remaining_mass -= mass;
+        }
+
+        std::vector< NodeID > sectors(bands);
+        std::vector< NodeID > band_first_sector(bands + 1, 0);
+        std::vector< NodeID > band_start(bands + 1, 0);
+        for( unsigned b = 0; b < bands; b++) {
+                sectors[b]               = std::max< NodeID >(1, band_count[b] / 8);
+                band_first_sector[b + 1] = band_first_sector[b] + sectors[b];
+                band_start[b + 1]        = band_start[b] + band_count[b];
+        }
+
+        // the points of a sector, sorted by angle, are generated from the sector alone
+        struct sector_points {
+                NodeID first;
+                std::vector< double > theta, cosh_r, sinh_r;
+        };
+        auto generate_sector = [&](NodeID sector, sector_points & points) {
+                unsigned b = std::upper_bound(band_first_sector.begin(), band_first_sector.end(), sector)
+                             - band_first_sector.begin() - 1;
+                NodeID s   = sector - band_first_sector[b];
+                NodeID first_in_band;
+                NodeID count    = cell_count(random_key(seed, 6, b), sectors[b], band_count[b], s, first_in_band);
+                double cdf_low  = cdf(band_radius[b]);
+                double cdf_high = cdf(band_radius[b + 1]);
+
+                counter_rng rng(random_key(seed, 7, sector));
+                std::vector< std::pair< double, double > > angle_radius;
+                for( NodeID i = 0; i < count; i++) {
+                        double angle  = 2 * M_PI * (s + rng.uniform()) / sectors[b];
+                        double u      = cdf_low + rng.uniform() * (cdf_high - cdf_low);
+                        double radius = std::min(R, acosh(1 + u * norm) / alpha);
+                        angle_radius.push_back(std::make_pair(angle, radius));
+                }
+                std::sort(angle_radius.begin(), angle_radius.end());
+
+                points.first = band_start[b] + first_in_band;
+                for( auto & point : angle_radius ) {
+                        points.theta.push_back(point.first);
+                        points.cosh_r.push_back(cosh(point.second));
+                        points.sinh_r.push_back(sinh(point.second));
+                }
+        };
+
+        // the sectors [first, last] (taken modulo the sectors of band b) contain all possible neighbors
+        auto search_sectors = [&](unsigned b, double theta, double cosh_r, double sinh_r, long & first, long & last) {
+                double delta = M_PI;
+                if( b > 0 && sinh_r > 0 ) {
+                        double arg = (cosh_r * band_cosh[b] - cosh_R) / (sinh_r * band_sinh[b]);
+                        if( arg >= 1 )       delta = 0;
+                        else if( arg > -1 )  delta = acos(arg);
+                }
+                delta += 1e-9;
+
+                first = 0;
+                last  = (long)sectors[b] - 1;
+                if( delta < M_PI ) {
+                        long lo = floor((theta - delta) * sectors[b] / (2 * M_PI));
+                        long hi = floor((theta + delta) * sectors[b] / (2 * M_PI));
+                        if( hi - lo + 1 < (long)sectors[b] ) {
+                                first = lo;
+                                last  = hi;
+                        }
+                }
+        };
+
+        NodeID from, local_n;
+        local_range(n, communicator, from, local_n);
+
+        // the sectors of the local nodes
+        std::vector< NodeID > own_sectors;
+        for( unsigned b = 0; b < bands && local_n > 0; b++) {
+                NodeID lo = std::max(from, band_start[b]);
+                NodeID hi = std::min(from + local_n, band_start[b + 1]);
+                if( lo >= hi ) continue;
+
+                uint64_t key = random_key(seed, 6, b);
+                uint64_t s_first = locate_cell(key, sectors[b], band_count[b], lo - band_start[b]);
+                uint64_t s_last  = locate_cell(key, sectors[b], band_count[b], hi - 1 - band_start[b]);
+                for( uint64_t s = s_first; s <= s_last; s++) {
+                        own_sectors.push_back(band_first_sector[b] + s);
+                }
+        }
+
+        std::vector< sector_points > own_points(own_sectors.size());
+        #pragma omp parallel for schedule(dynamic)
+        for( std::size_t i = 0; i < own_sectors.size(); i++) {
+                generate_sector(own_sectors[i], own_points[i]);
+        }
+
+        std::vector< double > theta(local_n), cosh_r(local_n), sinh_r(local_n);
+        for( auto & points : own_points ) {
+                for( std::size_t j = 0; j < points.theta.size(); j++) {
+                        NodeID node = points.first + j;
+                        if( node < from || node >= from + local_n ) continue;
+                        theta[node - from]  = points.theta[j];
+                        cosh_r[node - from] = points.cosh_r[j];
+                        sinh_r[node - from] = points.sinh_r[j];
+                }
+        }
+        std::vector< sector_points >().swap(own_points);
+
+        // the union of the searched sectors, collected as (wrapped) intervals per band
+        std::vector< std::pair< NodeID, NodeID > > intervals;
+        #pragma omp parallel
+        {
+                std::vector< std::pair< NodeID, NodeID > > local_intervals;
+                #pragma omp for schedule(static)
+                for( NodeID i = 0; i < local_n; i++) {
+                        for( unsigned b = 0; b < bands; b++) {
+                                long first, last;
+                                search_sectors(b, theta[i], cosh_r[i], sinh_r[i], first, last);
+                                long S = sectors[b];
+                                NodeID offset = band_first_sector[b];
+                                if( first < 0 ) {
+                                        local_intervals.push_back(std::make_pair(offset + first + S, offset + S - 1));
+                                        first = 0;
+                                }
+                                if( last >= S ) {
+                                        local_intervals.push_back(std::make_pair(offset, offset + last - S));
+                                        last = S - 1;
+                                }
+                                local_intervals.push_back(std::make_pair(offset + first, offset + last));
+                        }
+                }
+                #pragma omp critical
+                intervals.insert(intervals.end(), local_intervals.begin(), local_intervals.end());
+        }
+        std::sort(intervals.begin(), intervals.end());
+
+        std::vector< NodeID > needed_sectors;
+        for( auto & interval : intervals ) {
+                NodeID s = needed_sectors.empty() ? interval.first : std::max(interval.first, needed_sectors.back() + 1);
+                for( ; s <= interval.second; s++) {
+                        needed_sectors.push_back(s);
+                }
+        }
+        std::vector< std::pair< NodeID, NodeID > >().swap(intervals);
+
+        std::vector< sector_points > needed_points(needed_sectors.size());
+        #pragma omp parallel for schedule(dynamic)
+        for( std::size_t i = 0; i < needed_sectors.size(); i++) {
+                generate_sector(needed_sectors[i], needed_points[i]);
+        }
+
+        build_graph(G, n, from, local_n, [&](NodeID node, std::vector< NodeID > & adjacent) {
+                NodeID i = node - from;
+                for( unsigned b = 0; b < bands; b++) {
+                        long first, last;
+                        search_sectors(b, theta[i], cosh_r[i], sinh_r[i], first, last);
+
+                        for( long s = first; s <= last; s++) {
+                                NodeID sector = band_first_sector[b] + ((s % (long)sectors[b]) + sectors[b]) % sectors[b];
+                                const sector_points & points = needed_points[std::lower_bound(needed_sectors.begin(), needed_sectors.end(), sector)
+                                                                             - needed_sectors.begin()];
+                                for( std::size_t j = 0; j < points.theta.size(); j++) {
+                                        NodeID target = points.first + j;
+                                        if( target == node ) continue;
+                                        double cosh_distance = cosh_r[i] * points.cosh_r[j]
+                                                             - sinh_r[i] * points.sinh_r[j] * cos(fabs(theta[i] - points.theta[j]));
+                                        if( cosh_distance <= cosh_R ) adjacent.push_back(target);
+                                }
+                        }
+                }
+        }, communicator);
+}
+
+bool parallel_graph_generator::generate(parallel_graph_access & G, const std::string & type, NodeID n, double avg_degree, int seed,
+                                        MPI_Comm communicator) {
+        n = std::max< NodeID >(n, 1);
+        if( type == "grid2d" ) {
+                NodeID side = std::max(1.0, round(sqrt(n)));
+                grid(G, side, side, 1, communicator);
+        } else if( type == "grid3d" ) {
+                NodeID side = std::max(1.0, round(cbrt(n)));
+                grid(G, side, side, side, communicator);
+        } else if( type == "rgg2d" ) {
+                random_geometric(G, n, sqrt(avg_degree / (M_PI * n)), 2, seed, communicator);
+        } else if( type == "rgg3d" ) {
+                random_geometric(G, n, cbrt(3 * avg_degree / (4 * M_PI * n)), 3, seed, communicator);
+        } else if( type == "rmat" ) {
+                rmat(G, (int)round(log2(n)), avg_degree / 2, 0.57, 0.19, 0.19, seed, communicator);
+        } else if( type == "ba" ) {
+                barabasi_albert(G, n, std::max(1.0, round(avg_degree / 2)), seed, communicator);
+        } else if( type == "rhg" ) {
+                random_hyperbolic(G, n, avg_degree, 3.0, seed, communicator);
+        } else {
+                return false;
+        }
+        return true;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+ * parallel_graph_generator.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PARALLEL_GRAPH_GENERATOR_R7WQ2KDX
+#define PARALLEL_GRAPH_GENERATOR_R7WQ2KDX
+
+#include <mpi.h>
+#include <string>
+
+#include "definitions.h"
+#include "data_structure/parallel_graph_access.h"
+
+// Distributed counterpart of graph_generator in KaHIP. PE p generates the nodes
+// p*ceil(n/size) to (p+1)*ceil(n/size)-1 (the distribution of the graph readers).
+// The random numbers are drawn from counters, so the graph does not depend on the
+// number of PEs and is the same graph that graph_generator builds for these parameters.
+// grid, random_geometric and random_hyperbolic only generate the points close to
+// the local ones; rmat and barabasi_albert generate a share of the edges and send
+// them to the owners of their endpoints.
+class parallel_graph_generator {
+        public:
+                parallel_graph_generator();
+                virtual ~parallel_graph_generator();
+
+                static void grid(parallel_graph_access & G, NodeID x, NodeID y, NodeID z = 1,
+                                 MPI_Comm communicator = MPI_COMM_WORLD);
+
+                static void random_geometric(parallel_graph_access & G, NodeID n, double radius, int dimension, int seed,
+                                             MPI_Comm communicator = MPI_COMM_WORLD);
+
+                static void rmat(parallel_graph_access & G, int log_n, double edge_factor,
+                                 double a, double b, double c, int seed,
+                                 MPI_Comm communicator = MPI_COMM_WORLD);
+
+                static void barabasi_albert(parallel_graph_access & G, NodeID n, NodeID min_degree, int seed,
+                                            MPI_Comm communicator = MPI_COMM_WORLD);
+
+                static void random_hyperbolic(parallel_graph_access & G, NodeID n, double avg_degree, double gamma, int seed,
+                                              MPI_Comm communicator = MPI_COMM_WORLD);
+
+                // generator given by name (grid2d, grid3d, rgg2d, rgg3d, rmat, ba, rhg) with about
+                // n nodes, the other parameters are chosen to match the average degree
+                static bool generate(parallel_graph_access & G, const std::string & type, NodeID n, double avg_degree, int seed,
+                                     MPI_Comm communicator = MPI_COMM_WORLD);
+};
+
+#endif /* end of include guard: PARALLEL_GRAPH_GENERATOR_R7WQ2KDX */
@@ -7,6 +7,7 @@
 
 #define _FILE_OFFSET_BITS 64
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -17,12 +18,19 @@
 #include <stdlib.h>
 #include <vector>
 
+#include "communication/mpi_tools.h"
 #include "parallel_graph_io.h"
 #include "tools/helpers.h"
+#include "varint_coding.h"
 
 const ULONG fileTypeVersionNumber = 3;
 const ULONG header_count          = 3;
 
+// compressed format: version, n, m, nodes per block, followed by the byte offsets of the blocks
+const ULONG fileTypeVersionNumberCompressed = 4;
+const ULONG header_count_compressed         = 4;
+const ULONG compressed_block_size           = 1024;
+
 
 parallel_graph_io::parallel_graph_io() {
                 
@@ -46,7 +54,7 @@ int parallel_graph_io::readGraphWeighted(PPartitionConfig & config,
                 if(file_exists(ss.str())) {
                         return readGraphBinary(config, G, ss.str(), peID, comm_size, communicator);
                 } else {
-                        return readGraphWeightedFlexible(G, filename, peID, comm_size, communicator);
+                        return readGraphWeightedMPIIO(G, filename, peID, comm_size, communicator);
                 }
         }
 
@@ -55,7 +63,7 @@ int parallel_graph_io::readGraphWeighted(PPartitionConfig & config,
         }
 
         //non of both is true -- try metis format
-        return readGraphWeightedFlexible(G, filename, peID, comm_size, communicator);
+        return readGraphWeightedMPIIO(G, filename, peID, comm_size, communicator);
 }
 
 int parallel_graph_io::readGraphWeightedFlexible(parallel_graph_access & G, 
@@ -174,6 +182,244 @@ int parallel_graph_io::readGraphWeightedFlexible(parallel_graph_access & G,
         return 0;
 }
 
+// reads count bytes starting at offset, the call is collective on the communicator
+// (PEs that have nothing to read participate with count = 0)
+static void read_at_all_large( MPI_File & fh, ULONG offset, char * buffer, ULONG count, MPI_Comm communicator) {
+        const ULONG max_read = std::numeric_limits< int >::max();
+        ULONG rounds = (count + max_read - 1) / max_read;
+        ULONG max_rounds = 0;
+        MPI_Allreduce(&rounds, &max_rounds, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, communicator);
+
+        for( ULONG round = 0; round < max_rounds; round++) {
+                ULONG pos   = std::min(round * max_read, count);
+                int   bytes = std::min(max_read, count - pos);
+
+                MPI_Status st;
+                MPI_File_read_at_all(fh, offset + pos, buffer + pos, bytes, MPI_CHAR, &st);
+        }
+}
+
+static inline bool next_number( const char * & pos, const char * end, ULONG & value ) {
+        while( pos < end && (*pos < '0' || *pos > '9') ) pos++;
+        if( pos == end ) return false;
+
+        value = 0;
+        while( pos < end && *pos >= '0' && *pos <= '9' ) {
+                value = 10*value + (*pos - '0');
+                pos++;
+        }
+        return true;
+}
+
+int parallel_graph_io::readGraphWeightedMPIIO(parallel_graph_access & G, 
+                                              std::string filename, 
+                                              PEID peID, PEID comm_size, MPI_Comm communicator) {
+
+        // ROOT parses the header, buffer = n, m, ew, byte offset of the first adjacency line
+        std::vector< ULONG > buffer(4, 0);
+        int success = 0;
+        if( peID == ROOT ) {
+                std::ifstream in(filename.c_str());
+                if (in) {
+                        success = 1;
+
+                        std::string line;
+                        std::getline(in,line);
+                        //skip comments
+                        while( line[0] == '%' ) {
+                                std::getline(in, line);
+                        }
+
+                        std::stringstream ss(line);
+                        ss >> buffer[0];
+                        ss >> buffer[1];
+                        ss >> buffer[2];
+
+                        std::streamoff body_begin = in.tellg();
+                        buffer[3] = body_begin < 0 ? std::numeric_limits< ULONG >::max() : body_begin;
+                }
+                in.close();
+        }
+
+        MPI_Bcast(&success, 1, MPI_INT, ROOT, communicator);
+        if( !success ) {
+                if( peID == ROOT ) std::cerr << "Error opening " << filename << std::endl;
+                return 1;
+        }
+
+        MPI_Bcast(&buffer[0], 4, MPI_UNSIGNED_LONG_LONG, ROOT, communicator);
+        NodeID nmbNodes = buffer[0];
+        EdgeID nmbEdges = buffer[1];
+        int ew          = buffer[2];
+
+        bool read_ew = ew == 1 || ew == 11;
+        bool read_nw = ew == 10 || ew == 11;
+
+        MPI_File fh;
+        MPI_File_open(communicator, (char*)filename.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+        MPI_Offset file_size;
+        MPI_File_get_size(fh, &file_size);
+
+        // every PE reads a consecutive byte range of the adjacency part of the file 
+        ULONG body_begin  = std::min(buffer[3], (ULONG)file_size);
+        ULONG chunk_size  = ceil((file_size - body_begin) / (double)comm_size);
+        ULONG chunk_begin = std::min(body_begin + peID * chunk_size, (ULONG)file_size);
+        ULONG chunk_end   = std::min(chunk_begin + chunk_size, (ULONG)file_size);
+
+        std::vector< char > chunk(chunk_end - chunk_begin);
+        read_at_all_large(fh, chunk_begin, chunk.data(), chunk.size(), communicator);
+        MPI_File_close(&fh);
+
+        // a PE owns the lines that start within its byte range 
+        // to find the first of them we need to know wether the previous range ends with a line break
+        char last_char = chunk.size() > 0 ? chunk.back() : '\n';
+        std::vector< char > last_chars(comm_size);
+        MPI_Allgather(&last_char, 1, MPI_CHAR, &last_chars[0], 1, MPI_CHAR, communicator);
+
+        ULONG line_start = file_size;
+        if( chunk.size() > 0 ) {
+                if( peID == ROOT || last_chars[peID-1] == '\n' ) {
+                        line_start = chunk_begin;
+                } else {
+                        for( ULONG i = 0; i < chunk.size(); i++) {
+                                if( chunk[i] == '\n' ) {
+                                        if( i + 1 < chunk.size() ) line_start = chunk_begin + i + 1;
+                                        break;
+                                }
+                        }
+                }
+        }
+
+        std::vector< ULONG > line_starts(comm_size);
+        MPI_Allgather(&line_start, 1, MPI_UNSIGNED_LONG_LONG, &line_starts[0], 1, MPI_UNSIGNED_LONG_LONG, communicator);
+
+        // the bytes in front of our first line belong to the last line of the closest PE that owns a line 
+        // counts and displacements are 64 bit, a PE can send more than 2^31 bytes of text to another PE
+        std::vector< ULONG > send_counts(comm_size, 0), send_displs(comm_size+1, 0);
+        std::vector< ULONG > recv_counts(comm_size, 0), recv_displs(comm_size+1, 0);
+        ULONG prefix = std::min(line_start, chunk_end) - chunk_begin;
+        if( prefix > 0 ) {
+                PEID owner = peID - 1;
+                while( owner > 0 && line_starts[owner] == (ULONG)file_size ) owner--;
+                send_counts[owner] = prefix;
+        }
+        MPI_Alltoall(&send_counts[0], 1, MPI_UNSIGNED_LONG_LONG, &recv_counts[0], 1, MPI_UNSIGNED_LONG_LONG, communicator);
+        for( PEID i = 1; i <= comm_size; i++) {
+                send_displs[i] = send_displs[i-1] + send_counts[i-1];
+                recv_displs[i] = recv_displs[i-1] + recv_counts[i-1];
+        }
+
+        ULONG own_bytes = chunk.size() - prefix;
+        std::vector< char > text(own_bytes + recv_displs[comm_size]);
+        std::copy(chunk.begin() + prefix, chunk.end(), text.begin());
+        mpi_tools::alltoallv(chunk.data(), &send_counts[0], &send_displs[0], MPI_CHAR, 
+                             text.data() + own_bytes, &recv_counts[0], &recv_displs[0], MPI_CHAR, communicator);
+        std::vector< char >().swap(chunk);
+
+        // find the adjacency lines (non comment lines) in our part of the file
+        std::vector< ULONG > line_begin;
+        std::vector< ULONG > line_end;
+        for( ULONG pos = 0; pos < text.size(); ) {
+                ULONG end = pos;
+                while( end < text.size() && text[end] != '\n' ) end++;
+                if( pos == end || text[pos] != '%' ) {
+                        line_begin.push_back(pos);
+                        line_end.push_back(end);
+                }
+                pos = end + 1;
+        }
+
+        // rebalance the lines such that PE p gets lines p*ceil(n/size) to (p+1)*ceil(n/size)-1 
+        ULONG local_lines = line_begin.size();
+        ULONG first_line  = 0;
+        MPI_Exscan(&local_lines, &first_line, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        if( peID == ROOT ) first_line = 0;
+
+        ULONG nodes_per_pe = ceil(nmbNodes / (double)comm_size);
+        std::vector< char > send_text;
+        std::fill(send_counts.begin(), send_counts.end(), 0);
+        for( ULONG i = 0; i < local_lines && first_line + i < nmbNodes; i++) {
+                PEID target_pe = (first_line + i) / nodes_per_pe;
+                send_text.insert(send_text.end(), text.begin() + line_begin[i], text.begin() + line_end[i]);
+                send_text.push_back('\n');
+                send_counts[target_pe] += line_end[i] - line_begin[i] + 1;
+        }
+        std::vector< char >().swap(text);
+
+        MPI_Alltoall(&send_counts[0], 1, MPI_UNSIGNED_LONG_LONG, &recv_counts[0], 1, MPI_UNSIGNED_LONG_LONG, communicator);
+        for( PEID i = 1; i <= comm_size; i++) {
+                send_displs[i] = send_displs[i-1] + send_counts[i-1];
+                recv_displs[i] = recv_displs[i-1] + recv_counts[i-1];
+        }
+
+        std::vector< char > local_text(recv_displs[comm_size] + 1);
+        mpi_tools::alltoallv(send_text.data(), &send_counts[0], &send_displs[0], MPI_CHAR, 
+                             &local_text[0], &recv_counts[0], &recv_displs[0], MPI_CHAR, communicator);
+        std::vector< char >().swap(send_text);
+
+        // pe p reads the lines p*ceil(n/size) to (p+1)floor(n/size) lines of that file
+        ULONG from  = peID     * nodes_per_pe;
+        ULONG to    = (peID+1) * nodes_per_pe - 1;
+        to = std::min(to, nmbNodes-1);
+
+        ULONG local_no_nodes = from < nmbNodes ? to - from + 1 : 0;
+        PRINT(std::cout <<  "peID " <<  peID <<  " from " <<  from <<  " to " <<  to  <<  " amount " <<  local_no_nodes << std::endl;);
+
+        // parse the adjacency lines
+        std::vector< NodeWeight > local_node_weights(local_no_nodes, 1);
+        std::vector< EdgeID >     local_edge_starts(local_no_nodes+1, 0);
+        std::vector< NodeID >     local_edge_targets;
+        std::vector< EdgeWeight > local_edge_weights;
+
+        const char * pos = local_text.data();
+        const char * end = local_text.data() + local_text.size() - 1;
+        for( NodeID i = 0; i < local_no_nodes; i++) {
+                const char * line_end = std::find(pos, end, '\n');
+
+                ULONG value = 0;
+                if( read_nw && next_number(pos, line_end, value) ) {
+                        local_node_weights[i] = value;
+                }
+
+                while( next_number(pos, line_end, value) ) {
+                        local_edge_targets.push_back(value-1); // -1 since there are no nodes with id 0 in the file
+
+                        EdgeWeight edge_weight = 1;
+                        if( read_ew ) next_number(pos, line_end, edge_weight);
+                        local_edge_weights.push_back(edge_weight);
+                }
+                local_edge_starts[i+1] = local_edge_targets.size();
+                pos = std::min(line_end + 1, end);
+        }
+        std::vector< char >().swap(local_text);
+
+        G.start_construction(local_no_nodes, local_edge_targets.size(), nmbNodes, 2*nmbEdges);
+        G.set_range(from, to);
+
+        std::vector< NodeID > vertex_dist( comm_size+1, 0 );
+        for( PEID peID = 0; peID <= comm_size; peID++) {
+                vertex_dist[peID] = peID * nodes_per_pe; // from positions
+        }
+        G.set_range_array(vertex_dist);
+
+        for (NodeID i = 0; i < local_no_nodes; ++i) {
+                NodeID node = G.new_node();
+                G.setNodeWeight(node, local_node_weights[i]);
+                G.setNodeLabel(node, from+node);
+                G.setSecondPartitionIndex(node, 0);
+
+                for( EdgeID j = local_edge_starts[i]; j < local_edge_starts[i+1]; j++) {
+                        EdgeID e = G.new_edge(node, local_edge_targets[j]);
+                        G.setEdgeWeight(e, local_edge_weights[j]);
+                }
+        }
+
+        G.finish_construction();
+        MPI_Barrier(communicator);
+
+        return 0;
+}
+
 //int parallel_graph_io::readGraphWeightedMETISFast(parallel_graph_access & G, 
                                          //std::string filename, 
                                          //PEID peID, PEID comm_size, MPI_Comm communicator) {
@@ -558,6 +804,10 @@ int parallel_graph_io::readGraphBinary(PPartitionConfig & config, parallel_graph
         NodeID m     = buffer[2];
 
         if(peID == ROOT) std::cout <<  "version: " <<  version <<  " n: "<<  n <<  " m: " <<  m  << std::endl;
+        if( version == fileTypeVersionNumberCompressed ) {
+                return readGraphBinaryCompressed(config, G, filename, peID, size, communicator);
+        }
+
         if( version != fileTypeVersionNumber ) {
                 if(peID == ROOT) std::cout <<  "filetype version missmatch"  << std::endl;
                 MPI_Finalize(); exit(0);
@@ -631,6 +881,265 @@ int parallel_graph_io::readGraphBinary(PPartitionConfig & config, parallel_graph
         return 0;
 }
 
+int parallel_graph_io::writeGraphSequentiallyBinaryCompressed(complete_graph_access & G, std::string filename) {
+
+        std::ofstream outfile;
+        outfile.open(filename.c_str(), std::ios::binary | std::ios::out);
+        PEID size; MPI_Comm_size( MPI_COMM_WORLD, &size);
+        
+        if( size > 1 ) {
+                std::cout <<  "currently only one process supported."  << std::endl;
+                return 0;
+        }
+
+        std::cout <<  "Writing compressed graph " << filename  << std::endl;
+        printf("Writing graph with n = %lld, m = %lld\n", G.number_of_global_nodes(), G.number_of_global_edges());
+
+        NodeID n          = G.number_of_global_nodes();
+        NodeID m          = G.number_of_global_edges();
+        ULONG  block_size = compressed_block_size;
+        ULONG  num_blocks = (n + block_size - 1) / block_size;
+
+        outfile.write((char*)(&fileTypeVersionNumberCompressed), sizeof( ULONG ));
+        outfile.write((char*)(&n), sizeof( ULONG ));
+        outfile.write((char*)(&m), sizeof( ULONG ));
+        outfile.write((char*)(&block_size), sizeof( ULONG ));
+
+        std::vector< ULONG > block_offsets(num_blocks+1, 0);
+        ULONG offset = (header_count_compressed + num_blocks + 1) * (sizeof(ULONG));
+        outfile.seekp(offset);
+
+        std::vector< NodeID > targets;
+        std::vector< unsigned char > block;
+        for( ULONG b = 0; b < num_blocks; b++) {
+                block_offsets[b] = offset;
+                block.clear();
+
+                NodeID last_node = std::min(n, (b+1)*block_size);
+                for( NodeID node = b*block_size; node < last_node; node++) {
+                        targets.clear();
+                        forall_out_edges(G, e, node) {
+                                targets.push_back(G.getEdgeTarget(e));
+                        } endfor
+                        std::sort(targets.begin(), targets.end());
+                        encode_adjacency(node, targets.data(), targets.size(), block);
+                }
+
+                outfile.write((char*)(block.data()), block.size());
+                offset += block.size();
+        }
+        block_offsets[num_blocks] = offset;
+
+        outfile.seekp(header_count_compressed * sizeof(ULONG));
+        outfile.write((char*)(&block_offsets[0]), (num_blocks+1)*sizeof(ULONG));
+        outfile.close();
+
+        return 0;
+}
+
+int parallel_graph_io::writeGraphExternallyBinaryCompressed(std::string input_filename, std::string output_filename) {
+
+        std::string line;
+
+        // open file for reading
+        std::ifstream in(input_filename.c_str());
+        if (!in) {
+                std::cerr << "Error opening " << input_filename << std::endl;
+                return 1;
+        }
+
+        NodeID n;
+        EdgeID m;
+
+        std::getline(in,line);
+        //skip comments
+        while( line[0] == '%' ) {
+                std::getline(in, line);
+        }
+
+        int ew = 0;
+        std::stringstream ss(line);
+        ss >> n;
+        ss >> m;
+        ss >> ew;
+
+        m *= 2;
+
+        ULONG block_size = compressed_block_size;
+        ULONG num_blocks = (n + block_size - 1) / block_size;
+
+        std::ofstream outfile;
+        outfile.open(output_filename.c_str(), std::ios::binary | std::ios::out);
+        outfile.write((char*)(&fileTypeVersionNumberCompressed), sizeof( ULONG ));
+        outfile.write((char*)(&n), sizeof( ULONG ));
+        outfile.write((char*)(&m), sizeof( ULONG ));
+        outfile.write((char*)(&block_size), sizeof( ULONG ));
+
+        // the block offsets are written once all blocks are known, a single pass over the input suffices
+        std::vector< ULONG > block_offsets(num_blocks+1, 0);
+        ULONG offset = (header_count_compressed + num_blocks + 1) * (sizeof(ULONG));
+        outfile.seekp(offset);
+
+        std::vector< NodeID > targets;
+        std::vector< unsigned char > block;
+        NodeID node = 0;
+        while( node < n && std::getline(in, line) ) {
+                if (line[0] == '%') { // a comment in the file
+                        continue;
+                }
+
+                if( node % block_size == 0 ) {
+                        outfile.write((char*)(block.data()), block.size());
+                        offset += block.size();
+                        block.clear();
+                        block_offsets[node / block_size] = offset;
+                }
+
+                targets.clear();
+                std::stringstream ss(line);
+                NodeID target;
+                while( ss >> target ) {
+                        targets.push_back(target-1);
+                }
+                std::sort(targets.begin(), targets.end());
+                encode_adjacency(node, targets.data(), targets.size(), block);
+                node++;
+        }
+        in.close();
+
+        // missing lines at the end of the file are isolated nodes
+        for( ; node < n; node++) {
+                if( node % block_size == 0 ) {
+                        outfile.write((char*)(block.data()), block.size());
+                        offset += block.size();
+                        block.clear();
+                        block_offsets[node / block_size] = offset;
+                }
+                encode_adjacency(node, NULL, 0, block);
+        }
+
+        outfile.write((char*)(block.data()), block.size());
+        offset += block.size();
+        block_offsets[num_blocks] = offset;
+
+        outfile.seekp(header_count_compressed * sizeof(ULONG));
+        outfile.write((char*)(&block_offsets[0]), (num_blocks+1)*sizeof(ULONG));
+        outfile.close();
+        
+        return 0;
+}
+
+int parallel_graph_io::readGraphBinaryCompressed(PPartitionConfig & config, parallel_graph_access & G, 
+                                                 std::string filename, 
+                                                 PEID peID, PEID size, MPI_Comm communicator) { 
+
+        // read header
+        std::vector< ULONG > buffer(header_count_compressed, 0);
+        int success = 0;
+        if( peID == ROOT) {
+                std::ifstream file;
+                file.open(filename.c_str(), std::ios::binary | std::ios::in);
+                if(file) {
+                        success = 1;
+                        file.read((char*)(&buffer[0]), header_count_compressed*sizeof(ULONG));
+                }
+                file.close();
+        }
+
+        MPI_Bcast(&success, 1, MPI_INT, ROOT, communicator);
+
+        if( !success ) {
+                if( peID == ROOT ) std::cout <<  "problem to open the file"  << std::endl;
+                MPI_Finalize();
+                exit(0);
+        }
+
+        MPI_Bcast(&buffer[0], header_count_compressed, MPI_UNSIGNED_LONG_LONG, ROOT, communicator);
+        ULONG version    = buffer[0];
+        NodeID n         = buffer[1];
+        NodeID m         = buffer[2];
+        ULONG block_size = buffer[3];
+
+        if( version != fileTypeVersionNumberCompressed ) {
+                if(peID == ROOT) std::cout <<  "filetype version missmatch"  << std::endl;
+                MPI_Finalize(); exit(0);
+        }
+
+        PEID window_size = std::min(config.binary_io_window_size, size);
+        PEID lowPE = 0;
+        PEID highPE = window_size;
+
+        while ( lowPE < size ) {
+                if( peID >= lowPE && peID < highPE ) {
+                        std::ifstream file;
+                        file.open(filename.c_str(), std::ios::binary | std::ios::in);
+
+                        ULONG from = peID * ceil(n / (double)size);
+                        ULONG to   = (peID +1) * ceil(n / (double)size) - 1;
+                        to = std::min(to, n-1);
+
+                        ULONG local_no_nodes = from < n ? to - from + 1 : 0;
+                        PRINT(std::cout <<  "peID " <<  peID <<  " from " <<  from <<  " to " <<  to  <<  " amount " <<  local_no_nodes << std::endl;);
+
+                        // read the offsets of the blocks that contain our range and then the blocks themselves
+                        std::vector< NodeID > targets;
+                        std::vector< EdgeID > degrees(local_no_nodes, 0);
+                        if( local_no_nodes > 0 ) {
+                                ULONG first_block = from / block_size;
+                                ULONG last_block  = to / block_size;
+
+                                std::vector< ULONG > block_offsets(last_block - first_block + 2);
+                                file.seekg((header_count_compressed + first_block)*sizeof(ULONG));
+                                file.read((char*)(&block_offsets[0]), block_offsets.size()*sizeof(ULONG));
+
+                                std::vector< unsigned char > blocks(block_offsets.back() - block_offsets[0] + 1);
+                                file.seekg(block_offsets[0]);
+                                file.read((char*)(&blocks[0]), blocks.size()-1);
+
+                                const unsigned char * pos = &blocks[0];
+                                for( NodeID node = first_block * block_size; node <= to; node++) {
+                                        if( node < from ) {
+                                                decode_adjacency(node, pos, targets);
+                                                targets.clear();
+                                        } else {
+                                                degrees[node-from] = decode_adjacency(node, pos, targets);
+                                        }
+                                }
+                        }
+
+                        G.start_construction(local_no_nodes, targets.size(), n, m);
+                        G.set_range(from, to);
+
+                        std::vector< NodeID > vertex_dist( size+1, 0 );
+                        for( PEID peID = 0; peID <= size; peID++) {
+                                vertex_dist[peID] = peID * ceil(n / (double)size); // from positions
+                        }
+                        G.set_range_array(vertex_dist);
+
+                        ULONG pos = 0;
+                        for (NodeID i = 0; i < local_no_nodes; ++i) {
+                                NodeID node = G.new_node();
+                                G.setNodeWeight(node, 1);
+                                G.setNodeLabel(node, from+node);
+                                G.setSecondPartitionIndex(node, 0);
+
+                                for( ULONG j = 0; j < degrees[i]; j++, pos++) {
+                                        EdgeID e = G.new_edge(node, targets[pos]);
+                                        G.setEdgeWeight(e, 1);
+                                }
+                        }
+
+                        G.finish_construction();
+                        file.close();
+                }
+                lowPE  += window_size;
+                highPE += window_size;
+                MPI_Barrier(communicator);
+        }
+        
+        return 0;
+}
+
 int parallel_graph_io::writeGraphParallelSimple(parallel_graph_access & G, 
                                                 std::string filename, MPI_Comm communicator) {
         PEID rank, size;
@@ -33,6 +33,9 @@ class parallel_graph_io {
 
                 static int readGraphWeightedFlexible(parallel_graph_access & G, std::string filename, PEID peID, PEID comm_size, MPI_Comm communicator = MPI_COMM_WORLD); 
 
+                // collective reader for METIS text files, every PE reads a byte range of the file 
+                static int readGraphWeightedMPIIO(parallel_graph_access & G, std::string filename, PEID peID, PEID comm_size, MPI_Comm communicator = MPI_COMM_WORLD); 
+
                 //static int readGraphWeightedMETISFast(parallel_graph_access & G, 
                                 //std::string filename, 
                                 //PEID peID, 
@@ -62,6 +65,16 @@ class parallel_graph_io {
 
                 static int writeGraphExternallyBinary(std::string intput_filename, std::string output_filename);
 
+                // compressed binary format: varint gap encoded adjacency lists and a block offset index 
+                static int readGraphBinaryCompressed(PPartitionConfig & config, parallel_graph_access & G, 
+                                std::string filename, 
+                                PEID peID, 
+                                PEID comm_size, MPI_Comm communicator = MPI_COMM_WORLD);
+
+                static int writeGraphSequentiallyBinaryCompressed(complete_graph_access & G, std::string filename);
+
+                static int writeGraphExternallyBinaryCompressed(std::string intput_filename, std::string output_filename);
+
                 static int readGraphWeightedMETIS_fixed(parallel_graph_access & G, std::string filename, PEID peID, PEID comm_size, MPI_Comm communicator = MPI_COMM_WORLD); 
 
 
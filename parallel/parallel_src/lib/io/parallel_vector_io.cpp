@@ -185,7 +185,7 @@ void parallel_vector_io::writePartitionSimpleParallel(parallel_graph_access & G,
 
                 forall_local_nodes(G, node) {
                         f <<  G.getNodeLabel(node) ;
-                        f <<  std::endl;
+                        f <<  "\n";
                 } endfor
 
                 f.close();
@@ -199,7 +199,7 @@ void parallel_vector_io::writePartitionSimpleParallel(parallel_graph_access & G,
                         f.open(filename.c_str(), std::ofstream::out | std::ofstream::app);
                         forall_local_nodes(G, node) {
                                 f <<  G.getNodeLabel(node) ;
-                                f <<  std::endl;
+                                f <<  "\n";
                         } endfor
                         f.close();
                 }
@@ -207,6 +207,83 @@ void parallel_vector_io::writePartitionSimpleParallel(parallel_graph_access & G,
         MPI_Barrier(MPI_COMM_WORLD);
         
 }
+// writes count bytes starting at offset, the call is collective on the communicator
+// (PEs that have nothing to write participate with count = 0)
+static void write_at_all_large( MPI_File & fh, ULONG offset, const char * buffer, ULONG count, MPI_Comm communicator) {
+        const ULONG max_write = std::numeric_limits< int >::max();
+        ULONG rounds = (count + max_write - 1) / max_write;
+        ULONG max_rounds = 0;
+        MPI_Allreduce(&rounds, &max_rounds, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, communicator);
+
+        for( ULONG round = 0; round < max_rounds; round++) {
+                ULONG pos   = std::min(round * max_write, count);
+                int   bytes = std::min(max_write, count - pos);
+
+                MPI_Status st;
+                MPI_File_write_at_all(fh, offset + pos, (void*)(buffer + pos), bytes, MPI_CHAR, &st);
+        }
+}
+
+void parallel_vector_io::writePartitionSimpleParallelMPIIO(parallel_graph_access & G, 
+                                                           std::string filename, MPI_Comm communicator) {
+        // format the labels of the local nodes, one label per line
+        std::vector< char > buffer;
+        buffer.reserve(4*G.number_of_local_nodes());
+        char digits[24];
+        forall_local_nodes(G, node) {
+                ULONG label = G.getNodeLabel(node);
+                int length  = 0;
+                do {
+                        digits[length++] = '0' + label % 10;
+                        label /= 10;
+                } while( label > 0 );
+
+                while( length > 0 ) buffer.push_back(digits[--length]);
+                buffer.push_back('\n');
+        } endfor
+
+        ULONG local_bytes = buffer.size();
+        ULONG offset      = 0;
+        ULONG total_bytes = 0;
+        MPI_Exscan(&local_bytes, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+        MPI_Allreduce(&local_bytes, &total_bytes, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator);
+
+        PEID rank;
+        MPI_Comm_rank( communicator, &rank);
+        if( rank == ROOT ) offset = 0;
+
+        MPI_File fh;
+        MPI_File_open(communicator, (char*)filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+        MPI_File_set_size(fh, total_bytes);
+        write_at_all_large(fh, offset, buffer.data(), local_bytes, communicator);
+        MPI_File_close(&fh);
+}
+
+void parallel_vector_io::writePartitionBinaryParallelMPIIO(parallel_graph_access & G, 
+                                                           std::string filename, MPI_Comm communicator) {
+        PEID rank;
+        MPI_Comm_rank( communicator, &rank);
+
+        std::vector< ULONG > partition_ids;
+        if( rank == ROOT ) {
+                // ROOT writes the head in front of its labels
+                partition_ids.push_back(fileTypeVersionNumberPartition);
+                partition_ids.push_back(G.number_of_global_nodes());
+        }
+        forall_local_nodes(G, node) {
+                partition_ids.push_back(G.getNodeLabel(node));
+        } endfor
+
+        ULONG offset = rank == ROOT ? 0 : (header_count_partition + G.get_from_range())*(sizeof(ULONG));
+        ULONG total_bytes = (header_count_partition + G.number_of_global_nodes())*(sizeof(ULONG));
+
+        MPI_File fh;
+        MPI_File_open(communicator, (char*)filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+        MPI_File_set_size(fh, total_bytes);
+        write_at_all_large(fh, offset, (char*)partition_ids.data(), partition_ids.size()*sizeof(ULONG), communicator);
+        MPI_File_close(&fh);
+}
+
 void parallel_vector_io::readPartition(PPartitionConfig & config, parallel_graph_access & G, 
                                        std::string filename) {
         std::string text_ending(".txtp");
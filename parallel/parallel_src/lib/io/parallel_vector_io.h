@@ -35,6 +35,10 @@ public:
 
         void writePartitionSimpleParallel(parallel_graph_access & G, std::string filename);
 
+        // collective MPI-IO writers, every PE formats its labels locally and writes them with a single call
+        void writePartitionSimpleParallelMPIIO(parallel_graph_access & G, std::string filename, MPI_Comm communicator = MPI_COMM_WORLD);
+        void writePartitionBinaryParallelMPIIO(parallel_graph_access & G, std::string filename, MPI_Comm communicator = MPI_COMM_WORLD);
+
         void writePartitionBinaryParallel(PPartitionConfig & config, parallel_graph_access & G, std::string filename);
         void writePartitionBinaryParallelPosix(PPartitionConfig & config, parallel_graph_access & G, std::string filename);
 
@@ -49,7 +53,7 @@ template<typename vectortype>
 void parallel_vector_io::writeVectorSequentially(std::vector<vectortype> & vec, std::string filename) {
         std::ofstream f(filename.c_str());
         for( ULONG i = 0; i < vec.size(); ++i) {
-                f << vec[i] <<  std::endl;
+                f << vec[i] <<  "\n";
         }
 
         f.close();
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * varint_coding.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef VARINT_CODING_4KQ2ZT7P
+#define VARINT_CODING_4KQ2ZT7P
+
+#include <vector>
+
+#include "definitions.h"
+
+// LEB128 style variable length integers: 7 bits per byte, the high bit marks that more bytes follow
+inline void varint_encode( ULONG value, std::vector< unsigned char > & out ) {
+        while( value >= 0x80 ) {
+                out.push_back((unsigned char)(value | 0x80));
+                value >>= 7;
+        }
+        out.push_back((unsigned char)value);
+}
+
+inline ULONG varint_decode( const unsigned char * & pos ) {
+        // most gaps in a sorted adjacency list fit into a single byte
+        ULONG value = *pos++;
+        if( value < 0x80 ) return value;
+
+        value &= 0x7f;
+        unsigned shift = 7;
+        while( true ) {
+                ULONG byte = *pos++;
+                value |= (byte & 0x7f) << shift;
+                if( byte < 0x80 ) return value;
+                shift += 7;
+        }
+}
+
+// maps signed differences to unsigned values such that small magnitudes stay small
+inline ULONG zigzag_encode( long long value ) {
+        return ((ULONG)value << 1) ^ (ULONG)(value >> 63);
+}
+
+inline long long zigzag_decode( ULONG value ) {
+        return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+// encodes the adjacency list of node, the targets have to be sorted in ascending order
+// layout: degree, zigzag(first target - node), gaps between consecutive targets
+inline void encode_adjacency( NodeID node, const NodeID * targets, EdgeID degree, std::vector< unsigned char > & out ) {
+        varint_encode(degree, out);
+        if( degree == 0 ) return;
+
+        varint_encode(zigzag_encode((long long)targets[0] - (long long)node), out);
+        for( EdgeID i = 1; i < degree; i++) {
+                varint_encode(targets[i] - targets[i-1], out);
+        }
+}
+
+// decodes an adjacency list written by encode_adjacency, returns the degree
+inline EdgeID decode_adjacency( NodeID node, const unsigned char * & pos, std::vector< NodeID > & targets ) {
+        EdgeID degree = varint_decode(pos);
+        if( degree == 0 ) return 0;
+
+        NodeID target = (NodeID)((long long)node + zigzag_decode(varint_decode(pos)));
+        targets.push_back(target);
+        for( EdgeID i = 1; i < degree; i++) {
+                target += varint_decode(pos);
+                targets.push_back(target);
+        }
+        return degree;
+}
+
+#endif /* end of include guard: VARINT_CODING_4KQ2ZT7P */
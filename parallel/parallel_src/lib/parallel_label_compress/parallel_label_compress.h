@@ -11,6 +11,7 @@
 #include "data_structure/parallel_graph_access.h"
 #include "partition_config.h"
 #include "tools/random_functions.h"
+#include "tools/trace.h"
 #include "hmap_wrapper.h"
 #include "node_ordering.h"
 
@@ -40,6 +41,7 @@ class parallel_label_compress {
                         hash_map.init( G.get_max_degree() );
                         for( ULONG i = 0; i < config.label_iterations; i++) {
                                 NodeID prev_node = 0;
+                                NodeID moved     = 0;
                                 forall_local_nodes(G, rnode) {
                                         NodeID node = permutation[rnode]; // use the current random node
 
@@ -92,6 +94,7 @@ class parallel_label_compress {
 
                                         if( old_block != max_block ) {
                                                 G.setNodeLabel(node, max_block);
+                                                moved++;
 
                                                 G.setBlockSize(old_block, G.getBlockSize(old_block) - node_weight);
                                                 G.setBlockSize(max_block, G.getBlockSize(max_block) + node_weight);
@@ -103,6 +106,7 @@ class parallel_label_compress {
 
                                 } endfor
                                 G.update_ghost_node_data_finish(); 
+                                trace::count(TRACE_NODES_MOVED, moved);
                         }
                 }
 
@@ -22,9 +22,9 @@ struct PPartitionConfig
 
         long edge_factor;
 
-        bool generate_rgg;
-
-        bool generate_ba;
+        // generate the graph instead of reading it (grid2d, grid3d, rgg2d, rgg3d, rmat, ba, rhg)
+        // with 2^log_num_verts nodes and edge_factor * 2^log_num_verts edges
+        std::string generator;
 
         //=======================================
         //============ Communication ============
@@ -78,6 +78,8 @@ struct PPartitionConfig
 
         InitialPartitioningAlgorithm initial_partitioning_algorithm;
 
+        int initial_partitioning_pes; // PEs that hold a copy of the coarsest graph, 0 = all
+
         int stop_factor;
 
         bool vcycle;
@@ -116,8 +118,12 @@ struct PPartitionConfig
 
         bool vertex_degree_weights;
 
+        bool compact_input_graph;
+
         bool converter_evaluate;
 
+        std::string trace_filename;
+
         //=======================================
         //===============Shared Mem OMP==========
         //=======================================
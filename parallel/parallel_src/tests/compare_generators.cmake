@@ -0,0 +1,20 @@
+# generates the graph GENERATOR with generator_dump (SEQUENTIAL) and with
+# parallel_generator_dump (PARALLEL) on two PEs and compares the written files
+set(parameters ${GENERATOR} 3000 8 5)
+set(sequential_file ${CMAKE_CURRENT_BINARY_DIR}/${GENERATOR}_sequential.graph)
+set(parallel_file ${CMAKE_CURRENT_BINARY_DIR}/${GENERATOR}_parallel.graph)
+
+execute_process(COMMAND ${SEQUENTIAL} ${parameters} ${sequential_file} RESULT_VARIABLE result)
+if(result)
+  message(FATAL_ERROR "generator_dump failed: ${result}")
+endif()
+
+execute_process(COMMAND ${MPIEXEC} ${MPIEXEC_NUMPROC_FLAG} 2 ${PARALLEL} ${parameters} ${parallel_file} RESULT_VARIABLE result)
+if(result)
+  message(FATAL_ERROR "parallel_generator_dump failed: ${result}")
+endif()
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${sequential_file} ${parallel_file} RESULT_VARIABLE result)
+if(result)
+  message(FATAL_ERROR "${GENERATOR}: the graphs of graph_generator and parallel_graph_generator differ")
+endif()
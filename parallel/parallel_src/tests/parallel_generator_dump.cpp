@@ -0,0 +1,69 @@
+/******************************************************************************
+ * parallel_generator_dump.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <mpi.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "data_structure/parallel_graph_access.h"
+#include "io/parallel_graph_generator.h"
+
+// writes the graph of parallel_graph_generator in the format of generator_dump in
+// KaHIP, i.e. with global ids and sorted adjacency lists, the PEs append their nodes in turn
+int main(int argn, char **argv) {
+        MPI_Init(&argn, &argv);
+        if( argn != 6 ) {
+                std::cout <<  "Usage: parallel_generator_dump TYPE NODES AVG_DEGREE SEED FILE"  << std::endl;
+                MPI_Finalize();
+                return 1;
+        }
+
+        MPI_Comm communicator = MPI_COMM_WORLD;
+        PEID rank, size;
+        MPI_Comm_rank( communicator, &rank);
+        MPI_Comm_size( communicator, &size);
+
+        parallel_graph_access G(communicator);
+        if( !parallel_graph_generator::generate(G, argv[1], atoi(argv[2]), atof(argv[3]), atoi(argv[4]), communicator) ) {
+                if( rank == ROOT ) std::cerr <<  "unknown generator " << argv[1]  << std::endl;
+                MPI_Finalize();
+                return 1;
+        }
+
+        std::vector< NodeID > targets;
+        for( PEID pe = 0; pe < size; pe++) {
+                if( rank == pe ) {
+                        std::ofstream f;
+                        if( rank == ROOT ) {
+                                f.open(argv[5]);
+                                f << G.number_of_global_nodes() <<  " " <<  G.number_of_global_edges()/2 << std::endl;
+                        } else {
+                                f.open(argv[5], std::ofstream::out | std::ofstream::app);
+                        }
+
+                        forall_local_nodes(G, node) {
+                                targets.clear();
+                                forall_out_edges(G, e, node) {
+                                        targets.push_back(G.getGlobalID(G.getEdgeTarget(e)));
+                                } endfor
+                                std::sort(targets.begin(), targets.end());
+
+                                for( NodeID target : targets ) {
+                                        f << " " << (target + 1);
+                                }
+                                f << "\n";
+                        } endfor
+                }
+                MPI_Barrier(communicator);
+        }
+
+        MPI_Finalize();
+        return 0;
+}
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * varint_coding_test.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "io/varint_coding.h"
+
+// round trips of the varints and adjacency lists of the compressed binary graph format
+
+static int failures = 0;
+
+static void check(bool condition, const char * what) {
+        if( !condition ) {
+                std::cout <<  "failed: " << what  << std::endl;
+                failures++;
+        }
+}
+
+static void check_varint(ULONG value, std::size_t expected_bytes) {
+        std::vector< unsigned char > bytes;
+        varint_encode(value, bytes);
+        check(bytes.size() == expected_bytes, "varint length");
+
+        const unsigned char * pos = bytes.data();
+        check(varint_decode(pos) == value, "varint round trip");
+        check(pos == bytes.data() + bytes.size(), "varint decode consumes all bytes");
+}
+
+static void check_adjacency(NodeID node, const std::vector< NodeID > & targets) {
+        std::vector< unsigned char > bytes;
+        encode_adjacency(node, targets.data(), targets.size(), bytes);
+
+        std::vector< NodeID > decoded;
+        const unsigned char * pos = bytes.data();
+        check(decode_adjacency(node, pos, decoded) == targets.size(), "adjacency degree");
+        check(decoded == targets, "adjacency round trip");
+        check(pos == bytes.data() + bytes.size(), "adjacency decode consumes all bytes");
+}
+
+int main(int argn, char **argv) {
+        // the length changes at every multiple of 7 bits
+        check_varint(0, 1);
+        check_varint(1, 1);
+        check_varint(0x7f, 1);
+        check_varint(0x80, 2);
+        check_varint(0x3fff, 2);
+        check_varint(0x4000, 3);
+        check_varint((1ULL << 32) - 1, 5);
+        check_varint(1ULL << 32, 5);
+        check_varint((1ULL << 63) - 1, 9);
+        check_varint(std::numeric_limits<ULONG>::max(), 10);
+
+        long long signed_values[] = { 0, 1, -1, 63, -64, 64, -65,
+                                      std::numeric_limits<long long>::max(),
+                                      std::numeric_limits<long long>::min() };
+        for( long long value : signed_values ) {
+                check(zigzag_decode(zigzag_encode(value)) == value, "zigzag round trip");
+        }
+        check(zigzag_encode(-1) == 1 && zigzag_encode(1) == 2, "zigzag keeps small magnitudes small");
+
+        // empty lists, first targets before and after the node and large gaps
+        const NodeID large_node = 1ULL << 40;
+        check_adjacency(5, std::vector< NodeID >());
+        check_adjacency(5, std::vector< NodeID >{0});
+        check_adjacency(5, std::vector< NodeID >{6});
+        check_adjacency(1000, std::vector< NodeID >{0, 1, 2, 999, 1001, 1000000});
+        check_adjacency(0, std::vector< NodeID >{large_node - 1, large_node});
+        check_adjacency(large_node, std::vector< NodeID >{0, large_node - 1});
+
+        // several lists in one buffer are decoded one after the other
+        std::vector< unsigned char > bytes;
+        std::vector< std::vector< NodeID > > lists = { {1, 2}, {}, {0, 3, 300}, {2} };
+        for( NodeID node = 0; node < lists.size(); node++) {
+                encode_adjacency(node, lists[node].data(), lists[node].size(), bytes);
+        }
+        const unsigned char * pos = bytes.data();
+        for( NodeID node = 0; node < lists.size(); node++) {
+                std::vector< NodeID > decoded;
+                decode_adjacency(node, pos, decoded);
+                check(decoded == lists[node], "consecutive adjacency lists");
+        }
+        check(pos == bytes.data() + bytes.size(), "consecutive lists consume all bytes");
+
+        return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+/******************************************************************************
+ * generator_dump.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdlib.h>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "graph_generator.h"
+
+// writes the graph of graph_generator with sorted adjacency lists, one line per node.
+// parallel_generator_dump in ParHIP writes the graph of parallel_graph_generator in
+// the same format, the files have to be equal for the same parameters
+int main(int argn, char **argv) {
+        if( argn != 6 ) {
+                std::cout <<  "Usage: generator_dump TYPE NODES AVG_DEGREE SEED FILE"  << std::endl;
+                return 1;
+        }
+
+        graph_access G;
+        if( !graph_generator::generate(G, argv[1], atoi(argv[2]), atof(argv[3]), atoi(argv[4])) ) {
+                std::cerr <<  "unknown generator " << argv[1]  << std::endl;
+                return 1;
+        }
+
+        std::ofstream f(argv[5]);
+        f << G.number_of_nodes() <<  " " <<  G.number_of_edges()/2 << std::endl;
+
+        std::vector< NodeID > targets;
+        forall_nodes(G, node) {
+                targets.clear();
+                forall_out_edges(G, e, node) {
+                        targets.push_back(G.getEdgeTarget(e));
+                } endfor
+                std::sort(targets.begin(), targets.end());
+
+                for( NodeID target : targets ) {
+                        f << " " << (target + 1);
+                }
+                f << "\n";
+        } endfor
+
+        return 0;
+}
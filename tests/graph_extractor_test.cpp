@@ -0,0 +1,96 @@
+/******************************************************************************
+ * graph_extractor_test.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "graph_generator.h"
+#include "random_functions.h"
+#include "tools/graph_extractor.h"
+
+// extract_all_blocks has to build the same subgraphs and mappings as extract_block,
+// independent of the number of threads
+
+static bool same_graph(graph_access & lhs, graph_access & rhs) {
+        if( lhs.number_of_nodes() != rhs.number_of_nodes() || lhs.number_of_edges() != rhs.number_of_edges() ) {
+                return false;
+        }
+
+        forall_nodes(lhs, node) {
+                if( lhs.getNodeWeight(node) != rhs.getNodeWeight(node) ) return false;
+                if( lhs.get_first_edge(node) != rhs.get_first_edge(node) ) return false;
+                if( lhs.get_first_invalid_edge(node) != rhs.get_first_invalid_edge(node) ) return false;
+        } endfor
+
+        forall_edges(lhs, e) {
+                if( lhs.getEdgeTarget(e) != rhs.getEdgeTarget(e) ) return false;
+                if( lhs.getEdgeWeight(e) != rhs.getEdgeWeight(e) ) return false;
+        } endfor
+
+        return true;
+}
+
+int main(int argn, char **argv) {
+        graph_access G;
+        graph_generator::generate(G, "rgg2d", 1 << 13, 8, 1);
+
+        // weights and blocks that are not uniform, the last block stays empty
+        const PartitionID k = 6;
+        random_functions::setSeed(1);
+        G.set_partition_count(k);
+        forall_nodes(G, node) {
+                G.setNodeWeight(node, 1 + node % 7);
+                G.setPartitionIndex(node, random_functions::nextInt(0, k - 2));
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        G.setEdgeWeight(e, 1 + (node + target) % 5);
+                } endfor
+        } endfor
+
+        std::vector< graph_access* > expected(k);
+        std::vector< std::vector< NodeID > > expected_mappings(k);
+        graph_extractor extractor;
+        for( PartitionID block = 0; block < k; block++) {
+                expected[block] = new graph_access();
+                extractor.extract_block(G, *expected[block], block, expected_mappings[block]);
+        }
+
+        int failures = 0;
+        int thread_counts[] = {1, 4};
+        for( int num_threads : thread_counts ) {
+                std::vector< graph_access* > extracted_blocks;
+                std::vector< std::vector< NodeID > > mappings;
+                extractor.extract_all_blocks(G, extracted_blocks, mappings, num_threads);
+
+                if( extracted_blocks.size() != k || mappings.size() != k ) {
+                        std::cout <<  "extract_all_blocks with " << num_threads << " threads returned "
+                                  <<  extracted_blocks.size() << " blocks instead of " << k  << std::endl;
+                        return 1;
+                }
+
+                for( PartitionID block = 0; block < k; block++) {
+                        if( !same_graph(*expected[block], *extracted_blocks[block]) ) {
+                                std::cout <<  "block " << block << " differs from extract_block with "
+                                          <<  num_threads << " threads"  << std::endl;
+                                failures++;
+                        }
+                        if( mappings[block] != expected_mappings[block] ) {
+                                std::cout <<  "mapping of block " << block << " differs from extract_block with "
+                                          <<  num_threads << " threads"  << std::endl;
+                                failures++;
+                        }
+                        delete extracted_blocks[block];
+                }
+        }
+
+        for( PartitionID block = 0; block < k; block++) {
+                delete expected[block];
+        }
+
+        return failures == 0 ? 0 : 1;
+}
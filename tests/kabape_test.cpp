@@ -0,0 +1,94 @@
+/******************************************************************************
+ * kabape_test.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <iostream>
+#include <math.h>
+#include <omp.h>
+#include <vector>
+
+#include "balance_configuration.h"
+#include "configuration.h"
+#include "data_structure/graph_access.h"
+#include "graph_generator.h"
+#include "partition/graph_partitioner.h"
+#include "partition/partition_config.h"
+#include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
+#include "random_functions.h"
+
+// the pairwise local searches of KaBaPE run concurrently with --enable_omp, the
+// result must not depend on the number of threads
+
+static void refine(PartitionConfig config, graph_access & G, const std::vector< PartitionID > & start,
+                   int num_threads, std::vector< PartitionID > & result) {
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, start[node]);
+        } endfor
+
+        omp_set_num_threads(num_threads);
+        srand(config.seed);
+        random_functions::setSeed(config.seed);
+
+        complete_boundary boundary(&G);
+        boundary.build();
+
+        cycle_refinement cr;
+        cr.perform_refinement(config, G, boundary);
+
+        result.resize(G.number_of_nodes());
+        forall_nodes(G, node) {
+                result[node] = G.getPartitionIndex(node);
+        } endfor
+}
+
+int main(int argn, char **argv) {
+        PartitionConfig config;
+        configuration cfg;
+        cfg.standard(config);
+        cfg.eco(config);
+        config.k         = 8;
+        config.seed      = 2;
+        config.imbalance = 1;
+
+        graph_access G;
+        graph_generator::generate(G, "rgg2d", 1 << 13, 8, config.seed);
+        G.set_partition_count(config.k);
+
+        balance_configuration bc;
+        bc.configurate_balance(config, G);
+
+        srand(config.seed);
+        random_functions::setSeed(config.seed);
+        graph_partitioner partitioner;
+        partitioner.perform_partitioning(config, G);
+
+        std::vector< PartitionID > start(G.number_of_nodes());
+        forall_nodes(G, node) {
+                start[node] = G.getPartitionIndex(node);
+        } endfor
+
+        config.enable_omp            = true;
+        config.upper_bound_partition = (1 + config.imbalance / 100.0) * ceil(config.largest_graph_weight / (double)config.k);
+
+        int failures = 0;
+        CycleRefinementAlgorithm algorithms[] = { CYCLE_REFINEMENT_ALGORITHM_ULTRA_MODEL,
+                                                  CYCLE_REFINEMENT_ALGORITHM_ULTRA_MODEL_PLUS };
+        for( CycleRefinementAlgorithm algorithm : algorithms ) {
+                config.cycle_refinement_algorithm = algorithm;
+
+                std::vector< PartitionID > sequential, parallel;
+                refine(config, G, start, 1, sequential);
+                refine(config, G, start, 4, parallel);
+
+                if( sequential != parallel ) {
+                        std::cout <<  "cycle refinement algorithm " << algorithm
+                                  <<  " computed different partitions with 1 and 4 threads"  << std::endl;
+                        failures++;
+                }
+        }
+
+        return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+ * kaffpa_batch_test.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include "kaHIP_interface.h"
+
+// every graph of a kaffpa_batch call has to be partitioned exactly as by a separate
+// kaffpa call, even though the threads reuse their scratch memory across graphs
+
+struct csr_graph {
+        std::vector< int > xadj;
+        std::vector< int > adjncy;
+        std::vector< int > vwgt;
+        std::vector< int > adjcwgt;
+};
+
+// x times y grid, weighted graphs get node weights 1..3 and symmetric edge weights 1..4
+static void grid(csr_graph & graph, int x, int y, bool weighted) {
+        graph.xadj.push_back(0);
+        for( int node = 0; node < x * y; node++) {
+                int col = node % x;
+                int row = node / x;
+                int neighbors[4] = { col > 0 ? node - 1 : -1, col + 1 < x ? node + 1 : -1,
+                                     row > 0 ? node - x : -1, row + 1 < y ? node + x : -1 };
+                for( int target : neighbors ) {
+                        if( target < 0 ) continue;
+                        graph.adjncy.push_back(target);
+                        if( weighted ) graph.adjcwgt.push_back(1 + (node + target) % 4);
+                }
+                if( weighted ) graph.vwgt.push_back(1 + node % 3);
+                graph.xadj.push_back(graph.adjncy.size());
+        }
+}
+
+int main(int argn, char **argv) {
+        // sizes alternate such that the scratch memory of a thread is reused by smaller graphs
+        const int num_graphs   = 8;
+        int sizes[num_graphs]  = { 40, 12, 33, 7, 25, 50, 9, 30 };
+        int blocks[num_graphs] = { 2, 4, 3, 2, 8, 4, 2, 16 };
+
+        std::vector< csr_graph > graphs(num_graphs);
+        std::vector< int > n(num_graphs), nparts(num_graphs), edgecut(num_graphs);
+        std::vector< double > imbalance(num_graphs, 0.03);
+        std::vector< int* > vwgt(num_graphs), xadj(num_graphs), adjcwgt(num_graphs), adjncy(num_graphs), part(num_graphs);
+        std::vector< std::vector< int > > partitions(num_graphs);
+        for( int i = 0; i < num_graphs; i++) {
+                grid(graphs[i], sizes[i], sizes[i] / 2 + 1, i % 2 == 0);
+                n[i]       = sizes[i] * (sizes[i] / 2 + 1);
+                nparts[i]  = blocks[i];
+                xadj[i]    = graphs[i].xadj.data();
+                adjncy[i]  = graphs[i].adjncy.data();
+                vwgt[i]    = graphs[i].vwgt.empty() ? NULL : graphs[i].vwgt.data();
+                adjcwgt[i] = graphs[i].adjcwgt.empty() ? NULL : graphs[i].adjcwgt.data();
+                partitions[i].resize(n[i]);
+                part[i]    = partitions[i].data();
+        }
+
+        const int seed = 3;
+        kaffpa_batch(num_graphs, n.data(), vwgt.data(), xadj.data(), adjcwgt.data(), adjncy.data(),
+                     nparts.data(), imbalance.data(), true, seed, ECO, 3, edgecut.data(), part.data());
+
+        int failures = 0;
+        for( int i = 0; i < num_graphs; i++) {
+                std::vector< int > expected_partition(n[i]);
+                int expected_edgecut = 0;
+                double graph_imbalance = imbalance[i];
+                kaffpa(&n[i], vwgt[i], xadj[i], adjcwgt[i], adjncy[i], &nparts[i], &graph_imbalance, true, seed, ECO,
+                       &expected_edgecut, expected_partition.data());
+
+                if( edgecut[i] != expected_edgecut || partitions[i] != expected_partition ) {
+                        std::cout <<  "graph " << i << ": kaffpa_batch cut " << edgecut[i]
+                                  <<  ", kaffpa cut " << expected_edgecut  << std::endl;
+                        failures++;
+                }
+        }
+
+        return failures == 0 ? 0 : 1;
+}